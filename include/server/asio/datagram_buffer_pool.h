@@ -0,0 +1,173 @@
+/*!
+    \file datagram_buffer_pool.h
+    \brief Datagram buffer pool definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_DATAGRAM_BUFFER_POOL_H
+#define CPPSERVER_ASIO_DATAGRAM_BUFFER_POOL_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+class DatagramBufferPool;
+
+//! Datagram buffer
+/*!
+    Datagram buffer is a reference counted handle of the datagram stored
+    in the buffer of the datagram buffer pool. Handles are copied or moved
+    (e.g. to worker threads) without copying the datagram and allocating
+    memory. The pooled buffer returns to its pool when its last handle is
+    released.
+
+    Several handles might share the same pooled buffer with different
+    slices (e.g. datagrams split from the coalesced receive buffer).
+
+    Not thread-safe. Different handles of the same pooled buffer could be
+    used from different threads.
+*/
+class DatagramBuffer
+{
+    friend class DatagramBufferPool;
+
+public:
+    DatagramBuffer() noexcept : _block(nullptr), _offset(0), _size(0) {}
+    DatagramBuffer(const DatagramBuffer& buffer) noexcept;
+    DatagramBuffer(DatagramBuffer&& buffer) noexcept;
+    ~DatagramBuffer() { reset(); }
+
+    DatagramBuffer& operator=(const DatagramBuffer& buffer) noexcept;
+    DatagramBuffer& operator=(DatagramBuffer&& buffer) noexcept;
+
+    //! Check if the handle holds the pooled buffer
+    explicit operator bool() const noexcept { return (_block != nullptr); }
+
+    //! Get the datagram data
+    uint8_t* data() noexcept { return (_block != nullptr) ? (_block->buffer.data() + _offset) : nullptr; }
+    //! Get the constant datagram data
+    const uint8_t* data() const noexcept { return (_block != nullptr) ? (_block->buffer.data() + _offset) : nullptr; }
+    //! Is the datagram empty?
+    bool empty() const noexcept { return (_size == 0); }
+    //! Get the datagram size
+    size_t size() const noexcept { return _size; }
+    //! Get the datagram capacity up to the end of the pooled buffer
+    size_t capacity() const noexcept { return (_block != nullptr) ? (_block->buffer.size() - _offset) : 0; }
+    //! Get the count of handles sharing the pooled buffer
+    size_t use_count() const noexcept { return (_block != nullptr) ? _block->references.load(std::memory_order_acquire) : 0; }
+
+    //! Resize the datagram within its capacity
+    void resize(size_t size) noexcept { assert((size <= capacity()) && "Datagram size exceeds the pooled buffer capacity!"); _size = size; }
+    //! Get the handle of the datagram slice sharing the same pooled buffer
+    /*!
+        \param offset - Slice offset from the beginning of the datagram
+        \param size - Slice size
+        \return Datagram slice handle
+    */
+    DatagramBuffer slice(size_t offset, size_t size) const noexcept;
+
+    //! Release the pooled buffer
+    void reset() noexcept;
+
+    //! Swap two instances
+    void swap(DatagramBuffer& buffer) noexcept;
+    friend void swap(DatagramBuffer& buffer1, DatagramBuffer& buffer2) noexcept { buffer1.swap(buffer2); }
+
+private:
+    // Pooled buffer block
+    struct Block
+    {
+        std::atomic<size_t> references{0};
+        std::shared_ptr<DatagramBufferPool> pool;
+        std::vector<uint8_t> buffer;
+    };
+
+    Block* _block;
+    size_t _offset;
+    size_t _size;
+
+    DatagramBuffer(Block* block, size_t offset, size_t size) noexcept : _block(block), _offset(offset), _size(size) {}
+};
+
+//! Datagram buffer pool
+/*!
+    Datagram buffer pool keeps preallocated datagram buffers of the same
+    capacity in the lock-free bounded MPMC ring, so buffers are acquired
+    and released from any thread without locks and memory allocations.
+
+    If the pool is empty a new buffer is allocated (see allocations()).
+    The pool keeps up to twice the count of preallocated buffers, so new
+    buffers allocated on bursts are reused later, and frees released
+    buffers above that.
+
+    Pool should be created with std::make_shared(), as acquired buffers
+    keep their pool alive.
+
+    Thread-safe.
+*/
+class DatagramBufferPool : public std::enable_shared_from_this<DatagramBufferPool>
+{
+    friend class DatagramBuffer;
+
+public:
+    //! Initialize the pool with a given count of preallocated buffers and buffer capacity
+    /*!
+        \param buffers - Count of preallocated buffers
+        \param capacity - Buffer capacity (default is 65536 to fit any datagram)
+    */
+    explicit DatagramBufferPool(size_t buffers, size_t capacity = 65536);
+    DatagramBufferPool(const DatagramBufferPool&) = delete;
+    DatagramBufferPool(DatagramBufferPool&&) = delete;
+    ~DatagramBufferPool();
+
+    DatagramBufferPool& operator=(const DatagramBufferPool&) = delete;
+    DatagramBufferPool& operator=(DatagramBufferPool&&) = delete;
+
+    //! Get the buffer capacity
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the count of buffers the pool could keep
+    size_t buffers() const noexcept { return _ring.size(); }
+    //! Get the count of buffers allocated when the pool was empty
+    uint64_t allocations() const noexcept { return _allocations.load(std::memory_order_relaxed); }
+
+    //! Acquire the buffer from the pool
+    /*!
+        \return Datagram buffer handle with the size equal to the buffer capacity
+    */
+    DatagramBuffer Acquire();
+
+private:
+    // Lock-free ring cell
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        DatagramBuffer::Block* block;
+    };
+
+    size_t _capacity;
+    std::vector<Cell> _ring;
+    size_t _mask;
+    alignas(64) std::atomic<size_t> _head;
+    alignas(64) std::atomic<size_t> _tail;
+    std::atomic<uint64_t> _allocations;
+
+    //! Try to push the block into the ring
+    bool TryPush(DatagramBuffer::Block* block) noexcept;
+    //! Try to pop the block from the ring
+    bool TryPop(DatagramBuffer::Block*& block) noexcept;
+
+    //! Release the block with the last handle
+    void Release(DatagramBuffer::Block* block) noexcept;
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_DATAGRAM_BUFFER_POOL_H
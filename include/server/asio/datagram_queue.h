@@ -0,0 +1,95 @@
+/*!
+    \file datagram_queue.h
+    \brief Datagram queue definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_DATAGRAM_QUEUE_H
+#define CPPSERVER_ASIO_DATAGRAM_QUEUE_H
+
+#include "asio.h"
+
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Datagram queue
+/*!
+    Datagram queue is a pooled ring of (endpoint, datagram) entries
+    used to queue asynchronous UDP sends. Buffers of popped entries
+    keep their capacity and are reused by the following pushes, so
+    the steady state send path does not allocate memory. The ring
+    grows twice when it is full.
+
+    Not thread-safe.
+*/
+class DatagramQueue
+{
+public:
+    //! Queued datagram
+    struct Datagram
+    {
+        //! Destination endpoint
+        asio::ip::udp::endpoint endpoint;
+        //! Datagram buffer
+        std::vector<uint8_t> buffer;
+    };
+
+public:
+    DatagramQueue() noexcept : _head(0), _size(0), _bytes(0) {}
+    DatagramQueue(const DatagramQueue&) = delete;
+    DatagramQueue(DatagramQueue&&) = delete;
+    ~DatagramQueue() = default;
+
+    DatagramQueue& operator=(const DatagramQueue&) = delete;
+    DatagramQueue& operator=(DatagramQueue&&) = delete;
+
+    //! Check if the queue is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Access the queued datagram with a given index starting from the front
+    Datagram& operator[](size_t index) noexcept { return _ring[(_head + index) & (_ring.size() - 1)]; }
+
+    //! Is the queue empty?
+    bool empty() const noexcept { return (_size == 0); }
+    //! Get the queue size (count of queued datagrams)
+    size_t size() const noexcept { return _size; }
+    //! Get the queue capacity (count of pooled entries)
+    size_t capacity() const noexcept { return _ring.size(); }
+    //! Get the total size of queued datagrams in bytes
+    size_t bytes() const noexcept { return _bytes; }
+
+    //! Get the front queued datagram
+    Datagram& front() noexcept { return _ring[_head]; }
+
+    //! Push the datagram into the back of the queue
+    /*!
+        \param endpoint - Destination endpoint
+        \param buffer - Datagram buffer
+        \param size - Datagram buffer size
+    */
+    void Push(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size);
+    //! Pop the front datagram from the queue
+    void Pop();
+
+    //! Clear the queue and keep all pooled entries
+    void Clear();
+
+    //! Swap two instances
+    void swap(DatagramQueue& queue) noexcept;
+    friend void swap(DatagramQueue& queue1, DatagramQueue& queue2) noexcept { queue1.swap(queue2); }
+
+private:
+    std::vector<Datagram> _ring;
+    size_t _head;
+    size_t _size;
+    size_t _bytes;
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_DATAGRAM_QUEUE_H
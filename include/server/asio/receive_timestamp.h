@@ -0,0 +1,86 @@
+/*!
+    \file receive_timestamp.h
+    \brief Socket receive timestamp definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RECEIVE_TIMESTAMP_H
+#define CPPSERVER_ASIO_RECEIVE_TIMESTAMP_H
+
+#include "asio.h"
+
+#include <cstdint>
+
+namespace CppServer {
+namespace Asio {
+
+//! Socket receive timestamp
+/*!
+    Socket receive timestamp is a kernel timestamp of the received packet
+    reported with SO_TIMESTAMPING if the OS support this feature. Software
+    timestamps are taken by the kernel when the packet enters the network
+    stack. They are UTC nanoseconds comparable with CppCommon::Timestamp::utc(),
+    so the time the packet waited in the socket queue before the handler is
+    measured as their difference.
+
+    Hardware timestamps are reported only if they are explicitly requested
+    and the network device has receive hardware timestamping enabled (e.g.
+    with SIOCSHWTSTAMP). They are taken by the device clock which is not
+    necessarily synchronized with the system clock.
+
+    Thread-safe.
+*/
+class ReceiveTimestamp
+{
+public:
+    ReceiveTimestamp() = delete;
+    ReceiveTimestamp(const ReceiveTimestamp&) = delete;
+    ReceiveTimestamp(ReceiveTimestamp&&) = delete;
+    ~ReceiveTimestamp() = delete;
+
+    ReceiveTimestamp& operator=(const ReceiveTimestamp&) = delete;
+    ReceiveTimestamp& operator=(ReceiveTimestamp&&) = delete;
+
+    //! Control buffer size enough for the timestamp and other control messages
+    static constexpr size_t CONTROL_SIZE = 128;
+
+    //! Enable receive timestamps for the given socket
+    /*!
+        \param socket - Native socket handle
+        \param hardware - Request raw hardware timestamps instead of software ones (default is false)
+        \return 'true' if receive timestamps were enabled, 'false' if the OS does not support this feature
+    */
+    static bool Setup(asio::detail::socket_type socket, bool hardware = false) noexcept;
+
+#if defined(__linux__)
+    //! Parse the receive timestamp from control messages of the received message
+    /*!
+        The software timestamp is preferred, the raw hardware timestamp is
+        used only if the software one is not reported (hardware timestamps
+        were requested).
+
+        \param message - Received message header
+        \return Receive timestamp in nanoseconds or 0 if the timestamp is not reported
+    */
+    static uint64_t Parse(const msghdr& message) noexcept;
+
+    //! Receive data with the receive timestamp from the given socket without blocking
+    /*!
+        \param socket - Native socket handle
+        \param buffer - Buffer to receive
+        \param size - Buffer size to receive
+        \param address - Buffer to receive the source address (nullptr for connected sockets)
+        \param address_size - Source address buffer size to update with the received source address size
+        \param timestamp - Receive timestamp in nanoseconds or 0 if the timestamp is not reported
+        \return Size of received data or -1 on error with errno set
+    */
+    static ssize_t Receive(asio::detail::socket_type socket, void* buffer, size_t size, void* address, socklen_t& address_size, uint64_t& timestamp) noexcept;
+#endif
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RECEIVE_TIMESTAMP_H
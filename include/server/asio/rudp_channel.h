@@ -0,0 +1,244 @@
+/*!
+    \file rudp_channel.h
+    \brief Reliable UDP channel definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_CHANNEL_H
+#define CPPSERVER_ASIO_RUDP_CHANNEL_H
+
+#include "time/timespan.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP channel
+/*!
+    Reliable UDP channel is a transport independent protocol state of
+    one reliable UDP peer. Each message is sent in a single datagram
+    with a sequence number and is retransmitted until the peer acknowledges
+    it. Messages are sent either as ordered (delivered strictly in the
+    sequence order) or as unordered (delivered as soon as received).
+
+    The receiver acknowledges the next expected sequence number together
+    with a selective acknowledgment bitmap of 32 following packets. Gaps
+    are reported immediately, so the sender fast retransmits the missing
+    packets once enough following packets are selectively acknowledged
+    (NACK) instead of waiting for the retransmission timeout.
+
+    The tail of the flight is probed before the retransmission timeout,
+    so losses of the last packets are detected by selective acknowledgments
+    as well.
+
+    The amount of packets in flight is limited by AIMD congestion window
+    (slow start, congestion avoidance, multiplicative decrease on loss).
+    Send and receive windows are rings of pooled packet buffers, so the
+    steady state does not allocate memory.
+
+    Each packet carries the connection epoch chosen by the connecting peer.
+    The accepting peer adopts the epoch of the first received packet and
+    skips packets of other epochs, so stale data, acknowledgments and
+    resets of the previous connection from the same endpoint do not affect
+    the new one.
+
+    Datagrams are sent with the send function, received messages are
+    passed to the receive function and acknowledged messages are reported
+    to the deliver function.
+
+    Not thread-safe.
+*/
+class RUDPChannel
+{
+public:
+    //! Packet type
+    enum class PacketType : uint8_t
+    {
+        Data  = 1,  //!< Message data
+        Ack   = 2,  //!< Selective acknowledgment
+        Reset = 3   //!< Channel reset
+    };
+
+    //! Packet header size
+    static constexpr size_t HEADER_SIZE = 8;
+    //! Acknowledgment packet size
+    static constexpr size_t ACK_SIZE = 12;
+    //! Send/receive window size in packets
+    static constexpr size_t WINDOW_SIZE = 1024;
+    //! Maximal message size
+    static constexpr size_t MAX_MESSAGE_SIZE = 65507 - HEADER_SIZE;
+
+    //! Initialize reliable UDP channel with given send, receive and deliver functions
+    /*!
+        \param send - Datagram send function
+        \param receive - Message receive function
+        \param deliver - Acknowledged messages count function
+    */
+    RUDPChannel(const std::function<bool(const void*, size_t)>& send, const std::function<void(const void*, size_t)>& receive, const std::function<void(size_t)>& deliver);
+    RUDPChannel(const RUDPChannel&) = delete;
+    RUDPChannel(RUDPChannel&&) = delete;
+    ~RUDPChannel() = default;
+
+    RUDPChannel& operator=(const RUDPChannel&) = delete;
+    RUDPChannel& operator=(RUDPChannel&&) = delete;
+
+    //! Get the connection epoch (0 if it is not adopted yet)
+    uint16_t epoch() const noexcept { return _epoch; }
+
+    //! Get the count of messages pending acknowledgment (queued and in flight)
+    size_t messages_pending() const noexcept { return (size_t)(_snd_end - _snd_una); }
+    //! Get the count of messages which could be sent before the send window is full
+    size_t messages_available() const noexcept { return WINDOW_SIZE - messages_pending(); }
+    //! Get the congestion window in packets
+    size_t congestion_window() const noexcept { return _cwnd; }
+    //! Get the smoothed round-trip time
+    CppCommon::Timespan rtt() const noexcept { return CppCommon::Timespan((int64_t)_srtt); }
+    //! Get the retransmission timeout
+    CppCommon::Timespan rto() const noexcept { return CppCommon::Timespan((int64_t)_rto); }
+
+    //! Get the number of data packets sent for the first time
+    uint64_t packets_sent() const noexcept { return _packets_sent; }
+    //! Get the number of data packets received for the first time
+    uint64_t packets_received() const noexcept { return _packets_received; }
+    //! Get the number of duplicate data packets received
+    uint64_t packets_duplicated() const noexcept { return _packets_duplicated; }
+    //! Get the number of retransmitted data packets
+    uint64_t packets_retransmitted() const noexcept { return _packets_retransmitted; }
+    //! Get the number of fast retransmits triggered by selective acknowledgments
+    uint64_t fast_retransmits() const noexcept { return _fast_retransmits; }
+    //! Get the number of retransmission timeouts
+    uint64_t timeouts() const noexcept { return _timeouts; }
+    //! Get the number of tail loss probes
+    uint64_t probes() const noexcept { return _probes; }
+
+    //! Is the channel busy with unacknowledged messages or pending acknowledgment?
+    bool IsBusy() const noexcept { return (_snd_una != _snd_end) || (_ack_pending > 0); }
+
+    //! Send the message
+    /*!
+        \param buffer - Message buffer
+        \param size - Message size
+        \param ordered - Ordered delivery flag
+        \return 'true' if the message was queued, 'false' if the message is invalid or the send window is full
+    */
+    bool Send(const void* buffer, size_t size, bool ordered);
+    //! Send the reset packet
+    void SendReset();
+
+    //! Receive the datagram
+    /*!
+        \param buffer - Datagram buffer
+        \param size - Datagram size
+        \return 'true' if the datagram was processed, 'false' if the channel was reset by the peer
+    */
+    bool Receive(const void* buffer, size_t size);
+
+    //! Perform delayed acknowledgments and retransmissions
+    /*!
+        Should be called periodically with a resolution lower than
+        the minimal retransmission timeout.
+
+        \return 'true' if the peer is alive, 'false' if some packet exceeded the retransmissions limit
+    */
+    bool Tick();
+
+    //! Reset the channel state and statistic keeping all pooled buffers
+    /*!
+        \param epoch - New connection epoch (0 to adopt the epoch of the first received packet, default is 0)
+    */
+    void Reset(uint16_t epoch = 0);
+
+    //! Get the connection epoch of the given packet
+    /*!
+        \param buffer - Packet buffer of at least HEADER_SIZE bytes
+        \return Connection epoch of the packet
+    */
+    static uint16_t PacketEpoch(const void* buffer) noexcept;
+    //! Is the given packet the first data packet of the connection?
+    /*!
+        \param buffer - Packet buffer
+        \param size - Packet size
+        \return 'true' if the packet is the data packet with zero sequence number, 'false' otherwise
+    */
+    static bool IsFirstPacket(const void* buffer, size_t size) noexcept;
+
+private:
+    // Send window packet
+    struct Packet
+    {
+        std::vector<uint8_t> buffer;
+        uint64_t timestamp{0};
+        uint32_t retransmits{0};
+        bool acked{false};
+    };
+
+    // Receive window slot
+    struct Slot
+    {
+        std::vector<uint8_t> buffer;
+        bool received{false};
+        bool delivered{false};
+    };
+
+    std::function<bool(const void*, size_t)> _send;
+    std::function<void(const void*, size_t)> _receive;
+    std::function<void(size_t)> _deliver;
+
+    // Connection epoch
+    uint16_t _epoch;
+    // Send window
+    std::vector<Packet> _send_window;
+    uint32_t _snd_una;
+    uint32_t _snd_nxt;
+    uint32_t _snd_end;
+    // Receive window
+    std::vector<Slot> _receive_window;
+    uint32_t _rcv_nxt;
+    size_t _ack_pending;
+    // Congestion control
+    size_t _cwnd;
+    size_t _cwnd_count;
+    size_t _ssthresh;
+    uint32_t _recovery;
+    // Round-trip time estimation
+    uint64_t _srtt;
+    uint64_t _rttvar;
+    uint64_t _rto;
+    // Channel statistic
+    uint64_t _packets_sent;
+    uint64_t _packets_received;
+    uint64_t _packets_duplicated;
+    uint64_t _packets_retransmitted;
+    uint64_t _fast_retransmits;
+    uint64_t _timeouts;
+    uint64_t _probes;
+
+    Packet& packet(uint32_t seq) noexcept { return _send_window[seq & (WINDOW_SIZE - 1)]; }
+    Slot& slot(uint32_t seq) noexcept { return _receive_window[seq & (WINDOW_SIZE - 1)]; }
+
+    //! Receive the data packet
+    void ReceiveData(const uint8_t* buffer, size_t size);
+    //! Receive the acknowledgment packet
+    void ReceiveAck(const uint8_t* buffer, size_t size);
+    //! Send the acknowledgment packet
+    void SendAck();
+
+    //! Transmit queued packets allowed by the congestion window
+    void Transmit();
+    //! Retransmit the given packet
+    void Retransmit(Packet& packet, uint64_t timestamp);
+    //! Acknowledge the given packet
+    void Acknowledge(Packet& packet, uint64_t timestamp);
+    //! Decrease the congestion window on the detected loss
+    void Congestion(size_t window);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_CHANNEL_H
@@ -0,0 +1,155 @@
+/*!
+    \file rudp_client.h
+    \brief Reliable UDP client definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_CLIENT_H
+#define CPPSERVER_ASIO_RUDP_CLIENT_H
+
+#include "rudp_channel.h"
+#include "udp_client.h"
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP client
+/*!
+    Reliable UDP client is used to send and receive reliable messages
+    to/from the connected reliable UDP server. Client is ticked by its
+    timer to send delayed acknowledgments and retransmit lost packets.
+
+    Client handlers onConnected(), onDisconnected() and onReceived() are
+    used by the reliable UDP protocol, so overrides should call the base
+    implementation.
+
+    Not thread-safe. Reliable messages should be sent from the client
+    handlers (e.g. onConnected(), onReceivedMessage(), onDelivered())
+    or from handlers posted into the client strand or IO service.
+*/
+class RUDPClient : public UDPClient
+{
+public:
+    //! Initialize reliable UDP client with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Server port number
+    */
+    RUDPClient(const std::shared_ptr<Service>& service, const std::string& address, int port);
+    //! Initialize reliable UDP client with a given Asio service, server address and scheme name
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param scheme - Scheme name
+    */
+    RUDPClient(const std::shared_ptr<Service>& service, const std::string& address, const std::string& scheme);
+    //! Initialize reliable UDP client with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+    */
+    RUDPClient(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint);
+    RUDPClient(const RUDPClient&) = delete;
+    RUDPClient(RUDPClient&&) = delete;
+    virtual ~RUDPClient() = default;
+
+    RUDPClient& operator=(const RUDPClient&) = delete;
+    RUDPClient& operator=(RUDPClient&&) = delete;
+
+    //! Get the reliable UDP channel
+    const RUDPChannel& channel() const noexcept { return _channel; }
+
+    //! Get the option: tick interval
+    const CppCommon::Timespan& option_tick_interval() const noexcept { return _option_tick_interval; }
+
+    //! Disconnect the client (synchronous)
+    /*!
+        Reset packet is sent to the server.
+
+        \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
+    */
+    bool Disconnect() override;
+    //! Disconnect the client (asynchronous)
+    /*!
+        Reset packet is sent to the server.
+
+        \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
+    */
+    bool DisconnectAsync() override;
+
+    //! Send reliable message to the server (asynchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \param ordered - Ordered delivery flag (default is true)
+        \return 'true' if the message was successfully queued, 'false' if the client is not connected or the send window is full
+    */
+    virtual bool SendReliableAsync(const void* buffer, size_t size, bool ordered = true);
+    //! Send reliable text message to the server (asynchronous)
+    /*!
+        \param text - Text string to send
+        \param ordered - Ordered delivery flag (default is true)
+        \return 'true' if the message was successfully queued, 'false' if the client is not connected or the send window is full
+    */
+    virtual bool SendReliableAsync(std::string_view text, bool ordered = true) { return SendReliableAsync(text.data(), text.size(), ordered); }
+
+    //! Setup option: tick interval
+    /*!
+        Client sends delayed acknowledgments and retransmits lost packets
+        with this interval. It should be lower than the minimal retransmission
+        timeout (20 milliseconds).
+
+        \param interval - Tick interval (default is 10 milliseconds)
+    */
+    void SetupTickInterval(const CppCommon::Timespan& interval) noexcept { _option_tick_interval = interval; }
+
+protected:
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from the server.
+        Ordered messages are received in the send order.
+
+        \param buffer - Received message buffer
+        \param size - Received message size
+    */
+    virtual void onReceivedMessage(const void* buffer, size_t size) {}
+    //! Handle messages delivered notification
+    /*!
+        Notification is called when sent messages were acknowledged by the server.
+        This handler could be used to send more messages when the send window is full.
+
+        \param messages - Count of acknowledged messages
+    */
+    virtual void onDelivered(size_t messages) {}
+
+protected:
+    void onConnected() override;
+    void onDisconnected() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Reliable UDP channel
+    RUDPChannel _channel;
+    uint16_t _epoch;
+    // Client tick timer
+    asio::steady_timer _timer;
+    bool _ticking;
+    // Options
+    CppCommon::Timespan _option_tick_interval;
+
+    //! Send the reset packet to the server
+    void SendReset();
+
+    //! Try to start ticking the channel
+    void TryTick();
+    //! Tick the channel
+    void Tick();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_CLIENT_H
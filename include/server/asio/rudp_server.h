@@ -0,0 +1,170 @@
+/*!
+    \file rudp_server.h
+    \brief Reliable UDP server definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_SERVER_H
+#define CPPSERVER_ASIO_RUDP_SERVER_H
+
+#include "rudp_session.h"
+#include "udp_server.h"
+
+#include <map>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP server
+/*!
+    Reliable UDP server keeps reliable UDP sessions of its clients
+    keyed by their endpoints. Session is created with CreateSession()
+    on the first data packet of the connection received from a new
+    endpoint and removed when it is disconnected, reset by the client,
+    its client becomes unreachable or idle for the session timeout.
+    The first data packet of another connection epoch replaces the stale
+    session of the same endpoint.
+
+    Sessions share the server socket and are ticked by the server timer
+    to send delayed acknowledgments and retransmit lost packets.
+
+    Server handlers onStarted(), onStopped() and onReceived() are used
+    by the reliable UDP protocol, so overrides should call the base
+    implementation.
+
+    Not thread-safe. Sessions should be accessed from the server handlers.
+*/
+class RUDPServer : public UDPServer
+{
+    friend class RUDPSession;
+
+public:
+    //! Initialize reliable UDP server with a given Asio service and port number
+    /*!
+        \param service - Asio service
+        \param port - Port number
+        \param protocol - Internet protocol type (default is IPv4)
+    */
+    RUDPServer(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol = InternetProtocol::IPv4);
+    //! Initialize reliable UDP server with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Port number
+    */
+    RUDPServer(const std::shared_ptr<Service>& service, const std::string& address, int port);
+    //! Initialize reliable UDP server with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+    */
+    RUDPServer(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint);
+    RUDPServer(const RUDPServer&) = delete;
+    RUDPServer(RUDPServer&&) = delete;
+    virtual ~RUDPServer() = default;
+
+    RUDPServer& operator=(const RUDPServer&) = delete;
+    RUDPServer& operator=(RUDPServer&&) = delete;
+
+    //! Get the number of sessions connected to the server
+    uint64_t connected_sessions() const noexcept { return _sessions.size(); }
+
+    //! Get the option: tick interval
+    const CppCommon::Timespan& option_tick_interval() const noexcept { return _option_tick_interval; }
+    //! Get the option: session idle timeout
+    const CppCommon::Timespan& option_session_timeout() const noexcept { return _option_session_timeout; }
+    //! Get the option: maximal sessions count
+    size_t option_max_sessions() const noexcept { return _option_max_sessions; }
+
+    //! Find the session with a given client endpoint
+    /*!
+        \param endpoint - Client UDP endpoint
+        \return Session with a given client endpoint or null session if the session is not exist
+    */
+    std::shared_ptr<RUDPSession> FindSession(const asio::ip::udp::endpoint& endpoint);
+
+    //! Disconnect all connected sessions
+    /*!
+        \return 'true' if all sessions were successfully disconnected, 'false' if the server is not started
+    */
+    virtual bool DisconnectAll();
+
+    //! Setup option: tick interval
+    /*!
+        Sessions send delayed acknowledgments and retransmit lost packets
+        with this interval. It should be lower than the minimal retransmission
+        timeout (20 milliseconds).
+
+        \param interval - Tick interval (default is 10 milliseconds)
+    */
+    void SetupTickInterval(const CppCommon::Timespan& interval) noexcept { _option_tick_interval = interval; }
+    //! Setup option: session idle timeout
+    /*!
+        \param timeout - Session idle timeout (default is 30 seconds)
+    */
+    void SetupSessionTimeout(const CppCommon::Timespan& timeout) noexcept { _option_session_timeout = timeout; }
+    //! Setup option: maximal sessions count
+    /*!
+        First data packets of unknown endpoints are dropped without creating
+        new sessions if the sessions count meets the limit. It bounds the
+        memory used by datagrams with spoofed source endpoints.
+        Default is unlimited.
+
+        \param sessions - Maximal sessions count
+    */
+    void SetupMaxSessions(size_t sessions) noexcept { _option_max_sessions = sessions; }
+
+protected:
+    //! Create reliable UDP session factory method
+    /*!
+        \param server - Reliable UDP server
+        \param endpoint - Client UDP endpoint
+        \return Reliable UDP session
+    */
+    virtual std::shared_ptr<RUDPSession> CreateSession(const std::shared_ptr<RUDPServer>& server, const asio::ip::udp::endpoint& endpoint) { return std::make_shared<RUDPSession>(server, endpoint); }
+
+protected:
+    //! Handle session connected notification
+    /*!
+        \param session - Connected session
+    */
+    virtual void onConnected(std::shared_ptr<RUDPSession>& session) {}
+    //! Handle session disconnected notification
+    /*!
+        \param session - Disconnected session
+    */
+    virtual void onDisconnected(std::shared_ptr<RUDPSession>& session) {}
+
+protected:
+    void onStarted() override;
+    void onStopped() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Server sessions
+    std::map<asio::ip::udp::endpoint, std::shared_ptr<RUDPSession>> _sessions;
+    std::vector<std::shared_ptr<RUDPSession>> _ticked_sessions;
+    // Server tick timer
+    asio::steady_timer _timer;
+    bool _ticking;
+    // Options
+    CppCommon::Timespan _option_tick_interval;
+    CppCommon::Timespan _option_session_timeout;
+    size_t _option_max_sessions{0};
+
+    //! Try to start ticking sessions
+    void TryTick();
+    //! Tick all sessions
+    void Tick();
+
+    //! Unregister the session by client endpoint
+    void UnregisterSession(const asio::ip::udp::endpoint& endpoint);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_SERVER_H
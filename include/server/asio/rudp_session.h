@@ -0,0 +1,138 @@
+/*!
+    \file rudp_session.h
+    \brief Reliable UDP session definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_SESSION_H
+#define CPPSERVER_ASIO_RUDP_SESSION_H
+
+#include "rudp_channel.h"
+#include "service.h"
+
+#include "system/uuid.h"
+
+namespace CppServer {
+namespace Asio {
+
+class RUDPServer;
+
+//! Reliable UDP session
+/*!
+    Reliable UDP session is used to send and receive reliable messages
+    from the reliable UDP client identified by its endpoint.
+
+    Not thread-safe. Session should be used from the server handlers
+    (e.g. onReceivedMessage()) or from handlers posted into the server
+    strand or IO service.
+*/
+class RUDPSession : public std::enable_shared_from_this<RUDPSession>
+{
+    friend class RUDPServer;
+
+public:
+    //! Initialize the session with a given server and client endpoint
+    /*!
+        \param server - Connected server
+        \param endpoint - Client UDP endpoint
+    */
+    RUDPSession(const std::shared_ptr<RUDPServer>& server, const asio::ip::udp::endpoint& endpoint);
+    RUDPSession(const RUDPSession&) = delete;
+    RUDPSession(RUDPSession&&) = delete;
+    virtual ~RUDPSession() = default;
+
+    RUDPSession& operator=(const RUDPSession&) = delete;
+    RUDPSession& operator=(RUDPSession&&) = delete;
+
+    //! Get the session Id
+    const CppCommon::UUID& id() const noexcept { return _id; }
+
+    //! Get the server
+    std::shared_ptr<RUDPServer>& server() noexcept { return _server; }
+    //! Get the client endpoint
+    const asio::ip::udp::endpoint& endpoint() const noexcept { return _endpoint; }
+    //! Get the reliable UDP channel
+    const RUDPChannel& channel() const noexcept { return _channel; }
+
+    //! Is the session connected?
+    bool IsConnected() const noexcept { return _connected; }
+
+    //! Disconnect the session
+    /*!
+        Reset packet is sent to the client.
+
+        \return 'true' if the session was successfully disconnected, 'false' if the session is already disconnected
+    */
+    virtual bool Disconnect();
+
+    //! Send reliable message to the client (asynchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \param ordered - Ordered delivery flag (default is true)
+        \return 'true' if the message was successfully queued, 'false' if the session is not connected or the send window is full
+    */
+    virtual bool SendReliableAsync(const void* buffer, size_t size, bool ordered = true);
+    //! Send reliable text message to the client (asynchronous)
+    /*!
+        \param text - Text string to send
+        \param ordered - Ordered delivery flag (default is true)
+        \return 'true' if the message was successfully queued, 'false' if the session is not connected or the send window is full
+    */
+    virtual bool SendReliableAsync(std::string_view text, bool ordered = true) { return SendReliableAsync(text.data(), text.size(), ordered); }
+
+protected:
+    //! Handle session connected notification
+    virtual void onConnected() {}
+    //! Handle session disconnected notification
+    virtual void onDisconnected() {}
+
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from the client.
+        Ordered messages are received in the send order.
+
+        \param buffer - Received message buffer
+        \param size - Received message size
+    */
+    virtual void onReceivedMessage(const void* buffer, size_t size) {}
+    //! Handle messages delivered notification
+    /*!
+        Notification is called when sent messages were acknowledged by the client.
+        This handler could be used to send more messages when the send window is full.
+
+        \param messages - Count of acknowledged messages
+    */
+    virtual void onDelivered(size_t messages) {}
+
+private:
+    // Session Id
+    CppCommon::UUID _id;
+    // Server & endpoint
+    std::shared_ptr<RUDPServer> _server;
+    asio::ip::udp::endpoint _endpoint;
+    // Reliable UDP channel
+    RUDPChannel _channel;
+    std::atomic<bool> _connected;
+    uint64_t _activity;
+
+    //! Connect the session
+    void Connect();
+    //! Disconnect the session
+    /*!
+        \param reset - Send reset packet to the client flag
+    */
+    void DisconnectInternal(bool reset);
+
+    //! Receive the datagram from the client
+    void Receive(const void* buffer, size_t size);
+    //! Perform delayed acknowledgments, retransmissions and idle timeout check
+    void Tick(uint64_t timestamp);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_SESSION_H
@@ -11,6 +11,7 @@
 
 #include "asio.h"
 #include "memory.h"
+#include "timer_wheel.h"
 
 #include "threads/thread.h"
 
@@ -110,6 +111,16 @@ public:
     virtual std::shared_ptr<asio::io_context>& GetAsioService() noexcept
     { return _services[++_round_robin_index % _services.size()]; }
 
+    //! Get the timer wheel of the given Asio IO service
+    /*!
+        Each Asio IO service of the Asio service has its own timer wheel,
+        which is used to plan cheap timeouts of sessions bound to it.
+
+        \param io_service - Asio IO service
+        \return Timer wheel of the given Asio IO service or nullptr if the Asio IO service does not belong to the Asio service
+    */
+    std::shared_ptr<TimerWheel> GetTimerWheel(const std::shared_ptr<asio::io_context>& io_service) noexcept;
+
     //! Dispatch the given handler
     /*!
         The given handler may be executed immediately if this function is called from IO service thread.
@@ -162,6 +173,8 @@ protected:
 private:
     // Asio IO services
     std::vector<std::shared_ptr<asio::io_context>> _services;
+    // Asio IO services timer wheels
+    std::vector<std::shared_ptr<TimerWheel>> _wheels;
     // Asio service working threads
     std::vector<std::thread> _threads;
     // Asio service strand for serialized handler execution
@@ -11,6 +11,16 @@
 
 #include "service.h"
 
+#include "time/timespan.h"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace CppServer {
 namespace Asio {
 
@@ -18,22 +28,170 @@ namespace Asio {
 /*!
     SSL context is used to handle and validate certificates in SSL clients and servers.
 
+    SSL context also manages TLS session resumption: server-side session
+    cache, rotating session ticket keys and client-side session reuse
+    keyed by the server endpoint. Resumption statistic is collected for
+    all SSL clients and sessions which share the same SSL context.
+
+    On Linux with OpenSSL 3 SSL context is also able to capture traffic
+    keys of server sessions to offload their data path to kernel TLS.
+
     Thread-safe.
 */
 class SSLContext : public asio::ssl::context
 {
+    friend class SSLClient;
+    friend class SSLServer;
+    friend class SSLSession;
+
 public:
     using asio::ssl::context::context;
 
     SSLContext(const SSLContext&) = delete;
     SSLContext(SSLContext&&) = delete;
-    ~SSLContext() = default;
+    ~SSLContext();
 
     SSLContext& operator=(const SSLContext&) = delete;
     SSLContext& operator=(SSLContext&&) = delete;
 
     //! Configures the context to use system root certificates
     void set_root_certs();
+    //! Configures the context ALPN protocols
+    /*!
+        Client context advertises the given protocols. Server context
+        selects the first protocol from the given list which is also
+        supported by the client.
+
+        Throws asio::system_error if the protocols cannot be set.
+
+        \param protocols - ALPN protocols in the preference order (e.g. "h2", "http/1.1")
+    */
+    void set_alpn_protocols(const std::vector<std::string>& protocols);
+
+    //! Configures the server context session cache
+    /*!
+        Server context keeps resumable sessions in the shared cache
+        limited by the given size. The oldest sessions are evicted
+        when the cache is full.
+
+        \param size - Maximal count of cached sessions (default is 20480)
+        \param timeout - Session lifetime (default is 5 minutes)
+    */
+    void set_session_cache(size_t size = 20480, const CppCommon::Timespan& timeout = CppCommon::Timespan::minutes(5));
+    //! Configures the server context session tickets
+    /*!
+        Server context encrypts session tickets with its own ticket keys
+        which are rotated with the given interval. Tickets encrypted with
+        the previous key are still accepted and renewed with the current one.
+
+        \param enable - Enable/disable session tickets
+        \param rotation - Ticket keys rotation interval (default is 1 hour)
+    */
+    void set_session_tickets(bool enable, const CppCommon::Timespan& rotation = CppCommon::Timespan::hours(1));
+    //! Rotate the server context session ticket keys
+    void rotate_session_ticket_keys();
+    //! Configures the client context session reuse
+    /*!
+        Client context remembers the last resumable session for each
+        server endpoint and offers it in the next handshake with the same
+        endpoint.
+
+        \param enable - Enable/disable client session reuse
+        \param size - Maximal count of remembered endpoints (default is 1024)
+    */
+    void set_session_reuse(bool enable, size_t size = 1024);
+
+    //! Get the number of completed handshakes
+    uint64_t handshakes() const noexcept { return _handshakes; }
+    //! Get the number of resumed handshakes
+    uint64_t handshakes_resumed() const noexcept { return _handshakes_resumed; }
+    //! Get the resumption rate of completed handshakes (0.0 - 1.0)
+    double resumption_rate() const noexcept { uint64_t total = _handshakes; return (total > 0) ? ((double)_handshakes_resumed / total) : 0.0; }
+    //! Reset handshakes statistic
+    void reset_handshakes() noexcept { _handshakes = 0; _handshakes_resumed = 0; }
+
+private:
+    // ALPN protocols in the wire format
+    std::string _alpn;
+
+    // Session ticket key
+    struct TicketKey
+    {
+        unsigned char name[16];
+        unsigned char aes[32];
+        unsigned char hmac[32];
+    };
+
+    // Session ticket keys (current and previous)
+    std::mutex _tickets_lock;
+    std::array<TicketKey, 2> _tickets{};
+    CppCommon::Timespan _tickets_rotation;
+    uint64_t _tickets_rotated{0};
+
+    // Client sessions for reuse keyed by the server endpoint (most recently used first)
+    std::mutex _sessions_lock;
+    std::list<std::pair<std::string, SSL_SESSION*>> _sessions;
+    std::unordered_map<std::string, std::list<std::pair<std::string, SSL_SESSION*>>::iterator> _sessions_index;
+    size_t _sessions_limit{0};
+
+    // Handshakes statistic
+    std::atomic<uint64_t> _handshakes{0};
+    std::atomic<uint64_t> _handshakes_resumed{0};
+
+    //! Restore the client session for the given server endpoint before the handshake
+    void RestoreSession(SSL* ssl, const asio::ip::tcp::endpoint& endpoint);
+    //! Register the completed handshake in statistic
+    void RegisterHandshake(SSL* ssl) noexcept;
+    //! Store the client session for the given server endpoint key
+    bool StoreSession(const std::string& key, SSL_SESSION* session);
+    //! Is the session resumable?
+    static bool IsResumable(const SSL_SESSION* session) noexcept;
+
+    //! Generate a new session ticket key
+    static void GenerateTicketKey(TicketKey& key);
+    //! Rotate session ticket keys if the rotation interval is expired
+    void RotateTicketKeys(bool force);
+
+    // SSL context & SSL connection extra data indexes
+    static int ContextIndex();
+    static int EndpointIndex();
+
+    // ALPN protocol select callback
+    static int SelectALPN(SSL* ssl, const unsigned char** out, unsigned char* outlen, const unsigned char* in, unsigned int inlen, void* arg);
+    // Session ticket key callback
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    static int TicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cctx, EVP_MAC_CTX* mctx, int enc);
+#else
+    static int TicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cctx, HMAC_CTX* hctx, int enc);
+#endif
+    // New client session callback
+    static int NewSession(SSL* ssl, SSL_SESSION* session);
+
+    //! Prepare the context to capture traffic secrets for kernel TLS
+    void PrepareKTLS();
+    //! Track the server SSL connection handshake for kernel TLS
+    void TrackKTLS(SSL* ssl);
+    //! Offload the handshaked server SSL connection to kernel TLS
+    /*!
+        Only AES-GCM cipher suites of TLS 1.2 and TLS 1.3 are supported.
+        Each direction is offloaded independently and falls back to the
+        user-space SSL stream if the kernel refuses it.
+
+        \param ssl - Handshaked SSL connection
+        \param socket - Native socket handle
+        \param send - Kernel TLS send offload result
+        \param receive - Kernel TLS receive offload result
+    */
+    static void EnableKTLS(SSL* ssl, asio::ip::tcp::socket::native_handle_type socket, bool& send, bool& receive);
+    //! Send the close notify alert through kernel TLS
+    static void CloseKTLS(asio::ip::tcp::socket::native_handle_type socket);
+
+    // Kernel TLS SSL connection extra data index
+    static int KTLSIndex();
+    // Kernel TLS traffic secrets callback
+    static void KTLSKeylog(const SSL* ssl, const char* line);
+    // Kernel TLS record sequence callback
+    static void KTLSMessage(int write_p, int version, int content_type, const void* buf, size_t len, SSL* ssl, void* arg);
 };
 
 } // namespace Asio
@@ -13,6 +13,7 @@
 #include "ssl_session.h"
 
 #include "system/uuid.h"
+#include "time/timespan.h"
 
 #include <map>
 #include <mutex>
@@ -93,6 +94,19 @@ public:
     //! Get the number of bytes received by the server
     uint64_t bytes_received() const noexcept { return _bytes_received; }
 
+    //! Get the handshake Asio service
+    std::shared_ptr<Service>& handshake_service() noexcept { return _handshake_service; }
+    //! Get the number of handshakes in flight (started, but not finished yet)
+    uint64_t handshakes_in_flight() const noexcept { return _handshakes_in_flight; }
+    //! Get the maximal number of handshakes in flight
+    uint64_t handshakes_in_flight_max() const noexcept { return _handshakes_in_flight_max; }
+    //! Get the number of finished handshakes
+    uint64_t handshakes_finished() const noexcept { return _handshakes_finished; }
+    //! Get the average handshake latency
+    CppCommon::Timespan handshake_latency() const noexcept { uint64_t finished = _handshakes_finished; return CppCommon::Timespan((finished > 0) ? (int64_t)(_handshake_latency_total / finished) : 0); }
+    //! Get the maximal handshake latency
+    CppCommon::Timespan handshake_latency_max() const noexcept { return CppCommon::Timespan((int64_t)_handshake_latency_max); }
+
     //! Get the option: keep alive
     bool option_keep_alive() const noexcept { return _option_keep_alive; }
     //! Get the option: no delay
@@ -101,6 +115,8 @@ public:
     bool option_reuse_address() const noexcept { return _option_reuse_address; }
     //! Get the option: reuse port
     bool option_reuse_port() const noexcept { return _option_reuse_port; }
+    //! Get the option: kernel TLS
+    bool option_ktls() const noexcept { return _option_ktls; }
 
     //! Is the server started?
     bool IsStarted() const noexcept { return _started; }
@@ -178,6 +194,33 @@ public:
         \param enable - Enable/disable option
     */
     void SetupReusePort(bool enable) noexcept { _option_reuse_port = enable; }
+    //! Setup option: kernel TLS
+    /*!
+        This option will offload encryption and decryption of handshaked
+        sessions to the kernel TLS (Linux with OpenSSL 3 only). Sessions
+        use plain socket I/O for the offloaded directions and fall back to
+        the SSL stream if the protocol, the cipher suite or the kernel does
+        not support the offload. TLS 1.3 key updates are not supported by
+        the offloaded receiving and disconnect the session.
+
+        \param enable - Enable/disable option
+    */
+    void SetupKTLS(bool enable);
+    //! Setup the handshake Asio service
+    /*!
+        SSL handshakes of new sessions will be performed by working threads
+        of the given Asio service, so a burst of new connections does not
+        stall established sessions. Sessions continue to work in their own
+        IO services after the handshake. The handshake service should be
+        started before the server and its working threads count bounds
+        the handshake concurrency. If the handshake service is not started
+        when a new session is connected, its handshake is performed in the
+        session IO service. The handshake service must not be stopped while
+        the server is started, otherwise pending handshakes never complete.
+
+        \param service - Handshake Asio service (nullptr to perform handshakes in session IO services)
+    */
+    void SetupHandshakeService(const std::shared_ptr<Service>& service) noexcept { _handshake_service = service; }
 
 protected:
     //! Create SSL session factory method
@@ -246,11 +289,19 @@ private:
     uint64_t _bytes_pending;
     uint64_t _bytes_sent;
     uint64_t _bytes_received;
+    // Handshake service & statistic
+    std::shared_ptr<Service> _handshake_service;
+    std::atomic<uint64_t> _handshakes_in_flight;
+    std::atomic<uint64_t> _handshakes_in_flight_max;
+    std::atomic<uint64_t> _handshakes_finished;
+    std::atomic<uint64_t> _handshake_latency_total;
+    std::atomic<uint64_t> _handshake_latency_max;
     // Options
     bool _option_keep_alive;
     bool _option_no_delay;
     bool _option_reuse_address;
     bool _option_reuse_port;
+    bool _option_ktls;
 
     //! Accept new connections
     void Accept();
@@ -266,6 +317,14 @@ private:
     //! Clear multicast buffer
     void ClearBuffers();
 
+    //! Update handshake statistic when the handshake is started
+    void HandshakeStarted() noexcept;
+    //! Update handshake statistic when the handshake is finished
+    /*!
+        \param latency - Handshake latency in nanoseconds
+    */
+    void HandshakeFinished(uint64_t latency) noexcept;
+
     //! Send error notification
     void SendError(std::error_code ec);
 };
@@ -13,6 +13,9 @@
 
 #include "system/uuid.h"
 
+#include <initializer_list>
+#include <limits>
+
 namespace CppServer {
 namespace Asio {
 
@@ -75,6 +78,10 @@ public:
     bool IsConnected() const noexcept { return _connected; }
     //! Is the session handshaked?
     bool IsHandshaked() const noexcept { return _handshaked; }
+    //! Is the session sending offloaded to kernel TLS?
+    bool IsKTLSSend() const noexcept { return _ktls_send; }
+    //! Is the session receiving offloaded to kernel TLS?
+    bool IsKTLSReceive() const noexcept { return _ktls_receive; }
 
     //! Disconnect the session
     /*!
@@ -95,6 +102,12 @@ public:
         \return Size of sent text
     */
     virtual size_t Send(std::string_view text) { return Send(text.data(), text.size()); }
+    //! Send data chunks to the client with a single gather write (synchronous)
+    /*!
+        \param buffers - Buffers to send
+        \return Size of sent data
+    */
+    virtual size_t Send(std::initializer_list<asio::const_buffer> buffers);
 
     //! Send data to the client with timeout (synchronous)
     /*!
@@ -112,6 +125,19 @@ public:
     */
     virtual size_t Send(std::string_view text, const CppCommon::Timespan& timeout) { return Send(text.data(), text.size(), timeout); }
 
+    //! Send the file content to the client (synchronous)
+    /*!
+        File content is sent with sendfile() directly from the page cache
+        when the session send path is offloaded to kernel TLS, otherwise
+        it is read and sent through the SSL stream in TLS record chunks.
+
+        \param path - File path
+        \param offset - File offset (default is 0)
+        \param size - File content size (default is up to the end of the file)
+        \return Size of sent data
+    */
+    virtual size_t SendFile(const std::string& path, uint64_t offset = 0, size_t size = std::numeric_limits<size_t>::max());
+
     //! Send data to the client (asynchronous)
     /*!
         \param buffer - Buffer to send
@@ -125,6 +151,15 @@ public:
         \return 'true' if the text was successfully sent, 'false' if the session is not connected
     */
     virtual bool SendAsync(std::string_view text) { return SendAsync(text.data(), text.size()); }
+    //! Send data chunks to the client as a single message (asynchronous)
+    /*!
+        All chunks are appended to the send buffer at once, so they are
+        never interleaved with data sent from other threads.
+
+        \param buffers - Buffers to send
+        \return 'true' if the data was successfully sent, 'false' if the session is not connected
+    */
+    virtual bool SendAsync(std::initializer_list<asio::const_buffer> buffers);
 
     //! Receive data from the client (synchronous)
     /*!
@@ -251,6 +286,9 @@ private:
     asio::ssl::stream<asio::ip::tcp::socket> _stream;
     std::atomic<bool> _connected;
     std::atomic<bool> _handshaked;
+    // Kernel TLS offload
+    bool _ktls_send;
+    bool _ktls_receive;
     // Session statistic
     uint64_t _bytes_pending;
     uint64_t _bytes_sending;
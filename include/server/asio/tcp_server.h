@@ -95,6 +95,8 @@ public:
     bool option_reuse_address() const noexcept { return _option_reuse_address; }
     //! Get the option: reuse port
     bool option_reuse_port() const noexcept { return _option_reuse_port; }
+    //! Get the option: receive timestamps
+    bool option_receive_timestamp() const noexcept { return _option_receive_timestamp; }
 
     //! Is the server started?
     bool IsStarted() const noexcept { return _started; }
@@ -172,6 +174,17 @@ public:
         \param enable - Enable/disable option
     */
     void SetupReusePort(bool enable) noexcept { _option_reuse_port = enable; }
+    //! Setup option: receive timestamps
+    /*!
+        This option will enable SO_TIMESTAMPING receive timestamps of sessions
+        if the OS support this feature (see ReceiveTimestamp). The kernel
+        timestamp of the latest segment of the received data is available
+        with TCPSession::receive_timestamp() during TCPSession::onReceived().
+        Data which arrived before the session was connected has no timestamp.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReceiveTimestamp(bool enable) noexcept { _option_receive_timestamp = enable; }
 
 protected:
     //! Create TCP session factory method
@@ -239,6 +252,7 @@ private:
     bool _option_no_delay;
     bool _option_reuse_address;
     bool _option_reuse_port;
+    bool _option_receive_timestamp{false};
 
     //! Accept new connections
     void Accept();
@@ -9,10 +9,13 @@
 #ifndef CPPSERVER_ASIO_TCP_SESSION_H
 #define CPPSERVER_ASIO_TCP_SESSION_H
 
+#include "receive_timestamp.h"
 #include "service.h"
 
 #include "system/uuid.h"
 
+#include <initializer_list>
+
 namespace CppServer {
 namespace Asio {
 
@@ -59,6 +62,8 @@ public:
     uint64_t bytes_sent() const noexcept { return _bytes_sent; }
     //! Get the number of bytes received by the session
     uint64_t bytes_received() const noexcept { return _bytes_received; }
+    //! Get the kernel receive timestamp of the handled data in nanoseconds (0 if not available)
+    uint64_t receive_timestamp() const noexcept { return _receive_timestamp; }
 
     //! Get the option: receive buffer limit
     size_t option_receive_buffer_limit() const noexcept { return _receive_buffer_limit; }
@@ -71,6 +76,8 @@ public:
 
     //! Is the session connected?
     bool IsConnected() const noexcept { return _connected; }
+    //! Are the receive timestamps enabled for the connected session?
+    bool IsReceiveTimestamp() const noexcept { return _timestamp; }
 
     //! Disconnect the session
     /*!
@@ -91,6 +98,12 @@ public:
         \return Size of sent text
     */
     virtual size_t Send(std::string_view text) { return Send(text.data(), text.size()); }
+    //! Send data chunks to the client with a single gather write (synchronous)
+    /*!
+        \param buffers - Buffers to send
+        \return Size of sent data
+    */
+    virtual size_t Send(std::initializer_list<asio::const_buffer> buffers);
 
     //! Send data to the client with timeout (synchronous)
     /*!
@@ -121,6 +134,26 @@ public:
         \return 'true' if the text was successfully sent, 'false' if the session is not connected
     */
     virtual bool SendAsync(std::string_view text) { return SendAsync(text.data(), text.size()); }
+    //! Send data chunks to the client as a single message (asynchronous)
+    /*!
+        All chunks are appended to the send buffer at once, so they are
+        never interleaved with data sent from other threads.
+
+        \param buffers - Buffers to send
+        \return 'true' if the data was successfully sent, 'false' if the session is not connected
+    */
+    virtual bool SendAsync(std::initializer_list<asio::const_buffer> buffers);
+    //! Send shared buffer to the client (asynchronous)
+    /*!
+        Shared buffer is not copied into the send buffer. It is kept alive
+        until it is written to the socket, so the same buffer could be sent
+        to many sessions at once (e.g. pre-framed multicast messages).
+        Shared buffer must not be changed after it was sent!
+
+        \param buffer - Shared buffer to send
+        \return 'true' if the data was successfully sent, 'false' if the session is not connected
+    */
+    virtual bool SendAsync(const std::shared_ptr<const std::vector<uint8_t>>& buffer);
 
     //! Receive data from the client (synchronous)
     /*!
@@ -254,6 +287,9 @@ private:
     size_t _receive_buffer_limit{0};
     std::vector<uint8_t> _receive_buffer;
     HandlerStorage _receive_storage;
+    // Receive timestamps
+    bool _timestamp{false};
+    uint64_t _receive_timestamp{0};
     // Send buffer
     bool _sending;
     std::mutex _send_lock;
@@ -261,6 +297,12 @@ private:
     std::vector<uint8_t> _send_buffer_main;
     std::vector<uint8_t> _send_buffer_flush;
     size_t _send_buffer_flush_offset;
+    // Shared send buffers with their insert positions in the send buffer
+    std::vector<std::pair<size_t, std::shared_ptr<const std::vector<uint8_t>>>> _send_shared_main;
+    std::vector<std::pair<size_t, std::shared_ptr<const std::vector<uint8_t>>>> _send_shared_flush;
+    size_t _send_shared_main_size;
+    size_t _send_shared_flush_size;
+    std::vector<asio::const_buffer> _send_buffers;
     HandlerStorage _send_storage;
 
     //! Connect the session
@@ -274,8 +316,16 @@ private:
 
     //! Try to receive new data
     void TryReceive();
+#if defined(__linux__)
+    //! Try to receive new data with the receive timestamp
+    void TryReceiveTimestamp();
+#endif
+    //! Complete the received data
+    void ReceiveComplete(std::error_code ec, size_t size);
     //! Try to send pending data
     void TrySend();
+    //! Prepare gather buffers of the flush buffer and shared buffers starting from the flush offset
+    void PrepareSendBuffers();
 
     //! Clear send/receive buffers
     void ClearBuffers();
@@ -24,6 +24,11 @@ namespace Asio {
 /*!
     Timer is used to plan and perform delayed operation.
 
+    Asynchronous waits could be planned in the timer wheel of the Asio
+    IO service instead of the Asio timer heap (see SetupTimerWheel()),
+    which makes arm, re-arm and cancel operations cheap when a lot of
+    timers are used for coarse timeouts.
+
     Thread-safe.
 */
 class Timer : public std::enable_shared_from_this<Timer>
@@ -80,6 +85,9 @@ public:
     //! Get the Asio service strand for serialized handler execution
     asio::io_context::strand& strand() noexcept { return _strand; }
 
+    //! Is the timer planned in the timer wheel?
+    bool IsTimerWheel() const noexcept { return _wheel != nullptr; }
+
     //! Get the timer's expiry time as an absolute time
     CppCommon::UtcTime expire_time();
     //! Get the timer's expiry time relative to now
@@ -118,6 +126,20 @@ public:
     */
     virtual bool Setup(const std::function<void(bool)>& action, const CppCommon::Timespan& timespan);
 
+    //! Setup the timer wheel mode
+    /*!
+        In the timer wheel mode asynchronous waits are planned in the timer
+        wheel of the timer Asio IO service. Arm, re-arm and cancel operations
+        take O(1) time without memory allocation, but the expiry time is
+        rounded up to the timer wheel resolution. Synchronous waits always
+        use the Asio timer.
+
+        Mode should not be changed while the timer is waiting.
+
+        \param enable - Enable/disable the timer wheel mode
+    */
+    void SetupTimerWheel(bool enable);
+
     //! Wait for the timer (asynchronous)
     /*!
         \return 'true' if the timer was successfully expired, 'false' if any error occurred
@@ -159,6 +181,11 @@ private:
     asio::system_timer _timer;
     // Action function
     std::function<void(bool)> _action;
+    // Timer wheel
+    std::shared_ptr<TimerWheel> _wheel;
+    TimerWheel::Handle _wheel_handle;
+    //! Send timer wheel cancel notification
+    void SendWheelCancel();
     //! Send error notification
     void SendError(std::error_code ec);
     //! Send timer notification
@@ -0,0 +1,196 @@
+/*!
+    \file timer_wheel.h
+    \brief Timer wheel definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_TIMER_WHEEL_H
+#define CPPSERVER_ASIO_TIMER_WHEEL_H
+
+#include "asio.h"
+
+#include "time/timespan.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace CppServer {
+namespace Asio {
+
+//! Timer wheel
+/*!
+    Timer wheel is used to plan a large number of cheap timeouts
+    (idle disconnects, keep-alive pings, handshake timeouts) on
+    a single Asio IO service without creating an Asio timer for
+    each of them.
+
+    Timeouts are represented by intrusive handles embedded into
+    their owners, so scheduling, rescheduling and canceling take
+    O(1) time without any memory allocation. The wheel is driven
+    by a single Asio timer that ticks with the wheel resolution
+    only while there are scheduled handles. Each tick processes
+    one slot of the lowest level and cascades higher levels once
+    per level rotation, so its amortized cost is O(1).
+
+    Expired handle actions are called from the wheel IO service
+    thread without holding the wheel lock, so they are allowed
+    to reschedule or cancel any handle. Expired action is moved
+    out of its handle while it is called and moved back after,
+    so the handle could be destroyed by its own action or in
+    another thread in the meantime.
+
+    Thread-safe.
+*/
+class TimerWheel : public std::enable_shared_from_this<TimerWheel>
+{
+public:
+    //! Timer wheel handle
+    /*!
+        Handle is an intrusive node of the timer wheel. Its owner
+        must keep the timer wheel alive while the handle is scheduled.
+        Handle is automatically canceled on destruction. Its wheel
+        pointer is atomic, so the handle state could be checked and
+        the handle could be destroyed while the timer wheel expires
+        it in another thread.
+
+        Not thread-safe.
+    */
+    class Handle
+    {
+        friend class TimerWheel;
+
+    public:
+        Handle() = default;
+        //! Initialize the handle with a given action function
+        /*!
+            \param action - Action function
+        */
+        explicit Handle(const std::function<void()>& action) : _action(action) {}
+        Handle(const Handle&) = delete;
+        Handle(Handle&&) = delete;
+        ~Handle() { TimerWheel* wheel = _wheel.load(); if (wheel != nullptr) wheel->Release(*this); }
+
+        Handle& operator=(const Handle&) = delete;
+        Handle& operator=(Handle&&) = delete;
+
+        //! Is the handle scheduled or its expired action is being called?
+        bool IsScheduled() const noexcept { return _wheel.load() != nullptr; }
+
+        //! Setup the handle with an action function
+        /*!
+            Action function must not be changed while the handle is scheduled.
+
+            \param action - Action function
+        */
+        void Setup(const std::function<void()>& action) { _action = action; }
+
+    private:
+        Handle* _prev{nullptr};
+        Handle* _next{nullptr};
+        Handle** _slot{nullptr};
+        uint64_t _expire{0};
+        std::atomic<TimerWheel*> _wheel{nullptr};
+        std::function<void()> _action;
+    };
+
+public:
+    //! Initialize timer wheel with a given Asio IO service
+    /*!
+        \param io_service - Asio IO service
+        \param resolution - Timer wheel resolution (default is 100 milliseconds)
+    */
+    explicit TimerWheel(const std::shared_ptr<asio::io_context>& io_service, const CppCommon::Timespan& resolution = CppCommon::Timespan::milliseconds(100));
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    ~TimerWheel();
+
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    //! Get the Asio IO service
+    std::shared_ptr<asio::io_context>& io_service() noexcept { return _io_service; }
+
+    //! Get the timer wheel resolution
+    CppCommon::Timespan resolution() const noexcept { return CppCommon::Timespan((int64_t)_resolution); }
+    //! Get the number of scheduled handles
+    size_t size() const noexcept { return _size; }
+
+    //! Schedule the handle to expire after the given timeout
+    /*!
+        Already scheduled handle is rescheduled. Timeout is rounded up
+        to the timer wheel resolution.
+
+        \param handle - Timer wheel handle
+        \param timeout - Relative timeout
+        \return 'true' if the handle was successfully scheduled, 'false' if the handle belongs to another timer wheel
+    */
+    bool Schedule(Handle& handle, const CppCommon::Timespan& timeout);
+    //! Cancel the scheduled handle
+    /*!
+        \param handle - Timer wheel handle
+        \return 'true' if the handle was successfully canceled, 'false' if the handle is not scheduled in the timer wheel
+    */
+    bool Cancel(Handle& handle);
+
+    //! Expire all handles up to the given timestamp
+    /*!
+        Method is called by the timer wheel Asio timer, but could be
+        also used to drive the timer wheel manually. It must not be
+        called concurrently.
+
+        \param timestamp - Monotonic timestamp in nanoseconds
+        \return Count of expired handles
+    */
+    size_t Expire(uint64_t timestamp);
+
+private:
+    // Timer wheel geometry
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t LEVEL_SLOTS = 1 << LEVEL_BITS;
+    static constexpr size_t LEVEL_MASK = LEVEL_SLOTS - 1;
+    static constexpr size_t LEVELS = 4;
+    static constexpr uint64_t RANGE = (uint64_t)1 << (LEVEL_BITS * LEVELS);
+
+    // Asio IO service
+    std::shared_ptr<asio::io_context> _io_service;
+    // Asio timer that drives the timer wheel
+    asio::steady_timer _timer;
+    bool _ticking;
+    // Timer wheel state
+    std::mutex _lock;
+    uint64_t _resolution;
+    uint64_t _origin;
+    uint64_t _current;
+    size_t _size;
+    std::array<std::array<Handle*, LEVEL_SLOTS>, LEVELS> _slots;
+    // Expired handles waiting for their actions to be called
+    Handle* _expired;
+    // Expired handle whose action is being called and the action moved out of it
+    Handle* _running;
+    std::function<void()> _action;
+
+    //! Convert the timestamp to the timer wheel tick
+    uint64_t ToTick(uint64_t timestamp) const noexcept { return (timestamp > _origin) ? ((timestamp - _origin) / _resolution) : 0; }
+
+    //! Link the handle into the corresponding slot
+    void Link(Handle& handle) noexcept;
+    //! Unlink the handle from its slot
+    void Unlink(Handle& handle) noexcept;
+    //! Cascade the slot of the given level into lower levels
+    void Cascade(size_t level, size_t slot);
+    //! Release the destroyed handle
+    void Release(Handle& handle);
+
+    //! Start ticking the Asio timer
+    void Tick();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_TIMER_WHEEL_H
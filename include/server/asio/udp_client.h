@@ -9,6 +9,8 @@
 #ifndef CPPSERVER_ASIO_UDP_CLIENT_H
 #define CPPSERVER_ASIO_UDP_CLIENT_H
 
+#include "datagram_queue.h"
+#include "receive_timestamp.h"
 #include "udp_resolver.h"
 
 #include "system/uuid.h"
@@ -78,7 +80,9 @@ public:
     int port() const noexcept { return _port; }
 
     //! Get the number of bytes pending sent by the client
-    uint64_t bytes_pending() const noexcept { return _bytes_sending; }
+    uint64_t bytes_pending() const noexcept { return _bytes_pending + _bytes_sending; }
+    //! Get the number of datagrams pending sent by the client
+    uint64_t datagrams_pending() const noexcept { return _datagrams_pending + _datagrams_sending; }
     //! Get the number of bytes sent by the client
     uint64_t bytes_sent() const noexcept { return _bytes_sent; }
     //! Get the number of bytes received by the client
@@ -87,6 +91,8 @@ public:
     uint64_t datagrams_sent() const noexcept { return _datagrams_sent; }
     //! Get the number datagrams received by the client
     uint64_t datagrams_received() const noexcept { return _datagrams_received; }
+    //! Get the kernel receive timestamp of the handled datagram in nanoseconds (0 if not available)
+    uint64_t receive_timestamp() const noexcept { return _receive_timestamp; }
 
     //! Get the option: reuse address
     bool option_reuse_address() const noexcept { return _option_reuse_address; }
@@ -102,9 +108,15 @@ public:
     size_t option_send_buffer_limit() const noexcept { return _send_buffer_limit; }
     //! Get the option: send buffer size
     size_t option_send_buffer_size() const;
+    //! Get the option: send queue limit
+    size_t option_send_queue_limit() const noexcept { return _send_queue_limit; }
+    //! Get the option: receive timestamps
+    bool option_receive_timestamp() const noexcept { return _option_receive_timestamp; }
 
     //! Is the client connected?
     bool IsConnected() const noexcept { return _connected; }
+    //! Are the receive timestamps enabled for the connected client?
+    bool IsReceiveTimestamp() const noexcept { return _timestamp; }
 
     //! Connect the client (synchronous)
     /*!
@@ -249,6 +261,11 @@ public:
     virtual bool SendAsync(std::string_view text) { return SendAsync(text.data(), text.size()); }
     //! Send datagram to the given endpoint (asynchronous)
     /*!
+        Datagram is copied into the send queue and sent after all
+        previously queued datagrams. Queued datagrams are sent in
+        batches and onSent() is called for each of them from the client
+        IO service. Thread-safe.
+
         \param endpoint - Endpoint to send
         \param buffer - Datagram buffer to send
         \param size - Datagram buffer size
@@ -336,7 +353,8 @@ public:
     void SetupReceiveBufferSize(size_t size);
     //! Setup option: send buffer limit
     /*!
-        The client will be disconnected if the send buffer limit is met.
+        The send operation will fail if the total size of queued
+        datagrams meets the send buffer limit.
         Default is unlimited.
 
         \param limit - Send buffer limit
@@ -349,6 +367,29 @@ public:
         \param size - Send buffer size
     */
     void SetupSendBufferSize(size_t size);
+    //! Setup option: send queue limit
+    /*!
+        The send operation will fail if the count of queued datagrams
+        meets the send queue limit.
+        Default is unlimited.
+
+        \param limit - Send queue limit
+    */
+    void SetupSendQueueLimit(size_t limit) noexcept { _send_queue_limit = limit; }
+    //! Setup option: receive timestamps
+    /*!
+        This option will enable SO_TIMESTAMPING receive timestamps if the OS
+        support this feature (see ReceiveTimestamp). The kernel timestamp of
+        the received datagram is available with receive_timestamp() during
+        onReceived(). IsReceiveTimestamp() reports if the feature is available
+        once the client is connected.
+
+        The option should be setup before the client is connected.
+        Default is disabled.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReceiveTimestamp(bool enable) noexcept { _option_receive_timestamp = enable; }
 
 protected:
     //! Handle client connected notification
@@ -417,28 +458,43 @@ private:
     std::atomic<bool> _resolving;
     std::atomic<bool> _connected;
     // Client statistic
-    uint64_t _bytes_sending;
+    uint64_t _bytes_pending;
+    uint64_t _datagrams_pending;
+    std::atomic<uint64_t> _bytes_sending;
+    std::atomic<uint64_t> _datagrams_sending;
     uint64_t _bytes_sent;
     uint64_t _bytes_received;
     uint64_t _datagrams_sent;
     uint64_t _datagrams_received;
-    // Receive and send endpoints
+    // Receive endpoint
     asio::ip::udp::endpoint _receive_endpoint;
-    asio::ip::udp::endpoint _send_endpoint;
     // Receive buffer
     bool _receiving;
     size_t _receive_buffer_limit{0};
     std::vector<uint8_t> _receive_buffer;
     HandlerStorage _receive_storage;
-    // Send buffer
+    // Receive timestamps
+    bool _timestamp{false};
+    uint64_t _receive_timestamp{0};
+    // Send queues (main queue is filled by senders, flush queue is sent by the IO service)
     bool _sending;
     size_t _send_buffer_limit{0};
-    std::vector<uint8_t> _send_buffer;
+    size_t _send_queue_limit{0};
+    std::mutex _send_lock;
+    DatagramQueue _send_queue_main;
+    DatagramQueue _send_queue;
     HandlerStorage _send_storage;
+#if defined(__linux__)
+    // Send batch
+    static constexpr size_t BATCH_MAX = 1024;
+    std::vector<mmsghdr> _send_batch_messages;
+    std::vector<iovec> _send_batch_iovecs;
+#endif
     // Options
     bool _option_reuse_address;
     bool _option_reuse_port;
     bool _option_multicast;
+    bool _option_receive_timestamp{false};
 
     //! Disconnect the client (internal synchronous)
     bool DisconnectInternal();
@@ -447,6 +503,18 @@ private:
 
     //! Try to receive new datagram
     void TryReceive();
+#if defined(__linux__)
+    //! Try to receive new datagram with the receive timestamp
+    void TryReceiveTimestamp();
+#endif
+    //! Complete the received datagram
+    void ReceiveComplete(std::error_code ec, size_t size);
+    //! Swap the main send queue into the empty flush send queue
+    bool SwapSendQueues();
+    //! Try to send queued datagrams
+    void TrySend();
+    //! Complete the front queued datagram
+    bool SendComplete(std::error_code ec, size_t sent);
 
     //! Clear send/receive buffers
     void ClearBuffers();
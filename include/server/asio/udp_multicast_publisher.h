@@ -0,0 +1,210 @@
+/*!
+    \file udp_multicast_publisher.h
+    \brief UDP multicast publisher definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_UDP_MULTICAST_PUBLISHER_H
+#define CPPSERVER_ASIO_UDP_MULTICAST_PUBLISHER_H
+
+#include "udp_server.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! UDP multicast publisher
+/*!
+    UDP multicast publisher frames each published message with the publisher
+    session and the sequence number and multicasts it to the prepared
+    multicast endpoint. Published packets are kept in the bounded history
+    ring to serve retransmit requests of subscribers which detected sequence
+    gaps. Requests of packets which already left the history are answered
+    with the unavailable packet, so subscribers could skip them as lost.
+    Each request is clamped to the subscriber reorder window and packets
+    retransmitted to one endpoint are limited per second.
+
+    Heartbeat packets with the next sequence number are multicasted when
+    there is nothing to publish, so subscribers detect the loss of the last
+    published packets as well.
+
+    Server handlers onStarted(), onStopped() and onReceived() are used by
+    the multicast protocol, so overrides should call the base implementation.
+
+    Thread-safe.
+*/
+class UDPMulticastPublisher : public UDPServer
+{
+public:
+    //! Packet type
+    enum class PacketType : uint8_t
+    {
+        Data        = 1,    //!< Message data
+        Heartbeat   = 2,    //!< Next sequence number heartbeat
+        Request     = 3,    //!< Retransmit request
+        Unavailable = 4     //!< Requested packets are not available
+    };
+
+    //! Packet header size
+    static constexpr size_t HEADER_SIZE = 16;
+    //! Retransmit request and unavailable packet size
+    static constexpr size_t REQUEST_SIZE = 20;
+    //! Maximal message size
+    static constexpr size_t MAX_MESSAGE_SIZE = 65507 - HEADER_SIZE;
+    //! Maximal count of packets served by one retransmit request (subscriber reorder window)
+    static constexpr size_t MAX_RETRANSMIT_COUNT = 4096;
+
+    //! Initialize UDP multicast publisher with a given Asio service and port number
+    /*!
+        \param service - Asio service
+        \param port - Port number
+        \param protocol - Internet protocol type (default is IPv4)
+    */
+    UDPMulticastPublisher(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol = InternetProtocol::IPv4);
+    //! Initialize UDP multicast publisher with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Port number
+    */
+    UDPMulticastPublisher(const std::shared_ptr<Service>& service, const std::string& address, int port);
+    //! Initialize UDP multicast publisher with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+    */
+    UDPMulticastPublisher(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint);
+    UDPMulticastPublisher(const UDPMulticastPublisher&) = delete;
+    UDPMulticastPublisher(UDPMulticastPublisher&&) = delete;
+    virtual ~UDPMulticastPublisher() = default;
+
+    UDPMulticastPublisher& operator=(const UDPMulticastPublisher&) = delete;
+    UDPMulticastPublisher& operator=(UDPMulticastPublisher&&) = delete;
+
+    //! Get the publisher session
+    uint32_t session() const noexcept { return _session; }
+    //! Get the next sequence number to publish
+    uint64_t sequence() const noexcept { return _sequence; }
+
+    //! Get the number of published messages
+    uint64_t messages_published() const noexcept { return _messages_published; }
+    //! Get the number of received retransmit requests
+    uint64_t retransmit_requests() const noexcept { return _retransmit_requests; }
+    //! Get the number of retransmitted packets
+    uint64_t packets_retransmitted() const noexcept { return _packets_retransmitted; }
+    //! Get the number of requested packets which left the history
+    uint64_t packets_unavailable() const noexcept { return _packets_unavailable; }
+    //! Get the number of requested packets dropped by the retransmit rate limit
+    uint64_t packets_limited() const noexcept { return _packets_limited; }
+
+    //! Get the option: history size in packets
+    size_t option_history_size() const noexcept { return _option_history_size; }
+    //! Get the option: heartbeat interval
+    const CppCommon::Timespan& option_heartbeat_interval() const noexcept { return _option_heartbeat_interval; }
+    //! Get the option: multicast retransmit
+    bool option_multicast_retransmit() const noexcept { return _option_multicast_retransmit; }
+    //! Get the option: retransmit rate limit
+    size_t option_retransmit_rate_limit() const noexcept { return _option_retransmit_rate_limit; }
+
+    //! Publish the message to the prepared multicast endpoint (synchronous)
+    /*!
+        The message is kept in the history even if its multicast fails,
+        so subscribers could recover it with retransmit requests.
+
+        \param buffer - Message buffer to publish
+        \param size - Message buffer size
+        \return 'true' if the message was successfully published, 'false' if the publisher is not started or the message is too large
+    */
+    virtual bool Publish(const void* buffer, size_t size);
+    //! Publish the text to the prepared multicast endpoint (synchronous)
+    /*!
+        \param text - Text to publish
+        \return 'true' if the text was successfully published, 'false' if the publisher is not started or the text is too large
+    */
+    virtual bool Publish(std::string_view text) { return Publish(text.data(), text.size()); }
+
+    //! Setup option: history size
+    /*!
+        History size should be setup before the publisher is started.
+
+        \param packets - Count of the last published packets kept for retransmit requests (default is 65536)
+    */
+    void SetupHistorySize(size_t packets) noexcept { _option_history_size = packets; }
+    //! Setup option: heartbeat interval
+    /*!
+        \param interval - Heartbeat interval when there is nothing to publish (default is 100 milliseconds)
+    */
+    void SetupHeartbeatInterval(const CppCommon::Timespan& interval) noexcept { _option_heartbeat_interval = interval; }
+    //! Setup option: multicast retransmit
+    /*!
+        Retransmitted packets are sent to the requesting subscriber endpoint
+        by default. Subscribers which share the multicast port on the same host
+        might not receive unicast datagrams sent to that port, so retransmitted
+        packets should be multicasted to all subscribers in this case.
+
+        \param enable - Enable/disable multicast retransmit
+    */
+    void SetupMulticastRetransmit(bool enable) noexcept { _option_multicast_retransmit = enable; }
+    //! Setup option: retransmit rate limit
+    /*!
+        Packets requested over the limit are not retransmitted, so spoofed
+        or misbehaving subscribers could not flood the network. Subscribers
+        request them again on the next tick.
+
+        \param packets - Count of packets retransmitted to one endpoint per second (0 for unlimited, default is 16384)
+    */
+    void SetupRetransmitRateLimit(size_t packets) noexcept { _option_retransmit_rate_limit = packets; }
+
+protected:
+    void onStarted() override;
+    void onStopped() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Publisher session & sequence
+    std::mutex _publish_lock;
+    std::atomic<uint32_t> _session;
+    std::atomic<uint64_t> _sequence;
+    bool _published;
+    // History ring of pooled packet buffers
+    std::vector<std::vector<uint8_t>> _history;
+    // Retransmit budgets of requesting endpoints & packets copied from the history
+    struct RetransmitBudget
+    {
+        uint64_t timestamp{0};
+        uint64_t packets{0};
+    };
+    std::map<asio::ip::udp::endpoint, RetransmitBudget> _retransmit_budgets;
+    std::vector<std::vector<uint8_t>> _retransmit_packets;
+    // Publisher heartbeat timer
+    asio::steady_timer _timer;
+    // Publisher statistic
+    std::atomic<uint64_t> _messages_published;
+    std::atomic<uint64_t> _retransmit_requests;
+    std::atomic<uint64_t> _packets_retransmitted;
+    std::atomic<uint64_t> _packets_unavailable;
+    std::atomic<uint64_t> _packets_limited;
+    // Options
+    size_t _option_history_size;
+    CppCommon::Timespan _option_heartbeat_interval;
+    bool _option_multicast_retransmit;
+    size_t _option_retransmit_rate_limit;
+
+    //! Serve the retransmit request
+    void Retransmit(const asio::ip::udp::endpoint& endpoint, uint64_t first, uint32_t count);
+
+    //! Wait for the next heartbeat
+    void TryHeartbeat();
+    //! Multicast the heartbeat if nothing was published since the last one and release expired retransmit budgets
+    void Heartbeat();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_UDP_MULTICAST_PUBLISHER_H
@@ -0,0 +1,200 @@
+/*!
+    \file udp_multicast_subscriber.h
+    \brief UDP multicast subscriber definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_UDP_MULTICAST_SUBSCRIBER_H
+#define CPPSERVER_ASIO_UDP_MULTICAST_SUBSCRIBER_H
+
+#include "udp_client.h"
+#include "udp_multicast_publisher.h"
+
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! UDP multicast subscriber
+/*!
+    UDP multicast subscriber receives messages published by the UDP multicast
+    publisher and delivers them in the sequence order. Subscriber is synchronized
+    with the first packet of the publisher session it receives.
+
+    Sequence gaps are detected by data and heartbeat packets. Missing packets
+    are requested from the publisher with unicast retransmit requests, while
+    following packets wait in the reorder window. Missing packets are skipped
+    as lost if the publisher answers that they are not available anymore, if
+    retransmit requests are not answered or if the reorder window is overflowed.
+
+    Client handlers onConnected(), onDisconnected() and onReceived() are used
+    by the multicast protocol, so overrides should call the base implementation.
+    Subscriber should join the multicast group as usual UDP multicast client.
+
+    Not thread-safe.
+*/
+class UDPMulticastSubscriber : public UDPClient
+{
+public:
+    //! Reorder window size in packets
+    static constexpr size_t REORDER_WINDOW = 4096;
+
+    //! Initialize UDP multicast subscriber with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Server port number
+    */
+    UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, int port);
+    //! Initialize UDP multicast subscriber with a given Asio service, server address and scheme name
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param scheme - Scheme name
+    */
+    UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, const std::string& scheme);
+    //! Initialize UDP multicast subscriber with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+    */
+    UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint);
+    UDPMulticastSubscriber(const UDPMulticastSubscriber&) = delete;
+    UDPMulticastSubscriber(UDPMulticastSubscriber&&) = delete;
+    virtual ~UDPMulticastSubscriber() = default;
+
+    UDPMulticastSubscriber& operator=(const UDPMulticastSubscriber&) = delete;
+    UDPMulticastSubscriber& operator=(UDPMulticastSubscriber&&) = delete;
+
+    //! Get the publisher session
+    uint32_t session() const noexcept { return _session; }
+    //! Get the next expected sequence number
+    uint64_t sequence() const noexcept { return _expected; }
+
+    //! Get the number of delivered messages
+    uint64_t messages_received() const noexcept { return _messages_received; }
+    //! Get the number of recovered messages
+    uint64_t messages_recovered() const noexcept { return _messages_recovered; }
+    //! Get the number of lost messages
+    uint64_t messages_lost() const noexcept { return _messages_lost; }
+    //! Get the number of detected sequence gaps
+    uint64_t gaps_detected() const noexcept { return _gaps_detected; }
+    //! Get the number of sent retransmit requests
+    uint64_t retransmit_requests() const noexcept { return _retransmit_requests; }
+    //! Get the number of duplicate packets received
+    uint64_t packets_duplicated() const noexcept { return _packets_duplicated; }
+
+    //! Get the option: tick interval
+    const CppCommon::Timespan& option_tick_interval() const noexcept { return _option_tick_interval; }
+    //! Get the option: retransmit request timeout
+    const CppCommon::Timespan& option_request_timeout() const noexcept { return _option_request_timeout; }
+    //! Get the option: retransmit request retries
+    size_t option_request_retries() const noexcept { return _option_request_retries; }
+
+    //! Setup option: tick interval
+    /*!
+        \param interval - Retransmit requests tick interval (default is 10 milliseconds)
+    */
+    void SetupTickInterval(const CppCommon::Timespan& interval) noexcept { _option_tick_interval = interval; }
+    //! Setup option: retransmit request timeout
+    /*!
+        \param timeout - Timeout to repeat unanswered retransmit requests (default is 50 milliseconds)
+    */
+    void SetupRequestTimeout(const CppCommon::Timespan& timeout) noexcept { _option_request_timeout = timeout; }
+    //! Setup option: retransmit request retries
+    /*!
+        \param retries - Count of unanswered retransmit requests before missing packets are skipped as lost (default is 5)
+    */
+    void SetupRequestRetries(size_t retries) noexcept { _option_request_retries = retries; }
+
+protected:
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from the publisher.
+        Messages are received in the sequence order.
+
+        \param sequence - Message sequence number
+        \param buffer - Received message buffer
+        \param size - Received message size
+    */
+    virtual void onReceivedMessage(uint64_t sequence, const void* buffer, size_t size) {}
+    //! Handle messages lost notification
+    /*!
+        Notification is called when missing messages were skipped without recovery.
+
+        \param sequence - First lost message sequence number
+        \param count - Count of lost messages
+    */
+    virtual void onLost(uint64_t sequence, size_t count) {}
+
+protected:
+    void onConnected() override;
+    void onDisconnected() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Reorder window slot
+    struct Slot
+    {
+        std::vector<uint8_t> buffer;
+        bool received{false};
+    };
+
+    // Publisher endpoint & session
+    asio::ip::udp::endpoint _publisher;
+    uint32_t _session;
+    bool _synchronized;
+    // Reorder window of pooled packet buffers
+    std::vector<Slot> _window;
+    uint64_t _expected;
+    uint64_t _end;
+    // Retransmit requests
+    uint64_t _request_sequence;
+    uint64_t _request_timestamp;
+    size_t _request_retries;
+    // Subscriber tick timer
+    asio::steady_timer _timer;
+    bool _ticking;
+    // Subscriber statistic
+    uint64_t _messages_received;
+    uint64_t _messages_recovered;
+    uint64_t _messages_lost;
+    uint64_t _gaps_detected;
+    uint64_t _retransmit_requests;
+    uint64_t _packets_duplicated;
+    // Options
+    CppCommon::Timespan _option_tick_interval;
+    CppCommon::Timespan _option_request_timeout;
+    size_t _option_request_retries;
+
+    Slot& slot(uint64_t sequence) noexcept { return _window[sequence & (REORDER_WINDOW - 1)]; }
+
+    //! Synchronize with the publisher session
+    void Synchronize(uint32_t session, uint64_t sequence);
+
+    //! Receive the data packet
+    void ReceiveData(uint64_t sequence, const uint8_t* buffer, size_t size);
+    //! Detect the sequence gap up to the given sequence number
+    void Detect(uint64_t end);
+    //! Deliver received messages in the sequence order
+    void Deliver();
+    //! Skip missing messages as lost up to the given sequence number
+    void Skip(uint64_t end);
+
+    //! Send retransmit requests for all missing packets
+    void Request(uint64_t timestamp);
+    //! Send the retransmit request
+    void Request(uint64_t first, uint64_t count);
+
+    //! Try to start ticking retransmit requests
+    void TryTick();
+    //! Tick retransmit requests
+    void Tick();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_UDP_MULTICAST_SUBSCRIBER_H
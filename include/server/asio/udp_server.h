@@ -9,10 +9,15 @@
 #ifndef CPPSERVER_ASIO_UDP_SERVER_H
 #define CPPSERVER_ASIO_UDP_SERVER_H
 
+#include "datagram_buffer_pool.h"
+#include "datagram_queue.h"
+#include "receive_timestamp.h"
 #include "service.h"
 
 #include "system/uuid.h"
 
+#include <mutex>
+
 namespace CppServer {
 namespace Asio {
 
@@ -24,6 +29,22 @@ namespace Asio {
 */
 class UDPServer : public std::enable_shared_from_this<UDPServer>
 {
+public:
+    //! Received datagram
+    struct ReceivedDatagram
+    {
+        //! Received endpoint
+        asio::ip::udp::endpoint endpoint;
+        //! Received datagram buffer
+        const void* buffer{nullptr};
+        //! Received datagram buffer size
+        size_t size{0};
+        //! Received datagram pooled buffer (empty if the receive pool is not setup)
+        DatagramBuffer handle;
+        //! Received datagram kernel timestamp in nanoseconds (0 if receive timestamps are not setup)
+        uint64_t timestamp{0};
+    };
+
 public:
     //! Initialize UDP server with a given Asio service and port number
     /*!
@@ -72,7 +93,9 @@ public:
     int port() const noexcept { return _port; }
 
     //! Get the number of bytes pending sent by the server
-    uint64_t bytes_pending() const noexcept { return _bytes_sending; }
+    uint64_t bytes_pending() const noexcept { return _bytes_pending + _bytes_sending; }
+    //! Get the number of datagrams pending sent by the server
+    uint64_t datagrams_pending() const noexcept { return _datagrams_pending + _datagrams_sending; }
     //! Get the number of bytes sent by the server
     uint64_t bytes_sent() const noexcept { return _bytes_sent; }
     //! Get the number of bytes received by the server
@@ -81,6 +104,8 @@ public:
     uint64_t datagrams_sent() const noexcept { return _datagrams_sent; }
     //! Get the number datagrams received by the server
     uint64_t datagrams_received() const noexcept { return _datagrams_received; }
+    //! Get the kernel receive timestamp of the handled datagram in nanoseconds (0 if not available)
+    uint64_t receive_timestamp() const noexcept { return _receive_timestamp; }
 
     //! Get the option: reuse address
     bool option_reuse_address() const noexcept { return _option_reuse_address; }
@@ -94,9 +119,27 @@ public:
     size_t option_send_buffer_limit() const noexcept { return _send_buffer_limit; }
     //! Get the option: send buffer size
     size_t option_send_buffer_size() const;
+    //! Get the option: send queue limit
+    size_t option_send_queue_limit() const noexcept { return _send_queue_limit; }
+    //! Get the option: receive batch
+    size_t option_receive_batch() const noexcept { return _option_receive_batch; }
+    //! Get the option: UDP generic segmentation offload
+    bool option_gso() const noexcept { return _option_gso; }
+    //! Get the option: UDP generic receive offload
+    bool option_gro() const noexcept { return _option_gro; }
+    //! Get the option: receive pool
+    const std::shared_ptr<DatagramBufferPool>& option_receive_pool() const noexcept { return _option_receive_pool; }
+    //! Get the option: receive timestamps
+    bool option_receive_timestamp() const noexcept { return _option_receive_timestamp; }
 
     //! Is the server started?
     bool IsStarted() const noexcept { return _started; }
+    //! Is the UDP generic segmentation offload enabled for the started server?
+    bool IsGSO() const noexcept { return _gso; }
+    //! Is the UDP generic receive offload enabled for the started server?
+    bool IsGRO() const noexcept { return _gro; }
+    //! Are the receive timestamps enabled for the started server?
+    bool IsReceiveTimestamp() const noexcept { return _timestamp; }
 
     //! Start the server
     /*!
@@ -209,6 +252,14 @@ public:
 
     //! Send datagram into the given endpoint (asynchronous)
     /*!
+        Datagram is copied into the send queue and sent after all
+        previously queued datagrams. If GSO is enabled or a receive batch
+        is handled, the send queue is flushed after the current handler,
+        so datagrams queued together are sent in batches. Otherwise it
+        is sent immediately when called from the server IO service.
+        onSent() is called for each of them from the server IO service.
+        Thread-safe.
+
         \param endpoint - Endpoint to send
         \param buffer - Datagram buffer to send
         \param size - Datagram buffer size
@@ -291,7 +342,8 @@ public:
     void SetupReceiveBufferSize(size_t size);
     //! Setup option: send buffer limit
     /*!
-        The send operation will fail if the send buffer limit is met.
+        The send operation will fail if the total size of queued
+        datagrams meets the send buffer limit.
         Default is unlimited.
 
         \param limit - Send buffer limit
@@ -304,6 +356,93 @@ public:
         \param size - Send buffer size
     */
     void SetupSendBufferSize(size_t size);
+    //! Setup option: send queue limit
+    /*!
+        The send operation will fail if the count of queued datagrams
+        meets the send queue limit.
+        Default is unlimited.
+
+        \param limit - Send queue limit
+    */
+    void SetupSendQueueLimit(size_t limit) noexcept { _send_queue_limit = limit; }
+    //! Setup option: receive batch
+    /*!
+        This option will enable batched receive of up to the given count
+        of datagrams per socket wakeup with recvmmsg() if the OS support
+        this feature. Datagrams are received into a preallocated slab and
+        delivered with onReceivedBatch(). Datagrams queued while handling
+        the batch are sent together with sendmmsg().
+
+        Each slab slot is sized by the receive buffer limit (64 KiB if it is
+        unlimited or GRO is enabled) and the whole slab is capped to 4 MiB,
+        so the batch count is reduced for large slots.
+
+        The option should be setup before the server is started.
+        Default is disabled.
+
+        \param batch - Receive batch count
+    */
+    void SetupReceiveBatch(size_t batch) noexcept { _option_receive_batch = batch; }
+    //! Setup option: UDP generic segmentation offload
+    /*!
+        This option will enable UDP_SEGMENT if the OS support this feature.
+        Runs of equal-sized datagrams queued to the same endpoint (e.g.
+        with MulticastAsync()) are sent as a single super-buffer which
+        is split into datagrams by the kernel or NIC. IsGSO() reports
+        if the feature is available once the server is started.
+
+        The option should be setup before the server is started.
+
+        \param enable - Enable/disable option
+    */
+    void SetupGSO(bool enable) noexcept { _option_gso = enable; }
+    //! Setup option: UDP generic receive offload
+    /*!
+        This option will enable UDP_GRO if the OS support this feature.
+        Coalesced datagrams are received in the batched receive mode
+        and split back into datagrams before onReceivedBatch(). IsGRO()
+        reports if the feature is available once the server is started.
+
+        The option should be setup before the server is started.
+
+        \param enable - Enable/disable option
+    */
+    void SetupGRO(bool enable) noexcept { _option_gro = enable; }
+    //! Setup option: receive pool
+    /*!
+        This option will receive datagrams directly into buffers acquired
+        from the given datagram buffer pool and deliver them with
+        onReceivedBuffer(). The handler could keep a copy of the buffer
+        handle (e.g. to process the datagram in another thread) without
+        copying the datagram, the buffer returns to the pool when the last
+        handle is released. Unshared buffers are reused for the following
+        receives.
+
+        Pooled buffers have a fixed capacity, so datagrams which do not
+        fit into it are truncated in the single receive mode and dropped
+        in the batched receive mode.
+
+        The option should be setup before the server is started.
+        Default is disabled.
+
+        \param pool - Datagram buffer pool
+    */
+    void SetupReceivePool(const std::shared_ptr<DatagramBufferPool>& pool) noexcept { _option_receive_pool = pool; }
+    //! Setup option: receive timestamps
+    /*!
+        This option will enable SO_TIMESTAMPING receive timestamps if the OS
+        support this feature (see ReceiveTimestamp). Datagrams are received
+        in the batched receive mode with their kernel timestamps, which are
+        available with receive_timestamp() during onReceived() and with
+        ReceivedDatagram::timestamp in onReceivedBatch(). IsReceiveTimestamp()
+        reports if the feature is available once the server is started.
+
+        The option should be setup before the server is started.
+        Default is disabled.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReceiveTimestamp(bool enable) noexcept { _option_receive_timestamp = enable; }
 
 protected:
     //! Handle server started notification
@@ -321,6 +460,33 @@ protected:
         \param size - Received datagram buffer size
     */
     virtual void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) {}
+    //! Handle pooled datagram received notification
+    /*!
+        Notification is called when another datagram was received into
+        the pooled buffer (see SetupReceivePool()). Default implementation
+        calls onReceived().
+
+        The handler could keep a copy of the buffer handle to process the
+        datagram later or in another thread.
+
+        \param endpoint - Received endpoint
+        \param buffer - Received datagram pooled buffer
+    */
+    virtual void onReceivedBuffer(const asio::ip::udp::endpoint& endpoint, const DatagramBuffer& buffer) { onReceived(endpoint, buffer.data(), buffer.size()); }
+    //! Handle datagrams batch received notification
+    /*!
+        Notification is called when a batch of datagrams was received
+        in the batched receive mode. Default implementation calls
+        onReceived() (or onReceivedBuffer() with the receive pool) for
+        each datagram of the batch.
+
+        Datagram buffers are valid only during the notification unless
+        their pooled buffer handles are kept.
+
+        \param datagrams - Received datagrams
+        \param count - Received datagrams count
+    */
+    virtual void onReceivedBatch(const ReceivedDatagram* datagrams, size_t count);
     //! Handle datagram sent notification
     /*!
         Notification is called when a datagram was sent to the client.
@@ -359,31 +525,90 @@ private:
     asio::ip::udp::socket _socket;
     std::atomic<bool> _started;
     // Server statistic
-    uint64_t _bytes_sending;
+    uint64_t _bytes_pending;
+    uint64_t _datagrams_pending;
+    std::atomic<uint64_t> _bytes_sending;
+    std::atomic<uint64_t> _datagrams_sending;
     uint64_t _bytes_sent;
     uint64_t _bytes_received;
     uint64_t _datagrams_sent;
     uint64_t _datagrams_received;
-    // Multicast, receive and send endpoints
+    uint64_t _receive_timestamp{0};
+    // Multicast and receive endpoints
     asio::ip::udp::endpoint _multicast_endpoint;
     asio::ip::udp::endpoint _receive_endpoint;
-    asio::ip::udp::endpoint _send_endpoint;
     // Receive buffer
     bool _receiving;
     size_t _receive_buffer_limit{0};
     std::vector<uint8_t> _receive_buffer;
+    DatagramBuffer _receive_pooled;
     HandlerStorage _receive_storage;
-    // Send buffer
+    // Send queues (main queue is filled by senders, flush queue is sent by the IO service)
     bool _sending;
     size_t _send_buffer_limit{0};
-    std::vector<uint8_t> _send_buffer;
+    size_t _send_queue_limit{0};
+    std::mutex _send_lock;
+    DatagramQueue _send_queue_main;
+    DatagramQueue _send_queue;
     HandlerStorage _send_storage;
+    // Segmentation offloads (GSO could be disabled by the IO thread while SendAsync() checks it)
+    std::atomic<bool> _gso{false};
+    bool _gro{false};
+    // Receive timestamps
+    bool _timestamp{false};
+    // Receive batch handling flag
+    std::atomic<bool> _receiving_batch{false};
+#if defined(__linux__)
+    // Receive batch slab & send batch
+    static constexpr size_t BATCH_DATAGRAM_SIZE = 65536;
+    static constexpr size_t BATCH_BUFFER_MAX = 4 * 1024 * 1024;
+    static constexpr size_t BATCH_CONTROL_SIZE = ReceiveTimestamp::CONTROL_SIZE;
+    static constexpr size_t BATCH_MAX = 1024;
+    static constexpr size_t GSO_SEGMENTS_MAX = 64;
+    static constexpr size_t GSO_SIZE_MAX = 65507;
+    std::vector<uint8_t> _receive_batch_buffer;
+    size_t _receive_batch_slot{0};
+    std::vector<DatagramBuffer> _receive_batch_pooled;
+    std::vector<uint8_t> _receive_batch_control;
+    std::vector<asio::ip::udp::endpoint> _receive_batch_endpoints;
+    std::vector<mmsghdr> _receive_batch_messages;
+    std::vector<iovec> _receive_batch_iovecs;
+    std::vector<ReceivedDatagram> _receive_batch;
+    std::vector<mmsghdr> _send_batch_messages;
+    std::vector<iovec> _send_batch_iovecs;
+    std::vector<uint8_t> _send_batch_control;
+    std::vector<size_t> _send_batch_counts;
+#endif
     // Options
     bool _option_reuse_address;
     bool _option_reuse_port;
+    size_t _option_receive_batch{0};
+    bool _option_gso{false};
+    bool _option_gro{false};
+    std::shared_ptr<DatagramBufferPool> _option_receive_pool;
+    bool _option_receive_timestamp{false};
 
     //! Try to receive new datagram
     void TryReceive();
+    //! Try to receive new datagram into the pooled buffer
+    void TryReceivePooled();
+#if defined(__linux__)
+    //! Try to receive new batch of datagrams
+    void TryReceiveBatch();
+    //! Receive batch of datagrams from the readable socket
+    void ReceiveBatch();
+#endif
+    //! Try to flush the send queue
+    /*!
+        \param defer - Defer the flush after the current handler (to accumulate datagrams) or send immediately if called from the IO service
+    */
+    void TryFlush(bool defer);
+    //! Swap the main send queue into the empty flush send queue
+    bool SwapSendQueues();
+    //! Try to send queued datagrams
+    void TrySend();
+    //! Complete the front queued datagram
+    void SendComplete(std::error_code ec, size_t sent);
 
     //! Clear send/receive buffers
     void ClearBuffers();
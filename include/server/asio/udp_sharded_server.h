@@ -0,0 +1,169 @@
+/*!
+    \file udp_sharded_server.h
+    \brief UDP sharded server definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_UDP_SHARDED_SERVER_H
+#define CPPSERVER_ASIO_UDP_SHARDED_SERVER_H
+
+#include "udp_server.h"
+
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! UDP sharded server
+/*!
+    UDP sharded server serves one UDP port with several UDP server
+    shards. Each shard owns its own SO_REUSEPORT socket bound to the
+    same endpoint and is created on the next Asio IO service of the
+    Asio service, so by default every working thread of the service
+    gets its own shard. Incoming datagrams are distributed across the
+    shards by the kernel default hashing of the 4-tuple, so datagrams
+    of the same client are always received by the same shard.
+
+    Datagrams are handled and replied by the shard UDP servers created
+    with CreateShard(). Statistic of the sharded server is a sum of
+    all shards statistic.
+
+    On platforms without SO_REUSEPORT support the server has only one
+    shard.
+
+    Not thread-safe.
+*/
+class UDPShardedServer : public std::enable_shared_from_this<UDPShardedServer>
+{
+public:
+    //! Initialize UDP sharded server with a given Asio service and port number
+    /*!
+        \param service - Asio service
+        \param port - Port number
+        \param protocol - Internet protocol type (default is IPv4)
+        \param shards - Shards count (default is 0 to create shard per each working thread of the Asio service)
+    */
+    UDPShardedServer(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol = InternetProtocol::IPv4, size_t shards = 0);
+    //! Initialize UDP sharded server with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Port number
+        \param shards - Shards count (default is 0 to create shard per each working thread of the Asio service)
+    */
+    UDPShardedServer(const std::shared_ptr<Service>& service, const std::string& address, int port, size_t shards = 0);
+    //! Initialize UDP sharded server with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+        \param shards - Shards count (default is 0 to create shard per each working thread of the Asio service)
+    */
+    UDPShardedServer(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint, size_t shards = 0);
+    UDPShardedServer(const UDPShardedServer&) = delete;
+    UDPShardedServer(UDPShardedServer&&) = delete;
+    virtual ~UDPShardedServer() = default;
+
+    UDPShardedServer& operator=(const UDPShardedServer&) = delete;
+    UDPShardedServer& operator=(UDPShardedServer&&) = delete;
+
+    //! Get the server Id
+    const CppCommon::UUID& id() const noexcept { return _id; }
+
+    //! Get the Asio service
+    std::shared_ptr<Service>& service() noexcept { return _service; }
+    //! Get the server endpoint
+    asio::ip::udp::endpoint& endpoint() noexcept { return _endpoint; }
+    //! Get the server shards
+    const std::vector<std::shared_ptr<UDPServer>>& shards() const noexcept { return _shards; }
+
+    //! Get the server address
+    const std::string& address() const noexcept { return _address; }
+    //! Get the server port number
+    int port() const noexcept { return _port; }
+
+    //! Get the shards count
+    size_t shards_count() const noexcept { return _shards_count; }
+
+    //! Get the number of bytes pending sent by the server
+    uint64_t bytes_pending() const noexcept;
+    //! Get the number of datagrams pending sent by the server
+    uint64_t datagrams_pending() const noexcept;
+    //! Get the number of bytes sent by the server
+    uint64_t bytes_sent() const noexcept;
+    //! Get the number of bytes received by the server
+    uint64_t bytes_received() const noexcept;
+    //! Get the number datagrams sent by the server
+    uint64_t datagrams_sent() const noexcept;
+    //! Get the number datagrams received by the server
+    uint64_t datagrams_received() const noexcept;
+
+    //! Get the option: reuse address
+    bool option_reuse_address() const noexcept { return _option_reuse_address; }
+
+    //! Is the server started?
+    bool IsStarted() const noexcept { return _started; }
+
+    //! Start the server
+    /*!
+        Shards are created with CreateShard() on the first start and
+        started with SO_REUSEPORT option. If some shard fails to start
+        then all previously started shards are stopped.
+
+        \return 'true' if the server was successfully started, 'false' if the server failed to start
+    */
+    virtual bool Start();
+    //! Stop the server
+    /*!
+        \return 'true' if the server was successfully stopped, 'false' if the server is already stopped
+    */
+    virtual bool Stop();
+    //! Restart the server
+    /*!
+        \return 'true' if the server was successfully restarted, 'false' if the server failed to restart
+    */
+    virtual bool Restart();
+
+    //! Setup option: reuse address
+    /*!
+        This option will enable/disable SO_REUSEADDR if the OS support this feature.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReuseAddress(bool enable) noexcept { _option_reuse_address = enable; }
+
+protected:
+    //! Create UDP server shard factory method
+    /*!
+        Shard should be created with the given Asio service and endpoint
+        to be bound to the next Asio IO service of the Asio service. This
+        is the right place to setup shard options (e.g. receive batch).
+
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+        \return UDP server shard
+    */
+    virtual std::shared_ptr<UDPServer> CreateShard(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint) { return std::make_shared<UDPServer>(service, endpoint); }
+
+private:
+    // Server Id
+    CppCommon::UUID _id;
+    // Asio service
+    std::shared_ptr<Service> _service;
+    // Server endpoint
+    std::string _address;
+    int _port;
+    asio::ip::udp::endpoint _endpoint;
+    // Server shards
+    size_t _shards_count;
+    std::vector<std::shared_ptr<UDPServer>> _shards;
+    bool _started;
+    // Options
+    bool _option_reuse_address;
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_UDP_SHARDED_SERVER_H
@@ -0,0 +1,184 @@
+/*!
+    \file hpack.h
+    \brief HPACK header compression definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HPACK_H
+#define CPPSERVER_HTTP_HPACK_H
+
+#include "http.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HPACK header field
+typedef std::pair<std::string, std::string> HPACKHeader;
+
+//! HPACK utility class
+/*!
+    HPACK (RFC 7541) utility class is used to encode HTTP/2 header
+    blocks. Encoder is stateless: header fields are encoded using
+    static table references and literals without indexing, so the
+    encoded header blocks do not depend on each other and could be
+    produced from different threads.
+
+    Thread-safe.
+*/
+class HPACK
+{
+public:
+    HPACK() = delete;
+    HPACK(const HPACK&) = delete;
+    HPACK(HPACK&&) = delete;
+    ~HPACK() = delete;
+
+    HPACK& operator=(const HPACK&) = delete;
+    HPACK& operator=(HPACK&&) = delete;
+
+    //! Size of the HPACK static table
+    static const size_t STATIC_TABLE_SIZE = 61;
+
+    //! Get the HPACK static table entry
+    /*!
+        \param index - Static table index (from 1 to 61)
+        \return Static table header name and value
+    */
+    static std::pair<std::string_view, std::string_view> StaticEntry(size_t index) noexcept;
+
+    //! Encode header field
+    /*!
+        Header name must be in lowercase.
+
+        \param buffer - Output buffer
+        \param name - Header name
+        \param value - Header value
+        \param sensitive - Sensitive header value that must never be indexed (default is false)
+    */
+    static void EncodeHeader(std::vector<uint8_t>& buffer, std::string_view name, std::string_view value, bool sensitive = false);
+
+    //! Encode integer with the given prefix
+    /*!
+        \param buffer - Output buffer
+        \param prefix - First byte bits above the integer prefix
+        \param bits - Integer prefix size in bits
+        \param value - Integer value
+    */
+    static void EncodeInteger(std::vector<uint8_t>& buffer, uint8_t prefix, int bits, uint64_t value);
+    //! Decode integer with the given prefix
+    /*!
+        \param buffer - Input buffer
+        \param size - Input buffer size
+        \param offset - Input buffer offset (will be advanced)
+        \param bits - Integer prefix size in bits
+        \param value - Integer value
+        \return 'true' if the integer was successfully decoded, 'false' if the input is invalid or truncated
+    */
+    static bool DecodeInteger(const uint8_t* buffer, size_t size, size_t& offset, int bits, uint64_t& value);
+
+    //! Encode string literal (Huffman encoded if it is shorter)
+    /*!
+        \param buffer - Output buffer
+        \param value - String value
+    */
+    static void EncodeString(std::vector<uint8_t>& buffer, std::string_view value);
+    //! Decode string literal
+    /*!
+        \param buffer - Input buffer
+        \param size - Input buffer size
+        \param offset - Input buffer offset (will be advanced)
+        \param value - String value
+        \return 'true' if the string was successfully decoded, 'false' if the input is invalid or truncated
+    */
+    static bool DecodeString(const uint8_t* buffer, size_t size, size_t& offset, std::string& value);
+
+    //! Get the Huffman encoded size of the given string
+    static size_t HuffmanSize(std::string_view value) noexcept;
+    //! Huffman encode the given string
+    /*!
+        \param buffer - Output buffer
+        \param value - String value
+    */
+    static void EncodeHuffman(std::vector<uint8_t>& buffer, std::string_view value);
+    //! Huffman decode the given buffer
+    /*!
+        \param buffer - Huffman encoded buffer
+        \param size - Huffman encoded buffer size
+        \param value - Decoded string (will be appended)
+        \return 'true' if the buffer was successfully decoded, 'false' if the Huffman code is invalid
+    */
+    static bool DecodeHuffman(const uint8_t* buffer, size_t size, std::string& value);
+};
+
+//! HPACK decoder
+/*!
+    HPACK decoder is used to decode HTTP/2 header blocks and keeps
+    the dynamic table of the connection.
+
+    Not thread-safe.
+*/
+class HPACKDecoder
+{
+public:
+    //! Initialize HPACK decoder with a given dynamic table size limit
+    /*!
+        \param max_table_size - Dynamic table size limit (default is 4096)
+        \param max_headers_size - Decoded headers list size limit (default is 65536)
+    */
+    explicit HPACKDecoder(size_t max_table_size = 4096, size_t max_headers_size = 65536);
+    HPACKDecoder(const HPACKDecoder&) = delete;
+    HPACKDecoder(HPACKDecoder&&) = default;
+    ~HPACKDecoder() = default;
+
+    HPACKDecoder& operator=(const HPACKDecoder&) = delete;
+    HPACKDecoder& operator=(HPACKDecoder&&) = default;
+
+    //! Get the dynamic table entries count
+    size_t entries() const noexcept { return _table.size(); }
+    //! Get the dynamic table size
+    size_t table_size() const noexcept { return _table_size; }
+    //! Get the dynamic table size limit
+    size_t max_table_size() const noexcept { return _table_limit; }
+
+    //! Decode header block
+    /*!
+        \param buffer - Header block buffer
+        \param size - Header block size
+        \param headers - Decoded header fields (will be appended)
+        \return 'true' if the header block was successfully decoded, 'false' if the header block is invalid
+    */
+    bool Decode(const void* buffer, size_t size, std::vector<HPACKHeader>& headers);
+
+    //! Clear the dynamic table
+    void Clear();
+
+private:
+    // Dynamic table (newest entries are at the front)
+    std::deque<HPACKHeader> _table;
+    size_t _table_size;
+    size_t _table_max_size;
+    size_t _table_limit;
+    size_t _headers_limit;
+
+    // Find the header field by the combined static/dynamic table index
+    bool FindEntry(size_t index, std::string_view& name, std::string_view& value) const;
+    // Insert the header field into the dynamic table
+    void InsertEntry(const HPACKHeader& header);
+    // Evict the dynamic table entries to fit the given size
+    void EvictEntries(size_t size);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HPACK_H
@@ -0,0 +1,359 @@
+/*!
+    \file http2.h
+    \brief HTTP/2 protocol definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP2_H
+#define CPPSERVER_HTTP_HTTP2_H
+
+#include "hpack.h"
+#include "http_request.h"
+#include "http_response.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP/2 protocol
+/*!
+    HTTP/2 protocol (RFC 9113) utility class is used to multiplex
+    HTTP requests and responses over a single connection. It is not
+    bound to any transport: received data is passed to PrepareReceiveHTTP2()
+    and prepared frames are sent using SendHTTP2() virtual method.
+
+    Each stream keeps its own HTTPRequest and HTTPResponse objects, so
+    the regular HTTP request/response handlers are reused for HTTP/2
+    streams. Header blocks are compressed with HPACK, and both stream
+    and connection flow control windows are maintained. Response DATA
+    frames that do not fit the peer window are queued and flushed when
+    the peer sends WINDOW_UPDATE.
+
+    HTTP/2 handlers are called outside of the protocol lock, so it is
+    safe to send responses directly from them.
+
+    Thread-safe.
+*/
+class HTTP2
+{
+public:
+    //! HTTP/2 client connection preface
+    static constexpr std::string_view HTTP2_PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+    //! DATA frame
+    static const uint8_t HTTP2_DATA = 0x00;
+    //! HEADERS frame
+    static const uint8_t HTTP2_HEADERS = 0x01;
+    //! PRIORITY frame
+    static const uint8_t HTTP2_PRIORITY = 0x02;
+    //! RST_STREAM frame
+    static const uint8_t HTTP2_RST_STREAM = 0x03;
+    //! SETTINGS frame
+    static const uint8_t HTTP2_SETTINGS = 0x04;
+    //! PUSH_PROMISE frame
+    static const uint8_t HTTP2_PUSH_PROMISE = 0x05;
+    //! PING frame
+    static const uint8_t HTTP2_PING = 0x06;
+    //! GOAWAY frame
+    static const uint8_t HTTP2_GOAWAY = 0x07;
+    //! WINDOW_UPDATE frame
+    static const uint8_t HTTP2_WINDOW_UPDATE = 0x08;
+    //! CONTINUATION frame
+    static const uint8_t HTTP2_CONTINUATION = 0x09;
+
+    //! END_STREAM flag
+    static const uint8_t HTTP2_FLAG_END_STREAM = 0x01;
+    //! ACK flag
+    static const uint8_t HTTP2_FLAG_ACK = 0x01;
+    //! END_HEADERS flag
+    static const uint8_t HTTP2_FLAG_END_HEADERS = 0x04;
+    //! PADDED flag
+    static const uint8_t HTTP2_FLAG_PADDED = 0x08;
+    //! PRIORITY flag
+    static const uint8_t HTTP2_FLAG_PRIORITY = 0x20;
+
+    //! No error
+    static const uint32_t HTTP2_NO_ERROR = 0x00;
+    //! Protocol error
+    static const uint32_t HTTP2_PROTOCOL_ERROR = 0x01;
+    //! Internal error
+    static const uint32_t HTTP2_INTERNAL_ERROR = 0x02;
+    //! Flow control error
+    static const uint32_t HTTP2_FLOW_CONTROL_ERROR = 0x03;
+    //! Stream closed error
+    static const uint32_t HTTP2_STREAM_CLOSED = 0x05;
+    //! Frame size error
+    static const uint32_t HTTP2_FRAME_SIZE_ERROR = 0x06;
+    //! Refused stream error
+    static const uint32_t HTTP2_REFUSED_STREAM = 0x07;
+    //! Cancel error
+    static const uint32_t HTTP2_CANCEL = 0x08;
+    //! Compression error
+    static const uint32_t HTTP2_COMPRESSION_ERROR = 0x09;
+
+    //! Maximal count of concurrent streams accepted from the peer
+    static const uint32_t HTTP2_MAX_CONCURRENT_STREAMS = 128;
+    //! Stream receive window size advertised to the peer
+    static const int32_t HTTP2_STREAM_WINDOW_SIZE = 1048576;
+    //! Connection receive window size advertised to the peer
+    static const int32_t HTTP2_CONNECTION_WINDOW_SIZE = 16777216;
+    //! Maximal size of the received stream body (larger streams are refused)
+    static const size_t HTTP2_MAX_BODY_SIZE = 67108864;
+
+    HTTP2() { ClearHTTP2(); }
+    HTTP2(const HTTP2&) = delete;
+    HTTP2(HTTP2&&) = delete;
+    ~HTTP2() = default;
+
+    HTTP2& operator=(const HTTP2&) = delete;
+    HTTP2& operator=(HTTP2&&) = delete;
+
+    //! Is the HTTP/2 protocol started?
+    bool IsHTTP2() const noexcept { return _http2; }
+    //! Get the count of active HTTP/2 streams
+    size_t http2_streams() const { std::scoped_lock locker(_http2_lock); return _http2_streams.size(); }
+
+    //! Perform HTTP/2 server upgrade from HTTP/1.1 (h2c)
+    /*!
+        The upgrade request becomes the HTTP/2 stream 1. Upgrade response
+        must be sent before StartHTTP2Server() is called.
+
+        \param request - HTTP/1.1 upgrade request
+        \param response - HTTP/1.1 upgrade response (101 Switching Protocols)
+        \return 'true' if the HTTP/2 upgrade was successfully performed, 'false' if the request is not an HTTP/2 upgrade request
+    */
+    bool PerformHTTP2Upgrade(const HTTPRequest& request, HTTPResponse& response);
+
+    //! Start HTTP/2 server connection
+    /*!
+        Used after the h2c upgrade, for ALPN "h2" negotiated connections
+        and for connections with the prior knowledge client preface.
+        Server SETTINGS frame is sent and the client preface is expected.
+    */
+    void StartHTTP2Server();
+    //! Start HTTP/2 client connection
+    /*!
+        Client preface and SETTINGS frame are sent.
+    */
+    void StartHTTP2Client();
+
+    //! Send HTTP/2 request (client)
+    /*!
+        \param request - HTTP request
+        \param scheme - Request scheme (default is "http")
+        \return Stream Id of the request or 0 if the request cannot be sent
+    */
+    uint32_t SendHTTP2Request(const HTTPRequest& request, std::string_view scheme = "http");
+    //! Send HTTP/2 response (server)
+    /*!
+        \param stream - Stream Id
+        \param response - HTTP response
+        \return 'true' if the HTTP/2 response was successfully sent, 'false' if the stream is closed
+    */
+    bool SendHTTP2Response(uint32_t stream, const HTTPResponse& response) { return SendHTTP2Response(stream, std::string_view(response.cache())); }
+    //! Send HTTP/2 response from the pre-rendered HTTP/1.x response content (server)
+    /*!
+        If the response "Content-Length" is greater than the provided body
+        the stream stays open for SendHTTP2ResponseBody() calls.
+
+        \param stream - Stream Id
+        \param content - HTTP/1.x response content
+        \return 'true' if the HTTP/2 response was successfully sent, 'false' if the stream is closed or the content is invalid
+    */
+    bool SendHTTP2Response(uint32_t stream, std::string_view content);
+    //! Send HTTP/2 response body (server)
+    /*!
+        \param stream - Stream Id
+        \param buffer - Response body buffer
+        \param size - Response body size
+        \return 'true' if the HTTP/2 response body was successfully sent, 'false' if the stream is closed
+    */
+    bool SendHTTP2ResponseBody(uint32_t stream, const void* buffer, size_t size);
+
+    //! Reset HTTP/2 stream
+    /*!
+        \param stream - Stream Id
+        \param error - Error code (default is HTTP2_CANCEL)
+    */
+    void ResetHTTP2Stream(uint32_t stream, uint32_t error = HTTP2_CANCEL);
+    //! Send HTTP/2 GOAWAY frame
+    /*!
+        \param error - Error code (default is HTTP2_NO_ERROR)
+    */
+    void SendHTTP2GoAway(uint32_t error = HTTP2_NO_ERROR);
+
+    //! Prepare HTTP/2 received frames
+    /*!
+        \param buffer - Received buffer
+        \param size - Received buffer size
+    */
+    void PrepareReceiveHTTP2(const void* buffer, size_t size);
+
+    //! Clear HTTP/2 protocol state
+    void ClearHTTP2();
+
+protected:
+    //! Handle HTTP/2 request received notification (server)
+    /*!
+        Request storage belongs to the stream and could be swapped
+        by the handler to take the ownership of the request.
+
+        \param stream - Stream Id
+        \param request - HTTP request
+    */
+    virtual void onHTTP2Request(uint32_t stream, HTTPRequest& request) {}
+    //! Handle HTTP/2 response received notification (client)
+    /*!
+        \param stream - Stream Id
+        \param response - HTTP response
+    */
+    virtual void onHTTP2Response(uint32_t stream, HTTPResponse& response) {}
+    //! Handle HTTP/2 stream reset notification
+    /*!
+        \param stream - Stream Id
+        \param error - Error code
+    */
+    virtual void onHTTP2Reset(uint32_t stream, uint32_t error) {}
+    //! Handle HTTP/2 GOAWAY notification
+    /*!
+        \param last_stream - Last processed stream Id
+        \param error - Error code
+    */
+    virtual void onHTTP2GoAway(uint32_t last_stream, uint32_t error) {}
+    //! Handle HTTP/2 connection error notification
+    /*!
+        GOAWAY frame is already sent to the peer and the connection
+        should be closed.
+
+        \param message - Error message
+    */
+    virtual void onHTTP2Error(const std::string& message) {}
+
+    //! Send HTTP/2 frames using the underlying transport
+    /*!
+        \param buffer - Frames buffer
+        \param size - Frames buffer size
+        \return 'true' if the frames were successfully sent, 'false' if the transport is not connected
+    */
+    virtual bool SendHTTP2(const void* buffer, size_t size) { return false; }
+
+private:
+    // HTTP/2 stream
+    struct Stream
+    {
+        uint32_t id;
+        bool headers_received;
+        bool remote_closed;
+        bool local_closed;
+        int64_t send_window;
+        int64_t receive_window;
+        uint64_t body_remaining;
+        bool head;
+        HTTPRequest request;
+        HTTPResponse response;
+        std::string body;
+        std::string pending;
+        size_t pending_offset;
+        bool pending_end;
+    };
+
+    // HTTP/2 notification
+    struct Event
+    {
+        enum { REQUEST, RESPONSE, RESET, GOAWAY, FAILURE } type;
+        std::shared_ptr<Stream> stream;
+        uint32_t id;
+        uint32_t error;
+        std::string message;
+    };
+
+    mutable std::mutex _http2_lock;
+    std::atomic<bool> _http2;
+    bool _http2_server;
+    bool _http2_preface;
+    bool _http2_failed;
+    bool _http2_goaway;
+
+    // Peer settings
+    uint32_t _http2_peer_max_frame_size;
+    uint32_t _http2_peer_max_streams;
+    int64_t _http2_peer_window_size;
+
+    // Connection flow control windows
+    int64_t _http2_send_window;
+    int64_t _http2_receive_window;
+
+    // Streams
+    uint32_t _http2_last_stream;
+    uint32_t _http2_next_stream;
+    std::unordered_map<uint32_t, std::shared_ptr<Stream>> _http2_streams;
+    std::vector<std::shared_ptr<Stream>> _http2_free_streams;
+    std::vector<std::shared_ptr<Stream>> _http2_pending_streams;
+
+    // Header blocks
+    HPACKDecoder _http2_decoder;
+    std::vector<HPACKHeader> _http2_headers;
+    std::vector<uint8_t> _http2_header_block;
+    uint32_t _http2_continuation_stream;
+    uint8_t _http2_continuation_flags;
+    std::string _http2_header_name;
+
+    // Receive and send buffers
+    std::vector<uint8_t> _http2_receive_buffer;
+    std::vector<uint8_t> _http2_send_buffer;
+    std::vector<uint8_t> _http2_encode_buffer;
+
+    // Notifications
+    std::vector<Event> _http2_events;
+    std::vector<Event> _http2_dispatch;
+
+    // Receive frames
+    size_t ReceiveFrames(const uint8_t* buffer, size_t size);
+    void ReceiveFrame(uint8_t type, uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+    void ReceiveData(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+    void ReceiveHeaders(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+    void ReceiveHeaderBlock(uint8_t flags, uint32_t id, const uint8_t* block, size_t size);
+    void ReceiveSettings(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size);
+    void ReceiveWindowUpdate(uint32_t id, const uint8_t* payload, size_t size);
+    uint32_t ApplySettings(const uint8_t* payload, size_t size);
+
+    // Process received streams
+    void ProcessRequest(const std::shared_ptr<Stream>& stream, bool end_stream);
+    void ProcessResponse(const std::shared_ptr<Stream>& stream, bool end_stream);
+    void CompleteStream(const std::shared_ptr<Stream>& stream);
+
+    // Stream management
+    std::shared_ptr<Stream> CreateStream(uint32_t id);
+    std::shared_ptr<Stream> FindStream(uint32_t id) const;
+    void CloseStream(const std::shared_ptr<Stream>& stream);
+    void ResetStream(uint32_t id, uint32_t error);
+
+    // Prepare frames
+    void PrepareFrame(uint8_t type, uint8_t flags, uint32_t id, const void* payload, size_t size);
+    void PrepareSettings();
+    void PrepareWindowUpdate(uint32_t id, uint32_t increment);
+    void PrepareHeaderBlock(uint32_t id, bool end_stream);
+    void PrepareData(const std::shared_ptr<Stream>& stream, const void* buffer, size_t size, bool end_stream);
+    void FlushStream(const std::shared_ptr<Stream>& stream);
+    void FlushStreams();
+
+    // Encode header field with the lowercase name
+    void EncodeHeader(std::string_view name, std::string_view value);
+
+    // Fail the connection with GOAWAY frame
+    void Fail(uint32_t error, const std::string& message);
+    // Send prepared frames and dispatch notifications
+    void Flush();
+    void Dispatch();
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP2_H
@@ -0,0 +1,185 @@
+/*!
+    \file http_client_pool.h
+    \brief HTTP client connection pool definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_CLIENT_POOL_H
+#define CPPSERVER_HTTP_HTTP_CLIENT_POOL_H
+
+#include "http_request.h"
+#include "http_response.h"
+
+#include "server/asio/ssl_context.h"
+#include "server/asio/tcp_client.h"
+#include "server/asio/tcp_resolver.h"
+#include "server/asio/timer.h"
+
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP client connection pool
+/*!
+    HTTP client connection pool sends HTTP requests to any number of
+    HTTP Web servers and returns std::future for each request as
+    a synchronization primitive.
+
+    Connections are grouped by the server address and port and are
+    kept alive between requests. Resolved server endpoints are cached
+    until the connection to the server fails. A new request is sent
+    over an idle connection if possible, otherwise a new connection
+    is opened until the per-host connections limit is reached and
+    only then the request is pipelined after the outstanding requests
+    of the least loaded connection. Requests above the pipeline limit
+    of all connections wait in the host queue.
+
+    Idempotent requests that were lost because the server closed an
+    idle keep-alive connection are transparently sent again once.
+
+    Request timeout starts when the request is queued, so requests
+    waiting for a free connection expire as well.
+
+    Pool must be created with std::make_shared().
+
+    Thread-safe.
+*/
+class HTTPClientPool : public std::enable_shared_from_this<HTTPClientPool>
+{
+public:
+    //! Initialize HTTP client pool with a given Asio service
+    /*!
+        HTTP pipelining is disabled by default, because many HTTP Web
+        servers process only one request at a time per connection.
+
+        \param service - Asio service
+        \param max_connections - Connections limit per host (default is 8)
+        \param max_pipeline - Pipelined requests limit per connection (default is 1)
+    */
+    explicit HTTPClientPool(const std::shared_ptr<Asio::Service>& service, size_t max_connections = 8, size_t max_pipeline = 1);
+    HTTPClientPool(const HTTPClientPool&) = delete;
+    HTTPClientPool(HTTPClientPool&&) = delete;
+    virtual ~HTTPClientPool();
+
+    HTTPClientPool& operator=(const HTTPClientPool&) = delete;
+    HTTPClientPool& operator=(HTTPClientPool&&) = delete;
+
+    //! Get the Asio service
+    std::shared_ptr<Asio::Service>& service() noexcept { return _service; }
+    //! Get the connections limit per host
+    size_t max_connections() const noexcept { return _max_connections; }
+    //! Get the pipelined requests limit per connection
+    size_t max_pipeline() const noexcept { return _max_pipeline; }
+
+    //! Get the count of pooled connections
+    size_t connections() const;
+    //! Get the count of requests waiting for response
+    size_t requests() const;
+
+    //! Send HTTP request
+    /*!
+        \param address - Server address
+        \param port - Server port number
+        \param request - HTTP request
+        \param timeout - HTTP request timeout (default is 1 minute)
+        \return HTTP request future
+    */
+    std::future<HTTPResponse> SendRequest(const std::string& address, int port, const HTTPRequest& request, const CppCommon::Timespan& timeout = CppCommon::Timespan::minutes(1));
+
+    //! Disconnect all pooled connections and fail all waiting requests
+    void Clear();
+
+protected:
+    //! Initialize HTTP client pool with a given Asio service and SSL context
+    /*!
+        \param service - Asio service
+        \param context - SSL context shared by all pooled connections (nullptr for plain HTTP connections)
+        \param max_connections - Connections limit per host
+        \param max_pipeline - Pipelined requests limit per connection
+    */
+    HTTPClientPool(const std::shared_ptr<Asio::Service>& service, const std::shared_ptr<Asio::SSLContext>& context, size_t max_connections, size_t max_pipeline);
+
+    //! Get the SSL context of pooled connections
+    std::shared_ptr<Asio::SSLContext>& context() noexcept { return _context; }
+
+private:
+    class Connection;
+    class TCPConnection;
+    class SSLConnection;
+
+    // HTTP request waiting for response
+    struct Request
+    {
+        std::string data;
+        uint64_t deadline;
+        bool head;
+        bool idempotent;
+        bool sent;
+        bool retried;
+        std::promise<HTTPResponse> promise;
+    };
+
+    // Pooled host
+    struct Host
+    {
+        std::mutex lock;
+        std::string address;
+        int port;
+        std::vector<asio::ip::tcp::endpoint> endpoints;
+        size_t endpoint;
+        bool resolving;
+        std::vector<std::shared_ptr<Connection>> connections;
+        std::deque<std::shared_ptr<Request>> queue;
+        std::shared_ptr<Asio::Timer> timer;
+        uint64_t deadline;
+    };
+
+    std::shared_ptr<Asio::Service> _service;
+    std::shared_ptr<Asio::SSLContext> _context;
+    std::shared_ptr<Asio::TCPResolver> _resolver;
+    size_t _max_connections;
+    size_t _max_pipeline;
+    mutable std::mutex _hosts_lock;
+    std::unordered_map<std::string, std::shared_ptr<Host>> _hosts;
+
+    // Find or create the pooled host
+    std::shared_ptr<Host> GetHost(const std::string& address, int port);
+    // Create a new connection to the host endpoint
+    std::shared_ptr<Connection> CreateConnection(const std::shared_ptr<Host>& host, const asio::ip::tcp::endpoint& endpoint);
+    // Resolve the host endpoints
+    void Resolve(const std::shared_ptr<Host>& host);
+    // Dispatch queued requests of the host to its connections
+    void Dispatch(const std::shared_ptr<Host>& host);
+    // Send the request over the connection
+    void Send(Connection& connection, const std::shared_ptr<Request>& request);
+    // Setup the connection timeout timer for the oldest request
+    void Timeout(const std::shared_ptr<Connection>& connection);
+    // Setup the host timeout timer for the earliest queued request deadline
+    void Timeout(const std::shared_ptr<Host>& host);
+    // Receive the chunked HTTP response body
+    bool ReceiveChunkedBody(Connection& connection, bool& error);
+
+    // Connection handlers (called with the host lock released)
+    void onConnected(const std::shared_ptr<Connection>& connection);
+    void onDisconnected(const std::shared_ptr<Connection>& connection);
+    void onReceived(const std::shared_ptr<Connection>& connection, const void* buffer, size_t size);
+    void onTimeout(const std::shared_ptr<Connection>& connection);
+    void onTimeout(const std::shared_ptr<Host>& host);
+
+    // Complete the request with the given response or error
+    static void SetPromiseValue(Request& request, HTTPResponse& response);
+    static void SetPromiseError(Request& request, const std::string& error);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP_CLIENT_POOL_H
@@ -0,0 +1,124 @@
+/*!
+    \file http_message_pool.h
+    \brief HTTP message pool definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_MESSAGE_POOL_H
+#define CPPSERVER_HTTP_HTTP_MESSAGE_POOL_H
+
+#include "http_request.h"
+#include "http_response.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP message pool
+/*!
+    HTTP message pool keeps released HTTP requests or responses with
+    their retained cache and headers capacity. Acquired messages are
+    empty, but reuse the memory of previously released ones, so steady
+    state processing does not allocate.
+
+    Pooled messages are returned to the pool when the acquired pointer
+    is released. The pool must outlive all acquired messages, except the
+    thread pool (see GetThreadPool()) which is kept alive until its last
+    acquired message is released.
+
+    Thread-safe.
+*/
+template <class TMessage>
+class HTTPMessagePool
+{
+public:
+    //! Pooled message deleter
+    class Deleter
+    {
+    public:
+        Deleter() noexcept : _pool(nullptr) {}
+        explicit Deleter(HTTPMessagePool* pool) noexcept : _pool(pool) {}
+
+        //! Return the message into the pool
+        void operator()(TMessage* message) const;
+
+    private:
+        HTTPMessagePool* _pool;
+    };
+
+    //! Pooled message pointer
+    typedef std::unique_ptr<TMessage, Deleter> Pointer;
+
+    //! Initialize the HTTP message pool
+    /*!
+        \param capacity - Maximal count of messages kept in the pool (default is 64)
+        \param cache_capacity - Cache capacity reserved for new messages (default is 4096)
+    */
+    explicit HTTPMessagePool(size_t capacity = 64, size_t cache_capacity = 4096);
+    HTTPMessagePool(const HTTPMessagePool&) = delete;
+    HTTPMessagePool(HTTPMessagePool&&) = delete;
+    ~HTTPMessagePool();
+
+    HTTPMessagePool& operator=(const HTTPMessagePool&) = delete;
+    HTTPMessagePool& operator=(HTTPMessagePool&&) = delete;
+
+    //! Get the maximal count of messages kept in the pool
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the count of messages available in the pool
+    size_t size() const { std::scoped_lock locker(_lock); return _messages.size(); }
+
+    //! Acquire an empty message from the pool
+    /*!
+        \return Pooled message pointer
+    */
+    Pointer Acquire();
+
+    //! Get the HTTP message pool of the current thread
+    /*!
+        Thread pool is released with its thread. Messages acquired from it
+        and released after the thread exit are deleted, and the pool itself
+        is deleted with the last of them.
+
+        \return HTTP message pool of the current thread
+    */
+    static HTTPMessagePool& GetThreadPool();
+
+private:
+    mutable std::mutex _lock;
+    size_t _capacity;
+    size_t _cache_capacity;
+    std::vector<TMessage*> _messages;
+    size_t _acquired;
+    bool _orphaned;
+
+    // Thread pool holder
+    struct ThreadPool
+    {
+        HTTPMessagePool* pool;
+
+        ThreadPool() : pool(new HTTPMessagePool()) {}
+        ~ThreadPool() { pool->Orphan(); }
+    };
+
+    // Clear the message and keep it in the pool, or delete it if the pool is full
+    void Release(TMessage* message);
+    // Orphan the thread pool and delete it if there are no acquired messages
+    void Orphan();
+};
+
+//! HTTP request pool
+typedef HTTPMessagePool<HTTPRequest> HTTPRequestPool;
+//! HTTP response pool
+typedef HTTPMessagePool<HTTPResponse> HTTPResponsePool;
+
+} // namespace HTTP
+} // namespace CppServer
+
+#include "http_message_pool.inl"
+
+#endif // CPPSERVER_HTTP_HTTP_MESSAGE_POOL_H
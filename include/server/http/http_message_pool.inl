@@ -0,0 +1,119 @@
+/*!
+    \file http_message_pool.inl
+    \brief HTTP message pool inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppServer {
+namespace HTTP {
+
+template <class TMessage>
+inline void HTTPMessagePool<TMessage>::Deleter::operator()(TMessage* message) const
+{
+    if (_pool != nullptr)
+        _pool->Release(message);
+    else
+        delete message;
+}
+
+template <class TMessage>
+inline HTTPMessagePool<TMessage>::HTTPMessagePool(size_t capacity, size_t cache_capacity)
+    : _capacity(capacity),
+      _cache_capacity(cache_capacity),
+      _acquired(0),
+      _orphaned(false)
+{
+    _messages.reserve(capacity);
+}
+
+template <class TMessage>
+inline HTTPMessagePool<TMessage>::~HTTPMessagePool()
+{
+    for (auto message : _messages)
+        delete message;
+    _messages.clear();
+}
+
+template <class TMessage>
+inline typename HTTPMessagePool<TMessage>::Pointer HTTPMessagePool<TMessage>::Acquire()
+{
+    {
+        std::scoped_lock locker(_lock);
+
+        ++_acquired;
+
+        // Reuse the message with retained capacity
+        if (!_messages.empty())
+        {
+            TMessage* message = _messages.back();
+            _messages.pop_back();
+            return Pointer(message, Deleter(this));
+        }
+    }
+
+    // Create a new message with reserved capacity
+    auto message = new TMessage();
+    message->Reserve(_cache_capacity);
+    return Pointer(message, Deleter(this));
+}
+
+template <class TMessage>
+inline void HTTPMessagePool<TMessage>::Release(TMessage* message)
+{
+    // Clear the message, but keep its capacity
+    message->Clear();
+
+    bool last = false;
+    {
+        std::scoped_lock locker(_lock);
+
+        --_acquired;
+
+        // Keep the message unless the pool is full or orphaned
+        if (_orphaned)
+            last = (_acquired == 0);
+        else if (_messages.size() < _capacity)
+        {
+            _messages.push_back(message);
+            return;
+        }
+    }
+
+    delete message;
+
+    // Delete the orphaned pool with its last acquired message
+    if (last)
+        delete this;
+}
+
+template <class TMessage>
+inline void HTTPMessagePool<TMessage>::Orphan()
+{
+    bool last = false;
+    {
+        std::scoped_lock locker(_lock);
+
+        _orphaned = true;
+        last = (_acquired == 0);
+
+        // Free kept messages
+        for (auto message : _messages)
+            delete message;
+        _messages.clear();
+    }
+
+    if (last)
+        delete this;
+}
+
+template <class TMessage>
+inline HTTPMessagePool<TMessage>& HTTPMessagePool<TMessage>::GetThreadPool()
+{
+    thread_local ThreadPool holder;
+    return *holder.pool;
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -80,7 +80,16 @@ public:
     std::string string() const { std::stringstream ss; ss << *this; return ss.str(); }
 
     //! Clear the HTTP request cache
+    /*!
+        Cache and headers capacity is retained to be reused by the next request.
+    */
     HTTPRequest& Clear();
+    //! Reserve the HTTP request cache capacity
+    /*!
+        \param cache_capacity - Cache capacity in bytes
+        \param headers_capacity - Headers capacity (default is 32)
+    */
+    HTTPRequest& Reserve(size_t cache_capacity, size_t headers_capacity = 32);
 
     //! Set the HTTP request begin with a given method, URL and protocol
     /*!
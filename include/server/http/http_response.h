@@ -17,12 +17,13 @@
 #include <string>
 #include <string_view>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
 namespace CppServer {
 namespace HTTP {
 
+class HTTPResponseTemplate;
+
 //! HTTP response
 /*!
     HTTP response is used to create or process parameters
@@ -34,6 +35,7 @@ class HTTPResponse
 {
     friend class HTTPClient;
     friend class HTTPSClient;
+    friend class HTTPClientPool;
 
 public:
     //! Initialize an empty HTTP response
@@ -81,11 +83,29 @@ public:
     //! Get the HTTP response cache content
     const std::string& cache() const noexcept { return _cache; }
 
+    //! Find the content type for the given extension
+    /*!
+        Lookup is case-insensitive and uses the compile-time perfect hash MIME table.
+
+        \param extension - Content extension (e.g. ".html")
+        \return Content type or empty string if the extension is unknown
+    */
+    static std::string_view FindContentType(std::string_view extension) noexcept;
+
     //! Get string from the current HTTP response
     std::string string() const { std::stringstream ss; ss << *this; return ss.str(); }
 
     //! Clear the HTTP response cache
+    /*!
+        Cache and headers capacity is retained to be reused by the next response.
+    */
     HTTPResponse& Clear();
+    //! Reserve the HTTP response cache capacity
+    /*!
+        \param cache_capacity - Cache capacity in bytes
+        \param headers_capacity - Headers capacity (default is 32)
+    */
+    HTTPResponse& Reserve(size_t cache_capacity, size_t headers_capacity = 32);
 
     //! Set the HTTP response begin with a given status and protocol
     /*!
@@ -100,6 +120,14 @@ public:
         \param protocol - Protocol version
     */
     HTTPResponse& SetBegin(int status, std::string_view status_phrase, std::string_view protocol);
+    //! Set the HTTP response begin with a given pre-rendered template
+    /*!
+        Status line and fixed headers are copied from the template
+        without rendering them again.
+
+        \param response_template - HTTP response template
+    */
+    HTTPResponse& SetBegin(const HTTPResponseTemplate& response_template);
     //! Set the HTTP response content type
     /*!
         \param extension - Content extension
@@ -123,6 +151,11 @@ public:
         \param http_only - Cookie HTTP-only flag (default is true)
     */
     HTTPResponse& SetCookie(std::string_view name, std::string_view value, size_t max_age = 86400, std::string_view path = "", std::string_view domain = "", bool secure = true, bool strict = true, bool http_only = true);
+    //! Set the HTTP response "Date" header
+    /*!
+        HTTP-date value is cached per thread and formatted once per second.
+    */
+    HTTPResponse& SetDate();
     //! Set the HTTP response body
     /*!
         \param body - Body content (default is "")
@@ -134,6 +167,13 @@ public:
     */
     HTTPResponse& SetBodyLength(size_t length);
 
+    //! Make response from the pre-rendered template
+    /*!
+        \param response_template - HTTP response template
+        \param content - Content (default is "")
+        \return HTTP response
+    */
+    HTTPResponse& MakeResponse(const HTTPResponseTemplate& response_template, std::string_view content = "");
     //! Make OK response
     /*!
         \param status - OK status (default is 200 (OK))
@@ -210,9 +250,6 @@ private:
     std::string _cache;
     size_t _cache_size;
 
-    // HTTP response mime table
-    static const std::unordered_map<std::string, std::string> _mime_table;
-
     // Is pending parts of HTTP response
     bool IsPendingHeader() const;
     bool IsPendingBody() const;
@@ -223,6 +260,8 @@ private:
 
     // Fast convert integer value to the corresponding string representation
     std::string_view FastConvert(size_t value, char* buffer, size_t size);
+    // Fast get the current HTTP-date value cached per thread
+    static std::string_view FastDate();
 };
 
 } // namespace HTTP
@@ -0,0 +1,89 @@
+/*!
+    \file http_response_template.h
+    \brief HTTP response template definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_RESPONSE_TEMPLATE_H
+#define CPPSERVER_HTTP_HTTP_RESPONSE_TEMPLATE_H
+
+#include "http_response.h"
+
+#include <memory>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP response template
+/*!
+    HTTP response template is used to pre-render the HTTP response
+    status line and fixed headers once. Rendered content is kept in
+    a shared buffer, so copies of the template are cheap. Responses
+    made from the template copy the pre-rendered content and patch
+    only "Date" (optional), "Content-Length" and the body.
+
+    Modifying a shared template detaches it from other copies.
+
+    Thread-safe for concurrent reading. Not thread-safe for modification.
+*/
+class HTTPResponseTemplate
+{
+public:
+    //! Initialize a new HTTP response template with a given status and protocol
+    /*!
+        \param status - HTTP status (default is 200 (OK))
+        \param protocol - Protocol version (default is "HTTP/1.1")
+    */
+    explicit HTTPResponseTemplate(int status = 200, std::string_view protocol = "HTTP/1.1");
+    //! Initialize a new HTTP response template with a given status, status phrase and protocol
+    /*!
+        \param status - HTTP status
+        \param status_phrase - HTTP status phrase
+        \param protocol - Protocol version
+    */
+    HTTPResponseTemplate(int status, std::string_view status_phrase, std::string_view protocol);
+    HTTPResponseTemplate(const HTTPResponseTemplate&) = default;
+    HTTPResponseTemplate(HTTPResponseTemplate&&) = default;
+    ~HTTPResponseTemplate() = default;
+
+    HTTPResponseTemplate& operator=(const HTTPResponseTemplate&) = default;
+    HTTPResponseTemplate& operator=(HTTPResponseTemplate&&) = default;
+
+    //! Get the pre-rendered HTTP response (status line and fixed headers without body)
+    const HTTPResponse& response() const noexcept { return *_response; }
+    //! Is the "Date" header patched into each response?
+    bool date() const noexcept { return _date; }
+
+    //! Set the HTTP response template content type
+    /*!
+        \param extension - Content extension
+    */
+    HTTPResponseTemplate& SetContentType(std::string_view extension);
+    //! Set the HTTP response template fixed header
+    /*!
+        \param key - Header key
+        \param value - Header value
+    */
+    HTTPResponseTemplate& SetHeader(std::string_view key, std::string_view value);
+    //! Set the HTTP response template "Date" header patching flag
+    /*!
+        \param date - Patch the cached "Date" header into each response (default is true)
+    */
+    HTTPResponseTemplate& SetDate(bool date = true) noexcept { _date = date; return *this; }
+
+private:
+    // Shared pre-rendered HTTP response
+    std::shared_ptr<HTTPResponse> _response;
+    // Patch "Date" header flag
+    bool _date;
+
+    // Detach the shared pre-rendered HTTP response before modification
+    HTTPResponse& Detach();
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP_RESPONSE_TEMPLATE_H
@@ -42,6 +42,13 @@ public:
     CppCommon::FileCache& cache() noexcept { return _cache; }
     const CppCommon::FileCache& cache() const noexcept { return _cache; }
 
+    //! Get the option: HTTP/2
+    bool option_http2() const noexcept { return _option_http2; }
+    //! Get the option: handshake timeout
+    const CppCommon::Timespan& option_handshake_timeout() const noexcept { return _option_handshake_timeout; }
+    //! Get the option: idle timeout
+    const CppCommon::Timespan& option_idle_timeout() const noexcept { return _option_idle_timeout; }
+
     //! Add static content cache
     /*!
         \param path - Static content path
@@ -60,12 +67,46 @@ public:
     //! Watchdog the static content cache
     void Watchdog(const CppCommon::UtcTimestamp& utc = CppCommon::UtcTimestamp()) { _cache.watchdog(utc); }
 
+    //! Setup option: HTTP/2
+    /*!
+        This option will enable/disable HTTP/2 protocol for the HTTP sessions.
+        HTTP/2 connections are accepted with h2c upgrade or with the prior
+        knowledge connection preface.
+
+        \param enable - Enable/disable option
+    */
+    void SetupHTTP2(bool enable) noexcept { _option_http2 = enable; }
+    //! Setup option: handshake timeout
+    /*!
+        This option will disconnect sessions which did not receive the first
+        HTTP request header (or WebSocket upgrade request) within the given
+        timeout after the connection. Zero timeout disables the option.
+
+        \param timeout - Handshake timeout
+    */
+    void SetupHandshakeTimeout(const CppCommon::Timespan& timeout) noexcept { _option_handshake_timeout = timeout; }
+    //! Setup option: idle timeout
+    /*!
+        This option will disconnect sessions which did not receive any data
+        within the given timeout. Zero timeout disables the option.
+
+        Timeouts of all sessions are planned in the timer wheel of their
+        Asio IO service, so each session does not create its own timer.
+
+        \param timeout - Idle timeout
+    */
+    void SetupIdleTimeout(const CppCommon::Timespan& timeout) noexcept { _option_idle_timeout = timeout; }
+
 protected:
     std::shared_ptr<Asio::TCPSession> CreateSession(const std::shared_ptr<Asio::TCPServer>& server) override { return std::make_shared<HTTPSession>(std::dynamic_pointer_cast<HTTPServer>(server)); }
 
 private:
     // Static content cache
     CppCommon::FileCache _cache;
+    // Server options
+    bool _option_http2{false};
+    CppCommon::Timespan _option_handshake_timeout;
+    CppCommon::Timespan _option_idle_timeout;
 };
 
 /*! \example http_server.cpp HTTP server example */
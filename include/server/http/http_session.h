@@ -9,6 +9,8 @@
 #ifndef CPPSERVER_HTTP_HTTP_SESSION_H
 #define CPPSERVER_HTTP_HTTP_SESSION_H
 
+#include "http2.h"
+#include "http_message_pool.h"
 #include "http_request.h"
 #include "http_response.h"
 
@@ -24,9 +26,15 @@ class HTTPServer;
 /*!
     HTTP session is used to receive/send HTTP requests/responses from the connected HTTP client.
 
+    If HTTP/2 is enabled on the server, the session is able to switch
+    to HTTP/2 protocol. Each HTTP/2 stream request is dispatched to the
+    same request handlers and the response is sent to the current stream.
+    Responses sent later or from another thread must use the HTTP/2
+    stream Id taken from http2_stream() in the request handler.
+
     Thread-safe.
 */
-class HTTPSession : public Asio::TCPSession
+class HTTPSession : public Asio::TCPSession, protected HTTP2
 {
 public:
     explicit HTTPSession(const std::shared_ptr<HTTPServer>& server);
@@ -45,6 +53,29 @@ public:
     HTTPResponse& response() noexcept { return _response; }
     const HTTPResponse& response() const noexcept { return _response; }
 
+    //! Is the session switched to HTTP/2 protocol?
+    using HTTP2::IsHTTP2;
+    //! Get the current HTTP/2 stream Id
+    /*!
+        Stream Id is valid only in request handlers called by the current
+        thread and is 0 for HTTP/1.x requests. It could be stored to send
+        the response later with SendResponseAsync(stream, response).
+    */
+    uint32_t http2_stream() const noexcept;
+
+    //! Detach the current HTTP request from the session
+    /*!
+        Method should be called only from onReceivedRequest() handler.
+        The session HTTP request storage is swapped with an empty pooled
+        request of the current thread, so the received request can be
+        passed to another thread without copying. The request reference
+        passed to the handler becomes empty after this call. HTTP/2
+        request is detached from its stream storage the same way.
+
+        \return Detached HTTP request
+    */
+    HTTPRequestPool::Pointer DetachRequest();
+
     //! Send the current HTTP response (synchronous)
     /*!
         \return Size of sent data
@@ -55,21 +86,21 @@ public:
         \param response - HTTP response
         \return Size of sent data
     */
-    size_t SendResponse(const HTTPResponse& response) { return Send(response.cache()); }
+    size_t SendResponse(const HTTPResponse& response);
 
     //! Send the HTTP response body (synchronous)
     /*!
         \param body - HTTP response body
         \return Size of sent data
     */
-    size_t SendResponseBody(std::string_view body) { return Send(body); }
+    size_t SendResponseBody(std::string_view body) { return SendResponseBody(body.data(), body.size()); }
     //! Send the HTTP response body (synchronous)
     /*!
         \param buffer - HTTP response body buffer
         \param size - HTTP response body size
         \return Size of sent data
     */
-    size_t SendResponseBody(const void* buffer, size_t size) { return Send(buffer, size); }
+    size_t SendResponseBody(const void* buffer, size_t size);
 
     //! Send the current HTTP response with timeout (synchronous)
     /*!
@@ -83,7 +114,7 @@ public:
         \param timeout - Timeout
         \return Size of sent data
     */
-    size_t SendResponse(const HTTPResponse& response, const CppCommon::Timespan& timeout) { return Send(response.cache(), timeout); }
+    size_t SendResponse(const HTTPResponse& response, const CppCommon::Timespan& timeout);
 
     //! Send the HTTP response body with timeout (synchronous)
     /*!
@@ -91,7 +122,7 @@ public:
         \param timeout - Timeout
         \return Size of sent data
     */
-    size_t SendResponseBody(std::string_view body, const CppCommon::Timespan& timeout) { return Send(body, timeout); }
+    size_t SendResponseBody(std::string_view body, const CppCommon::Timespan& timeout) { return SendResponseBody(body.data(), body.size(), timeout); }
     //! Send the HTTP response body with timeout (synchronous)
     /*!
         \param buffer - HTTP response body buffer
@@ -99,7 +130,7 @@ public:
         \param timeout - Timeout
         \return Size of sent data
     */
-    size_t SendResponseBody(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return Send(buffer, size, timeout); }
+    size_t SendResponseBody(const void* buffer, size_t size, const CppCommon::Timespan& timeout);
 
     //! Send the current HTTP response (asynchronous)
     /*!
@@ -111,23 +142,39 @@ public:
         \param response - HTTP response
         \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
     */
-    bool SendResponseAsync(const HTTPResponse& response) { return SendAsync(response.cache()); }
+    bool SendResponseAsync(const HTTPResponse& response);
+    //! Send the HTTP response to the given HTTP/2 stream (asynchronous)
+    /*!
+        \param stream - HTTP/2 stream Id
+        \param response - HTTP response
+        \return 'true' if the HTTP response was successfully sent, 'false' if the stream is closed
+    */
+    bool SendResponseAsync(uint32_t stream, const HTTPResponse& response) { return SendHTTP2Response(stream, response); }
 
     //! Send the HTTP response body (asynchronous)
     /*!
         \param body - HTTP response body
         \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
     */
-    bool SendResponseBodyAsync(std::string_view body) { return SendAsync(body); }
+    bool SendResponseBodyAsync(std::string_view body) { return SendResponseBodyAsync(body.data(), body.size()); }
     //! Send the HTTP response body (asynchronous)
     /*!
         \param buffer - HTTP response body buffer
         \param size - HTTP response body size
         \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
     */
-    bool SendResponseBodyAsync(const void* buffer, size_t size) { return SendAsync(buffer, size); }
+    bool SendResponseBodyAsync(const void* buffer, size_t size);
+    //! Send the HTTP response body to the given HTTP/2 stream (asynchronous)
+    /*!
+        \param stream - HTTP/2 stream Id
+        \param buffer - HTTP response body buffer
+        \param size - HTTP response body size
+        \return 'true' if the HTTP response body was successfully sent, 'false' if the stream is closed
+    */
+    bool SendResponseBodyAsync(uint32_t stream, const void* buffer, size_t size) { return SendHTTP2ResponseBody(stream, buffer, size); }
 
 protected:
+    void onConnected() override;
     void onReceived(const void* buffer, size_t size) override;
     void onDisconnected() override;
 
@@ -155,12 +202,12 @@ protected:
         was found.
 
         Default behavior is just send cached response content
-        to the client.
+        to the client (or to the current HTTP/2 stream).
 
         \param request - HTTP request
         \param content - Cached response content
     */
-    virtual void onReceivedCachedRequest(const HTTPRequest& request, std::string_view content) { SendAsync(content); }
+    virtual void onReceivedCachedRequest(const HTTPRequest& request, std::string_view content);
 
     //! Handle HTTP request error notification
     /*!
@@ -172,6 +219,36 @@ protected:
     */
     virtual void onReceivedRequestError(const HTTPRequest& request, const std::string& error) {}
 
+    //! Handle session watchdog notification
+    /*!
+        Notification is called from the timer wheel of the session Asio IO
+        service when the session watchdog is checked. It could be used to
+        perform keep-alive activities of the idle session.
+
+        \param idle - Session idle timespan since the last received data
+        \return Timespan until the next required watchdog notification (zero if not required)
+    */
+    virtual CppCommon::Timespan onWatchdog(const CppCommon::Timespan& idle) { return CppCommon::Timespan::zero(); }
+
+    //! Check the session watchdog and reschedule it in the timer wheel
+    /*!
+        Session is disconnected if its handshake or idle timeout is expired.
+        Method should be called when the session state was changed and the
+        watchdog should be rescheduled (e.g. after WebSocket handshake).
+    */
+    void UpdateWatchdog();
+
+    //! Stop the session watchdog and release its timer wheel handle
+    /*!
+        Method should be called when the session is disconnected by derived
+        classes which override onDisconnected() handler without calling it.
+    */
+    void StopWatchdog();
+
+    void onHTTP2Request(uint32_t stream, HTTPRequest& request) override;
+    void onHTTP2Error(const std::string& message) override;
+    bool SendHTTP2(const void* buffer, size_t size) override { return SendAsync(buffer, size); }
+
 protected:
     //! HTTP request
     HTTPRequest _request;
@@ -181,6 +258,19 @@ protected:
 private:
     // Static content cache
     CppCommon::FileCache& _cache;
+    // Static content cache key (reused to avoid allocations)
+    std::string _cache_key;
+    // HTTP/2 option
+    bool _http2_option;
+    // Session watchdog
+    std::shared_ptr<Asio::TimerWheel> _watchdog_wheel;
+    Asio::TimerWheel::Handle _watchdog;
+    CppCommon::Timespan _watchdog_handshake_timeout;
+    CppCommon::Timespan _watchdog_idle_timeout;
+    uint64_t _watchdog_connected;
+    uint64_t _watchdog_activity;
+    uint64_t _watchdog_received;
+    bool _watchdog_handshaked;
 
     void onReceivedRequestInternal(const HTTPRequest& request);
 };
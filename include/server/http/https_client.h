@@ -9,6 +9,7 @@
 #ifndef CPPSERVER_HTTP_HTTPS_CLIENT_H
 #define CPPSERVER_HTTP_HTTPS_CLIENT_H
 
+#include "http_message_pool.h"
 #include "http_request.h"
 #include "http_response.h"
 
@@ -44,6 +45,18 @@ public:
     HTTPRequest& request() noexcept { return _request; }
     const HTTPRequest& request() const noexcept { return _request; }
 
+    //! Detach the current HTTP response from the client
+    /*!
+        Method should be called only from onReceivedResponse() handler.
+        The client HTTP response storage is swapped with an empty pooled
+        response of the current thread, so the received response can be
+        passed to another thread without copying. The response reference
+        passed to the handler becomes empty after this call.
+
+        \return Detached HTTP response
+    */
+    HTTPResponsePool::Pointer DetachResponse();
+
     //! Send the current HTTP request (synchronous)
     /*!
         \return Size of sent data
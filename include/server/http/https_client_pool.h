@@ -0,0 +1,58 @@
+/*!
+    \file https_client_pool.h
+    \brief HTTPS client connection pool definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
+#define CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
+
+#include "http_client_pool.h"
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTPS client connection pool
+/*!
+    HTTPS client connection pool sends HTTP requests to any number of
+    secured HTTPS Web servers and returns std::future for each request
+    as a synchronization primitive.
+
+    Connections are grouped and kept alive the same way as in the HTTP
+    client connection pool, so the SSL handshake is performed once per
+    pooled connection. All connections share the given SSL context,
+    which allows to resume SSL sessions of new connections to the same
+    host if the session reuse is enabled in the context.
+
+    Pool must be created with std::make_shared().
+
+    Thread-safe.
+*/
+class HTTPSClientPool : public HTTPClientPool
+{
+public:
+    //! Initialize HTTPS client pool with a given Asio service and SSL context
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param max_connections - Connections limit per host (default is 8)
+        \param max_pipeline - Pipelined requests limit per connection (default is 1)
+    */
+    explicit HTTPSClientPool(const std::shared_ptr<Asio::Service>& service, const std::shared_ptr<Asio::SSLContext>& context, size_t max_connections = 8, size_t max_pipeline = 1);
+    HTTPSClientPool(const HTTPSClientPool&) = delete;
+    HTTPSClientPool(HTTPSClientPool&&) = delete;
+    virtual ~HTTPSClientPool() = default;
+
+    HTTPSClientPool& operator=(const HTTPSClientPool&) = delete;
+    HTTPSClientPool& operator=(HTTPSClientPool&&) = delete;
+
+    //! Get the SSL context
+    using HTTPClientPool::context;
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
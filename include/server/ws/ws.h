@@ -11,10 +11,13 @@
 
 #include "server/http/http_request.h"
 #include "server/http/http_response.h"
+#include "server/ws/ws_deflate.h"
 
 #include "system/uuid.h"
+#include "time/timespan.h"
 
 #include <array>
+#include <memory>
 #include <mutex>
 
 namespace CppServer {
@@ -41,6 +44,11 @@ public:
     static const uint8_t WS_PING = 0x09;
     //! Pong frame
     static const uint8_t WS_PONG = 0x0A;
+    //! Compressed message flag (permessage-deflate)
+    static const uint8_t WS_RSV1 = 0x40;
+
+    //! Maximal WebSocket frame header size (including the close status)
+    static const size_t WS_MAX_HEADER_SIZE = 16;
 
     WebSocket() { ClearWSBuffers(); InitWSNonce(); }
     WebSocket(const WebSocket&) = delete;
@@ -53,6 +61,65 @@ public:
     //! Get the WebSocket random nonce
     std::string_view ws_nonce() const noexcept { return std::string_view((char*)_ws_nonce.data(), _ws_nonce.size()); }
 
+    //! Is the WebSocket permessage-deflate extension enabled?
+    bool ws_deflate_enabled() const noexcept { return _ws_deflate_enabled; }
+    //! Get the WebSocket permessage-deflate extension options
+    const WSDeflateOptions& ws_deflate_options() const noexcept { return _ws_deflate_options; }
+    //! Is the WebSocket permessage-deflate extension negotiated?
+    bool ws_deflate() const noexcept { return _ws_deflate.IsInitialized(); }
+
+    //! Setup WebSocket permessage-deflate extension
+    /*!
+        This option will be applied to the next WebSocket handshake.
+        WebSocket client offers the extension to the server and WebSocket
+        server sessions accept offers of clients.
+
+        \param enable - Enable/disable permessage-deflate extension
+        \param options - permessage-deflate extension options (default is WSDeflateOptions())
+    */
+    void SetupWSDeflate(bool enable, const WSDeflateOptions& options = WSDeflateOptions()) { _ws_deflate_enabled = enable; _ws_deflate_options = options; }
+
+    //! Is the WebSocket streaming receive mode enabled?
+    bool ws_streaming() const noexcept { return _ws_streaming; }
+    //! Get the WebSocket maximal message size (0 if unlimited)
+    size_t ws_max_message_size() const noexcept { return _ws_max_message_size; }
+
+    //! Setup WebSocket streaming receive mode
+    /*!
+        In streaming mode text and binary messages are not collected
+        into the receive buffer. Payload slices are unmasked in place
+        and delivered with onWSReceivedFragment() handler as soon as
+        they arrive. Compressed messages are still collected and
+        delivered as a single fragment after decompression.
+
+        Synchronous receive methods are not supported in streaming mode!
+
+        \param enable - Enable/disable streaming receive mode
+    */
+    void SetupWSStreaming(bool enable) noexcept { _ws_streaming = enable; }
+    //! Setup WebSocket maximal message size
+    /*!
+        Message is rejected as soon as the received frame header shows
+        that the message exceeds the limit. The connection is closed
+        with 1009 status (message too big).
+
+        \param size - Maximal message size in bytes (0 if unlimited)
+    */
+    void SetupWSMaxMessageSize(size_t size) noexcept { _ws_max_message_size = size; }
+
+    //! Get the WebSocket keep-alive ping interval
+    const CppCommon::Timespan& ws_ping_interval() const noexcept { return _ws_ping_interval; }
+
+    //! Setup WebSocket keep-alive ping interval
+    /*!
+        WebSocket server sessions send ping frames when nothing was received
+        from the client within the given interval. Combined with the server
+        idle timeout it allows to detect and disconnect dead clients.
+
+        \param interval - Keep-alive ping interval (zero to disable pings)
+    */
+    void SetupWSPingInterval(const CppCommon::Timespan& interval) noexcept { _ws_ping_interval = interval; }
+
     //! Perform WebSocket client upgrade
     /*!
         \param response - WebSocket upgrade HTTP response
@@ -69,6 +136,33 @@ public:
     */
     bool PerformServerUpgrade(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response);
 
+    //! Prepare WebSocket frame header
+    /*!
+        Close status is stored right after the frame header as the first
+        two bytes of the frame payload, so the caller sends the returned
+        header followed by the original payload.
+
+        \param header - WebSocket frame header buffer (at least WS_MAX_HEADER_SIZE bytes)
+        \param opcode - WebSocket opcode
+        \param mask - WebSocket mask (4 bytes) or nullptr for unmasked frame
+        \param size - WebSocket frame payload size
+        \param status - WebSocket status (default is 0)
+        \return WebSocket frame header size
+    */
+    static size_t PrepareFrameHeader(uint8_t* header, uint8_t opcode, const uint8_t* mask, size_t size, int status = 0) noexcept;
+    //! Prepare unmasked WebSocket frame in a shared buffer
+    /*!
+        Shared frame is prepared once and could be sent to any number
+        of WebSocket server sessions without copying.
+
+        \param opcode - WebSocket opcode
+        \param buffer - Buffer to send
+        \param size - Buffer size
+        \param status - WebSocket status (default is 0)
+        \return Shared WebSocket frame
+    */
+    static std::shared_ptr<const std::vector<uint8_t>> PrepareSharedFrame(uint8_t opcode, const void* buffer, size_t size, int status = 0);
+
     //! Prepare WebSocket send frame
     /*!
         \param opcode - WebSocket opcode
@@ -78,9 +172,24 @@ public:
         \param status - WebSocket status (defualt is 0)
     */
     void PrepareSendFrame(uint8_t opcode, bool mask, const void* buffer, size_t size, int status = 0);
+    //! Prepare WebSocket send message compression
+    /*!
+        Text and binary messages are compressed if the permessage-deflate
+        extension was negotiated and the message is not smaller than the
+        compression threshold. Should be called under the send lock!
+
+        \param opcode - WebSocket opcode (RSV1 flag is set for compressed message)
+        \param buffer - Buffer to send (replaced with the compressed buffer)
+        \param size - Buffer size (replaced with the compressed buffer size)
+        \return 'true' if the message was compressed, 'false' otherwise
+    */
+    bool PrepareSendDeflate(uint8_t& opcode, const void*& buffer, size_t& size);
 
     //! Prepare WebSocket receive frame
     /*!
+        In streaming mode masked payload is unmasked in place,
+        so the received buffer must be writable.
+
         \param buffer - Received buffer
         \param size - Received buffer size
     */
@@ -92,6 +201,22 @@ public:
     //! Clear WebSocket send/receive buffers
     void ClearWSBuffers();
 
+    //! Mask or unmask WebSocket payload
+    /*!
+        Payload is XORed with the repeated 4-byte WebSocket mask using
+        the widest available SIMD registers (AVX2, SSE2 or NEON) with
+        a scalar fallback. Source and destination buffers might be the
+        same to unmask the payload in place. Zero mask is detected and
+        the payload is just copied.
+
+        \param destination - Destination buffer
+        \param source - Source buffer
+        \param size - Payload size
+        \param mask - WebSocket mask (4 bytes)
+        \param offset - Payload offset used to rotate the mask (default is 0)
+    */
+    static void MaskPayload(uint8_t* destination, const uint8_t* source, size_t size, const uint8_t* mask, size_t offset = 0) noexcept;
+
     //! Initialize WebSocket random nonce
     void InitWSNonce();
 
@@ -128,6 +253,14 @@ protected:
     */
     virtual void onWSConnected(const HTTP::HTTPRequest& request) {}
 
+    //! Handle WebSocket server session handshaked notification
+    /*!
+        Notification is called right after the WebSocket upgrade response
+        was sent and before the connected notification. It is used by
+        WebSocket server sessions to register in the server.
+    */
+    virtual void onWSHandshaked() {}
+
     //! Handle WebSocket client disconnected notification
     virtual void onWSDisconnected() {}
 
@@ -137,6 +270,18 @@ protected:
         \param size - Received buffer size
     */
     virtual void onWSReceived(const void* buffer, size_t size) {}
+    //! Handle WebSocket received fragment notification
+    /*!
+        Notification is called only in streaming mode instead of
+        onWSReceived() handler. Fragment buffer is valid only during
+        the call.
+
+        \param buffer - Received fragment buffer
+        \param size - Received fragment size
+        \param first - First fragment of the message flag
+        \param last - Last fragment of the message flag
+    */
+    virtual void onWSReceivedFragment(const void* buffer, size_t size, bool first, bool last) {}
 
     //! Handle WebSocket client close notification
     /*!
@@ -184,6 +329,28 @@ protected:
     std::vector<uint8_t> _ws_receive_final_buffer;
     //! Receive mask
     uint8_t _ws_receive_mask[4];
+    //! Receive message size
+    size_t _ws_receive_message_size{0};
+    //! Receive streamed frame payload size
+    size_t _ws_receive_streamed{0};
+    //! Receive streamed fragment buffer
+    std::vector<uint8_t> _ws_receive_stream_buffer;
+    //! Receive first fragment flag
+    bool _ws_receive_first{true};
+    //! Receive rejected message flag
+    bool _ws_receive_rejected{false};
+
+    //! Streaming receive mode flag
+    bool _ws_streaming{false};
+    //! Maximal message size
+    size_t _ws_max_message_size{0};
+    //! Keep-alive ping interval
+    CppCommon::Timespan _ws_ping_interval;
+
+    //! Receive compressed message flag
+    bool _ws_receive_compressed{false};
+    //! Receive decompressed message buffer
+    std::vector<uint8_t> _ws_receive_deflate_buffer;
 
     //! Send buffer lock
     std::mutex _ws_send_lock;
@@ -192,6 +359,16 @@ protected:
     //! Send mask
     uint8_t _ws_send_mask[4];
 
+    //! Send compressed message buffer
+    std::vector<uint8_t> _ws_send_deflate_buffer;
+
+    //! permessage-deflate extension enabled flag
+    bool _ws_deflate_enabled{false};
+    //! permessage-deflate extension options
+    WSDeflateOptions _ws_deflate_options;
+    //! permessage-deflate extension codec
+    WSDeflate _ws_deflate;
+
     //! WebSocket random nonce of 16 bytes
     std::array<uint8_t, 16> _ws_nonce;
 
@@ -200,6 +377,12 @@ protected:
         \param response - WebSocket upgrade HTTP response
     */
     virtual void SendResponse(const HTTP::HTTPResponse& response) {}
+    //! Close WebSocket connection with the given status
+    /*!
+        \param status - WebSocket status
+        \param reason - Close reason
+    */
+    virtual void CloseConnection(int status, std::string_view reason) {}
 };
 
 } // namespace WS
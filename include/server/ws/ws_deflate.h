@@ -0,0 +1,146 @@
+/*!
+    \file ws_deflate.h
+    \brief WebSocket permessage-deflate extension definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_DEFLATE_H
+#define CPPSERVER_WS_DEFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct z_stream_s;
+
+namespace CppServer {
+namespace WS {
+
+//! WebSocket permessage-deflate extension options
+/*!
+    Options are used in two ways: as the local setup of the extension
+    before WebSocket handshake and as the agreed extension parameters
+    after WebSocket handshake.
+
+    https://tools.ietf.org/html/rfc7692
+*/
+struct WSDeflateOptions
+{
+    //! Server must reset its compression context after each message
+    bool server_no_context_takeover{false};
+    //! Client must reset its compression context after each message
+    bool client_no_context_takeover{false};
+    //! Server LZ77 sliding window size in bits (9..15)
+    int server_max_window_bits{15};
+    //! Client LZ77 sliding window size in bits (9..15)
+    int client_max_window_bits{15};
+    //! Compression level (0..9 or -1 for the default level)
+    int level{-1};
+    //! Messages smaller than the threshold are sent uncompressed
+    size_t threshold{128};
+
+    //! Prepare the client extension offer
+    std::string PrepareOffer() const;
+    //! Negotiate the extension offer on the server side
+    /*!
+        \param offers - Sec-WebSocket-Extensions header value of the client request
+        \param agreed - Agreed extension parameters
+        \param response - Sec-WebSocket-Extensions header value of the server response
+        \return 'true' if one of permessage-deflate offers was accepted, 'false' otherwise
+    */
+    bool NegotiateOffer(std::string_view offers, WSDeflateOptions& agreed, std::string& response) const;
+    //! Negotiate the extension response on the client side
+    /*!
+        \param value - Sec-WebSocket-Extensions header value of the server response
+        \param agreed - Agreed extension parameters
+        \return 'true' if the server response is valid, 'false' otherwise
+    */
+    bool NegotiateResponse(std::string_view value, WSDeflateOptions& agreed) const;
+};
+
+//! WebSocket permessage-deflate codec
+/*!
+    Codec keeps one zlib stream for each direction. zlib streams
+    allocate their memory from the shared pool, so the memory of
+    disconnected sessions is reused by new ones.
+
+    Not thread-safe.
+*/
+class WSDeflate
+{
+public:
+    WSDeflate();
+    WSDeflate(const WSDeflate&) = delete;
+    WSDeflate(WSDeflate&&) = delete;
+    ~WSDeflate();
+
+    WSDeflate& operator=(const WSDeflate&) = delete;
+    WSDeflate& operator=(WSDeflate&&) = delete;
+
+    //! Is the codec initialized?
+    bool IsInitialized() const noexcept { return _initialized; }
+
+    //! Get the agreed extension parameters
+    const WSDeflateOptions& options() const noexcept { return _options; }
+
+    //! Initialize the codec with agreed extension parameters
+    /*!
+        \param options - Agreed extension parameters
+        \param server - Server side flag
+        \return 'true' if the codec was successfully initialized, 'false' if failed
+    */
+    bool Initialize(const WSDeflateOptions& options, bool server);
+    //! Release zlib streams
+    void Clear();
+
+    //! Compress the message payload
+    /*!
+        \param buffer - Message payload
+        \param size - Message payload size
+        \param output - Compressed payload
+        \return 'true' if the payload was successfully compressed, 'false' if failed
+    */
+    bool Compress(const void* buffer, size_t size, std::vector<uint8_t>& output);
+    //! Decompress the message payload
+    /*!
+        \param buffer - Compressed payload
+        \param size - Compressed payload size
+        \param output - Decompressed payload
+        \param limit - Decompressed payload size limit (default is 0 for unlimited)
+        \return 'true' if the payload was successfully decompressed, 'false' if failed or exceeded the limit
+    */
+    bool Decompress(const void* buffer, size_t size, std::vector<uint8_t>& output, size_t limit = 0);
+
+    //! Compress the message payload with a new compression context
+    /*!
+        Used to compress the message once for all sessions with
+        the same agreed parameters and without context takeover.
+
+        \param buffer - Message payload
+        \param size - Message payload size
+        \param window_bits - LZ77 sliding window size in bits
+        \param level - Compression level
+        \param output - Compressed payload
+        \return 'true' if the payload was successfully compressed, 'false' if failed
+    */
+    static bool CompressOnce(const void* buffer, size_t size, int window_bits, int level, std::vector<uint8_t>& output);
+
+private:
+    bool _initialized{false};
+    bool _server{false};
+    WSDeflateOptions _options;
+    std::unique_ptr<z_stream_s> _deflate;
+    std::unique_ptr<z_stream_s> _inflate;
+
+    static bool Deflate(z_stream_s& stream, const void* buffer, size_t size, std::vector<uint8_t>& output);
+};
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_DEFLATE_H
@@ -35,6 +35,18 @@ public:
     WSSClient& operator=(const WSSClient&) = delete;
     WSSClient& operator=(WSSClient&&) = delete;
 
+    // WebSocket permessage-deflate extension methods
+    using WebSocket::ws_deflate_enabled;
+    using WebSocket::ws_deflate_options;
+    using WebSocket::ws_deflate;
+    using WebSocket::SetupWSDeflate;
+
+    // WebSocket receive setup methods
+    using WebSocket::ws_streaming;
+    using WebSocket::ws_max_message_size;
+    using WebSocket::SetupWSStreaming;
+    using WebSocket::SetupWSMaxMessageSize;
+
     // WebSocket connection methods
     bool Connect() override;
     bool Connect(const std::shared_ptr<Asio::TCPResolver>& resolver) override;
@@ -116,6 +128,8 @@ private:
 
     // WebSocket clients cannot send response
     void SendResponse(const HTTP::HTTPResponse& response) override {}
+    // Close WebSocket client with the given status
+    void CloseConnection(int status, std::string_view reason) override { CloseAsync(status, reason); }
 };
 
 /*! \example wss_chat_client.cpp WebSocket secure chat client example */
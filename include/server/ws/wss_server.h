@@ -27,6 +27,8 @@ namespace WS {
 */
 class WSSServer : public HTTP::HTTPSServer, protected WebSocket
 {
+    friend class WSSSession;
+
 public:
     using HTTPSServer::HTTPSServer;
 
@@ -37,29 +39,69 @@ public:
     WSSServer& operator=(const WSSServer&) = delete;
     WSSServer& operator=(WSSServer&&) = delete;
 
+    // WebSocket permessage-deflate extension methods
+    using WebSocket::ws_deflate_enabled;
+    using WebSocket::ws_deflate_options;
+    using WebSocket::SetupWSDeflate;
+
+    // WebSocket receive setup methods
+    using WebSocket::ws_streaming;
+    using WebSocket::ws_max_message_size;
+    using WebSocket::SetupWSStreaming;
+    using WebSocket::SetupWSMaxMessageSize;
+
+    // WebSocket keep-alive setup methods
+    using WebSocket::ws_ping_interval;
+    using WebSocket::SetupWSPingInterval;
+
     // WebSocket connection methods
     virtual bool CloseAll() { return CloseAll(0, nullptr, 0); }
     virtual bool CloseAll(int status) { return CloseAll(status, nullptr, 0); }
     virtual bool CloseAll(int status, const void* buffer, size_t size);
     virtual bool CloseAll(int status, std::string_view text);
 
+    //! Get the count of connected WebSocket sessions
+    uint64_t connected_ws_sessions() const { std::shared_lock<std::shared_mutex> locker(_ws_sessions_lock); return _ws_sessions.size(); }
+
     //! Multicast data to all connected WebSocket sessions
     bool Multicast(const void* buffer, size_t size) override;
+    //! Multicast shared buffer to all connected WebSocket sessions
+    /*!
+        Shared buffer is encrypted separately for each session, but it is
+        prepared only once for all of them.
+
+        \param buffer - Shared buffer to multicast
+        \return 'true' if the data was successfully multicasted, 'false' if the server is not started
+    */
+    bool Multicast(const std::shared_ptr<const std::vector<uint8_t>>& buffer);
 
     // WebSocket multicast text methods
-    size_t MulticastText(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, buffer, size); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t MulticastText(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, text.data(), text.size()); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t MulticastText(const void* buffer, size_t size) { return MulticastFrame(WS_FIN | WS_TEXT, buffer, size); }
+    size_t MulticastText(std::string_view text) { return MulticastFrame(WS_FIN | WS_TEXT, text.data(), text.size()); }
 
     // WebSocket multicast binary methods
-    size_t MulticastBinary(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, buffer, size); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t MulticastBinary(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, text.data(), text.size()); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t MulticastBinary(const void* buffer, size_t size) { return MulticastFrame(WS_FIN | WS_BINARY, buffer, size); }
+    size_t MulticastBinary(std::string_view text) { return MulticastFrame(WS_FIN | WS_BINARY, text.data(), text.size()); }
 
     // WebSocket multicast ping methods
-    size_t MulticastPing(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, buffer, size); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t MulticastPing(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, text.data(), text.size()); return Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t MulticastPing(const void* buffer, size_t size) { return MulticastFrame(WS_FIN | WS_PING, buffer, size); }
+    size_t MulticastPing(std::string_view text) { return MulticastFrame(WS_FIN | WS_PING, text.data(), text.size()); }
 
 protected:
     std::shared_ptr<Asio::SSLSession> CreateSession(const std::shared_ptr<Asio::SSLServer>& server) override { return std::make_shared<WSSSession>(std::dynamic_pointer_cast<WSSServer>(server)); }
+
+private:
+    // Handshaked WebSocket sessions
+    mutable std::shared_mutex _ws_sessions_lock;
+    std::map<CppCommon::UUID, std::shared_ptr<WSSSession>> _ws_sessions;
+
+    //! Multicast WebSocket frame prepared once for all connected WebSocket sessions
+    bool MulticastFrame(uint8_t opcode, const void* buffer, size_t size, int status = 0);
+
+    //! Register a new handshaked WebSocket session
+    void RegisterWSSession(const std::shared_ptr<WSSSession>& session);
+    //! Unregister WebSocket session by Id
+    void UnregisterWSSession(const CppCommon::UUID& id);
 };
 
 /*! \example wss_chat_server.cpp WebSocket secure chat server example */
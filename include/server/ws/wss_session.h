@@ -36,6 +36,22 @@ public:
     WSSSession& operator=(const WSSSession&) = delete;
     WSSSession& operator=(WSSSession&&) = delete;
 
+    // WebSocket permessage-deflate extension methods
+    using WebSocket::ws_deflate_enabled;
+    using WebSocket::ws_deflate_options;
+    using WebSocket::ws_deflate;
+    using WebSocket::SetupWSDeflate;
+
+    // WebSocket receive setup methods
+    using WebSocket::ws_streaming;
+    using WebSocket::ws_max_message_size;
+    using WebSocket::SetupWSStreaming;
+    using WebSocket::SetupWSMaxMessageSize;
+
+    // WebSocket keep-alive setup methods
+    using WebSocket::ws_ping_interval;
+    using WebSocket::SetupWSPingInterval;
+
     // WebSocket connection methods
     virtual bool Close() { return Close(0, nullptr, 0); }
     virtual bool Close(int status) { return Close(status, nullptr, 0); }
@@ -43,44 +59,44 @@ public:
     virtual bool Close(int status, std::string_view text) { SendCloseAsync(status, text); HTTPSSession::Disconnect(); return true; }
 
     // WebSocket send text methods
-    size_t SendText(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendText(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendText(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    size_t SendText(std::string_view text, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    bool SendTextAsync(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, buffer, size); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    bool SendTextAsync(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_TEXT, false, text.data(), text.size()); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t SendText(const void* buffer, size_t size) { return SendFrame(WS_FIN | WS_TEXT, buffer, size); }
+    size_t SendText(std::string_view text) { return SendFrame(WS_FIN | WS_TEXT, text.data(), text.size()); }
+    size_t SendText(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_TEXT, buffer, size, timeout); }
+    size_t SendText(std::string_view text, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_TEXT, text.data(), text.size(), timeout); }
+    bool SendTextAsync(const void* buffer, size_t size) { return SendFrameAsync(WS_FIN | WS_TEXT, buffer, size); }
+    bool SendTextAsync(std::string_view text) { return SendFrameAsync(WS_FIN | WS_TEXT, text.data(), text.size()); }
 
     // WebSocket send binary methods
-    size_t SendBinary(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendBinary(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendBinary(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    size_t SendBinary(std::string_view text, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    bool SendBinaryAsync(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, buffer, size); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    bool SendBinaryAsync(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_BINARY, false, text.data(), text.size()); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t SendBinary(const void* buffer, size_t size) { return SendFrame(WS_FIN | WS_BINARY, buffer, size); }
+    size_t SendBinary(std::string_view text) { return SendFrame(WS_FIN | WS_BINARY, text.data(), text.size()); }
+    size_t SendBinary(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_BINARY, buffer, size, timeout); }
+    size_t SendBinary(std::string_view text, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_BINARY, text.data(), text.size(), timeout); }
+    bool SendBinaryAsync(const void* buffer, size_t size) { return SendFrameAsync(WS_FIN | WS_BINARY, buffer, size); }
+    bool SendBinaryAsync(std::string_view text) { return SendFrameAsync(WS_FIN | WS_BINARY, text.data(), text.size()); }
 
     // WebSocket close methods
-    size_t SendClose(int status, const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, buffer, size, status); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendClose(int status, std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, text.data(), text.size(), status); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendClose(int status, const void* buffer, size_t size, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, buffer, size, status); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    size_t SendClose(int status, std::string_view text, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, text.data(), text.size(), status); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    bool SendCloseAsync(int status, const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, buffer, size, status); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    bool SendCloseAsync(int status, std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_CLOSE, false, text.data(), text.size(), status); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t SendClose(int status, const void* buffer, size_t size) { return SendFrame(WS_FIN | WS_CLOSE, buffer, size, status); }
+    size_t SendClose(int status, std::string_view text) { return SendFrame(WS_FIN | WS_CLOSE, text.data(), text.size(), status); }
+    size_t SendClose(int status, const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_CLOSE, buffer, size, timeout, status); }
+    size_t SendClose(int status, std::string_view text, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_CLOSE, text.data(), text.size(), timeout, status); }
+    bool SendCloseAsync(int status, const void* buffer, size_t size) { return SendFrameAsync(WS_FIN | WS_CLOSE, buffer, size, status); }
+    bool SendCloseAsync(int status, std::string_view text) { return SendFrameAsync(WS_FIN | WS_CLOSE, text.data(), text.size(), status); }
 
     // WebSocket ping methods
-    size_t SendPing(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendPing(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendPing(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    size_t SendPing(std::string_view text, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    bool SendPingAsync(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, buffer, size); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    bool SendPingAsync(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PING, false, text.data(), text.size()); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t SendPing(const void* buffer, size_t size) { return SendFrame(WS_FIN | WS_PING, buffer, size); }
+    size_t SendPing(std::string_view text) { return SendFrame(WS_FIN | WS_PING, text.data(), text.size()); }
+    size_t SendPing(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_PING, buffer, size, timeout); }
+    size_t SendPing(std::string_view text, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_PING, text.data(), text.size(), timeout); }
+    bool SendPingAsync(const void* buffer, size_t size) { return SendFrameAsync(WS_FIN | WS_PING, buffer, size); }
+    bool SendPingAsync(std::string_view text) { return SendFrameAsync(WS_FIN | WS_PING, text.data(), text.size()); }
 
     // WebSocket pong methods
-    size_t SendPong(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendPong(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    size_t SendPong(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, buffer, size); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    size_t SendPong(std::string_view text, const CppCommon::Timespan& timeout) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, text.data(), text.size()); return HTTPSSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout); }
-    bool SendPongAsync(const void* buffer, size_t size) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, buffer, size); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
-    bool SendPongAsync(std::string_view text) { std::scoped_lock locker(_ws_send_lock); PrepareSendFrame(WS_FIN | WS_PONG, false, text.data(), text.size()); return HTTPSSession::SendAsync(_ws_send_buffer.data(), _ws_send_buffer.size()); }
+    size_t SendPong(const void* buffer, size_t size) { return SendFrame(WS_FIN | WS_PONG, buffer, size); }
+    size_t SendPong(std::string_view text) { return SendFrame(WS_FIN | WS_PONG, text.data(), text.size()); }
+    size_t SendPong(const void* buffer, size_t size, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_PONG, buffer, size, timeout); }
+    size_t SendPong(std::string_view text, const CppCommon::Timespan& timeout) { return SendFrame(WS_FIN | WS_PONG, text.data(), text.size(), timeout); }
+    bool SendPongAsync(const void* buffer, size_t size) { return SendFrameAsync(WS_FIN | WS_PONG, buffer, size); }
+    bool SendPongAsync(std::string_view text) { return SendFrameAsync(WS_FIN | WS_PONG, text.data(), text.size()); }
 
     // WebSocket receive methods
     std::string ReceiveText();
@@ -102,9 +118,24 @@ protected:
     //! Handle WebSocket error notification
     void onWSError(const std::string& message) override { onError(asio::error::fault, "WebSocket error", message); }
 
+    //! Send WebSocket keep-alive pings to the idle client
+    CppCommon::Timespan onWatchdog(const CppCommon::Timespan& idle) override;
+
 private:
     // WebSocket send response
     void SendResponse(const HTTP::HTTPResponse& response) override { SendResponseAsync(response); }
+    // Close WebSocket session with the given status
+    void CloseConnection(int status, std::string_view reason) override { Close(status, reason); }
+    // Register the handshaked WebSocket session in the server
+    void onWSHandshaked() override;
+
+    // Send WebSocket frame header followed by the payload with a gather write
+    size_t SendFrame(uint8_t opcode, const void* buffer, size_t size, int status = 0);
+    size_t SendFrame(uint8_t opcode, const void* buffer, size_t size, const CppCommon::Timespan& timeout, int status = 0);
+    bool SendFrameAsync(uint8_t opcode, const void* buffer, size_t size, int status = 0);
+
+    // Idle timespan of the last keep-alive ping
+    CppCommon::Timespan _ws_ping_idle;
 };
 
 } // namespace WS
@@ -11,6 +11,8 @@
 #include "time/timestamp.h"
 
 #include <atomic>
+#include <cstdlib>
+#include <new>
 #include <iostream>
 #include <vector>
 
@@ -27,6 +29,21 @@ std::atomic<uint64_t> total_errors(0);
 std::atomic<uint64_t> total_bytes(0);
 std::atomic<uint64_t> total_messages(0);
 
+std::atomic<uint64_t> total_allocations(0);
+
+// Count heap allocations to measure allocations per request
+void* operator new(size_t size)
+{
+    ++total_allocations;
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 class HTTPSTraceClient : public HTTPSClient
 {
 public:
@@ -163,7 +180,11 @@ int main(int argc, char** argv)
 
     // Wait for benchmarking
     std::cout << "Benchmarking...";
+    uint64_t allocations_start = total_allocations;
+    uint64_t messages_start = total_messages;
     Thread::Sleep(seconds_count * 1000);
+    uint64_t allocations_stop = total_allocations;
+    uint64_t messages_stop = total_messages;
     std::cout << "Done!" << std::endl;
 
     // Disconnect clients
@@ -196,6 +217,8 @@ int main(int argc, char** argv)
         std::cout << "Message latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / total_messages) << std::endl;
         std::cout << "Message throughput: " << total_messages * 1000000000 / (timestamp_stop - timestamp_start) << " msg/s" << std::endl;
     }
+    if (messages_stop > messages_start)
+        std::cout << "Allocations per message: " << (double)(allocations_stop - allocations_start) / (messages_stop - messages_start) << std::endl;
 
     return 0;
 }
@@ -6,7 +6,10 @@
 #include "server/http/https_server.h"
 #include "system/cpu.h"
 
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 #include <OptionParser.h>
 
@@ -14,6 +17,22 @@ using namespace CppCommon;
 using namespace CppServer::Asio;
 using namespace CppServer::HTTP;
 
+std::atomic<uint64_t> total_requests(0);
+std::atomic<uint64_t> total_allocations(0);
+
+// Count heap allocations to measure allocations per request
+void* operator new(size_t size)
+{
+    ++total_allocations;
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 class HTTPSTraceSession : public HTTPSSession
 {
 public:
@@ -22,6 +41,8 @@ public:
 protected:
     void onReceivedRequest(const HTTPRequest& request) override
     {
+        ++total_requests;
+
         // Process HTTP request methods
         if (request.method() == "TRACE")
             SendResponseAsync(response().MakeTraceResponse(request.cache()));
@@ -109,6 +130,9 @@ int main(int argc, char** argv)
     server->Start();
     std::cout << "Done!" << std::endl;
 
+    uint64_t allocations_start = total_allocations;
+    uint64_t requests_start = total_requests;
+
     std::cout << "Press Enter to stop the server or '!' to restart the server..." << std::endl;
 
     // Perform text input
@@ -128,6 +152,9 @@ int main(int argc, char** argv)
         }
     }
 
+    uint64_t allocations_stop = total_allocations;
+    uint64_t requests_stop = total_requests;
+
     // Stop the server
     std::cout << "Server stopping...";
     server->Stop();
@@ -138,5 +165,11 @@ int main(int argc, char** argv)
     service->Stop();
     std::cout << "Done!" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Total requests: " << (requests_stop - requests_start) << std::endl;
+    if (requests_stop > requests_start)
+        std::cout << "Allocations per request: " << (double)(allocations_stop - allocations_start) / (requests_stop - requests_start) << std::endl;
+
     return 0;
 }
@@ -10,6 +10,7 @@
 #include "threads/thread.h"
 #include "time/timestamp.h"
 
+#include "../proto/fbe_extensions.h"
 #include "../proto/simple_protocol.h"
 
 #include <atomic>
@@ -30,13 +31,14 @@ std::atomic<uint64_t> total_errors(0);
 std::atomic<uint64_t> total_bytes(0);
 std::atomic<uint64_t> total_messages(0);
 
-class ProtoClient : public TCPClient, public FBE::simple::Client
+class ProtoClient : public TCPClient, public FBE::BatchSender<FBE::simple::Client>
 {
 public:
-    ProtoClient(const std::shared_ptr<Service>& service, const std::string& address, int port, int messages)
+    ProtoClient(const std::shared_ptr<Service>& service, const std::string& address, int port, int messages, size_t batch)
         : TCPClient(service, address, port),
           _messages(messages)
     {
+        this->batch(batch);
     }
 
     void SendMessage()
@@ -54,9 +56,12 @@ protected:
 
         for (size_t i = _messages; i > 0; --i)
             SendMessage();
+
+        // Flush batched requests
+        flush();
     }
 
-    size_t onSend(const void* data, size_t size) override
+    size_t onFlush(const void* data, size_t size) override
     {
         return SendAsync(data, size) ? size : 0;
     }
@@ -73,6 +78,9 @@ protected:
         total_bytes += size;
 
         receive(buffer, size);
+
+        // Flush batched requests
+        flush();
     }
 
     void onError(int error, const std::string& category, const std::string& message) override
@@ -101,6 +109,7 @@ int main(int argc, char** argv)
     parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000).help("Count of messages to send at the same time. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-b", "--batch").dest("batch").action("store").type("int").set_default(0).help("Batch requests up to the given size and flush them once per receive (0 to disable). Default: %default");
     parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -119,6 +128,7 @@ int main(int argc, char** argv)
     int clients_count = options.get("clients");
     int messages_count = options.get("messages");
     int message_size = options.get("size");
+    int batch = options.get("batch");
     int seconds_count = options.get("seconds");
 
     std::cout << "Server address: " << address << std::endl;
@@ -127,6 +137,7 @@ int main(int argc, char** argv)
     std::cout << "Working clients: " << clients_count << std::endl;
     std::cout << "Working messages: " << messages_count << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Request batch: " << batch << std::endl;
     std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
 
     std::cout << std::endl;
@@ -147,7 +158,7 @@ int main(int argc, char** argv)
     for (int i = 0; i < clients_count; ++i)
     {
         // Create protocol client
-        auto client = std::make_shared<ProtoClient>(service, address, port, messages_count);
+        auto client = std::make_shared<ProtoClient>(service, address, port, messages_count, (size_t)batch);
         // client->SetupNoDelay(true);
         clients.emplace_back(client);
     }
@@ -6,19 +6,25 @@
 #include "server/asio/tcp_server.h"
 #include "system/cpu.h"
 
+#include "../proto/fbe_extensions.h"
 #include "../proto/simple_protocol.h"
 
 #include <iostream>
+#include <string_view>
 
 #include <OptionParser.h>
 
 using namespace CppCommon;
 using namespace CppServer::Asio;
 
-class ProtoSession : public TCPSession, public FBE::simple::Sender, public FBE::simple::Receiver
+class ProtoSession : public TCPSession, public FBE::BatchSender<FBE::simple::Sender>, public FBE::simple::Receiver
 {
 public:
-    using TCPSession::TCPSession;
+    ProtoSession(const std::shared_ptr<TCPServer>& server, size_t batch)
+        : TCPSession(server)
+    {
+        this->batch(batch);
+    }
 
 protected:
     void onError(int error, const std::string& category, const std::string& message) override
@@ -39,19 +45,62 @@ protected:
     }
 
     // Protocol implementation
-    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); }
-    size_t onSend(const void* data, size_t size) override { return SendAsync(data, size) ? size : 0; }
+    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); flush(); }
+    size_t onFlush(const void* data, size_t size) override { return SendAsync(data, size) ? size : 0; }
+};
+
+class ProtoViewSession : public TCPSession, public FBE::BatchSender<FBE::simple::Sender>, public FBE::simple::Proxy
+{
+public:
+    ProtoViewSession(const std::shared_ptr<TCPServer>& server, size_t batch)
+        : TCPSession(server)
+    {
+        this->batch(batch);
+    }
+
+protected:
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Protocol session caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+
+protected:
+    // Protocol handlers
+    void onProxy(FBE::simple::SimpleRequestModel& model, size_t type, const void* data, size_t size) override
+    {
+        // Read the request view over the received bytes without deserialization
+        std::string_view message = FBE::GetStringView(model.buffer(), model.model.Message);
+
+        // Send response
+        simple::SimpleResponse response;
+        model.model.id.get(response.id);
+        response.Hash = 0;
+        response.Length = (uint32_t)message.size();
+        send(response);
+    }
+
+    // Protocol implementation
+    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); flush(); }
+    size_t onFlush(const void* data, size_t size) override { return SendAsync(data, size) ? size : 0; }
 };
 
 class ProtoServer : public TCPServer, public FBE::simple::Sender
 {
 public:
-    using TCPServer::TCPServer;
+    ProtoServer(const std::shared_ptr<Service>& service, int port, bool view, size_t batch)
+        : TCPServer(service, port),
+          _view(view),
+          _batch(batch)
+    {
+    }
 
 protected:
     std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override
     {
-        return std::make_shared<ProtoSession>(server);
+        if (_view)
+            return std::make_shared<ProtoViewSession>(server, _batch);
+        else
+            return std::make_shared<ProtoSession>(server, _batch);
     }
 
 protected:
@@ -63,6 +112,10 @@ protected:
 protected:
     // Protocol implementation
     size_t onSend(const void* data, size_t size) override { Multicast(data, size); return size; }
+
+private:
+    bool _view;
+    size_t _batch;
 };
 
 int main(int argc, char** argv)
@@ -71,6 +124,8 @@ int main(int argc, char** argv)
 
     parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(4444).help("Server port. Default: %default");
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-v", "--view").dest("view").action("store_true").help("Dispatch read-only view models over received bytes instead of deserialized messages");
+    parser.add_option("-b", "--batch").dest("batch").action("store").type("int").set_default(0).help("Batch responses up to the given size and flush them once per receive (0 to disable). Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -84,9 +139,13 @@ int main(int argc, char** argv)
     // Server port
     int port = options.get("port");
     int threads = options.get("threads");
+    bool view = options.get("view");
+    int batch = options.get("batch");
 
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
+    std::cout << "Message dispatch: " << (view ? "view" : "deserialize") << std::endl;
+    std::cout << "Response batch: " << batch << std::endl;
 
     std::cout << std::endl;
 
@@ -99,7 +158,7 @@ int main(int argc, char** argv)
     std::cout << "Done!" << std::endl;
 
     // Create a new protocol server
-    auto server = std::make_shared<ProtoServer>(service, port);
+    auto server = std::make_shared<ProtoServer>(service, port, view, (size_t)batch);
     // server->SetupNoDelay(true);
     server->SetupReuseAddress(true);
     server->SetupReusePort(true);
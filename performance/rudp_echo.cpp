@@ -0,0 +1,374 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "server/asio/rudp_client.h"
+#include "server/asio/rudp_server.h"
+#include "server/asio/service.h"
+#include "server/asio/tcp_client.h"
+#include "server/asio/tcp_server.h"
+
+#include "benchmark/reporter_console.h"
+#include "threads/thread.h"
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <OptionParser.h>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+int loss_permille = 0;
+bool unordered = false;
+size_t message_size = 32;
+size_t window_size = 64;
+
+std::atomic<uint64_t> total_dropped(0);
+std::atomic<uint64_t> total_messages(0);
+std::atomic<uint64_t> total_latency(0);
+std::atomic<uint64_t> max_latency(0);
+
+uint64_t total_retransmitted = 0;
+uint64_t total_fast_retransmits = 0;
+uint64_t total_probes = 0;
+uint64_t total_timeouts = 0;
+
+// Drop the datagram with the configured loss probability
+bool Drop()
+{
+    thread_local std::mt19937 random(std::random_device{}());
+    if ((loss_permille > 0) && ((int)(random() % 1000) < loss_permille))
+    {
+        ++total_dropped;
+        return true;
+    }
+    return false;
+}
+
+// Prepare the message with the current timestamp
+void PrepareMessage(std::vector<uint8_t>& message)
+{
+    uint64_t timestamp = Timestamp::nano();
+    std::memcpy(message.data(), &timestamp, sizeof(timestamp));
+}
+
+// Update the round-trip latency of the echoed message
+void UpdateLatency(const void* buffer)
+{
+    uint64_t timestamp;
+    std::memcpy(&timestamp, buffer, sizeof(timestamp));
+    uint64_t latency = Timestamp::nano() - timestamp;
+
+    ++total_messages;
+    total_latency += latency;
+    uint64_t current = max_latency;
+    while ((latency > current) && !max_latency.compare_exchange_weak(current, latency));
+}
+
+class RUDPEchoSession : public RUDPSession
+{
+public:
+    using RUDPSession::RUDPSession;
+
+protected:
+    void onReceivedMessage(const void* buffer, size_t size) override
+    {
+        // Resend the message back to the client
+        SendReliableAsync(buffer, size, !unordered);
+    }
+};
+
+class RUDPEchoServer : public RUDPServer
+{
+public:
+    using RUDPServer::RUDPServer;
+
+    bool SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        return Drop() ? true : RUDPServer::SendAsync(endpoint, buffer, size);
+    }
+
+protected:
+    std::shared_ptr<RUDPSession> CreateSession(const std::shared_ptr<RUDPServer>& server, const asio::ip::udp::endpoint& endpoint) override
+    {
+        return std::make_shared<RUDPEchoSession>(server, endpoint);
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Reliable UDP server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+class RUDPEchoClient : public RUDPClient
+{
+public:
+    RUDPEchoClient(const std::shared_ptr<Service>& service, const std::string& address, int port)
+        : RUDPClient(service, address, port),
+          _message(message_size, 0)
+    {
+    }
+
+    bool SendAsync(const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        return Drop() ? true : RUDPClient::SendAsync(buffer, size);
+    }
+
+protected:
+    void onConnected() override
+    {
+        RUDPClient::onConnected();
+
+        // Fill the window of messages in flight
+        for (size_t i = 0; i < window_size; ++i)
+            SendMessage();
+    }
+
+    void onDisconnected() override
+    {
+        // Collect the channel statistic before it is reset
+        total_retransmitted = channel().packets_retransmitted();
+        total_fast_retransmits = channel().fast_retransmits();
+        total_probes = channel().probes();
+        total_timeouts = channel().timeouts();
+
+        RUDPClient::onDisconnected();
+    }
+
+    void onReceivedMessage(const void* buffer, size_t size) override
+    {
+        UpdateLatency(buffer);
+        SendMessage();
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Reliable UDP client caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+
+private:
+    std::vector<uint8_t> _message;
+
+    void SendMessage()
+    {
+        PrepareMessage(_message);
+        SendReliableAsync(_message.data(), _message.size(), !unordered);
+    }
+};
+
+class TCPEchoSession : public TCPSession
+{
+public:
+    using TCPSession::TCPSession;
+
+protected:
+    void onReceived(const void* buffer, size_t size) override
+    {
+        // Resend the message back to the client
+        SendAsync(buffer, size);
+    }
+};
+
+class TCPEchoServer : public TCPServer
+{
+public:
+    using TCPServer::TCPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override
+    {
+        return std::make_shared<TCPEchoSession>(server);
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "TCP server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+class TCPEchoClient : public TCPClient
+{
+public:
+    TCPEchoClient(const std::shared_ptr<Service>& service, const std::string& address, int port)
+        : TCPClient(service, address, port),
+          _message(message_size, 0)
+    {
+    }
+
+protected:
+    void onConnected() override
+    {
+        // Fill the window of messages in flight
+        for (size_t i = 0; i < window_size; ++i)
+            SendMessage();
+    }
+
+    void onReceived(const void* buffer, size_t size) override
+    {
+        // Split the received stream into echoed messages
+        const uint8_t* data = (const uint8_t*)buffer;
+        while (size > 0)
+        {
+            size_t chunk = std::min(size, message_size - _received.size());
+            _received.insert(_received.end(), data, data + chunk);
+            data += chunk;
+            size -= chunk;
+
+            if (_received.size() == message_size)
+            {
+                UpdateLatency(_received.data());
+                _received.clear();
+                SendMessage();
+            }
+        }
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "TCP client caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+
+private:
+    std::vector<uint8_t> _message;
+    std::vector<uint8_t> _received;
+
+    void SendMessage()
+    {
+        PrepareMessage(_message);
+        SendAsync(_message.data(), _message.size());
+    }
+};
+
+void Report(const std::string& name, uint64_t duration)
+{
+    std::cout << name << " messages: " << total_messages << std::endl;
+    std::cout << name << " message throughput: " << total_messages * 1000000000 / duration << " msg/s" << std::endl;
+    if (total_messages > 0)
+        std::cout << name << " round-trip latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(total_latency / total_messages) << std::endl;
+    std::cout << name << " round-trip latency max: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(max_latency) << std::endl;
+
+    total_messages = 0;
+    total_latency = 0;
+    max_latency = 0;
+}
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(4444).help("Server port. Default: %default");
+    parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(2).help("Count of working threads. Default: %default");
+    parser.add_option("-w", "--window").dest("window").action("store").type("int").set_default(64).help("Count of messages in flight. Default: %default");
+    parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-l", "--loss").dest("loss").action("store").type("float").set_default(1.0).help("Injected reliable UDP datagram loss in percents (use netem on loopback to inject loss for TCP). Default: %default");
+    parser.add_option("-u", "--unordered").dest("unordered").action("store_true").help("Send unordered reliable UDP messages");
+    parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking each protocol. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    // Benchmark parameters
+    int port = options.get("port");
+    int threads_count = options.get("threads");
+    int seconds_count = options.get("seconds");
+    double loss = options.get("loss");
+    loss_permille = (int)(loss * 10);
+    unordered = options.get("unordered");
+    message_size = std::max((size_t)(int)options.get("size"), sizeof(uint64_t));
+    window_size = std::min((size_t)(int)options.get("window"), RUDPChannel::WINDOW_SIZE);
+
+    std::cout << "Server port: " << port << std::endl;
+    std::cout << "Working threads: " << threads_count << std::endl;
+    std::cout << "Messages in flight: " << window_size << std::endl;
+    std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Reliable UDP loss: " << loss << "%" << std::endl;
+    std::cout << "Reliable UDP delivery: " << (unordered ? "unordered" : "ordered") << std::endl;
+    std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+
+    std::cout << std::endl;
+
+    // Create and start a new Asio service
+    auto service = std::make_shared<Service>(threads_count);
+    service->Start();
+
+    // Benchmark reliable UDP
+    {
+        auto server = std::make_shared<RUDPEchoServer>(service, port);
+        server->Start();
+        while (!server->IsStarted())
+            Thread::Yield();
+
+        auto client = std::make_shared<RUDPEchoClient>(service, "127.0.0.1", port);
+
+        std::cout << "Reliable UDP benchmarking...";
+        uint64_t timestamp_start = Timestamp::nano();
+        client->ConnectAsync();
+        Thread::Sleep(seconds_count * 1000);
+        client->DisconnectAsync();
+        uint64_t timestamp_stop = Timestamp::nano();
+        std::cout << "Done!" << std::endl;
+
+        while (client->IsConnected())
+            Thread::Yield();
+        server->Stop();
+        while (server->IsStarted())
+            Thread::Yield();
+
+        std::cout << std::endl;
+        Report("Reliable UDP", timestamp_stop - timestamp_start);
+        std::cout << "Reliable UDP datagrams dropped: " << total_dropped << std::endl;
+        std::cout << "Reliable UDP client retransmits: " << total_retransmitted << std::endl;
+        std::cout << "Reliable UDP client fast retransmits: " << total_fast_retransmits << std::endl;
+        std::cout << "Reliable UDP client tail loss probes: " << total_probes << std::endl;
+        std::cout << "Reliable UDP client timeouts: " << total_timeouts << std::endl;
+        std::cout << std::endl;
+    }
+
+    // Benchmark TCP
+    {
+        auto server = std::make_shared<TCPEchoServer>(service, port);
+        server->SetupNoDelay(true);
+        server->Start();
+        while (!server->IsStarted())
+            Thread::Yield();
+
+        auto client = std::make_shared<TCPEchoClient>(service, "127.0.0.1", port);
+        client->SetupNoDelay(true);
+
+        std::cout << "TCP benchmarking...";
+        uint64_t timestamp_start = Timestamp::nano();
+        client->ConnectAsync();
+        Thread::Sleep(seconds_count * 1000);
+        client->DisconnectAsync();
+        uint64_t timestamp_stop = Timestamp::nano();
+        std::cout << "Done!" << std::endl;
+
+        while (client->IsConnected())
+            Thread::Yield();
+        server->Stop();
+        while (server->IsStarted())
+            Thread::Yield();
+
+        std::cout << std::endl;
+        Report("TCP", timestamp_stop - timestamp_start);
+    }
+
+    // Stop the Asio service
+    service->Stop();
+
+    return 0;
+}
@@ -27,6 +27,10 @@ std::atomic<uint64_t> timestamp_stop(Timestamp::nano());
 std::atomic<uint64_t> total_errors(0);
 std::atomic<uint64_t> total_bytes(0);
 std::atomic<uint64_t> total_messages(0);
+std::atomic<uint64_t> total_handshakes(0);
+
+std::atomic<bool> handshakes_mode(false);
+std::atomic<bool> benchmarking(true);
 
 class EchoClient : public SSLClient
 {
@@ -42,10 +46,25 @@ public:
 protected:
     void onHandshaked() override
     {
+        // Reconnect immediately to measure handshakes throughput
+        if (handshakes_mode)
+        {
+            timestamp_stop = Timestamp::nano();
+            ++total_handshakes;
+            DisconnectAsync();
+            return;
+        }
+
         for (size_t i = _messages; i > 0; --i)
             SendMessage();
     }
 
+    void onDisconnected() override
+    {
+        if (handshakes_mode && benchmarking)
+            ConnectAsync();
+    }
+
     void onSent(size_t sent, size_t pending) override
     {
         _sent += sent;
@@ -86,6 +105,8 @@ int main(int argc, char** argv)
     parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000).help("Count of messages to send at the same time. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-k", "--handshakes").dest("handshakes").action("store_true").help("Benchmark handshakes by reconnecting clients");
+    parser.add_option("-r", "--resumption").dest("resumption").action("store_true").help("Enable TLS session resumption");
     parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -105,6 +126,8 @@ int main(int argc, char** argv)
     int messages_count = options.get("messages");
     int message_size = options.get("size");
     int seconds_count = options.get("seconds");
+    bool handshakes = options.get("handshakes");
+    bool resumption = options.get("resumption");
 
     std::cout << "Server address: " << address << std::endl;
     std::cout << "Server port: " << port << std::endl;
@@ -113,11 +136,14 @@ int main(int argc, char** argv)
     std::cout << "Working messages: " << messages_count << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
     std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+    std::cout << "Handshakes mode: " << (handshakes ? "enabled" : "disabled") << std::endl;
+    std::cout << "Session resumption: " << (resumption ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
     // Prepare a message to send
     message_to_send.resize(message_size, 0);
+    handshakes_mode = handshakes;
 
     // Create a new Asio service
     auto service = std::make_shared<Service>(threads_count);
@@ -133,6 +159,8 @@ int main(int argc, char** argv)
     context->set_root_certs();
     context->set_verify_mode(asio::ssl::verify_peer | asio::ssl::verify_fail_if_no_peer_cert);
     context->load_verify_file("../tools/certificates/ca.pem");
+    if (resumption)
+        context->set_session_reuse(true);
 
     // Create echo clients
     std::vector<std::shared_ptr<EchoClient>> clients;
@@ -151,16 +179,22 @@ int main(int argc, char** argv)
     for (auto& client : clients)
         client->ConnectAsync();
     std::cout << "Done!" << std::endl;
-    for (const auto& client : clients)
-        while (!client->IsHandshaked())
-            Thread::Yield();
-    std::cout << "All clients connected!" << std::endl;
+    if (!handshakes)
+    {
+        for (const auto& client : clients)
+            while (!client->IsHandshaked())
+                Thread::Yield();
+        std::cout << "All clients connected!" << std::endl;
+    }
 
     // Wait for benchmarking
     std::cout << "Benchmarking...";
     Thread::Sleep(seconds_count * 1000);
     std::cout << "Done!" << std::endl;
 
+    // Stop reconnecting clients
+    benchmarking = false;
+
     // Disconnect clients
     std::cout << "Clients disconnecting...";
     for (auto& client : clients)
@@ -182,6 +216,20 @@ int main(int argc, char** argv)
 
     std::cout << std::endl;
 
+    if (handshakes)
+    {
+        std::cout << "Total time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+        std::cout << "Total handshakes: " << total_handshakes << std::endl;
+        std::cout << "Resumed handshakes: " << context->handshakes_resumed() << std::endl;
+        std::cout << "Resumption rate: " << (int)(context->resumption_rate() * 100) << "%" << std::endl;
+        if (total_handshakes > 0)
+        {
+            std::cout << "Handshake latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / total_handshakes) << std::endl;
+            std::cout << "Handshake throughput: " << total_handshakes * 1000000000 / (timestamp_stop - timestamp_start) << " handshakes/s" << std::endl;
+        }
+        return 0;
+    }
+
     total_messages = total_bytes / message_size;
 
     std::cout << "Total time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
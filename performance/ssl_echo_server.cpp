@@ -4,8 +4,11 @@
 
 #include "server/asio/service.h"
 #include "server/asio/ssl_server.h"
+
+#include "benchmark/reporter_console.h"
 #include "system/cpu.h"
 
+#include <atomic>
 #include <iostream>
 
 #include <OptionParser.h>
@@ -13,12 +16,20 @@
 using namespace CppCommon;
 using namespace CppServer::Asio;
 
+std::atomic<uint64_t> ktls_sessions(0);
+
 class EchoSession : public SSLSession
 {
 public:
     using SSLSession::SSLSession;
 
 protected:
+    void onHandshaked() override
+    {
+        if (IsKTLSSend() && IsKTLSReceive())
+            ++ktls_sessions;
+    }
+
     void onReceived(const void* buffer, size_t size) override
     {
         // Resend the message back to the client
@@ -54,7 +65,10 @@ int main(int argc, char** argv)
     auto parser = optparse::OptionParser().version("1.0.0.0");
 
     parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(2222).help("Server port. Default: %default");
+    parser.add_option("-x", "--ktls").dest("ktls").action("store_true").help("Offload sessions to kernel TLS");
+    parser.add_option("-r", "--no-resumption").dest("no_resumption").action("store_true").help("Disable TLS session resumption");
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-k", "--handshake-threads").dest("handshake_threads").action("store").type("int").set_default(0).help("Count of dedicated handshake threads (0 to perform handshakes in working threads). Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -68,9 +82,15 @@ int main(int argc, char** argv)
     // Server port
     int port = options.get("port");
     int threads = options.get("threads");
+    int handshake_threads = options.get("handshake_threads");
+    bool resumption = !(bool)options.get("no_resumption");
+    bool ktls = options.get("ktls");
 
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
+    std::cout << "Handshake threads: " << handshake_threads << std::endl;
+    std::cout << "Session resumption: " << (resumption ? "enabled" : "disabled") << std::endl;
+    std::cout << "Kernel TLS: " << (ktls ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
@@ -82,18 +102,40 @@ int main(int argc, char** argv)
     service->Start();
     std::cout << "Done!" << std::endl;
 
+    // Create and start a new Asio service for handshakes
+    std::shared_ptr<Service> handshake_service;
+    if (handshake_threads > 0)
+    {
+        handshake_service = std::make_shared<Service>(handshake_threads);
+        std::cout << "Asio handshake service starting...";
+        handshake_service->Start();
+        std::cout << "Done!" << std::endl;
+    }
+
     // Create and prepare a new SSL server context
     auto context = std::make_shared<SSLContext>(asio::ssl::context::tlsv13);
     context->set_password_callback([](size_t max_length, asio::ssl::context::password_purpose purpose) -> std::string { return "qwerty"; });
     context->use_certificate_chain_file("../tools/certificates/server.pem");
     context->use_private_key_file("../tools/certificates/server.pem", asio::ssl::context::pem);
     context->use_tmp_dh_file("../tools/certificates/dh4096.pem");
+    if (resumption)
+    {
+        context->set_session_cache();
+        context->set_session_tickets(true);
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(context->native_handle(), SSL_SESS_CACHE_OFF);
+        context->set_session_tickets(false);
+    }
 
     // Create a new echo server
     auto server = std::make_shared<EchoServer>(service, context, port);
     // server->SetupNoDelay(true);
     server->SetupReuseAddress(true);
     server->SetupReusePort(true);
+    server->SetupHandshakeService(handshake_service);
+    server->SetupKTLS(ktls);
 
     // Start the server
     std::cout << "Server starting...";
@@ -124,10 +166,28 @@ int main(int argc, char** argv)
     server->Stop();
     std::cout << "Done!" << std::endl;
 
+    // Stop the Asio handshake service
+    if (handshake_service)
+    {
+        std::cout << "Asio handshake service stopping...";
+        handshake_service->Stop();
+        std::cout << "Done!" << std::endl;
+    }
+
     // Stop the Asio service
     std::cout << "Asio service stopping...";
     service->Stop();
     std::cout << "Done!" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Handshakes: " << server->handshakes_finished() << std::endl;
+    std::cout << "Resumed handshakes: " << context->handshakes_resumed() << std::endl;
+    std::cout << "Handshake latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(server->handshake_latency().total()) << std::endl;
+    std::cout << "Handshake latency max: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(server->handshake_latency_max().total()) << std::endl;
+    std::cout << "Handshakes in flight max: " << server->handshakes_in_flight_max() << std::endl;
+    std::cout << "Kernel TLS sessions: " << ktls_sessions << std::endl;
+    std::cout << "Data received: " << CppBenchmark::ReporterConsole::GenerateDataSize(server->bytes_received()) << std::endl;
+
     return 0;
 }
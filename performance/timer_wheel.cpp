@@ -0,0 +1,134 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "benchmark/cppbenchmark.h"
+
+#include "server/asio/timer_wheel.h"
+#include "time/timestamp.h"
+
+#include <memory>
+#include <vector>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+const auto settings = CppBenchmark::Settings().Param(1000).Param(10000).Param(100000).Param(1000000);
+
+class AsioTimerFixture : public virtual CppBenchmark::Fixture
+{
+protected:
+    std::shared_ptr<asio::io_context> io_service;
+    std::vector<std::unique_ptr<asio::steady_timer>> timers;
+
+    void Initialize(CppBenchmark::Context& context) override
+    {
+        io_service = std::make_shared<asio::io_context>();
+        for (int64_t i = 0; i < context.x(); ++i)
+            timers.emplace_back(std::make_unique<asio::steady_timer>(*io_service));
+    }
+
+    void Cleanup(CppBenchmark::Context& context) override
+    {
+        timers.clear();
+        io_service.reset();
+    }
+};
+
+class TimerWheelFixture : public virtual CppBenchmark::Fixture
+{
+protected:
+    std::shared_ptr<asio::io_context> io_service;
+    std::shared_ptr<TimerWheel> wheel;
+    std::vector<std::unique_ptr<TimerWheel::Handle>> handles;
+    size_t fired;
+
+    void Initialize(CppBenchmark::Context& context) override
+    {
+        io_service = std::make_shared<asio::io_context>();
+        wheel = std::make_shared<TimerWheel>(io_service);
+        fired = 0;
+        for (int64_t i = 0; i < context.x(); ++i)
+            handles.emplace_back(std::make_unique<TimerWheel::Handle>([this]() { ++fired; }));
+    }
+
+    void Cleanup(CppBenchmark::Context& context) override
+    {
+        handles.clear();
+        wheel.reset();
+        io_service.reset();
+    }
+};
+
+BENCHMARK_FIXTURE(AsioTimerFixture, "Asio timer arm/cancel", settings)
+{
+    for (size_t i = 0; i < timers.size(); ++i)
+    {
+        timers[i]->expires_after(std::chrono::seconds(30 + (i % 300)));
+        timers[i]->async_wait([](const std::error_code& ec) {});
+    }
+    for (auto& timer : timers)
+        timer->cancel();
+
+    // Dispatch all aborted handlers
+    io_service->restart();
+    io_service->poll();
+
+    context.metrics().AddItems(timers.size());
+}
+
+BENCHMARK_FIXTURE(AsioTimerFixture, "Asio timer re-arm", settings)
+{
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < timers.size(); ++i)
+        {
+            timers[i]->expires_after(std::chrono::seconds(30 + ((i + pass) % 300)));
+            timers[i]->async_wait([](const std::error_code& ec) {});
+        }
+    }
+    for (auto& timer : timers)
+        timer->cancel();
+
+    // Dispatch all aborted handlers
+    io_service->restart();
+    io_service->poll();
+
+    context.metrics().AddItems(timers.size());
+}
+
+BENCHMARK_FIXTURE(TimerWheelFixture, "Timer wheel arm/cancel", settings)
+{
+    for (size_t i = 0; i < handles.size(); ++i)
+        wheel->Schedule(*handles[i], Timespan::seconds(30 + (i % 300)));
+    for (auto& handle : handles)
+        wheel->Cancel(*handle);
+
+    context.metrics().AddItems(handles.size());
+}
+
+BENCHMARK_FIXTURE(TimerWheelFixture, "Timer wheel re-arm", settings)
+{
+    for (int pass = 0; pass < 2; ++pass)
+        for (size_t i = 0; i < handles.size(); ++i)
+            wheel->Schedule(*handles[i], Timespan::seconds(30 + ((i + pass) % 300)));
+    for (auto& handle : handles)
+        wheel->Cancel(*handle);
+
+    context.metrics().AddItems(handles.size());
+}
+
+BENCHMARK_FIXTURE(TimerWheelFixture, "Timer wheel fire", settings)
+{
+    uint64_t timestamp = Timestamp::nano();
+    for (size_t i = 0; i < handles.size(); ++i)
+        wheel->Schedule(*handles[i], Timespan::seconds(1 + (i % 300)));
+
+    // Drive the timer wheel manually over all planned timeouts
+    fired = 0;
+    wheel->Expire(timestamp + Timespan::seconds(302).total());
+
+    context.metrics().AddItems(fired);
+}
+
+BENCHMARK_MAIN()
@@ -20,6 +20,7 @@ using namespace CppCommon;
 using namespace CppServer::Asio;
 
 std::vector<uint8_t> message_to_send;
+bool message_queue = false;
 
 std::atomic<uint64_t> timestamp_start(Timestamp::nano());
 std::atomic<uint64_t> timestamp_stop(Timestamp::nano());
@@ -37,7 +38,13 @@ public:
     {
     }
 
-    void SendMessage() { Send(message_to_send.data(), message_to_send.size()); }
+    void SendMessage()
+    {
+        if (message_queue)
+            SendAsync(message_to_send.data(), message_to_send.size());
+        else
+            Send(message_to_send.data(), message_to_send.size());
+    }
 
 protected:
     void onConnected() override
@@ -81,6 +88,7 @@ int main(int argc, char** argv)
     parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000).help("Count of messages to send at the same time. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-q", "--queue").dest("queue").action("store_true").help("Send messages through the asynchronous send queue");
     parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -100,6 +108,7 @@ int main(int argc, char** argv)
     int messages_count = options.get("messages");
     int message_size = options.get("size");
     int seconds_count = options.get("seconds");
+    message_queue = options.get("queue");
 
     std::cout << "Server address: " << address << std::endl;
     std::cout << "Server port: " << port << std::endl;
@@ -108,6 +117,7 @@ int main(int argc, char** argv)
     std::cout << "Working messages: " << messages_count << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
     std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+    std::cout << "Send queue: " << (message_queue ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
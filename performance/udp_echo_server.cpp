@@ -3,9 +3,14 @@
 //
 
 #include "server/asio/service.h"
-#include "server/asio/udp_server.h"
+#include "server/asio/udp_sharded_server.h"
+
+#include "benchmark/reporter_console.h"
 #include "system/cpu.h"
+#include "time/timestamp.h"
 
+#include <array>
+#include <atomic>
 #include <iostream>
 
 #include <OptionParser.h>
@@ -13,10 +18,36 @@
 using namespace CppCommon;
 using namespace CppServer::Asio;
 
+std::atomic<uint64_t> total_dropped(0);
+std::atomic<uint64_t> total_pending_max(0);
+
+// Socket queue wait histogram with power of two microseconds buckets
+std::array<std::atomic<uint64_t>, 32> queue_wait_histogram{};
+
+void UpdateQueueWait(uint64_t timestamp)
+{
+    if (timestamp == 0)
+        return;
+
+    uint64_t now = Timestamp::utc();
+    uint64_t wait = (now > timestamp) ? ((now - timestamp) / 1000) : 0;
+    size_t bucket = 0;
+    while ((wait > 0) && (bucket < (queue_wait_histogram.size() - 1)))
+    {
+        wait >>= 1;
+        ++bucket;
+    }
+    ++queue_wait_histogram[bucket];
+}
+
 class EchoServer : public UDPServer
 {
 public:
-    using UDPServer::UDPServer;
+    EchoServer(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint, bool pipeline)
+        : UDPServer(service, endpoint),
+          _pipeline(pipeline)
+    {
+    }
 
 protected:
     void onStarted() override
@@ -34,8 +65,20 @@ protected:
             return;
         }
 
+        // Update the socket queue wait histogram
+        UpdateQueueWait(receive_timestamp());
+
         // Resend the message back to the client
-        SendAsync(endpoint, buffer, size);
+        if (!SendAsync(endpoint, buffer, size))
+            ++total_dropped;
+
+        // Update the maximal send queue depth
+        if (datagrams_pending() > total_pending_max)
+            total_pending_max = datagrams_pending();
+
+        // Continue receive datagrams without waiting for the sent reply
+        if (_pipeline)
+            ReceiveAsync();
     }
 
     void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override
@@ -48,6 +91,38 @@ protected:
     {
         std::cout << "UDP server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
     }
+
+private:
+    bool _pipeline;
+};
+
+class EchoShardedServer : public UDPShardedServer
+{
+public:
+    EchoShardedServer(const std::shared_ptr<Service>& service, int port, size_t shards, bool pipeline, size_t queue_limit, size_t batch, bool queue_wait)
+        : UDPShardedServer(service, port, InternetProtocol::IPv4, shards),
+          _pipeline(pipeline),
+          _queue_limit(queue_limit),
+          _batch(batch),
+          _queue_wait(queue_wait)
+    {
+    }
+
+protected:
+    std::shared_ptr<UDPServer> CreateShard(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint) override
+    {
+        auto shard = std::make_shared<EchoServer>(service, endpoint, _pipeline);
+        shard->SetupSendQueueLimit(_queue_limit);
+        shard->SetupReceiveBatch(_batch);
+        shard->SetupReceiveTimestamp(_queue_wait);
+        return shard;
+    }
+
+private:
+    bool _pipeline;
+    size_t _queue_limit;
+    size_t _batch;
+    bool _queue_wait;
 };
 
 int main(int argc, char** argv)
@@ -56,6 +131,11 @@ int main(int argc, char** argv)
 
     parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(3333).help("Server port. Default: %default");
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-q", "--pipeline").dest("pipeline").action("store_true").help("Continue receiving while replies are queued for sending");
+    parser.add_option("-b", "--batch").dest("batch").action("store").type("int").set_default(0).help("Count of datagrams to receive per wakeup with recvmmsg() (0 to receive datagrams one by one). Default: %default");
+    parser.add_option("-l", "--queue-limit").dest("queue_limit").action("store").type("int").set_default(0).help("Send queue limit in datagrams (0 for unlimited). Default: %default");
+    parser.add_option("-w", "--queue-wait").dest("queue_wait").action("store_true").help("Measure the socket queue wait of datagrams with kernel receive timestamps");
+    parser.add_option("-s", "--shards").dest("shards").action("store").type("int").set_default(0).help("Count of SO_REUSEPORT server shards (0 to serve the port with a single socket). Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -69,9 +149,19 @@ int main(int argc, char** argv)
     // Server port
     int port = options.get("port");
     int threads = options.get("threads");
+    bool pipeline = options.get("pipeline");
+    int queue_limit = options.get("queue_limit");
+    int batch = options.get("batch");
+    int shards = options.get("shards");
+    bool queue_wait = options.get("queue_wait");
 
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
+    std::cout << "Pipeline: " << (pipeline ? "enabled" : "disabled") << std::endl;
+    std::cout << "Send queue limit: " << queue_limit << std::endl;
+    std::cout << "Receive batch: " << batch << std::endl;
+    std::cout << "Server shards: " << shards << std::endl;
+    std::cout << "Queue wait: " << (queue_wait ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
@@ -84,13 +174,29 @@ int main(int argc, char** argv)
     std::cout << "Done!" << std::endl;
 
     // Create a new echo server
-    auto server = std::make_shared<EchoServer>(service, port);
-    server->SetupReuseAddress(true);
-    server->SetupReusePort(true);
+    std::shared_ptr<EchoServer> server;
+    std::shared_ptr<EchoShardedServer> sharded_server;
+    if (shards > 0)
+    {
+        sharded_server = std::make_shared<EchoShardedServer>(service, port, shards, pipeline, queue_limit, batch, queue_wait);
+        sharded_server->SetupReuseAddress(true);
+    }
+    else
+    {
+        server = std::make_shared<EchoServer>(service, asio::ip::udp::endpoint(asio::ip::udp::v4(), (unsigned short)port), pipeline);
+        server->SetupReuseAddress(true);
+        server->SetupReusePort(true);
+        server->SetupSendQueueLimit(queue_limit);
+        server->SetupReceiveBatch(batch);
+        server->SetupReceiveTimestamp(queue_wait);
+    }
 
     // Start the server
     std::cout << "Server starting...";
-    server->Start();
+    if (sharded_server)
+        sharded_server->Start();
+    else
+        server->Start();
     std::cout << "Done!" << std::endl;
 
     std::cout << "Press Enter to stop the server or '!' to restart the server..." << std::endl;
@@ -106,7 +212,10 @@ int main(int argc, char** argv)
         if (line == "!")
         {
             std::cout << "Server restarting...";
-            server->Restart();
+            if (sharded_server)
+                sharded_server->Restart();
+            else
+                server->Restart();
             std::cout << "Done!" << std::endl;
             continue;
         }
@@ -114,7 +223,10 @@ int main(int argc, char** argv)
 
     // Stop the server
     std::cout << "Server stopping...";
-    server->Stop();
+    if (sharded_server)
+        sharded_server->Stop();
+    else
+        server->Stop();
     std::cout << "Done!" << std::endl;
 
     // Stop the Asio service
@@ -122,5 +234,23 @@ int main(int argc, char** argv)
     service->Stop();
     std::cout << "Done!" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Datagrams received: " << (sharded_server ? sharded_server->datagrams_received() : server->datagrams_received()) << std::endl;
+    std::cout << "Datagrams sent: " << (sharded_server ? sharded_server->datagrams_sent() : server->datagrams_sent()) << std::endl;
+    std::cout << "Datagrams dropped: " << total_dropped << std::endl;
+    std::cout << "Send queue depth max: " << total_pending_max << std::endl;
+    std::cout << "Data sent: " << CppBenchmark::ReporterConsole::GenerateDataSize(sharded_server ? sharded_server->bytes_sent() : server->bytes_sent()) << std::endl;
+
+    // Print the socket queue wait histogram
+    if (queue_wait)
+    {
+        std::cout << std::endl;
+        std::cout << "Socket queue wait:" << std::endl;
+        for (size_t i = 0; i < queue_wait_histogram.size(); ++i)
+            if (queue_wait_histogram[i] > 0)
+                std::cout << "< " << CppBenchmark::ReporterConsole::GenerateTimePeriod((1ull << i) * 1000) << ": " << queue_wait_histogram[i] << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,267 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "server/asio/service.h"
+#include "server/asio/udp_multicast_publisher.h"
+#include "server/asio/udp_multicast_subscriber.h"
+
+#include "benchmark/reporter_console.h"
+#include "system/cpu.h"
+#include "threads/thread.h"
+#include "time/timestamp.h"
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <OptionParser.h>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+std::atomic<uint64_t> total_dropped(0);
+
+class MulticastSubscriber : public UDPMulticastSubscriber
+{
+public:
+    MulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, const std::string& multicast, int port, int loss)
+        : UDPMulticastSubscriber(service, address, port),
+          _multicast(multicast),
+          _loss(loss),
+          _random(std::random_device{}())
+    {
+    }
+
+protected:
+    void onConnected() override
+    {
+        UDPMulticastSubscriber::onConnected();
+
+        // Join UDP multicast group
+        JoinMulticastGroup(_multicast);
+    }
+
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        if ((_loss > 0) && ((int)(_random() % 1000) < _loss))
+        {
+            ++total_dropped;
+            ReceiveAsync();
+            return;
+        }
+
+        UDPMulticastSubscriber::onReceived(endpoint, buffer, size);
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "UDP multicast subscriber caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+
+private:
+    std::string _multicast;
+    int _loss;
+    std::mt19937 _random;
+};
+
+class MulticastPublisher : public UDPMulticastPublisher
+{
+public:
+    using UDPMulticastPublisher::UDPMulticastPublisher;
+
+protected:
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "UDP multicast publisher caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-a", "--address").dest("address").set_default("239.255.0.1").help("Multicast address. Default: %default");
+    parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(3333).help("Multicast port. Default: %default");
+    parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(1).help("Count of multicast subscribers. Default: %default");
+    parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(100000).help("Rate of messages per second to publish. Default: %default");
+    parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-l", "--loss").dest("loss").action("store").type("float").set_default(1.0).help("Injected datagram loss of each subscriber in percents. Default: %default");
+    parser.add_option("-y", "--history").dest("history").action("store").type("int").set_default(65536).help("Publisher history size in packets. Default: %default");
+    parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    // Benchmark parameters
+    std::string address(options.get("address"));
+    int port = options.get("port");
+    int threads_count = options.get("threads");
+    int clients_count = options.get("clients");
+    int messages_rate = options.get("messages");
+    int message_size = options.get("size");
+    double loss = options.get("loss");
+    int history = options.get("history");
+    int seconds_count = options.get("seconds");
+
+    std::cout << "Multicast address: " << address << std::endl;
+    std::cout << "Multicast port: " << port << std::endl;
+    std::cout << "Working threads: " << threads_count << std::endl;
+    std::cout << "Working clients: " << clients_count << std::endl;
+    std::cout << "Messages rate: " << messages_rate << std::endl;
+    std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Datagram loss: " << loss << "%" << std::endl;
+    std::cout << "History size: " << history << std::endl;
+    std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+
+    std::cout << std::endl;
+
+    // Create a new Asio service
+    auto service = std::make_shared<Service>(threads_count);
+
+    // Start the Asio service
+    std::cout << "Asio service starting...";
+    service->Start();
+    std::cout << "Done!" << std::endl;
+
+    // Create a new multicast publisher
+    auto publisher = std::make_shared<MulticastPublisher>(service, 0);
+    publisher->SetupHistorySize(history);
+    // Subscribers of the same host share the multicast port, so retransmit to all of them
+    publisher->SetupMulticastRetransmit(clients_count > 1);
+
+    // Start the publisher
+    std::cout << "Publisher starting...";
+    publisher->Start(address, port);
+    while (!publisher->IsStarted())
+        Thread::Yield();
+    std::cout << "Done!" << std::endl;
+
+    // Create multicast subscribers
+    std::vector<std::shared_ptr<MulticastSubscriber>> subscribers;
+    for (int i = 0; i < clients_count; ++i)
+    {
+        auto subscriber = std::make_shared<MulticastSubscriber>(service, "0.0.0.0", address, port, (int)(loss * 10));
+        subscriber->SetupMulticast(true);
+        subscribers.emplace_back(subscriber);
+    }
+
+    // Connect subscribers
+    std::cout << "Subscribers connecting...";
+    for (auto& subscriber : subscribers)
+        subscriber->ConnectAsync();
+    for (auto& subscriber : subscribers)
+        while (!subscriber->IsConnected())
+            Thread::Yield();
+    std::cout << "Done!" << std::endl;
+
+    // Wait for subscribers synchronized with publisher heartbeats
+    Thread::Sleep(2 * publisher->option_heartbeat_interval().milliseconds());
+
+    std::cout << "Benchmarking...";
+
+    // Start the publishing thread
+    std::atomic<bool> publishing(true);
+    auto publisher_thread = std::thread([&publisher, &publishing, messages_rate, message_size]()
+    {
+        // Prepare message to publish
+        std::vector<uint8_t> message_to_publish(message_size);
+
+        // Publishing loop
+        while (publishing)
+        {
+            auto start = UtcTimestamp();
+            for (int i = 0; publishing && (i < messages_rate); ++i)
+                publisher->Publish(message_to_publish.data(), message_to_publish.size());
+            auto end = UtcTimestamp();
+
+            // Sleep for remaining time or yield
+            auto milliseconds = (end - start).milliseconds();
+            if (milliseconds < 1000)
+                Thread::Sleep(1000 - milliseconds);
+            else
+                Thread::Yield();
+        }
+    });
+
+    uint64_t timestamp_start = Timestamp::nano();
+
+    // Wait for benchmarking
+    Thread::Sleep(seconds_count * 1000);
+
+    // Stop the publishing thread
+    publishing = false;
+    publisher_thread.join();
+
+    // Wait for the tail recovery
+    Thread::Sleep(1000);
+
+    uint64_t timestamp_stop = Timestamp::nano();
+
+    std::cout << "Done!" << std::endl;
+
+    // Disconnect subscribers
+    std::cout << "Subscribers disconnecting...";
+    for (auto& subscriber : subscribers)
+        subscriber->DisconnectAsync();
+    for (auto& subscriber : subscribers)
+        while (subscriber->IsConnected())
+            Thread::Yield();
+    std::cout << "Done!" << std::endl;
+
+    // Stop the publisher
+    std::cout << "Publisher stopping...";
+    publisher->Stop();
+    while (publisher->IsStarted())
+        Thread::Yield();
+    std::cout << "Done!" << std::endl;
+
+    // Stop the Asio service
+    std::cout << "Asio service stopping...";
+    service->Stop();
+    std::cout << "Done!" << std::endl;
+
+    // Collect subscribers statistic
+    uint64_t total_received = 0;
+    uint64_t total_recovered = 0;
+    uint64_t total_lost = 0;
+    uint64_t total_gaps = 0;
+    uint64_t total_requests = 0;
+    uint64_t total_duplicated = 0;
+    for (auto& subscriber : subscribers)
+    {
+        total_received += subscriber->messages_received();
+        total_recovered += subscriber->messages_recovered();
+        total_lost += subscriber->messages_lost();
+        total_gaps += subscriber->gaps_detected();
+        total_requests += subscriber->retransmit_requests();
+        total_duplicated += subscriber->packets_duplicated();
+    }
+
+    std::cout << std::endl;
+
+    std::cout << "Total time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Messages published: " << publisher->messages_published() << std::endl;
+    std::cout << "Messages received: " << total_received << std::endl;
+    std::cout << "Messages throughput: " << total_received * 1000000000 / (timestamp_stop - timestamp_start) << " msg/s" << std::endl;
+    std::cout << "Datagrams dropped: " << total_dropped << std::endl;
+    std::cout << "Gaps detected: " << total_gaps << std::endl;
+    std::cout << "Messages recovered: " << total_recovered << std::endl;
+    std::cout << "Messages lost: " << total_lost << std::endl;
+    std::cout << "Duplicate packets: " << total_duplicated << std::endl;
+    std::cout << "Retransmit requests: " << total_requests << std::endl;
+    std::cout << "Packets retransmitted: " << publisher->packets_retransmitted() << std::endl;
+    std::cout << "Packets unavailable: " << publisher->packets_unavailable() << std::endl;
+
+    return 0;
+}
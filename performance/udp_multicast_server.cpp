@@ -8,6 +8,7 @@
 #include "threads/thread.h"
 #include "time/timestamp.h"
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <thread>
@@ -18,12 +19,20 @@
 using namespace CppCommon;
 using namespace CppServer::Asio;
 
+std::atomic<uint64_t> total_sent(0);
+
 class MulticastServer : public UDPServer
 {
 public:
     using UDPServer::UDPServer;
 
 protected:
+    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override
+    {
+        if (sent > 0)
+            ++total_sent;
+    }
+
     void onError(int error, const std::string& category, const std::string& message) override
     {
         std::cout << "UDP server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
@@ -39,6 +48,8 @@ int main(int argc, char** argv)
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000000).help("Rate of messages per second to send. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-g", "--gso").dest("gso").action("store_true").help("Multicast asynchronously in chunks with UDP generic segmentation offload");
+    parser.add_option("-c", "--chunk").dest("chunk").action("store").type("int").set_default(64).help("Count of messages multicasted asynchronously in a single chunk. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -55,12 +66,17 @@ int main(int argc, char** argv)
     int threads = options.get("threads");
     int messages_rate = options.get("messages");
     int message_size = options.get("size");
+    bool gso = options.get("gso");
+    int chunk = options.get("chunk");
 
     std::cout << "Server address: " << address << std::endl;
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
     std::cout << "Messages rate: " << messages_rate << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Segmentation offload: " << (gso ? "enabled" : "disabled") << std::endl;
+    if (gso)
+        std::cout << "Messages chunk: " << chunk << std::endl;
 
     std::cout << std::endl;
 
@@ -76,25 +92,49 @@ int main(int argc, char** argv)
     auto server = std::make_shared<MulticastServer>(service, 0);
     server->SetupReuseAddress(true);
     server->SetupReusePort(true);
+    server->SetupGSO(gso);
 
     // Start the server
     std::cout << "Server starting...";
     server->Start(address, port);
     std::cout << "Done!" << std::endl;
 
+    if (gso)
+        std::cout << "Segmentation offload available: " << (server->IsGSO() ? "yes" : "no") << std::endl;
+
     // Start the multicasting thread
     std::atomic<bool> multicasting(true);
-    auto multicaster = std::thread([&server, &multicasting, messages_rate, message_size]()
+    auto multicaster = std::thread([&service, &server, &multicasting, messages_rate, message_size, gso, chunk]()
     {
         // Prepare message to multicast
-        std::vector<uint8_t> message_to_send(message_size);
+        auto message_to_send = std::make_shared<std::vector<uint8_t>>(message_size);
 
         // Multicasting loop
         while (multicasting)
         {
             auto start = UtcTimestamp();
-            for (int i = 0; i < messages_rate; ++i)
-                server->Multicast(message_to_send.data(), message_to_send.size());
+            if (gso)
+            {
+                // Queue chunks of messages in server handlers to coalesce them into segmented sends
+                for (int i = 0; i < messages_rate; i += chunk)
+                {
+                    int count = std::min(chunk, messages_rate - i);
+                    auto multicast_handler = [server, message_to_send, count]()
+                    {
+                        for (int j = 0; j < count; ++j)
+                            server->MulticastAsync(message_to_send->data(), message_to_send->size());
+                    };
+                    if (service->IsStrandRequired())
+                        asio::post(server->strand(), multicast_handler);
+                    else
+                        asio::post(*server->io_service(), multicast_handler);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < messages_rate; ++i)
+                    server->Multicast(message_to_send->data(), message_to_send->size());
+            }
             auto end = UtcTimestamp();
 
             // Sleep for remaining time or yield
@@ -139,5 +179,9 @@ int main(int argc, char** argv)
     service->Stop();
     std::cout << "Done!" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Datagrams sent: " << total_sent << std::endl;
+
     return 0;
 }
@@ -0,0 +1,62 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "benchmark/cppbenchmark.h"
+
+#include "server/ws/ws.h"
+
+#include <vector>
+
+using namespace CppServer::WS;
+
+const uint8_t mask[4] = { 0x37, 0xFA, 0x21, 0x3D };
+const uint8_t zero_mask[4] = { 0x00, 0x00, 0x00, 0x00 };
+
+const auto settings = CppBenchmark::Settings().Param(16).Param(64).Param(256).Param(1024).Param(16384).Param(65536).Param(1048576);
+
+class MaskFixture : public virtual CppBenchmark::Fixture
+{
+protected:
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> destination;
+
+    void Initialize(CppBenchmark::Context& context) override
+    {
+        source.resize(context.x(), 0xAA);
+        destination.resize(context.x());
+    }
+
+    void Cleanup(CppBenchmark::Context& context) override
+    {
+        source.clear();
+        destination.clear();
+    }
+};
+
+BENCHMARK_FIXTURE(MaskFixture, "WebSocket mask (scalar loop)", settings)
+{
+    for (size_t i = 0; i < source.size(); ++i)
+        destination[i] = source[i] ^ mask[i % 4];
+    context.metrics().AddBytes(source.size());
+}
+
+BENCHMARK_FIXTURE(MaskFixture, "WebSocket mask", settings)
+{
+    WebSocket::MaskPayload(destination.data(), source.data(), source.size(), mask);
+    context.metrics().AddBytes(source.size());
+}
+
+BENCHMARK_FIXTURE(MaskFixture, "WebSocket unmask in place", settings)
+{
+    WebSocket::MaskPayload(source.data(), source.data(), source.size(), mask);
+    context.metrics().AddBytes(source.size());
+}
+
+BENCHMARK_FIXTURE(MaskFixture, "WebSocket zero mask", settings)
+{
+    WebSocket::MaskPayload(destination.data(), source.data(), source.size(), zero_mask);
+    context.metrics().AddBytes(source.size());
+}
+
+BENCHMARK_MAIN()
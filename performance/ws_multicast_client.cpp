@@ -66,6 +66,7 @@ int main(int argc, char** argv)
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
     parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-d", "--deflate").dest("deflate").action("store_true").help("Enable permessage-deflate extension");
     parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -84,6 +85,7 @@ int main(int argc, char** argv)
     int clients_count = options.get("clients");
     int message_size = options.get("size");
     int seconds_count = options.get("seconds");
+    bool deflate = options.get("deflate");
 
     std::cout << "Server address: " << address << std::endl;
     std::cout << "Server port: " << port << std::endl;
@@ -91,6 +93,7 @@ int main(int argc, char** argv)
     std::cout << "Working clients: " << clients_count << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
     std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+    std::cout << "Deflate: " << (deflate ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
@@ -108,6 +111,7 @@ int main(int argc, char** argv)
     {
         auto client = std::make_shared<MulticastClient>(service, address, port);
         // client->SetupNoDelay(true);
+        client->SetupWSDeflate(deflate);
         clients.emplace_back(client);
     }
 
@@ -140,6 +144,11 @@ int main(int argc, char** argv)
 
     timestamp_stop = Timestamp::nano();
 
+    // Calculate received wire bytes
+    uint64_t total_wire_bytes = 0;
+    for (const auto& client : clients)
+        total_wire_bytes += client->bytes_received();
+
     // Stop the Asio service
     std::cout << "Asio service stopping...";
     service->Stop();
@@ -155,6 +164,9 @@ int main(int argc, char** argv)
 
     std::cout << "Total time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
     std::cout << "Total data: " << CppBenchmark::ReporterConsole::GenerateDataSize(total_bytes) << std::endl;
+    std::cout << "Total wire data: " << CppBenchmark::ReporterConsole::GenerateDataSize(total_wire_bytes) << std::endl;
+    if (total_wire_bytes > 0)
+        std::cout << "Compression ratio: " << (double)total_bytes / total_wire_bytes << std::endl;
     std::cout << "Total messages: " << total_messages << std::endl;
     std::cout << "Data throughput: " << CppBenchmark::ReporterConsole::GenerateDataSize(total_bytes * 1000000000 / (timestamp_stop - timestamp_start)) << "/s" << std::endl;
     if (total_messages > 0)
@@ -4,6 +4,8 @@
 
 #include "server/asio/service.h"
 #include "server/ws/ws_server.h"
+
+#include "benchmark/reporter_console.h"
 #include "system/cpu.h"
 #include "threads/thread.h"
 #include "time/timestamp.h"
@@ -19,6 +21,9 @@ using namespace CppCommon;
 using namespace CppServer::Asio;
 using namespace CppServer::WS;
 
+std::atomic<uint64_t> total_multicast_time(0);
+std::atomic<uint64_t> total_multicast_messages(0);
+
 class MulticastSession : public WSSession
 {
 public:
@@ -57,6 +62,7 @@ int main(int argc, char** argv)
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000000).help("Rate of messages per second to send. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-d", "--deflate").dest("deflate").action("store_true").help("Enable permessage-deflate extension");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -72,11 +78,13 @@ int main(int argc, char** argv)
     int threads = options.get("threads");
     int messages_rate = options.get("messages");
     int message_size = options.get("size");
+    bool deflate = options.get("deflate");
 
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
     std::cout << "Messages rate: " << messages_rate << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Deflate: " << (deflate ? "enabled" : "disabled") << std::endl;
 
     std::cout << std::endl;
 
@@ -93,6 +101,7 @@ int main(int argc, char** argv)
     // server->SetupNoDelay(true);
     server->SetupReuseAddress(true);
     server->SetupReusePort(true);
+    server->SetupWSDeflate(deflate);
 
     // Start the server
     std::cout << "Server starting...";
@@ -103,8 +112,11 @@ int main(int argc, char** argv)
     std::atomic<bool> multicasting(true);
     auto multicaster = std::thread([&server, &multicasting, messages_rate, message_size]()
     {
-        // Prepare message to multicast
+        // Prepare JSON like message to multicast
+        const std::string pattern = "{\"symbol\":\"EURUSD\",\"bid\":1.10123,\"ask\":1.10125,\"volume\":1000000},";
         std::vector<uint8_t> message_to_send(message_size);
+        for (size_t i = 0; i < message_to_send.size(); ++i)
+            message_to_send[i] = pattern[i % pattern.size()];
 
         // Multicasting loop
         while (multicasting)
@@ -114,6 +126,10 @@ int main(int argc, char** argv)
                 server->MulticastBinary(message_to_send.data(), message_to_send.size());
             auto end = UtcTimestamp();
 
+            // Update multicast statistic
+            total_multicast_time += (end - start).nanoseconds();
+            total_multicast_messages += messages_rate;
+
             // Sleep for remaining time or yield
             auto milliseconds = (end - start).milliseconds();
             if (milliseconds < 1000)
@@ -156,5 +172,11 @@ int main(int argc, char** argv)
     service->Stop();
     std::cout << "Done!" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Total multicast messages: " << total_multicast_messages << std::endl;
+    if (total_multicast_messages > 0)
+        std::cout << "Multicast CPU cost: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(total_multicast_time / total_multicast_messages) << " per message" << std::endl;
+
     return 0;
 }
@@ -0,0 +1,142 @@
+/*!
+    \file fbe_extensions.h
+    \brief Fast Binary Encoding protocol extensions definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_PROTO_FBE_EXTENSIONS_H
+#define CPPSERVER_PROTO_FBE_EXTENSIONS_H
+
+#include "fbe_models.h"
+#include "fbe_protocol.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace FBE {
+
+//! Get the string field value view over the attached buffer
+/*!
+    Read the string field of the model attached to the received bytes
+    without copying it. Other FBE files are generated by the FBE compiler,
+    so such hand-written extensions are kept in this file to survive the
+    protocol regeneration.
+
+    The result view is valid while the model is attached to the buffer
+    (e.g. during the proxy handler call).
+
+    \param buffer - Model buffer
+    \param field - String field model
+    \return String field value view (empty if the field is empty or broken)
+*/
+inline std::string_view GetStringView(const FBEBuffer& buffer, const FieldModel<std::string>& field) noexcept
+{
+    if ((buffer.offset() + field.fbe_offset() + field.fbe_size()) > buffer.size())
+        return std::string_view();
+
+    uint32_t fbe_string_offset = *((const uint32_t*)(buffer.data() + buffer.offset() + field.fbe_offset()));
+    if ((fbe_string_offset == 0) || ((buffer.offset() + fbe_string_offset + 4) > buffer.size()))
+        return std::string_view();
+
+    uint32_t fbe_string_size = *((const uint32_t*)(buffer.data() + buffer.offset() + fbe_string_offset));
+    if ((buffer.offset() + fbe_string_offset + 4 + fbe_string_size) > buffer.size())
+        return std::string_view();
+
+    return std::string_view((const char*)(buffer.data() + buffer.offset() + fbe_string_offset + 4), fbe_string_size);
+}
+
+//! Batch sender
+/*!
+    Batch sender wraps the generated FBE sender (or client) and coalesces
+    serialized messages into a single batch buffer until the batch threshold
+    is reached or flush() is called, so many small messages are sent with a
+    single onFlush() call. Each message is reported as sent to the generated
+    code once it is kept in the batch.
+
+    onBatch() handler is called when the first message is kept in the batch
+    after the last flush(), so it could schedule the next flush() call (e.g.
+    post it into the session strand). Messages which were not accepted by
+    onFlush() are kept in the batch and the next kept message will call
+    onBatch() again.
+
+    Not thread-safe.
+*/
+template <class TSender>
+class BatchSender : public TSender
+{
+public:
+    //! Get the batch threshold
+    size_t batch() const noexcept { return _batch_threshold; }
+    //! Enable/Disable batching of serialized messages up to the given threshold size (0 to disable)
+    void batch(size_t threshold) noexcept { _batch_threshold = threshold; }
+
+    //! Reset the sender and batch buffers
+    void reset() noexcept
+    {
+        TSender::reset();
+        _batch_buffer.clear();
+        _batch_scheduled = false;
+    }
+
+    //! Flush batched messages
+    /*!
+        \return Size of flushed messages
+    */
+    size_t flush()
+    {
+        _batch_scheduled = false;
+
+        if (_batch_buffer.empty())
+            return 0;
+
+        // Send batched messages, all unsent messages are kept in the batch
+        size_t sent = std::min(onFlush(_batch_buffer.data(), _batch_buffer.size()), _batch_buffer.size());
+        _batch_buffer.erase(_batch_buffer.begin(), _batch_buffer.begin() + sent);
+        return sent;
+    }
+
+protected:
+    //! Handle flush of batched messages
+    /*!
+        \param data - Batched messages data
+        \param size - Batched messages size
+        \return Size of sent messages
+    */
+    virtual size_t onFlush(const void* data, size_t size) = 0;
+    //! Handle the new batch (override to schedule flush())
+    virtual void onBatch() {}
+
+    size_t onSend(const void* data, size_t size) override
+    {
+        // Send the message directly if batching is disabled
+        if ((_batch_threshold == 0) && _batch_buffer.empty())
+            return onFlush(data, size);
+
+        // Keep the message in the batch
+        const uint8_t* bytes = (const uint8_t*)data;
+        _batch_buffer.insert(_batch_buffer.end(), bytes, bytes + size);
+
+        // Flush the batch once the threshold is reached
+        if (_batch_buffer.size() >= _batch_threshold)
+            flush();
+        else if (!_batch_scheduled)
+        {
+            _batch_scheduled = true;
+            onBatch();
+        }
+
+        return size;
+    }
+
+private:
+    size_t _batch_threshold{0};
+    bool _batch_scheduled{false};
+    std::vector<uint8_t> _batch_buffer;
+};
+
+} // namespace FBE
+
+#endif // CPPSERVER_PROTO_FBE_EXTENSIONS_H
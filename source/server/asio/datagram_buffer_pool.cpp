@@ -0,0 +1,200 @@
+/*!
+    \file datagram_buffer_pool.cpp
+    \brief Datagram buffer pool implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/datagram_buffer_pool.h"
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Round up the ring size to the power of two
+size_t RingSize(size_t buffers)
+{
+    size_t size = 2;
+    while (size < buffers)
+        size <<= 1;
+    return size;
+}
+
+} // namespace
+
+DatagramBuffer::DatagramBuffer(const DatagramBuffer& buffer) noexcept
+    : _block(buffer._block),
+      _offset(buffer._offset),
+      _size(buffer._size)
+{
+    if (_block != nullptr)
+        _block->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+DatagramBuffer::DatagramBuffer(DatagramBuffer&& buffer) noexcept
+    : _block(buffer._block),
+      _offset(buffer._offset),
+      _size(buffer._size)
+{
+    buffer._block = nullptr;
+    buffer._offset = 0;
+    buffer._size = 0;
+}
+
+DatagramBuffer& DatagramBuffer::operator=(const DatagramBuffer& buffer) noexcept
+{
+    DatagramBuffer(buffer).swap(*this);
+    return *this;
+}
+
+DatagramBuffer& DatagramBuffer::operator=(DatagramBuffer&& buffer) noexcept
+{
+    DatagramBuffer(std::move(buffer)).swap(*this);
+    return *this;
+}
+
+DatagramBuffer DatagramBuffer::slice(size_t offset, size_t size) const noexcept
+{
+    assert(((offset + size) <= capacity()) && "Datagram slice exceeds the pooled buffer capacity!");
+
+    DatagramBuffer result(*this);
+    result._offset += offset;
+    result._size = size;
+    return result;
+}
+
+void DatagramBuffer::reset() noexcept
+{
+    if (_block == nullptr)
+        return;
+
+    // Return the pooled buffer with the last handle
+    if (_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        auto pool = std::move(_block->pool);
+        pool->Release(_block);
+    }
+
+    _block = nullptr;
+    _offset = 0;
+    _size = 0;
+}
+
+void DatagramBuffer::swap(DatagramBuffer& buffer) noexcept
+{
+    using std::swap;
+    swap(_block, buffer._block);
+    swap(_offset, buffer._offset);
+    swap(_size, buffer._size);
+}
+
+DatagramBufferPool::DatagramBufferPool(size_t buffers, size_t capacity)
+    : _capacity(capacity),
+      _ring(RingSize(2 * buffers)),
+      _mask(_ring.size() - 1),
+      _head(0),
+      _tail(0),
+      _allocations(0)
+{
+    for (size_t i = 0; i < _ring.size(); ++i)
+    {
+        _ring[i].sequence.store(i, std::memory_order_relaxed);
+        _ring[i].block = nullptr;
+    }
+
+    // Preallocate pooled buffers
+    for (size_t i = 0; i < buffers; ++i)
+    {
+        auto block = new DatagramBuffer::Block();
+        block->buffer.resize(_capacity);
+        TryPush(block);
+    }
+}
+
+DatagramBufferPool::~DatagramBufferPool()
+{
+    // Free pooled buffers
+    DatagramBuffer::Block* block;
+    while (TryPop(block))
+        delete block;
+}
+
+DatagramBuffer DatagramBufferPool::Acquire()
+{
+    DatagramBuffer::Block* block = nullptr;
+
+    // Allocate a new buffer if the pool is empty
+    if (!TryPop(block))
+    {
+        block = new DatagramBuffer::Block();
+        block->buffer.resize(_capacity);
+        _allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    block->references.store(1, std::memory_order_relaxed);
+    block->pool = shared_from_this();
+
+    return DatagramBuffer(block, 0, _capacity);
+}
+
+void DatagramBufferPool::Release(DatagramBuffer::Block* block) noexcept
+{
+    // Free the buffer if the pool is full
+    if (!TryPush(block))
+        delete block;
+}
+
+bool DatagramBufferPool::TryPush(DatagramBuffer::Block* block) noexcept
+{
+    Cell* cell;
+    size_t position = _tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = &_ring[position & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+        if (diff == 0)
+        {
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false;
+        else
+            position = _tail.load(std::memory_order_relaxed);
+    }
+
+    cell->block = block;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool DatagramBufferPool::TryPop(DatagramBuffer::Block*& block) noexcept
+{
+    Cell* cell;
+    size_t position = _head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        cell = &_ring[position & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(position + 1);
+        if (diff == 0)
+        {
+            if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false;
+        else
+            position = _head.load(std::memory_order_relaxed);
+    }
+
+    block = cell->block;
+    cell->sequence.store(position + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,70 @@
+/*!
+    \file datagram_queue.cpp
+    \brief Datagram queue implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/datagram_queue.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CppServer {
+namespace Asio {
+
+void DatagramQueue::Push(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    // Grow the full ring twice keeping the queued order
+    if (_size == _ring.size())
+    {
+        std::rotate(_ring.begin(), _ring.begin() + _head, _ring.end());
+        _ring.resize(std::max(_ring.size() * 2, (size_t)16));
+        _head = 0;
+    }
+
+    // Fill the pooled entry
+    Datagram& datagram = _ring[(_head + _size) & (_ring.size() - 1)];
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    datagram.endpoint = endpoint;
+    datagram.buffer.assign(bytes, bytes + size);
+
+    ++_size;
+    _bytes += size;
+}
+
+void DatagramQueue::Pop()
+{
+    assert(!empty() && "Datagram queue is empty!");
+    if (empty())
+        return;
+
+    // Release the pooled entry keeping its buffer capacity
+    Datagram& datagram = _ring[_head];
+    _bytes -= datagram.buffer.size();
+    datagram.buffer.clear();
+
+    _head = (_head + 1) & (_ring.size() - 1);
+    --_size;
+}
+
+void DatagramQueue::Clear()
+{
+    while (!empty())
+        Pop();
+
+    _head = 0;
+}
+
+void DatagramQueue::swap(DatagramQueue& queue) noexcept
+{
+    using std::swap;
+    swap(_ring, queue._ring);
+    swap(_head, queue._head);
+    swap(_size, queue._size);
+    swap(_bytes, queue._bytes);
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,78 @@
+/*!
+    \file receive_timestamp.cpp
+    \brief Socket receive timestamp implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/receive_timestamp.h"
+
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#endif
+
+namespace CppServer {
+namespace Asio {
+
+bool ReceiveTimestamp::Setup(asio::detail::socket_type socket, bool hardware) noexcept
+{
+#if defined(__linux__)
+    // Request either software or raw hardware receive timestamps, as they are taken by different clocks
+    int flags = hardware ? (SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE) : (SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE);
+    return (::setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0);
+#else
+    return false;
+#endif
+}
+
+#if defined(__linux__)
+uint64_t ReceiveTimestamp::Parse(const msghdr& message) noexcept
+{
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR((msghdr*)&message, cmsg))
+    {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPING))
+        {
+            scm_timestamping timestamping;
+            std::memcpy(&timestamping, CMSG_DATA(cmsg), sizeof(timestamping));
+
+            // Prefer the software timestamp over the raw hardware one
+            const timespec& ts = ((timestamping.ts[0].tv_sec != 0) || (timestamping.ts[0].tv_nsec != 0)) ? timestamping.ts[0] : timestamping.ts[2];
+            return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+        }
+    }
+    return 0;
+}
+
+ssize_t ReceiveTimestamp::Receive(asio::detail::socket_type socket, void* buffer, size_t size, void* address, socklen_t& address_size, uint64_t& timestamp) noexcept
+{
+    alignas(cmsghdr) uint8_t control[CONTROL_SIZE];
+
+    iovec iov;
+    iov.iov_base = buffer;
+    iov.iov_len = size;
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_name = address;
+    message.msg_namelen = (address != nullptr) ? address_size : 0;
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t result = ::recvmsg(socket, &message, MSG_DONTWAIT);
+    if (result < 0)
+        return result;
+
+    address_size = message.msg_namelen;
+    timestamp = Parse(message);
+    return result;
+}
+#endif
+
+} // namespace Asio
+} // namespace CppServer
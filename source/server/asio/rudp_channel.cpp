@@ -0,0 +1,471 @@
+/*!
+    \file rudp_channel.cpp
+    \brief Reliable UDP channel implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_channel.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstring>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Packet flags
+constexpr uint8_t FLAG_ORDERED = 0x01;
+
+// Congestion control
+constexpr size_t INITIAL_WINDOW = 16;
+constexpr size_t MIN_WINDOW = 2;
+constexpr size_t DUPLICATE_THRESHOLD = 3;
+constexpr size_t ACK_FREQUENCY = 1;
+
+// Retransmission timeouts
+constexpr uint64_t INITIAL_RTO = 200000000;
+constexpr uint64_t MIN_RTO = 20000000;
+constexpr uint64_t MAX_RTO = 2000000000;
+constexpr uint32_t MAX_RETRANSMITS = 16;
+
+void WriteUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+uint32_t ReadUInt32(const uint8_t* buffer)
+{
+    return (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+}
+
+void WriteHeader(uint8_t* buffer, RUDPChannel::PacketType type, uint8_t flags, uint16_t epoch, uint32_t seq)
+{
+    buffer[0] = (uint8_t)type;
+    buffer[1] = flags;
+    buffer[2] = (uint8_t)epoch;
+    buffer[3] = (uint8_t)(epoch >> 8);
+    WriteUInt32(buffer + 4, seq);
+}
+
+} // namespace
+
+RUDPChannel::RUDPChannel(const std::function<bool(const void*, size_t)>& send, const std::function<void(const void*, size_t)>& receive, const std::function<void(size_t)>& deliver)
+    : _send(send),
+      _receive(receive),
+      _deliver(deliver),
+      _send_window(WINDOW_SIZE),
+      _receive_window(WINDOW_SIZE)
+{
+    Reset();
+}
+
+void RUDPChannel::Reset(uint16_t epoch)
+{
+    // Release send and receive windows keeping pooled buffers
+    for (auto& packet : _send_window)
+    {
+        packet.buffer.clear();
+        packet.timestamp = 0;
+        packet.retransmits = 0;
+        packet.acked = false;
+    }
+    for (auto& slot : _receive_window)
+    {
+        slot.buffer.clear();
+        slot.received = false;
+        slot.delivered = false;
+    }
+
+    _epoch = epoch;
+
+    _snd_una = 0;
+    _snd_nxt = 0;
+    _snd_end = 0;
+    _rcv_nxt = 0;
+    _ack_pending = 0;
+
+    _cwnd = INITIAL_WINDOW;
+    _cwnd_count = 0;
+    _ssthresh = WINDOW_SIZE;
+    _recovery = 0;
+
+    _srtt = 0;
+    _rttvar = 0;
+    _rto = INITIAL_RTO;
+
+    _packets_sent = 0;
+    _packets_received = 0;
+    _packets_duplicated = 0;
+    _packets_retransmitted = 0;
+    _fast_retransmits = 0;
+    _timeouts = 0;
+    _probes = 0;
+}
+
+bool RUDPChannel::Send(const void* buffer, size_t size, bool ordered)
+{
+    if ((size == 0) || (size > MAX_MESSAGE_SIZE))
+        return false;
+
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    // Check the send window limit
+    if (messages_pending() >= WINDOW_SIZE)
+        return false;
+
+    // Fill the pooled packet buffer
+    Packet& packet = this->packet(_snd_end);
+    packet.buffer.resize(HEADER_SIZE + size);
+    WriteHeader(packet.buffer.data(), PacketType::Data, ordered ? FLAG_ORDERED : 0, _epoch, _snd_end);
+    std::memcpy(packet.buffer.data() + HEADER_SIZE, buffer, size);
+    packet.retransmits = 0;
+    packet.acked = false;
+    ++_snd_end;
+
+    // Transmit packets allowed by the congestion window
+    Transmit();
+
+    return true;
+}
+
+void RUDPChannel::SendReset()
+{
+    uint8_t buffer[HEADER_SIZE];
+    WriteHeader(buffer, PacketType::Reset, 0, _epoch, 0);
+    _send(buffer, sizeof(buffer));
+}
+
+uint16_t RUDPChannel::PacketEpoch(const void* buffer) noexcept
+{
+    const uint8_t* packet = (const uint8_t*)buffer;
+    return (uint16_t)packet[2] | (uint16_t)((uint16_t)packet[3] << 8);
+}
+
+bool RUDPChannel::IsFirstPacket(const void* buffer, size_t size) noexcept
+{
+    if (size < HEADER_SIZE)
+        return false;
+
+    const uint8_t* packet = (const uint8_t*)buffer;
+    return (packet[0] == (uint8_t)PacketType::Data) && (ReadUInt32(packet + 4) == 0);
+}
+
+bool RUDPChannel::Receive(const void* buffer, size_t size)
+{
+    if (size < HEADER_SIZE)
+        return true;
+
+    const uint8_t* packet = (const uint8_t*)buffer;
+
+    // Adopt the connection epoch from the first packet, skip packets of other epochs
+    uint16_t epoch = PacketEpoch(packet);
+    if (_epoch == 0)
+        _epoch = epoch;
+    else if (epoch != _epoch)
+        return true;
+
+    switch ((PacketType)packet[0])
+    {
+        case PacketType::Data:
+            ReceiveData(packet, size);
+            return true;
+        case PacketType::Ack:
+            ReceiveAck(packet, size);
+            return true;
+        case PacketType::Reset:
+            return false;
+        default:
+            // Skip unknown packets
+            return true;
+    }
+}
+
+void RUDPChannel::ReceiveData(const uint8_t* buffer, size_t size)
+{
+    uint32_t seq = ReadUInt32(buffer + 4);
+    bool ordered = (buffer[1] & FLAG_ORDERED) != 0;
+
+    // Acknowledge duplicates immediately as the previous acknowledgment might be lost
+    int32_t distance = (int32_t)(seq - _rcv_nxt);
+    if ((distance < 0) || ((distance < (int32_t)WINDOW_SIZE) && slot(seq).received))
+    {
+        ++_packets_duplicated;
+        SendAck();
+        return;
+    }
+
+    // Drop packets out of the receive window
+    if (distance >= (int32_t)WINDOW_SIZE)
+        return;
+
+    ++_packets_received;
+
+    // Deliver unordered or in-order messages immediately, buffer others
+    Slot& received = slot(seq);
+    received.received = true;
+    received.delivered = (!ordered || (distance == 0));
+    if (received.delivered)
+        _receive(buffer + HEADER_SIZE, size - HEADER_SIZE);
+    else
+        received.buffer.assign(buffer + HEADER_SIZE, buffer + size);
+
+    // Advance the receive window delivering buffered ordered messages
+    size_t advanced = 0;
+    while (slot(_rcv_nxt).received)
+    {
+        Slot& next = slot(_rcv_nxt);
+        bool deliver = !next.delivered;
+        next.received = false;
+        next.delivered = false;
+        ++_rcv_nxt;
+        ++advanced;
+
+        if (deliver)
+            _receive(next.buffer.data(), next.buffer.size());
+    }
+
+    // Report gaps and filled gaps immediately, otherwise acknowledge every ACK_FREQUENCY received packets
+    if ((distance != 0) || (advanced > 1) || (++_ack_pending >= ACK_FREQUENCY))
+        SendAck();
+}
+
+void RUDPChannel::SendAck()
+{
+    // Collect the selective acknowledgment bitmap of packets following the gap
+    uint32_t sack = 0;
+    for (uint32_t i = 0; i < 32; ++i)
+        if (slot(_rcv_nxt + 1 + i).received)
+            sack |= (1u << i);
+
+    uint8_t buffer[ACK_SIZE];
+    WriteHeader(buffer, PacketType::Ack, 0, _epoch, _rcv_nxt);
+    WriteUInt32(buffer + HEADER_SIZE, sack);
+    _ack_pending = 0;
+    _send(buffer, sizeof(buffer));
+}
+
+void RUDPChannel::ReceiveAck(const uint8_t* buffer, size_t size)
+{
+    if (size < ACK_SIZE)
+        return;
+
+    uint32_t ack = ReadUInt32(buffer + 4);
+    uint32_t sack = ReadUInt32(buffer + HEADER_SIZE);
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    size_t acked = 0;
+
+    // Release cumulatively acknowledged packets
+    int32_t advance = (int32_t)(ack - _snd_una);
+    if ((advance > 0) && (advance <= (int32_t)(_snd_nxt - _snd_una)))
+    {
+        for (; _snd_una != ack; ++_snd_una)
+        {
+            Packet& released = packet(_snd_una);
+            if (!released.acked)
+            {
+                Acknowledge(released, timestamp);
+                ++acked;
+            }
+            released.acked = false;
+            released.retransmits = 0;
+        }
+    }
+
+    // Mark selectively acknowledged packets
+    for (uint32_t i = 0; i < 32; ++i)
+    {
+        if ((sack & (1u << i)) == 0)
+            continue;
+
+        uint32_t seq = ack + 1 + i;
+        if (((int32_t)(seq - _snd_una) < 0) || ((int32_t)(seq - _snd_nxt) >= 0))
+            continue;
+
+        Packet& sacked = packet(seq);
+        if (!sacked.acked)
+        {
+            Acknowledge(sacked, timestamp);
+            ++acked;
+        }
+    }
+
+    // Fast retransmit gaps followed by enough selectively acknowledged packets
+    // (lower the threshold for small flights to avoid waiting for the timeout)
+    if ((sack != 0) && (ack == _snd_una))
+    {
+        size_t flight = (size_t)(_snd_nxt - _snd_una);
+        size_t threshold = std::max(std::min(DUPLICATE_THRESHOLD, flight - 1), (size_t)1);
+        for (uint32_t i = 0; i < 32; ++i)
+        {
+            uint32_t seq = ack + i;
+            if ((int32_t)(seq - _snd_nxt) >= 0)
+                break;
+
+            // Skip selectively acknowledged packets
+            if ((i > 0) && ((sack & (1u << (i - 1))) != 0))
+                continue;
+
+            // Count selectively acknowledged packets above the gap
+            if (std::bitset<32>(sack >> i).count() < threshold)
+                break;
+
+            // Retransmit the gap at most once per round-trip time
+            Packet& lost = packet(seq);
+            if (lost.acked || ((timestamp - lost.timestamp) < std::max(_srtt, (uint64_t)1)))
+                continue;
+
+            Congestion(_cwnd);
+            Retransmit(lost, timestamp);
+            ++_fast_retransmits;
+        }
+    }
+
+    if (acked > 0)
+    {
+        // Grow the congestion window (slow start or congestion avoidance)
+        for (size_t i = 0; i < acked; ++i)
+        {
+            if (_cwnd < _ssthresh)
+                ++_cwnd;
+            else if (++_cwnd_count >= _cwnd)
+            {
+                ++_cwnd;
+                _cwnd_count = 0;
+            }
+        }
+        _cwnd = std::min(_cwnd, WINDOW_SIZE);
+
+        // Report acknowledged messages
+        _deliver(acked);
+    }
+
+    // Transmit packets allowed by the updated congestion window
+    Transmit();
+}
+
+bool RUDPChannel::Tick()
+{
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+
+    // Send the delayed acknowledgment
+    if (_ack_pending > 0)
+        SendAck();
+
+    // Retransmit packets with expired retransmission timeout
+    bool expired = false;
+    for (uint32_t seq = _snd_una; seq != _snd_nxt; ++seq)
+    {
+        Packet& unacked = packet(seq);
+        if (unacked.acked || ((timestamp - unacked.timestamp) < _rto))
+            continue;
+
+        if (unacked.retransmits >= MAX_RETRANSMITS)
+            return false;
+
+        Retransmit(unacked, timestamp);
+        ++_timeouts;
+        expired = true;
+    }
+
+    // Collapse the congestion window and back off the retransmission timeout
+    if (expired)
+    {
+        Congestion(MIN_WINDOW);
+        _rto = std::min(_rto * 2, MAX_RTO);
+    }
+    else if ((_snd_una != _snd_nxt) && (_srtt > 0))
+    {
+        // Probe the newest unacknowledged packet to get selective acknowledgments of the lost tail before the timeout
+        for (uint32_t seq = _snd_nxt - 1; seq != (_snd_una - 1); --seq)
+        {
+            Packet& tail = packet(seq);
+            if (tail.acked)
+                continue;
+
+            if ((timestamp - tail.timestamp) >= (2 * _srtt))
+            {
+                Retransmit(tail, timestamp);
+                ++_probes;
+            }
+            break;
+        }
+    }
+
+    // Transmit packets allowed by the congestion window
+    Transmit();
+
+    return true;
+}
+
+void RUDPChannel::Transmit()
+{
+    uint64_t timestamp = 0;
+    while ((_snd_nxt != _snd_end) && ((size_t)(_snd_nxt - _snd_una) < _cwnd))
+    {
+        if (timestamp == 0)
+            timestamp = CppCommon::Timestamp::nano();
+
+        Packet& transmitted = packet(_snd_nxt++);
+        transmitted.timestamp = timestamp;
+        ++_packets_sent;
+        _send(transmitted.buffer.data(), transmitted.buffer.size());
+    }
+}
+
+void RUDPChannel::Retransmit(Packet& packet, uint64_t timestamp)
+{
+    packet.timestamp = timestamp;
+    ++packet.retransmits;
+    ++_packets_retransmitted;
+    _send(packet.buffer.data(), packet.buffer.size());
+}
+
+void RUDPChannel::Acknowledge(Packet& packet, uint64_t timestamp)
+{
+    packet.acked = true;
+
+    // Estimate the round-trip time using only not retransmitted packets (Karn's algorithm)
+    if (packet.retransmits > 0)
+        return;
+
+    uint64_t sample = timestamp - packet.timestamp;
+    if (_srtt == 0)
+    {
+        _srtt = sample;
+        _rttvar = sample / 2;
+    }
+    else
+    {
+        uint64_t deviation = (_srtt > sample) ? (_srtt - sample) : (sample - _srtt);
+        _rttvar = (3 * _rttvar + deviation) / 4;
+        _srtt = (7 * _srtt + sample) / 8;
+    }
+    _rto = std::clamp(_srtt + 4 * _rttvar, MIN_RTO, MAX_RTO);
+}
+
+void RUDPChannel::Congestion(size_t window)
+{
+    // Decrease the congestion window once per recovery epoch
+    if ((int32_t)(_snd_una - _recovery) < 0)
+        return;
+
+    _ssthresh = std::max(_cwnd * 7 / 10, MIN_WINDOW);
+    _cwnd = std::max(std::min(window, _ssthresh), MIN_WINDOW);
+    _cwnd_count = 0;
+    _recovery = _snd_nxt;
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,169 @@
+/*!
+    \file rudp_client.cpp
+    \brief Reliable UDP client implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_client.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+RUDPClient::RUDPClient(const std::shared_ptr<Service>& service, const std::string& address, int port)
+    : UDPClient(service, address, port),
+      _channel([this](const void* buffer, size_t size) { return SendAsync(buffer, size); },
+               [this](const void* buffer, size_t size) { onReceivedMessage(buffer, size); },
+               [this](size_t messages) { onDelivered(messages); }),
+      _epoch((uint16_t)CppCommon::Timestamp::nano()),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10))
+{
+}
+
+RUDPClient::RUDPClient(const std::shared_ptr<Service>& service, const std::string& address, const std::string& scheme)
+    : UDPClient(service, address, scheme),
+      _channel([this](const void* buffer, size_t size) { return SendAsync(buffer, size); },
+               [this](const void* buffer, size_t size) { onReceivedMessage(buffer, size); },
+               [this](size_t messages) { onDelivered(messages); }),
+      _epoch((uint16_t)CppCommon::Timestamp::nano()),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10))
+{
+}
+
+RUDPClient::RUDPClient(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint)
+    : UDPClient(service, endpoint),
+      _channel([this](const void* buffer, size_t size) { return SendAsync(buffer, size); },
+               [this](const void* buffer, size_t size) { onReceivedMessage(buffer, size); },
+               [this](size_t messages) { onDelivered(messages); }),
+      _epoch((uint16_t)CppCommon::Timestamp::nano()),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10))
+{
+}
+
+bool RUDPClient::Disconnect()
+{
+    SendReset();
+    return UDPClient::Disconnect();
+}
+
+bool RUDPClient::DisconnectAsync()
+{
+    SendReset();
+    return UDPClient::DisconnectAsync();
+}
+
+bool RUDPClient::SendReliableAsync(const void* buffer, size_t size, bool ordered)
+{
+    if (!IsConnected())
+        return false;
+
+    if (!_channel.Send(buffer, size, ordered))
+        return false;
+
+    // Start ticking the busy channel
+    TryTick();
+
+    return true;
+}
+
+void RUDPClient::SendReset()
+{
+    if (!IsConnected())
+        return;
+
+    // Send the reset packet synchronously as the client socket is about to be closed
+    uint8_t buffer[RUDPChannel::HEADER_SIZE] = { (uint8_t)RUDPChannel::PacketType::Reset, 0, (uint8_t)_channel.epoch(), (uint8_t)(_channel.epoch() >> 8) };
+    Send(buffer, sizeof(buffer));
+}
+
+void RUDPClient::onConnected()
+{
+    // Start the new connection epoch, so the server replaces the stale session of the same endpoint
+    if (++_epoch == 0)
+        ++_epoch;
+
+    // Reset the channel keeping pooled buffers
+    _channel.Reset(_epoch);
+
+    // Start receive datagrams
+    ReceiveAsync();
+}
+
+void RUDPClient::onDisconnected()
+{
+    // Stop ticking the channel
+    _timer.cancel();
+
+    // Reset the channel keeping pooled buffers
+    _channel.Reset(_epoch);
+}
+
+void RUDPClient::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    // Skip datagrams of other endpoints
+    if ((size > 0) && (endpoint == this->endpoint()))
+    {
+        // Disconnect the client reset by the server
+        if (!_channel.Receive(buffer, size))
+        {
+            UDPClient::DisconnectAsync();
+            return;
+        }
+
+        // Start ticking the busy channel
+        TryTick();
+    }
+
+    // Continue receive datagrams
+    ReceiveAsync();
+}
+
+void RUDPClient::TryTick()
+{
+    if (_ticking || !_channel.IsBusy() || !IsConnected())
+        return;
+
+    _ticking = true;
+
+    // Wait for the next tick
+    auto self(std::static_pointer_cast<RUDPClient>(this->shared_from_this()));
+    auto tick_handler = [this, self](std::error_code ec)
+    {
+        _ticking = false;
+
+        if (ec || !IsConnected())
+            return;
+
+        Tick();
+    };
+    _timer.expires_after(std::chrono::nanoseconds(option_tick_interval().total()));
+    if (service()->IsStrandRequired())
+        _timer.async_wait(asio::bind_executor(strand(), tick_handler));
+    else
+        _timer.async_wait(tick_handler);
+}
+
+void RUDPClient::Tick()
+{
+    // Disconnect the client with unreachable server
+    if (!_channel.Tick())
+    {
+        UDPClient::DisconnectAsync();
+        return;
+    }
+
+    // Continue ticking the busy channel
+    TryTick();
+}
+
+} // namespace Asio
+} // namespace CppServer
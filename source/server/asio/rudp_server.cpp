@@ -0,0 +1,188 @@
+/*!
+    \file rudp_server.cpp
+    \brief Reliable UDP server implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_server.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+RUDPServer::RUDPServer(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol)
+    : UDPServer(service, port, protocol),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_session_timeout(CppCommon::Timespan::seconds(30))
+{
+}
+
+RUDPServer::RUDPServer(const std::shared_ptr<Service>& service, const std::string& address, int port)
+    : UDPServer(service, address, port),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_session_timeout(CppCommon::Timespan::seconds(30))
+{
+}
+
+RUDPServer::RUDPServer(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint)
+    : UDPServer(service, endpoint),
+      _timer(*io_service()),
+      _ticking(false),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_session_timeout(CppCommon::Timespan::seconds(30))
+{
+}
+
+std::shared_ptr<RUDPSession> RUDPServer::FindSession(const asio::ip::udp::endpoint& endpoint)
+{
+    // Try to find the required session
+    auto it = _sessions.find(endpoint);
+    return (it != _sessions.end()) ? it->second : nullptr;
+}
+
+bool RUDPServer::DisconnectAll()
+{
+    if (!IsStarted())
+        return false;
+
+    // Dispatch the disconnect all handler
+    auto self(std::static_pointer_cast<RUDPServer>(this->shared_from_this()));
+    auto disconnect_all_handler = [this, self]()
+    {
+        if (!IsStarted())
+            return;
+
+        // Disconnect all sessions (each of them unregisters itself)
+        while (!_sessions.empty())
+        {
+            auto session = _sessions.begin()->second;
+            session->Disconnect();
+        }
+    };
+    if (service()->IsStrandRequired())
+        asio::dispatch(strand(), disconnect_all_handler);
+    else
+        asio::dispatch(io_service()->get_executor(), disconnect_all_handler);
+
+    return true;
+}
+
+void RUDPServer::onStarted()
+{
+    // Start receive datagrams
+    ReceiveAsync();
+}
+
+void RUDPServer::onStopped()
+{
+    // Disconnect all sessions without sending reset packets to the closed socket
+    while (!_sessions.empty())
+    {
+        auto session = _sessions.begin()->second;
+        session->DisconnectInternal(false);
+    }
+
+    // Stop ticking sessions
+    _timer.cancel();
+}
+
+void RUDPServer::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    if (size >= RUDPChannel::HEADER_SIZE)
+    {
+        auto it = _sessions.find(endpoint);
+
+        // Replace the stale session of the same endpoint with the first data packet of the new connection epoch
+        if ((it != _sessions.end()) && RUDPChannel::IsFirstPacket(buffer, size) && (RUDPChannel::PacketEpoch(buffer) != it->second->channel().epoch()))
+        {
+            auto session = it->second;
+            session->DisconnectInternal(false);
+            it = _sessions.end();
+        }
+
+        if (it != _sessions.end())
+        {
+            // Receive the datagram in the session
+            auto session = it->second;
+            session->Receive(buffer, size);
+        }
+        else if (RUDPChannel::IsFirstPacket(buffer, size) && ((option_max_sessions() == 0) || (_sessions.size() < option_max_sessions())))
+        {
+            // Create and register a new session on the first data packet of the connection
+            auto self(std::static_pointer_cast<RUDPServer>(this->shared_from_this()));
+            auto session = CreateSession(self, endpoint);
+            _sessions.emplace(endpoint, session);
+
+            // Connect the new session and receive the datagram
+            session->Connect();
+            session->Receive(buffer, size);
+        }
+
+        // Start ticking connected sessions
+        TryTick();
+    }
+
+    // Continue receive datagrams
+    ReceiveAsync();
+}
+
+void RUDPServer::TryTick()
+{
+    if (_ticking || _sessions.empty() || !IsStarted())
+        return;
+
+    _ticking = true;
+
+    // Wait for the next tick
+    auto self(std::static_pointer_cast<RUDPServer>(this->shared_from_this()));
+    auto tick_handler = [this, self](std::error_code ec)
+    {
+        _ticking = false;
+
+        if (ec)
+            return;
+
+        Tick();
+    };
+    _timer.expires_after(std::chrono::nanoseconds(option_tick_interval().total()));
+    if (service()->IsStrandRequired())
+        _timer.async_wait(asio::bind_executor(strand(), tick_handler));
+    else
+        _timer.async_wait(tick_handler);
+}
+
+void RUDPServer::Tick()
+{
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+
+    // Tick all sessions (ticked sessions might be disconnected and unregistered)
+    for (auto& session : _sessions)
+        _ticked_sessions.emplace_back(session.second);
+    for (auto& session : _ticked_sessions)
+        session->Tick(timestamp);
+    _ticked_sessions.clear();
+
+    // Continue ticking connected sessions
+    TryTick();
+}
+
+void RUDPServer::UnregisterSession(const asio::ip::udp::endpoint& endpoint)
+{
+    // Try to find the unregistered session
+    auto it = _sessions.find(endpoint);
+    if (it != _sessions.end())
+    {
+        // Erase the session
+        _sessions.erase(it);
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,113 @@
+/*!
+    \file rudp_session.cpp
+    \brief Reliable UDP session implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_session.h"
+#include "server/asio/rudp_server.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+RUDPSession::RUDPSession(const std::shared_ptr<RUDPServer>& server, const asio::ip::udp::endpoint& endpoint)
+    : _id(CppCommon::UUID::Sequential()),
+      _server(server),
+      _endpoint(endpoint),
+      _channel([this](const void* buffer, size_t size) { return _server->SendAsync(_endpoint, buffer, size); },
+               [this](const void* buffer, size_t size) { onReceivedMessage(buffer, size); },
+               [this](size_t messages) { onDelivered(messages); }),
+      _connected(false),
+      _activity(0)
+{
+}
+
+void RUDPSession::Connect()
+{
+    // Update the last activity timestamp
+    _activity = CppCommon::Timestamp::nano();
+
+    // Update the connected flag
+    _connected = true;
+
+    // Call the session connected handler
+    onConnected();
+
+    // Call the session connected handler in the server
+    auto connected_session(this->shared_from_this());
+    _server->onConnected(connected_session);
+}
+
+bool RUDPSession::Disconnect()
+{
+    if (!IsConnected())
+        return false;
+
+    DisconnectInternal(true);
+    return true;
+}
+
+void RUDPSession::DisconnectInternal(bool reset)
+{
+    if (!IsConnected())
+        return;
+
+    // Notify the client about disconnect
+    if (reset)
+        _channel.SendReset();
+
+    // Update the connected flag
+    _connected = false;
+
+    // Call the session disconnected handler
+    onDisconnected();
+
+    // Call the session disconnected handler in the server
+    auto disconnected_session(this->shared_from_this());
+    _server->onDisconnected(disconnected_session);
+
+    // Reset the channel keeping pooled buffers
+    _channel.Reset();
+
+    // Unregister the session
+    _server->UnregisterSession(_endpoint);
+}
+
+bool RUDPSession::SendReliableAsync(const void* buffer, size_t size, bool ordered)
+{
+    if (!IsConnected())
+        return false;
+
+    return _channel.Send(buffer, size, ordered);
+}
+
+void RUDPSession::Receive(const void* buffer, size_t size)
+{
+    // Update the last activity timestamp
+    _activity = CppCommon::Timestamp::nano();
+
+    // Disconnect the session reset by the client
+    if (!_channel.Receive(buffer, size))
+        DisconnectInternal(false);
+}
+
+void RUDPSession::Tick(uint64_t timestamp)
+{
+    // Disconnect the idle session
+    if ((timestamp - _activity) > (uint64_t)_server->option_session_timeout().total())
+    {
+        DisconnectInternal(true);
+        return;
+    }
+
+    // Disconnect the session with unreachable client
+    if (!_channel.Tick())
+        DisconnectInternal(false);
+}
+
+} // namespace Asio
+} // namespace CppServer
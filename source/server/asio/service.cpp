@@ -45,6 +45,10 @@ Service::Service(int threads, bool pool)
         _strand = std::make_shared<asio::io_context::strand>(*_services[0]);
         _strand_required = true;
     }
+
+    // Create timer wheels of Asio IO services
+    for (auto& service : _services)
+        _wheels.emplace_back(std::make_shared<TimerWheel>(service));
 }
 
 Service::Service(const std::shared_ptr<asio::io_context>& service, bool strands)
@@ -60,6 +64,9 @@ Service::Service(const std::shared_ptr<asio::io_context>& service, bool strands)
     _services.emplace_back(service);
     if (_strand_required)
         _strand = std::make_shared<asio::io_context::strand>(*_services[0]);
+
+    // Create timer wheel of Asio IO service
+    _wheels.emplace_back(std::make_shared<TimerWheel>(service));
 }
 
 bool Service::Start(bool polling)
@@ -152,15 +159,28 @@ bool Service::Restart()
     if (!Stop())
         return false;
 
-    // Reinitialize new Asio IO services
+    // Reinitialize new Asio IO services and their timer wheels
     for (size_t service = 0; service < _services.size(); ++service)
+    {
         _services[service] = std::make_shared<asio::io_context>();
+        _wheels[service] = std::make_shared<TimerWheel>(_services[service]);
+    }
     if (_strand_required)
         _strand = std::make_shared<asio::io_context::strand>(*_services[0]);
 
     return Start(polling);
 }
 
+std::shared_ptr<TimerWheel> Service::GetTimerWheel(const std::shared_ptr<asio::io_context>& io_service) noexcept
+{
+    for (size_t service = 0; service < _services.size(); ++service)
+        if (_services[service] == io_service)
+            return _wheels[service];
+
+    // Foreign Asio IO service has no timer wheel
+    return nullptr;
+}
+
 void Service::ServiceThread(const std::shared_ptr<Service>& service, const std::shared_ptr<asio::io_context>& io_service)
 {
     bool polling = service->IsPolling();
@@ -196,6 +196,9 @@ bool SSLClient::Connect()
     // Call the client connected handler
     onConnected();
 
+    // Restore the previous session of the server endpoint
+    _context->RestoreSession(_stream.native_handle(), _endpoint);
+
     // SSL handshake
     _stream.handshake(asio::ssl::stream_base::client, ec);
 
@@ -208,6 +211,9 @@ bool SSLClient::Connect()
         return false;
     }
 
+    // Update the handshake statistic
+    _context->RegisterHandshake(_stream.native_handle());
+
     // Update the handshaked flag
     _handshaked = true;
 
@@ -284,6 +290,9 @@ bool SSLClient::Connect(const std::shared_ptr<TCPResolver>& resolver)
     // Call the client connected handler
     onConnected();
 
+    // Restore the previous session of the server endpoint
+    _context->RestoreSession(_stream.native_handle(), _endpoint);
+
     // SSL handshake
     _stream.handshake(asio::ssl::stream_base::client, ec);
 
@@ -296,6 +305,9 @@ bool SSLClient::Connect(const std::shared_ptr<TCPResolver>& resolver)
         return false;
     }
 
+    // Update the handshake statistic
+    _context->RegisterHandshake(_stream.native_handle());
+
     // Update the handshaked flag
     _handshaked = true;
 
@@ -400,6 +412,9 @@ bool SSLClient::ConnectAsync()
                 // Call the client connected handler
                 onConnected();
 
+                // Restore the previous session of the server endpoint
+                _context->RestoreSession(_stream.native_handle(), _endpoint);
+
                 // Async SSL handshake with the handshake handler
                 _handshaking = true;
                 auto async_handshake_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec2)
@@ -411,6 +426,9 @@ bool SSLClient::ConnectAsync()
 
                     if (!ec2)
                     {
+                        // Update the handshake statistic
+                        _context->RegisterHandshake(_stream.native_handle());
+
                         // Update the handshaked flag
                         _handshaked = true;
 
@@ -526,6 +544,9 @@ bool SSLClient::ConnectAsync(const std::shared_ptr<TCPResolver>& resolver)
                         // Call the client connected handler
                         onConnected();
 
+                        // Restore the previous session of the server endpoint
+                        _context->RestoreSession(_stream.native_handle(), _endpoint);
+
                         // Async SSL handshake with the handshake handler
                         _handshaking = true;
                         auto async_handshake_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec3)
@@ -537,6 +558,9 @@ bool SSLClient::ConnectAsync(const std::shared_ptr<TCPResolver>& resolver)
 
                             if (!ec3)
                             {
+                                // Update the handshake statistic
+                                _context->RegisterHandshake(_stream.native_handle());
+
                                 // Update the handshaked flag
                                 _handshaked = true;
 
@@ -8,6 +8,30 @@
 
 #include "server/asio/ssl_context.h"
 
+#include "time/timestamp.h"
+
+#include <openssl/rand.h>
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#include <openssl/core_names.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#include <openssl/kdf.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
 #if defined(_WIN32) || defined(_WIN64)
 #include <wincrypt.h>
 #endif
@@ -15,6 +39,143 @@
 namespace CppServer {
 namespace Asio {
 
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+namespace {
+
+// Kernel TLS state of the server SSL connection
+struct KTLSState
+{
+    unsigned char client_secret[EVP_MAX_MD_SIZE];
+    unsigned char server_secret[EVP_MAX_MD_SIZE];
+    size_t client_secret_size{0};
+    size_t server_secret_size{0};
+    uint64_t tickets{0};
+
+    ~KTLSState()
+    {
+        OPENSSL_cleanse(client_secret, sizeof(client_secret));
+        OPENSSL_cleanse(server_secret, sizeof(server_secret));
+    }
+};
+
+// Parse the traffic secret in the hex format
+size_t ParseSecret(std::string_view hex, unsigned char* secret, size_t capacity)
+{
+    if (((hex.size() % 2) != 0) || ((hex.size() / 2) > capacity))
+        return 0;
+
+    auto digit = [](char ch) -> int
+    {
+        if ((ch >= '0') && (ch <= '9'))
+            return ch - '0';
+        if ((ch >= 'a') && (ch <= 'f'))
+            return ch - 'a' + 10;
+        if ((ch >= 'A') && (ch <= 'F'))
+            return ch - 'A' + 10;
+        return -1;
+    };
+
+    for (size_t i = 0; i < hex.size(); i += 2)
+    {
+        int hi = digit(hex[i]);
+        int lo = digit(hex[i + 1]);
+        if ((hi < 0) || (lo < 0))
+            return 0;
+        secret[i / 2] = (unsigned char)((hi << 4) | lo);
+    }
+
+    return hex.size() / 2;
+}
+
+// Derive TLS 1.3 traffic key or IV with HKDF-Expand-Label (RFC 8446)
+bool ExpandLabel(const EVP_MD* md, const unsigned char* secret, size_t secret_size, std::string_view label, unsigned char* output, size_t size)
+{
+    std::string info;
+    info.push_back((char)((size >> 8) & 0xFF));
+    info.push_back((char)(size & 0xFF));
+    info.push_back((char)(6 + label.size()));
+    info.append("tls13 ");
+    info.append(label);
+    info.push_back(0);
+
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+    bool result = (ctx != nullptr) &&
+                  (EVP_PKEY_derive_init(ctx) > 0) &&
+                  (EVP_PKEY_CTX_set_hkdf_mode(ctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0) &&
+                  (EVP_PKEY_CTX_set_hkdf_md(ctx, md) > 0) &&
+                  (EVP_PKEY_CTX_set1_hkdf_key(ctx, secret, (int)secret_size) > 0) &&
+                  (EVP_PKEY_CTX_add1_hkdf_info(ctx, (const unsigned char*)info.data(), (int)info.size()) > 0) &&
+                  (EVP_PKEY_derive(ctx, output, &size) > 0);
+    EVP_PKEY_CTX_free(ctx);
+    return result;
+}
+
+// Derive TLS 1.2 key block from the session master key (RFC 5246)
+bool ExpandKeyBlock(SSL* ssl, const EVP_MD* md, unsigned char* output, size_t size)
+{
+    unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+    unsigned char client_random[SSL3_RANDOM_SIZE];
+    unsigned char server_random[SSL3_RANDOM_SIZE];
+    size_t master_size = SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+    SSL_get_client_random(ssl, client_random, sizeof(client_random));
+    SSL_get_server_random(ssl, server_random, sizeof(server_random));
+
+    static const char label[] = "key expansion";
+
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr);
+    bool result = (ctx != nullptr) && (master_size > 0) &&
+                  (EVP_PKEY_derive_init(ctx) > 0) &&
+                  (EVP_PKEY_CTX_set_tls1_prf_md(ctx, md) > 0) &&
+                  (EVP_PKEY_CTX_set1_tls1_prf_secret(ctx, master, (int)master_size) > 0) &&
+                  (EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, (const unsigned char*)label, (int)(sizeof(label) - 1)) > 0) &&
+                  (EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, server_random, (int)sizeof(server_random)) > 0) &&
+                  (EVP_PKEY_CTX_add1_tls1_prf_seed(ctx, client_random, (int)sizeof(client_random)) > 0) &&
+                  (EVP_PKEY_derive(ctx, output, &size) > 0);
+    EVP_PKEY_CTX_free(ctx);
+    OPENSSL_cleanse(master, sizeof(master));
+    return result;
+}
+
+// Write the big-endian record sequence number
+void WriteSequence(unsigned char* buffer, uint64_t sequence)
+{
+    for (size_t i = 0; i < 8; ++i)
+        buffer[i] = (unsigned char)(sequence >> (8 * (7 - i)));
+}
+
+// Configure kernel TLS crypto for the given direction
+template <typename TCryptoInfo>
+bool SetupCrypto(int socket, int direction, unsigned short version, unsigned short cipher, const unsigned char* key, const unsigned char* iv, uint64_t sequence)
+{
+    TCryptoInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.info.version = version;
+    info.info.cipher_type = cipher;
+    std::memcpy(info.key, key, sizeof(info.key));
+    std::memcpy(info.salt, iv, sizeof(info.salt));
+    std::memcpy(info.iv, iv + sizeof(info.salt), sizeof(info.iv));
+    WriteSequence(info.rec_seq, sequence);
+
+    bool result = (setsockopt(socket, SOL_TLS, direction, &info, sizeof(info)) == 0);
+    OPENSSL_cleanse(&info, sizeof(info));
+    return result;
+}
+
+} // namespace
+
+#endif
+
+SSLContext::~SSLContext()
+{
+    // Release all client sessions
+    std::scoped_lock locker(_sessions_lock);
+    for (auto& session : _sessions)
+        SSL_SESSION_free(session.second);
+    _sessions.clear();
+    _sessions_index.clear();
+}
+
 void SSLContext::set_root_certs()
 {
 #if defined(_WIN32) || defined(_WIN64)
@@ -43,5 +204,536 @@ void SSLContext::set_root_certs()
 #endif
 }
 
+void SSLContext::set_alpn_protocols(const std::vector<std::string>& protocols)
+{
+    // Prepare ALPN protocols in the wire format (length-prefixed strings)
+    _alpn.clear();
+    for (const auto& protocol : protocols)
+    {
+        if (protocol.empty() || (protocol.size() > 255))
+            continue;
+
+        _alpn.push_back((char)protocol.size());
+        _alpn.append(protocol);
+    }
+
+    // Advertise protocols as the client (OpenSSL returns 0 on success)
+    if (SSL_CTX_set_alpn_protos(native_handle(), (const unsigned char*)_alpn.data(), (unsigned int)_alpn.size()) != 0)
+    {
+        unsigned long error = ::ERR_get_error();
+        std::error_code ec = (error != 0) ? std::error_code((int)error, asio::error::get_ssl_category()) : asio::error::make_error_code(asio::error::no_memory);
+        throw asio::system_error(ec, "set_alpn_protocols");
+    }
+
+    // Select protocols as the server
+    SSL_CTX_set_alpn_select_cb(native_handle(), SelectALPN, this);
+}
+
+int SSLContext::SelectALPN(SSL* ssl, const unsigned char** out, unsigned char* outlen, const unsigned char* in, unsigned int inlen, void* arg)
+{
+    SSLContext* context = (SSLContext*)arg;
+
+    unsigned char* selected = nullptr;
+    if (SSL_select_next_proto(&selected, outlen, (const unsigned char*)context->_alpn.data(), (unsigned int)context->_alpn.size(), in, inlen) != OPENSSL_NPN_NEGOTIATED)
+        return SSL_TLSEXT_ERR_NOACK;
+
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+
+void SSLContext::set_session_cache(size_t size, const CppCommon::Timespan& timeout)
+{
+    // Enable the server-side session cache
+    SSL_CTX_set_session_cache_mode(native_handle(), SSL_CTX_get_session_cache_mode(native_handle()) | SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(native_handle(), (long)size);
+    SSL_CTX_set_timeout(native_handle(), (long)std::max(timeout.seconds(), (int64_t)1));
+
+    // Session id context is required to resume sessions with verified client certificates
+    static const char session_id_context[] = "CppServer";
+    SSL_CTX_set_session_id_context(native_handle(), (const unsigned char*)session_id_context, (unsigned int)(sizeof(session_id_context) - 1));
+}
+
+void SSLContext::set_session_tickets(bool enable, const CppCommon::Timespan& rotation)
+{
+    if (!enable)
+    {
+        // Disable session tickets, TLS 1.3 will use stateful tickets from the session cache
+        SSL_CTX_set_options(native_handle(), SSL_OP_NO_TICKET);
+        return;
+    }
+
+    // Prepare new session ticket keys
+    {
+        std::scoped_lock locker(_tickets_lock);
+        _tickets_rotation = rotation;
+        GenerateTicketKey(_tickets[0]);
+        GenerateTicketKey(_tickets[1]);
+        _tickets_rotated = CppCommon::Timestamp::nano();
+    }
+
+    // Encrypt session tickets with own rotating keys
+    SSL_CTX_set_ex_data(native_handle(), ContextIndex(), this);
+    SSL_CTX_clear_options(native_handle(), SSL_OP_NO_TICKET);
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    SSL_CTX_set_tlsext_ticket_key_evp_cb(native_handle(), TicketKeyCallback);
+#else
+    SSL_CTX_set_tlsext_ticket_key_cb(native_handle(), TicketKeyCallback);
+#endif
+}
+
+void SSLContext::rotate_session_ticket_keys()
+{
+    std::scoped_lock locker(_tickets_lock);
+    RotateTicketKeys(true);
+}
+
+void SSLContext::set_session_reuse(bool enable, size_t size)
+{
+    {
+        std::scoped_lock locker(_sessions_lock);
+
+        // Release all client sessions
+        for (auto& session : _sessions)
+            SSL_SESSION_free(session.second);
+        _sessions.clear();
+        _sessions_index.clear();
+
+        _sessions_limit = enable ? std::max(size, (size_t)1) : 0;
+    }
+
+    if (enable)
+    {
+        // Capture new client sessions including TLS 1.3 tickets received after the handshake
+        SSL_CTX_set_ex_data(native_handle(), ContextIndex(), this);
+        SSL_CTX_set_session_cache_mode(native_handle(), SSL_CTX_get_session_cache_mode(native_handle()) | SSL_SESS_CACHE_CLIENT);
+        SSL_CTX_sess_set_new_cb(native_handle(), NewSession);
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(native_handle(), SSL_CTX_get_session_cache_mode(native_handle()) & ~SSL_SESS_CACHE_CLIENT);
+        SSL_CTX_sess_set_new_cb(native_handle(), nullptr);
+    }
+}
+
+void SSLContext::RestoreSession(SSL* ssl, const asio::ip::tcp::endpoint& endpoint)
+{
+    std::scoped_lock locker(_sessions_lock);
+
+    if (_sessions_limit == 0)
+        return;
+
+    std::string key = endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+
+    // Offer the last resumable session of the server endpoint
+    auto it = _sessions_index.find(key);
+    if (it != _sessions_index.end())
+    {
+        auto session = it->second;
+        if (IsResumable(session->second))
+        {
+            SSL_set_session(ssl, session->second);
+
+            // Mark the server endpoint as the most recently used
+            _sessions.splice(_sessions.begin(), _sessions, session);
+        }
+        else
+        {
+            // Forget the session which was already used (e.g. single-use TLS 1.3 ticket)
+            SSL_SESSION_free(session->second);
+            _sessions.erase(session);
+            _sessions_index.erase(it);
+        }
+    }
+
+    // Remember the server endpoint to store new sessions
+    SSL_set_ex_data(ssl, EndpointIndex(), new std::string(std::move(key)));
+}
+
+void SSLContext::RegisterHandshake(SSL* ssl) noexcept
+{
+    ++_handshakes;
+    if (SSL_session_reused(ssl))
+        ++_handshakes_resumed;
+
+    // Store the client session which might be renewed during the handshake
+    std::string* key = (std::string*)SSL_get_ex_data(ssl, EndpointIndex());
+    if (key != nullptr)
+    {
+        SSL_SESSION* session = SSL_get1_session(ssl);
+        if ((session != nullptr) && !StoreSession(*key, session))
+            SSL_SESSION_free(session);
+    }
+}
+
+bool SSLContext::StoreSession(const std::string& key, SSL_SESSION* session)
+{
+    if (!IsResumable(session))
+        return false;
+
+    std::scoped_lock locker(_sessions_lock);
+
+    if (_sessions_limit == 0)
+        return false;
+
+    auto it = _sessions_index.find(key);
+    if (it != _sessions_index.end())
+    {
+        // Replace the previous session of the server endpoint
+        auto previous = it->second;
+        if (previous->second == session)
+            return false;
+        SSL_SESSION_free(previous->second);
+        previous->second = session;
+        _sessions.splice(_sessions.begin(), _sessions, previous);
+    }
+    else
+    {
+        // Evict the least recently used endpoint if the limit is reached
+        if (_sessions.size() >= _sessions_limit)
+        {
+            SSL_SESSION_free(_sessions.back().second);
+            _sessions_index.erase(_sessions.back().first);
+            _sessions.pop_back();
+        }
+        _sessions.emplace_front(key, session);
+        _sessions_index.emplace(key, _sessions.begin());
+    }
+
+    return true;
+}
+
+bool SSLContext::IsResumable(const SSL_SESSION* session) noexcept
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    return SSL_SESSION_is_resumable(session) != 0;
+#else
+    return true;
+#endif
+}
+
+void SSLContext::GenerateTicketKey(TicketKey& key)
+{
+    RAND_bytes(key.name, sizeof(key.name));
+    RAND_bytes(key.aes, sizeof(key.aes));
+    RAND_bytes(key.hmac, sizeof(key.hmac));
+}
+
+void SSLContext::RotateTicketKeys(bool force)
+{
+    // Must be called under the session ticket keys lock
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    if (!force && ((timestamp - _tickets_rotated) < (uint64_t)_tickets_rotation.total()))
+        return;
+
+    // Keep the previous key to accept and renew recently issued tickets
+    _tickets[1] = _tickets[0];
+    GenerateTicketKey(_tickets[0]);
+    _tickets_rotated = timestamp;
+}
+
+int SSLContext::ContextIndex()
+{
+    static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+int SSLContext::EndpointIndex()
+{
+    static int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, [](void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp)
+    {
+        delete (std::string*)ptr;
+    });
+    return index;
+}
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+int SSLContext::TicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cctx, EVP_MAC_CTX* mctx, int enc)
+#else
+int SSLContext::TicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cctx, HMAC_CTX* hctx, int enc)
+#endif
+{
+    SSLContext* context = (SSLContext*)SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ContextIndex());
+    if (context == nullptr)
+        return -1;
+
+    TicketKey key;
+    bool current = true;
+
+    {
+        std::scoped_lock locker(context->_tickets_lock);
+
+        if (enc)
+        {
+            // Encrypt new tickets with the current key
+            context->RotateTicketKeys(false);
+            key = context->_tickets[0];
+        }
+        else
+        {
+            // Find the key which was used to encrypt the ticket
+            size_t index = 0;
+            while ((index < context->_tickets.size()) && (std::memcmp(name, context->_tickets[index].name, sizeof(key.name)) != 0))
+                ++index;
+            if (index == context->_tickets.size())
+                return 0;
+
+            key = context->_tickets[index];
+            current = (index == 0);
+        }
+    }
+
+    if (enc)
+    {
+        std::memcpy(name, key.name, sizeof(key.name));
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) <= 0)
+            return -1;
+        if (!EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, key.aes, iv))
+            return -1;
+    }
+    else
+    {
+        if (!EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, key.aes, iv))
+            return -1;
+    }
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] =
+    {
+        OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac, sizeof(key.hmac)),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end()
+    };
+    if (!EVP_MAC_CTX_set_params(mctx, params))
+        return -1;
+#else
+    if (!HMAC_Init_ex(hctx, key.hmac, sizeof(key.hmac), EVP_sha256(), nullptr))
+        return -1;
+#endif
+
+    // Ask to renew tickets encrypted with the previous key. TLS 1.3 clients
+    // use tickets only once, so always renew them to keep resumption going.
+    return (current && (SSL_version(ssl) != TLS1_3_VERSION)) ? 1 : 2;
+}
+
+int SSLContext::NewSession(SSL* ssl, SSL_SESSION* session)
+{
+    SSLContext* context = (SSLContext*)SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), ContextIndex());
+    std::string* key = (std::string*)SSL_get_ex_data(ssl, EndpointIndex());
+    if ((context == nullptr) || (key == nullptr))
+        return 0;
+
+    // Keep the session reference only if the session was stored
+    return context->StoreSession(*key, session) ? 1 : 0;
+}
+
+void SSLContext::PrepareKTLS()
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    // Capture TLS 1.3 traffic secrets of tracked connections
+    SSL_CTX_set_keylog_callback(native_handle(), KTLSKeylog);
+#endif
+}
+
+void SSLContext::TrackKTLS(SSL* ssl)
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    SSL_set_ex_data(ssl, KTLSIndex(), new KTLSState());
+
+    // Count records protected with application traffic keys during the handshake
+    SSL_set_msg_callback(ssl, KTLSMessage);
+
+    // Kernel TLS cannot handle renegotiation
+    SSL_set_options(ssl, SSL_OP_NO_RENEGOTIATION);
+#endif
+}
+
+void SSLContext::EnableKTLS(SSL* ssl, asio::ip::tcp::socket::native_handle_type socket, bool& send, bool& receive)
+{
+    send = false;
+    receive = false;
+
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    KTLSState* state = (KTLSState*)SSL_get_ex_data(ssl, KTLSIndex());
+    if (state == nullptr)
+        return;
+
+    // Check the protocol version and the cipher suite
+    int version = SSL_version(ssl);
+    if ((version != TLS1_2_VERSION) && (version != TLS1_3_VERSION))
+        return;
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+    if (cipher == nullptr)
+        return;
+    size_t key_size = 0;
+    switch (SSL_CIPHER_get_cipher_nid(cipher))
+    {
+        case NID_aes_128_gcm:
+            key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+            break;
+        case NID_aes_256_gcm:
+            key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+            break;
+        default:
+            return;
+    }
+    const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+    if (md == nullptr)
+        return;
+
+    // Prepare client and server keys and IVs (4 bytes salt + 8 bytes nonce)
+    unsigned char client_key[TLS_CIPHER_AES_GCM_256_KEY_SIZE];
+    unsigned char server_key[TLS_CIPHER_AES_GCM_256_KEY_SIZE];
+    unsigned char client_iv[12];
+    unsigned char server_iv[12];
+    uint64_t send_sequence = 0;
+    uint64_t receive_sequence = 0;
+    bool prepared = false;
+    if (version == TLS1_3_VERSION)
+    {
+        prepared = (state->client_secret_size > 0) && (state->server_secret_size > 0) &&
+                   ExpandLabel(md, state->client_secret, state->client_secret_size, "key", client_key, key_size) &&
+                   ExpandLabel(md, state->client_secret, state->client_secret_size, "iv", client_iv, sizeof(client_iv)) &&
+                   ExpandLabel(md, state->server_secret, state->server_secret_size, "key", server_key, key_size) &&
+                   ExpandLabel(md, state->server_secret, state->server_secret_size, "iv", server_iv, sizeof(server_iv));
+
+        // Session tickets are the only records sent with application traffic keys during the handshake
+        send_sequence = state->tickets;
+        receive_sequence = 0;
+    }
+    else
+    {
+        // Key block: client write key, server write key, client write IV, server write IV
+        unsigned char block[2 * TLS_CIPHER_AES_GCM_256_KEY_SIZE + 2 * 4];
+        prepared = ExpandKeyBlock(ssl, md, block, 2 * key_size + 2 * 4);
+        if (prepared)
+        {
+            std::memcpy(client_key, block, key_size);
+            std::memcpy(server_key, block + key_size, key_size);
+            std::memcpy(client_iv, block + 2 * key_size, 4);
+            std::memcpy(server_iv, block + 2 * key_size + 4, 4);
+        }
+        OPENSSL_cleanse(block, sizeof(block));
+
+        // Finished messages are the only records protected before the application data
+        send_sequence = 1;
+        receive_sequence = 1;
+
+        // Explicit nonces are carried in records, start them from the record sequence
+        WriteSequence(client_iv + 4, receive_sequence);
+        WriteSequence(server_iv + 4, send_sequence);
+    }
+
+    // Attach the kernel TLS upper layer protocol to the socket
+    if (prepared && (setsockopt(socket, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0))
+    {
+        unsigned short kversion = (version == TLS1_3_VERSION) ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+
+        // Offload sending with server keys if all handshake records were flushed
+        if (BIO_wpending(SSL_get_wbio(ssl)) == 0)
+        {
+            if (key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE)
+                send = SetupCrypto<tls12_crypto_info_aes_gcm_128>(socket, TLS_TX, kversion, TLS_CIPHER_AES_GCM_128, server_key, server_iv, send_sequence);
+            else
+                send = SetupCrypto<tls12_crypto_info_aes_gcm_256>(socket, TLS_TX, kversion, TLS_CIPHER_AES_GCM_256, server_key, server_iv, send_sequence);
+        }
+
+        // Offload receiving with client keys if there are no buffered records
+        if (!SSL_has_pending(ssl) && (BIO_pending(SSL_get_rbio(ssl)) == 0))
+        {
+            if (key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE)
+                receive = SetupCrypto<tls12_crypto_info_aes_gcm_128>(socket, TLS_RX, kversion, TLS_CIPHER_AES_GCM_128, client_key, client_iv, receive_sequence);
+            else
+                receive = SetupCrypto<tls12_crypto_info_aes_gcm_256>(socket, TLS_RX, kversion, TLS_CIPHER_AES_GCM_256, client_key, client_iv, receive_sequence);
+        }
+    }
+
+    OPENSSL_cleanse(client_key, sizeof(client_key));
+    OPENSSL_cleanse(server_key, sizeof(server_key));
+    OPENSSL_cleanse(client_iv, sizeof(client_iv));
+    OPENSSL_cleanse(server_iv, sizeof(server_iv));
+
+    // Traffic secrets are not required anymore
+    SSL_set_ex_data(ssl, KTLSIndex(), nullptr);
+    SSL_set_msg_callback(ssl, nullptr);
+    delete state;
+#endif
+}
+
+void SSLContext::CloseKTLS(asio::ip::tcp::socket::native_handle_type socket)
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    // Send the warning level close notify alert as the alert record
+    unsigned char alert[2] = { 1, 0 };
+    char control[CMSG_SPACE(sizeof(unsigned char))];
+    std::memset(control, 0, sizeof(control));
+
+    struct iovec iov = { alert, sizeof(alert) };
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = SSL3_RT_ALERT;
+
+    sendmsg(socket, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+#endif
+}
+
+int SSLContext::KTLSIndex()
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    static int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, [](void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp)
+    {
+        delete (KTLSState*)ptr;
+    });
+    return index;
+#else
+    return -1;
+#endif
+}
+
+void SSLContext::KTLSKeylog(const SSL* ssl, const char* line)
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    KTLSState* state = (KTLSState*)SSL_get_ex_data(ssl, KTLSIndex());
+    if (state == nullptr)
+        return;
+
+    // Keylog line format: <label> <client random> <secret>
+    std::string_view keylog(line);
+    size_t label = keylog.find(' ');
+    size_t random = keylog.find(' ', (label != std::string_view::npos) ? (label + 1) : label);
+    if ((label == std::string_view::npos) || (random == std::string_view::npos))
+        return;
+
+    std::string_view name = keylog.substr(0, label);
+    std::string_view secret = keylog.substr(random + 1);
+    if (name == "CLIENT_TRAFFIC_SECRET_0")
+        state->client_secret_size = ParseSecret(secret, state->client_secret, sizeof(state->client_secret));
+    else if (name == "SERVER_TRAFFIC_SECRET_0")
+        state->server_secret_size = ParseSecret(secret, state->server_secret, sizeof(state->server_secret));
+#endif
+}
+
+void SSLContext::KTLSMessage(int write_p, int version, int content_type, const void* buf, size_t len, SSL* ssl, void* arg)
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    // Each TLS 1.3 session ticket is sent in its own record
+    if (write_p && (content_type == SSL3_RT_HANDSHAKE) && (len > 0) && (((const unsigned char*)buf)[0] == SSL3_MT_NEWSESSION_TICKET))
+    {
+        KTLSState* state = (KTLSState*)SSL_get_ex_data(ssl, KTLSIndex());
+        if (state != nullptr)
+            ++state->tickets;
+    }
+#endif
+}
+
 } // namespace Asio
 } // namespace CppServer
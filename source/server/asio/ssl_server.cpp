@@ -24,10 +24,16 @@ SSLServer::SSLServer(const std::shared_ptr<Service>& service, const std::shared_
       _bytes_pending(0),
       _bytes_sent(0),
       _bytes_received(0),
+      _handshakes_in_flight(0),
+      _handshakes_in_flight_max(0),
+      _handshakes_finished(0),
+      _handshake_latency_total(0),
+      _handshake_latency_max(0),
       _option_keep_alive(false),
       _option_no_delay(false),
       _option_reuse_address(false),
-      _option_reuse_port(false)
+      _option_reuse_port(false),
+      _option_ktls(false)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -63,10 +69,16 @@ SSLServer::SSLServer(const std::shared_ptr<Service>& service, const std::shared_
       _bytes_pending(0),
       _bytes_sent(0),
       _bytes_received(0),
+      _handshakes_in_flight(0),
+      _handshakes_in_flight_max(0),
+      _handshakes_finished(0),
+      _handshake_latency_total(0),
+      _handshake_latency_max(0),
       _option_keep_alive(false),
       _option_no_delay(false),
       _option_reuse_address(false),
-      _option_reuse_port(false)
+      _option_reuse_port(false),
+      _option_ktls(false)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -95,10 +107,16 @@ SSLServer::SSLServer(const std::shared_ptr<Service>& service, const std::shared_
       _bytes_pending(0),
       _bytes_sent(0),
       _bytes_received(0),
+      _handshakes_in_flight(0),
+      _handshakes_in_flight_max(0),
+      _handshakes_finished(0),
+      _handshake_latency_total(0),
+      _handshake_latency_max(0),
       _option_keep_alive(false),
       _option_no_delay(false),
       _option_reuse_address(false),
-      _option_reuse_port(false)
+      _option_reuse_port(false),
+      _option_ktls(false)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -141,6 +159,10 @@ bool SSLServer::Start()
         _bytes_pending = 0;
         _bytes_sent = 0;
         _bytes_received = 0;
+        _handshakes_in_flight_max = 0;
+        _handshakes_finished = 0;
+        _handshake_latency_total = 0;
+        _handshake_latency_max = 0;
 
         // Update the started flag
         _started = true;
@@ -333,6 +355,35 @@ void SSLServer::ClearBuffers()
     _bytes_pending = 0;
 }
 
+void SSLServer::SetupKTLS(bool enable)
+{
+    _option_ktls = enable;
+
+    // Capture traffic secrets of handshakes in the server SSL context
+    if (enable)
+        _context->PrepareKTLS();
+}
+
+void SSLServer::HandshakeStarted() noexcept
+{
+    uint64_t in_flight = ++_handshakes_in_flight;
+
+    // Update the maximal number of handshakes in flight
+    uint64_t in_flight_max = _handshakes_in_flight_max;
+    while ((in_flight > in_flight_max) && !_handshakes_in_flight_max.compare_exchange_weak(in_flight_max, in_flight));
+}
+
+void SSLServer::HandshakeFinished(uint64_t latency) noexcept
+{
+    --_handshakes_in_flight;
+    ++_handshakes_finished;
+    _handshake_latency_total += latency;
+
+    // Update the maximal handshake latency
+    uint64_t latency_max = _handshake_latency_max;
+    while ((latency > latency_max) && !_handshake_latency_max.compare_exchange_weak(latency_max, latency));
+}
+
 void SSLServer::SendError(std::error_code ec)
 {
     // Skip Asio disconnect errors
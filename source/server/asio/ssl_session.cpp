@@ -9,6 +9,17 @@
 #include "server/asio/ssl_session.h"
 #include "server/asio/ssl_server.h"
 
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 namespace CppServer {
 namespace Asio {
 
@@ -21,6 +32,8 @@ SSLSession::SSLSession(const std::shared_ptr<SSLServer>& server)
       _stream(*_io_service, *server->context()),
       _connected(false),
       _handshaked(false),
+      _ktls_send(false),
+      _ktls_receive(false),
       _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
@@ -87,6 +100,16 @@ void SSLSession::Connect()
     auto connected_session(this->shared_from_this());
     _server->onConnected(connected_session);
 
+    // Update the handshake statistic
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    _server->HandshakeStarted();
+
+    // Track the handshake to offload the session to kernel TLS
+    _ktls_send = false;
+    _ktls_receive = false;
+    if (_server->option_ktls())
+        _server->context()->TrackKTLS(_stream.native_handle());
+
     // Async SSL handshake with the handshake handler
     auto self(this->shared_from_this());
     auto async_handshake_handler = [this, self](std::error_code ec)
@@ -96,6 +119,13 @@ void SSLSession::Connect()
 
         if (!ec)
         {
+            // Update the handshake statistic
+            _server->context()->RegisterHandshake(_stream.native_handle());
+
+            // Offload the session data path to kernel TLS
+            if (_server->option_ktls())
+                SSLContext::EnableKTLS(_stream.native_handle(), socket().native_handle(), _ktls_send, _ktls_receive);
+
             // Update the handshaked flag
             _handshaked = true;
 
@@ -120,10 +150,39 @@ void SSLSession::Connect()
             Disconnect(ec);
         }
     };
-    if (_strand_required)
-        _stream.async_handshake(asio::ssl::stream_base::server, bind_executor(_strand, async_handshake_handler));
+
+    auto async_local_handler = [this, self, timestamp, async_handshake_handler](std::error_code ec)
+    {
+        // Update the handshake statistic
+        _server->HandshakeFinished(CppCommon::Timestamp::nano() - timestamp);
+
+        async_handshake_handler(ec);
+    };
+    auto async_offload_handler = [this, self, timestamp, async_handshake_handler](std::error_code ec)
+    {
+        // Update the handshake statistic
+        _server->HandshakeFinished(CppCommon::Timestamp::nano() - timestamp);
+
+        // Migrate the session back to its IO service
+        auto migrate_handler = [ec, async_handshake_handler]() { async_handshake_handler(ec); };
+        if (_strand_required)
+            asio::post(_strand, migrate_handler);
+        else
+            asio::post(_io_service->get_executor(), migrate_handler);
+    };
+
+    // SSL engine performs the handshake on the executor associated with the
+    // completion handler, so binding it to the handshake service moves the
+    // handshake cryptography to its threads while the socket stays bound to
+    // the session IO service. Not started handshake service would never call
+    // the handler, so the handshake is performed locally in this case.
+    auto& handshake_service = _server->_handshake_service;
+    if (handshake_service && handshake_service->IsStarted())
+        _stream.async_handshake(asio::ssl::stream_base::server, bind_executor(handshake_service->GetAsioService()->get_executor(), async_offload_handler));
+    else if (_strand_required)
+        _stream.async_handshake(asio::ssl::stream_base::server, bind_executor(_strand, async_local_handler));
     else
-        _stream.async_handshake(asio::ssl::stream_base::server, async_handshake_handler);
+        _stream.async_handshake(asio::ssl::stream_base::server, async_local_handler);
 }
 
 void SSLSession::Disconnect(std::error_code ec)
@@ -183,6 +242,14 @@ bool SSLSession::DisconnectAsync(bool dispatch)
         // Cancel the session socket
         socket().cancel(ec);
 
+        // SSL stream cannot send the close notify alert after kernel TLS offload
+        if (_ktls_send)
+        {
+            SSLContext::CloseKTLS(socket().native_handle());
+            Disconnect(ec);
+            return;
+        }
+
         // Async SSL shutdown with the shutdown handler
         auto async_shutdown_handler = [this, self](std::error_code ec2) { Disconnect(ec2); };
         if (_strand_required)
@@ -220,10 +287,21 @@ size_t SSLSession::Send(const void* buffer, size_t size)
     if (buffer == nullptr)
         return 0;
 
+    return Send({ asio::const_buffer(buffer, size) });
+}
+
+size_t SSLSession::Send(std::initializer_list<asio::const_buffer> buffers)
+{
+    if (!IsHandshaked())
+        return 0;
+
+    if (asio::buffer_size(buffers) == 0)
+        return 0;
+
     asio::error_code ec;
 
-    // Send data to the client
-    size_t sent = asio::write(_stream, asio::buffer(buffer, size), ec);
+    // Send data chunks to the client with a single gather write
+    size_t sent = _ktls_send ? asio::write(socket(), buffers, ec) : asio::write(_stream, buffers, ec);
     if (sent > 0)
     {
         // Update statistic
@@ -244,6 +322,101 @@ size_t SSLSession::Send(const void* buffer, size_t size)
     return sent;
 }
 
+size_t SSLSession::SendFile(const std::string& path, uint64_t offset, size_t size)
+{
+    if (!IsHandshaked())
+        return 0;
+
+    if (size == 0)
+        return 0;
+
+#if defined(__linux__)
+    // Send the file content from the page cache to the kernel TLS socket
+    if (_ktls_send)
+    {
+        int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return 0;
+
+        std::error_code ec;
+        size_t sent = 0;
+        off_t position = (off_t)offset;
+        while (sent < size)
+        {
+            ssize_t result = ::sendfile(socket().native_handle(), file, &position, std::min(size - sent, (size_t)0x7FFFF000));
+            if (result > 0)
+            {
+                sent += (size_t)result;
+                continue;
+            }
+
+            // End of the file
+            if (result == 0)
+                break;
+
+            int error = errno;
+            if (error == EINTR)
+                continue;
+
+            // Wait for the writable socket
+            if ((error == EAGAIN) || (error == EWOULDBLOCK))
+            {
+                socket().wait(asio::ip::tcp::socket::wait_write, ec);
+                if (ec)
+                    break;
+                continue;
+            }
+
+            ec = std::error_code(error, asio::error::get_system_category());
+            break;
+        }
+
+        ::close(file);
+
+        if (sent > 0)
+        {
+            // Update statistic
+            _bytes_sent += sent;
+            _server->_bytes_sent += sent;
+
+            // Call the buffer sent handler
+            onSent(sent, bytes_pending());
+        }
+
+        // Disconnect on error
+        if (ec)
+        {
+            SendError(ec);
+            Disconnect(ec);
+        }
+
+        return sent;
+    }
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file || !file.seekg((std::streamoff)offset))
+        return 0;
+
+    // Read and send the file content in chunks of the maximal TLS record size
+    char chunk[16384];
+    size_t sent = 0;
+    while (sent < size)
+    {
+        file.read(chunk, (std::streamsize)std::min(size - sent, sizeof(chunk)));
+        size_t read = (size_t)file.gcount();
+        if (read == 0)
+            break;
+
+        size_t result = Send(chunk, read);
+        sent += result;
+        if (result < read)
+            break;
+    }
+
+    return sent;
+}
+
 size_t SSLSession::Send(const void* buffer, size_t size, const CppCommon::Timespan& timeout)
 {
     if (!IsHandshaked())
@@ -281,7 +454,10 @@ size_t SSLSession::Send(const void* buffer, size_t size, const CppCommon::Timesp
 
     // Async write some data to the client
     size_t sent = 0;
-    _stream.async_write_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
+    if (_ktls_send)
+        socket().async_write_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
+    else
+        _stream.async_write_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
 
     // Wait for complete or timeout
     std::unique_lock<std::mutex> lck(mtx);
@@ -320,6 +496,18 @@ bool SSLSession::SendAsync(const void* buffer, size_t size)
     if (buffer == nullptr)
         return false;
 
+    return SendAsync({ asio::const_buffer(buffer, size) });
+}
+
+bool SSLSession::SendAsync(std::initializer_list<asio::const_buffer> buffers)
+{
+    if (!IsHandshaked())
+        return false;
+
+    size_t size = asio::buffer_size(buffers);
+    if (size == 0)
+        return true;
+
     {
         std::scoped_lock locker(_send_lock);
 
@@ -334,8 +522,11 @@ bool SSLSession::SendAsync(const void* buffer, size_t size)
         }
 
         // Fill the main send buffer
-        const uint8_t* bytes = (const uint8_t*)buffer;
-        _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + size);
+        for (const auto& buffer : buffers)
+        {
+            const uint8_t* bytes = (const uint8_t*)buffer.data();
+            _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + buffer.size());
+        }
 
         // Update statistic
         _bytes_pending = _send_buffer_main.size();
@@ -375,7 +566,7 @@ size_t SSLSession::Receive(void* buffer, size_t size)
     asio::error_code ec;
 
     // Receive data from the client
-    size_t received = _stream.read_some(asio::buffer(buffer, size), ec);
+    size_t received = _ktls_receive ? socket().read_some(asio::buffer(buffer, size), ec) : _stream.read_some(asio::buffer(buffer, size), ec);
     if (received > 0)
     {
         // Update statistic
@@ -386,6 +577,10 @@ size_t SSLSession::Receive(void* buffer, size_t size)
         onReceived(buffer, received);
     }
 
+    // Kernel TLS fails to receive non-application records (e.g. close notify alert)
+    if (ec && _ktls_receive && (ec == std::errc::io_error))
+        ec = asio::error::eof;
+
     // Disconnect on error
     if (ec)
     {
@@ -440,7 +635,10 @@ size_t SSLSession::Receive(void* buffer, size_t size, const CppCommon::Timespan&
 
     // Async read some data from the client
     size_t received = 0;
-    _stream.async_read_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t read) { async_done_handler(ec); received = read; });
+    if (_ktls_receive)
+        socket().async_read_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t read) { async_done_handler(ec); received = read; });
+    else
+        _stream.async_read_some(asio::buffer(buffer, size), [&](std::error_code ec, size_t read) { async_done_handler(ec); received = read; });
 
     // Wait for complete or timeout
     std::unique_lock<std::mutex> lck(mtx);
@@ -457,6 +655,10 @@ size_t SSLSession::Receive(void* buffer, size_t size, const CppCommon::Timespan&
         onReceived(buffer, received);
     }
 
+    // Kernel TLS fails to receive non-application records (e.g. close notify alert)
+    if (error && _ktls_receive && (error == std::errc::io_error))
+        error = asio::error::eof;
+
     // Disconnect on error
     if (error && (error != asio::error::timed_out))
     {
@@ -523,6 +725,10 @@ void SSLSession::TryReceive()
             }
         }
 
+        // Kernel TLS fails to receive non-application records (e.g. close notify alert)
+        if (ec && _ktls_receive && (ec == std::errc::io_error))
+            ec = asio::error::eof;
+
         // Try to receive again if the session is valid
         if (!ec)
             TryReceive();
@@ -532,10 +738,20 @@ void SSLSession::TryReceive()
             Disconnect(ec);
         }
     });
-    if (_strand_required)
-        _stream.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+    if (_ktls_receive)
+    {
+        if (_strand_required)
+            socket().async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+        else
+            socket().async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+    }
     else
-        _stream.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+    {
+        if (_strand_required)
+            _stream.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+        else
+            _stream.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+    }
 }
 
 void SSLSession::TrySend()
@@ -610,10 +826,20 @@ void SSLSession::TrySend()
             Disconnect(ec);
         }
     });
-    if (_strand_required)
-        _stream.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), bind_executor(_strand, async_write_handler));
+    if (_ktls_send)
+    {
+        if (_strand_required)
+            socket().async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), bind_executor(_strand, async_write_handler));
+        else
+            socket().async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), async_write_handler);
+    }
     else
-        _stream.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), async_write_handler);
+    {
+        if (_strand_required)
+            _stream.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), bind_executor(_strand, async_write_handler));
+        else
+            _stream.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), async_write_handler);
+    }
 }
 
 void SSLSession::ClearBuffers()
@@ -26,7 +26,9 @@ TCPSession::TCPSession(const std::shared_ptr<TCPServer>& server)
       _bytes_received(0),
       _receiving(false),
       _sending(false),
-      _send_buffer_flush_offset(0)
+      _send_buffer_flush_offset(0),
+      _send_shared_main_size(0),
+      _send_shared_flush_size(0)
 {
 }
 
@@ -64,6 +66,8 @@ void TCPSession::Connect()
     // Apply the option: no delay
     if (_server->option_no_delay())
         _socket.set_option(asio::ip::tcp::no_delay(true));
+    // Apply the option: receive timestamps
+    _timestamp = _server->option_receive_timestamp() && ReceiveTimestamp::Setup(_socket.native_handle());
 
     // Prepare receive & send buffers
     _receive_buffer.resize(option_receive_buffer_size());
@@ -75,6 +79,7 @@ void TCPSession::Connect()
     _bytes_sending = 0;
     _bytes_sent = 0;
     _bytes_received = 0;
+    _receive_timestamp = 0;
 
     // Update the connected flag
     _connected = true;
@@ -166,10 +171,21 @@ size_t TCPSession::Send(const void* buffer, size_t size)
     if (buffer == nullptr)
         return 0;
 
+    return Send({ asio::const_buffer(buffer, size) });
+}
+
+size_t TCPSession::Send(std::initializer_list<asio::const_buffer> buffers)
+{
+    if (!IsConnected())
+        return 0;
+
+    if (asio::buffer_size(buffers) == 0)
+        return 0;
+
     asio::error_code ec;
 
-    // Send data to the client
-    size_t sent = asio::write(_socket, asio::buffer(buffer, size), ec);
+    // Send data chunks to the client with a single gather write
+    size_t sent = asio::write(_socket, buffers, ec);
     if (sent > 0)
     {
         // Update statistic
@@ -266,25 +282,93 @@ bool TCPSession::SendAsync(const void* buffer, size_t size)
     if (buffer == nullptr)
         return false;
 
+    return SendAsync({ asio::const_buffer(buffer, size) });
+}
+
+bool TCPSession::SendAsync(std::initializer_list<asio::const_buffer> buffers)
+{
+    if (!IsConnected())
+        return false;
+
+    size_t size = asio::buffer_size(buffers);
+    if (size == 0)
+        return true;
+
     {
         std::scoped_lock locker(_send_lock);
 
         // Detect multiple send handlers
-        bool send_required = _send_buffer_main.empty() || _send_buffer_flush.empty();
+        bool send_required = (_send_buffer_main.empty() && _send_shared_main.empty()) || (_send_buffer_flush.empty() && _send_shared_flush.empty());
 
         // Check the send buffer limit
-        if (((_send_buffer_main.size() + size) > _send_buffer_limit) && (_send_buffer_limit > 0))
+        if (((_send_buffer_main.size() + _send_shared_main_size + size) > _send_buffer_limit) && (_send_buffer_limit > 0))
         {
             SendError(asio::error::no_buffer_space);
             return false;
         }
 
         // Fill the main send buffer
-        const uint8_t* bytes = (const uint8_t*)buffer;
-        _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + size);
+        for (const auto& buffer : buffers)
+        {
+            const uint8_t* bytes = (const uint8_t*)buffer.data();
+            _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + buffer.size());
+        }
+
+        // Update statistic
+        _bytes_pending = _send_buffer_main.size() + _send_shared_main_size;
+
+        // Avoid multiple send handlers
+        if (!send_required)
+            return true;
+    }
+
+    // Dispatch the send handler
+    auto self(this->shared_from_this());
+    auto send_handler = [this, self]()
+    {
+        // Try to send the main buffer
+        TrySend();
+    };
+    if (_strand_required)
+        asio::dispatch(_strand, send_handler);
+    else
+        asio::dispatch(_io_service->get_executor(), send_handler);
+
+    return true;
+}
+
+bool TCPSession::SendAsync(const std::shared_ptr<const std::vector<uint8_t>>& buffer)
+{
+    if (!IsConnected())
+        return false;
+
+    assert((buffer != nullptr) && "Pointer to the shared buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    size_t size = buffer->size();
+    if (size == 0)
+        return true;
+
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Detect multiple send handlers
+        bool send_required = (_send_buffer_main.empty() && _send_shared_main.empty()) || (_send_buffer_flush.empty() && _send_shared_flush.empty());
+
+        // Check the send buffer limit
+        if (((_send_buffer_main.size() + _send_shared_main_size + size) > _send_buffer_limit) && (_send_buffer_limit > 0))
+        {
+            SendError(asio::error::no_buffer_space);
+            return false;
+        }
+
+        // Reference the shared buffer at the end of the main send buffer
+        _send_shared_main.emplace_back(_send_buffer_main.size(), buffer);
+        _send_shared_main_size += size;
 
         // Update statistic
-        _bytes_pending = _send_buffer_main.size();
+        _bytes_pending = _send_buffer_main.size() + _send_shared_main_size;
 
         // Avoid multiple send handlers
         if (!send_required)
@@ -434,54 +518,111 @@ void TCPSession::TryReceive()
     if (!IsConnected())
         return;
 
+#if defined(__linux__)
+    // Receive data with receive timestamps
+    if (_timestamp)
+    {
+        TryReceiveTimestamp();
+        return;
+    }
+#endif
+
     // Async receive with the receive handler
     _receiving = true;
     auto self(this->shared_from_this());
     auto async_receive_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec, size_t size)
     {
-        _receiving = false;
+        ReceiveComplete(ec, size);
+    });
+    if (_strand_required)
+        _socket.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+    else
+        _socket.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+}
 
-        if (!IsConnected())
+#if defined(__linux__)
+void TCPSession::TryReceiveTimestamp()
+{
+    // Async wait for the readable socket with the wait handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec)
+    {
+        if (ec)
+        {
+            ReceiveComplete(ec, 0);
             return;
+        }
 
-        // Received some data from the client
-        if (size > 0)
+        // Receive data with the receive timestamp without blocking
+        socklen_t address_size = 0;
+        ssize_t result = ReceiveTimestamp::Receive(_socket.native_handle(), _receive_buffer.data(), _receive_buffer.size(), nullptr, address_size, _receive_timestamp);
+        if (result < 0)
         {
-            // Update statistic
-            _bytes_received += size;
-            _server->_bytes_received += size;
+            int error = errno;
 
-            // Call the buffer received handler
-            onReceived(_receive_buffer.data(), size);
-
-            // If the receive buffer is full increase its size
-            if (_receive_buffer.size() == size)
+            // Wait for the next wakeup if the socket readiness was spurious
+            if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
             {
-                // Check the receive buffer limit
-                if (((2 * size) > _receive_buffer_limit) && (_receive_buffer_limit > 0))
-                {
-                    SendError(asio::error::no_buffer_space);
-                    Disconnect(true);
-                    return;
-                }
-
-                _receive_buffer.resize(2 * size);
+                _receiving = false;
+                TryReceive();
+                return;
             }
-        }
 
-        // Try to receive again if the session is valid
-        if (!ec)
-            TryReceive();
-        else
-        {
-            SendError(ec);
-            Disconnect(true);
+            ReceiveComplete(std::error_code(error, asio::error::get_system_category()), 0);
+            return;
         }
+
+        // Zero size receive means the connection was closed by the peer
+        ReceiveComplete((result > 0) ? ec : asio::error::eof, (size_t)result);
     });
     if (_strand_required)
-        _socket.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+        _socket.async_wait(asio::ip::tcp::socket::wait_read, bind_executor(_strand, async_wait_handler));
     else
-        _socket.async_read_some(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+        _socket.async_wait(asio::ip::tcp::socket::wait_read, async_wait_handler);
+}
+#endif
+
+void TCPSession::ReceiveComplete(std::error_code ec, size_t size)
+{
+    _receiving = false;
+
+    if (!IsConnected())
+        return;
+
+    // Received some data from the client
+    if (size > 0)
+    {
+        // Update statistic
+        _bytes_received += size;
+        _server->_bytes_received += size;
+
+        // Call the buffer received handler
+        onReceived(_receive_buffer.data(), size);
+
+        // If the receive buffer is full increase its size
+        if (_receive_buffer.size() == size)
+        {
+            // Check the receive buffer limit
+            if (((2 * size) > _receive_buffer_limit) && (_receive_buffer_limit > 0))
+            {
+                SendError(asio::error::no_buffer_space);
+                Disconnect(true);
+                return;
+            }
+
+            _receive_buffer.resize(2 * size);
+        }
+    }
+
+    // Try to receive again if the session is valid
+    if (!ec)
+        TryReceive();
+    else
+    {
+        SendError(ec);
+        Disconnect(true);
+    }
 }
 
 void TCPSession::TrySend()
@@ -493,7 +634,7 @@ void TCPSession::TrySend()
         return;
 
     // Swap send buffers
-    if (_send_buffer_flush.empty())
+    if (_send_buffer_flush.empty() && _send_shared_flush.empty())
     {
         std::scoped_lock locker(_send_lock);
 
@@ -501,13 +642,18 @@ void TCPSession::TrySend()
         _send_buffer_flush.swap(_send_buffer_main);
         _send_buffer_flush_offset = 0;
 
+        // Swap flush and main shared buffers
+        _send_shared_flush.swap(_send_shared_main);
+        _send_shared_flush_size = _send_shared_main_size;
+        _send_shared_main_size = 0;
+
         // Update statistic
         _bytes_pending = 0;
-        _bytes_sending += _send_buffer_flush.size();
+        _bytes_sending += _send_buffer_flush.size() + _send_shared_flush_size;
     }
 
     // Check if the flush buffer is empty
-    if (_send_buffer_flush.empty())
+    if (_send_buffer_flush.empty() && _send_shared_flush.empty())
     {
         // Call the empty send buffer handler
         onEmpty();
@@ -536,11 +682,15 @@ void TCPSession::TrySend()
             _send_buffer_flush_offset += size;
 
             // Successfully send the whole flush buffer
-            if (_send_buffer_flush_offset == _send_buffer_flush.size())
+            if (_send_buffer_flush_offset == (_send_buffer_flush.size() + _send_shared_flush_size))
             {
                 // Clear the flush buffer
                 _send_buffer_flush.clear();
                 _send_buffer_flush_offset = 0;
+
+                // Release shared buffers
+                _send_shared_flush.clear();
+                _send_shared_flush_size = 0;
             }
 
             // Call the buffer sent handler
@@ -556,10 +706,55 @@ void TCPSession::TrySend()
             Disconnect(true);
         }
     });
-    if (_strand_required)
-        _socket.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), bind_executor(_strand, async_write_handler));
+    if (_send_shared_flush.empty())
+    {
+        if (_strand_required)
+            _socket.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), bind_executor(_strand, async_write_handler));
+        else
+            _socket.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), async_write_handler);
+    }
     else
-        _socket.async_write_some(asio::buffer(_send_buffer_flush.data() + _send_buffer_flush_offset, _send_buffer_flush.size() - _send_buffer_flush_offset), async_write_handler);
+    {
+        // Gather write of the flush buffer with shared buffers
+        PrepareSendBuffers();
+        if (_strand_required)
+            _socket.async_write_some(_send_buffers, bind_executor(_strand, async_write_handler));
+        else
+            _socket.async_write_some(_send_buffers, async_write_handler);
+    }
+}
+
+void TCPSession::PrepareSendBuffers()
+{
+    // Limit gather buffers with the maximal count of buffers per write operation
+    const size_t max_buffers = 64;
+
+    _send_buffers.clear();
+
+    size_t skip = _send_buffer_flush_offset;
+    auto append = [this, &skip, max_buffers](const uint8_t* data, size_t size)
+    {
+        // Skip already sent data
+        if (skip >= size)
+        {
+            skip -= size;
+            return;
+        }
+
+        if (_send_buffers.size() < max_buffers)
+            _send_buffers.emplace_back(data + skip, size - skip);
+        skip = 0;
+    };
+
+    // Interleave the flush buffer with shared buffers at their insert positions
+    size_t position = 0;
+    for (const auto& shared : _send_shared_flush)
+    {
+        append(_send_buffer_flush.data() + position, shared.first - position);
+        append(shared.second->data(), shared.second->size());
+        position = shared.first;
+    }
+    append(_send_buffer_flush.data() + position, _send_buffer_flush.size() - position);
 }
 
 void TCPSession::ClearBuffers()
@@ -572,6 +767,12 @@ void TCPSession::ClearBuffers()
         _send_buffer_flush.clear();
         _send_buffer_flush_offset = 0;
 
+        // Release shared send buffers
+        _send_shared_main.clear();
+        _send_shared_flush.clear();
+        _send_shared_main_size = 0;
+        _send_shared_flush_size = 0;
+
         // Update statistic
         _bytes_pending = 0;
         _bytes_sending = 0;
@@ -110,6 +110,10 @@ bool Timer::Setup(const CppCommon::UtcTime& time)
     asio::error_code ec;
     _timer.expires_at(time.chrono());
 
+    // Changing the expiry time cancels the pending timer wheel wait
+    if (_wheel && _wheel->Cancel(_wheel_handle))
+        SendWheelCancel();
+
     // Check for error
     if (ec)
     {
@@ -125,6 +129,10 @@ bool Timer::Setup(const CppCommon::Timespan& timespan)
     asio::error_code ec;
     _timer.expires_at(std::chrono::system_clock::now() + timespan.chrono());
 
+    // Changing the expiry time cancels the pending timer wheel wait
+    if (_wheel && _wheel->Cancel(_wheel_handle))
+        SendWheelCancel();
+
     // Check for error
     if (ec)
     {
@@ -165,8 +173,49 @@ bool Timer::Setup(const std::function<void(bool)>& action, const CppCommon::Time
     return Setup(timespan);
 }
 
+void Timer::SetupTimerWheel(bool enable)
+{
+    if (!enable)
+    {
+        if (_wheel && _wheel->Cancel(_wheel_handle))
+            SendWheelCancel();
+        _wheel.reset();
+        return;
+    }
+
+    if (_wheel)
+        return;
+
+    _wheel = _service->GetTimerWheel(_io_service);
+    if (!_wheel)
+        return;
+
+    // Setup the timer wheel action once to keep waits allocation free
+    std::weak_ptr<Timer> weak(weak_from_this());
+    bool strand_required = _strand_required;
+    _wheel_handle.Setup([weak, strand_required]()
+    {
+        auto self = weak.lock();
+        if (!self)
+            return;
+
+        // Call the timer expired handler
+        if (strand_required)
+            asio::post(self->_strand, [self]() { self->SendTimer(false); });
+        else
+            self->SendTimer(false);
+    });
+}
+
 bool Timer::WaitAsync()
 {
+    // Plan the wait in the timer wheel
+    if (_wheel)
+    {
+        auto timeout = CppCommon::Timespan(_timer.expiry() - std::chrono::system_clock::now());
+        return _wheel->Schedule(_wheel_handle, timeout);
+    }
+
     auto self(this->shared_from_this());
     auto async_wait_handler = [this, self](const std::error_code& ec)
     {
@@ -216,6 +265,10 @@ bool Timer::WaitSync()
 
 bool Timer::Cancel()
 {
+    // Cancel the pending timer wheel wait
+    if (_wheel && _wheel->Cancel(_wheel_handle))
+        SendWheelCancel();
+
     asio::error_code ec;
     _timer.cancel();
 
@@ -238,6 +291,17 @@ void Timer::SendError(std::error_code ec)
     onError(ec.value(), ec.category().name(), ec.message());
 }
 
+void Timer::SendWheelCancel()
+{
+    // Post the timer aborted handler like the canceled Asio timer does
+    auto self(this->shared_from_this());
+    auto cancel_handler = [this, self]() { SendTimer(true); };
+    if (_strand_required)
+        asio::post(_strand, cancel_handler);
+    else
+        asio::post(*_io_service, cancel_handler);
+}
+
 void Timer::SendTimer(bool canceled)
 {
     // Call the timer handler
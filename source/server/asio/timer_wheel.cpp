@@ -0,0 +1,296 @@
+/*!
+    \file timer_wheel.cpp
+    \brief Timer wheel implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/timer_wheel.h"
+
+#include "errors/exceptions.h"
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CppServer {
+namespace Asio {
+
+TimerWheel::TimerWheel(const std::shared_ptr<asio::io_context>& io_service, const CppCommon::Timespan& resolution)
+    : _io_service(io_service),
+      _timer(*_io_service),
+      _ticking(false),
+      _resolution((uint64_t)std::max(resolution.total(), (int64_t)1)),
+      _origin(CppCommon::Timestamp::nano()),
+      _current(0),
+      _size(0),
+      _expired(nullptr),
+      _running(nullptr)
+{
+    assert((io_service != nullptr) && "Asio IO service is invalid!");
+    if (io_service == nullptr)
+        throw CppCommon::ArgumentException("Asio IO service is invalid!");
+
+    for (auto& level : _slots)
+        level.fill(nullptr);
+}
+
+TimerWheel::~TimerWheel()
+{
+    // Detach all scheduled handles
+    for (auto& level : _slots)
+    {
+        for (auto& slot : level)
+        {
+            for (Handle* handle = slot; handle != nullptr; handle = handle->_next)
+            {
+                handle->_slot = nullptr;
+                handle->_wheel = nullptr;
+            }
+            slot = nullptr;
+        }
+    }
+}
+
+bool TimerWheel::Schedule(Handle& handle, const CppCommon::Timespan& timeout)
+{
+    std::scoped_lock locker(_lock);
+
+    if ((handle._wheel != nullptr) && (handle._wheel != this))
+        return false;
+
+    // Reschedule already scheduled handle
+    if ((handle._wheel == this) && (handle._slot != nullptr))
+    {
+        Unlink(handle);
+        --_size;
+    }
+
+    uint64_t now = CppCommon::Timestamp::nano();
+
+    // Synchronize the empty timer wheel with the current time
+    if (_size == 0)
+        _current = std::max(_current, ToTick(now));
+
+    // Calculate the expire tick rounded up to the timer wheel resolution
+    uint64_t delay = (uint64_t)std::max(timeout.total(), (int64_t)0);
+    uint64_t expire = ToTick(now + delay + _resolution - 1);
+    handle._expire = std::max(expire, _current + 1);
+    handle._wheel = this;
+    Link(handle);
+    ++_size;
+
+    // Start ticking the Asio timer
+    if (!_ticking)
+    {
+        _ticking = true;
+        Tick();
+    }
+
+    return true;
+}
+
+bool TimerWheel::Cancel(Handle& handle)
+{
+    std::scoped_lock locker(_lock);
+
+    if ((handle._wheel != this) || (handle._slot == nullptr))
+        return false;
+
+    Unlink(handle);
+    --_size;
+
+    // Handle whose action is being called is detached after the call
+    if (&handle != _running)
+        handle._wheel = nullptr;
+    return true;
+}
+
+void TimerWheel::Release(Handle& handle)
+{
+    std::scoped_lock locker(_lock);
+
+    if (handle._wheel != this)
+        return;
+
+    if (handle._slot != nullptr)
+    {
+        Unlink(handle);
+        --_size;
+    }
+    handle._wheel = nullptr;
+
+    // Do not move the action back into the destroyed handle
+    if (&handle == _running)
+        _running = nullptr;
+}
+
+size_t TimerWheel::Expire(uint64_t timestamp)
+{
+    {
+        std::scoped_lock locker(_lock);
+
+        uint64_t target = ToTick(timestamp);
+        while (_current < target)
+        {
+            // Skip ticks of the empty timer wheel
+            if (_size == 0)
+            {
+                _current = target;
+                break;
+            }
+
+            ++_current;
+
+            // Cascade higher levels once per rotation of the lower level
+            for (size_t level = 1; level < LEVELS; ++level)
+            {
+                if (((_current >> (LEVEL_BITS * (level - 1))) & LEVEL_MASK) != 0)
+                    break;
+                Cascade(level, (_current >> (LEVEL_BITS * level)) & LEVEL_MASK);
+            }
+
+            // Expire the current slot of the lowest level
+            Cascade(0, _current & LEVEL_MASK);
+        }
+    }
+
+    // Call expired actions releasing the lock for each call
+    std::unique_lock<std::mutex> locker(_lock);
+    size_t expired = 0;
+    while (_expired != nullptr)
+    {
+        Handle* handle = _expired;
+        Unlink(*handle);
+        --_size;
+        ++expired;
+
+        // Move the action out of the handle, its owner may destroy the handle during the call
+        _running = handle;
+        _action.swap(handle->_action);
+
+        locker.unlock();
+        if (_action)
+            _action();
+        locker.lock();
+
+        if (_running == handle)
+        {
+            // Move the action back unless it was replaced during the call
+            if (!handle->_action)
+                handle->_action.swap(_action);
+
+            // Detaching the handle which was not rescheduled by its action must be the last access
+            _running = nullptr;
+            if (handle->_slot == nullptr)
+                handle->_wheel = nullptr;
+        }
+
+        // Destroy the action of the released handle without holding the lock
+        if (_action)
+        {
+            locker.unlock();
+            _action = nullptr;
+            locker.lock();
+        }
+    }
+
+    return expired;
+}
+
+void TimerWheel::Link(Handle& handle) noexcept
+{
+    uint64_t delta = handle._expire - _current;
+
+    // Find the lowest level which covers the handle expire tick
+    size_t level = 0;
+    while ((level < (LEVELS - 1)) && (delta >= ((uint64_t)1 << (LEVEL_BITS * (level + 1)))))
+        ++level;
+
+    // Clamp too far expire tick into the highest level, the handle will be cascaded again
+    uint64_t expire = (delta < RANGE) ? handle._expire : (_current + RANGE - 1);
+
+    Handle*& head = _slots[level][(expire >> (LEVEL_BITS * level)) & LEVEL_MASK];
+    handle._prev = nullptr;
+    handle._next = head;
+    handle._slot = &head;
+    if (head != nullptr)
+        head->_prev = &handle;
+    head = &handle;
+}
+
+void TimerWheel::Unlink(Handle& handle) noexcept
+{
+    if (handle._prev != nullptr)
+        handle._prev->_next = handle._next;
+    else if (handle._slot != nullptr)
+        *handle._slot = handle._next;
+    if (handle._next != nullptr)
+        handle._next->_prev = handle._prev;
+
+    handle._prev = nullptr;
+    handle._next = nullptr;
+    handle._slot = nullptr;
+}
+
+void TimerWheel::Cascade(size_t level, size_t slot)
+{
+    // Detach the whole slot list
+    Handle* handle = _slots[level][slot];
+    _slots[level][slot] = nullptr;
+
+    while (handle != nullptr)
+    {
+        Handle* next = handle->_next;
+        handle->_prev = nullptr;
+        handle->_next = nullptr;
+        handle->_slot = nullptr;
+
+        if (handle->_expire <= _current)
+        {
+            // Move the handle into the expired list
+            handle->_next = _expired;
+            handle->_slot = &_expired;
+            if (_expired != nullptr)
+                _expired->_prev = handle;
+            _expired = handle;
+        }
+        else
+        {
+            // Move the handle into the lower level
+            Link(*handle);
+        }
+
+        handle = next;
+    }
+}
+
+void TimerWheel::Tick()
+{
+    std::weak_ptr<TimerWheel> weak(weak_from_this());
+    auto async_wait_handler = [weak](const std::error_code& ec)
+    {
+        if (ec)
+            return;
+
+        auto self = weak.lock();
+        if (!self)
+            return;
+
+        // Expire handles up to the current time
+        self->Expire(CppCommon::Timestamp::nano());
+
+        // Continue ticking only while there are scheduled handles
+        std::scoped_lock locker(self->_lock);
+        if (self->_size > 0)
+            self->Tick();
+        else
+            self->_ticking = false;
+    };
+    _timer.expires_after(std::chrono::nanoseconds(_resolution));
+    _timer.async_wait(async_wait_handler);
+}
+
+} // namespace Asio
+} // namespace CppServer
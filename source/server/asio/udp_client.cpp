@@ -8,6 +8,9 @@
 
 #include "server/asio/udp_client.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace CppServer {
 namespace Asio {
 
@@ -22,7 +25,10 @@ UDPClient::UDPClient(const std::shared_ptr<Service>& service, const std::string&
       _socket(*_io_service),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -50,7 +56,10 @@ UDPClient::UDPClient(const std::shared_ptr<Service>& service, const std::string&
       _socket(*_io_service),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -78,7 +87,10 @@ UDPClient::UDPClient(const std::shared_ptr<Service>& service, const asio::ip::ud
       _socket(*_io_service),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -154,12 +166,19 @@ bool UDPClient::Connect()
     // Prepare receive buffer
     _receive_buffer.resize(option_receive_buffer_size());
 
+    // Setup receive timestamps
+    _timestamp = option_receive_timestamp() && ReceiveTimestamp::Setup(_socket.native_handle());
+
     // Reset statistic
+    _bytes_pending = 0;
+    _datagrams_pending = 0;
     _bytes_sending = 0;
+    _datagrams_sending = 0;
     _bytes_sent = 0;
     _bytes_received = 0;
     _datagrams_sent = 0;
     _datagrams_received = 0;
+    _receive_timestamp = 0;
 
     // Update the connected flag
     _connected = true;
@@ -223,12 +242,19 @@ bool UDPClient::Connect(const std::shared_ptr<UDPResolver>& resolver)
     // Prepare receive buffer
     _receive_buffer.resize(option_receive_buffer_size());
 
+    // Setup receive timestamps
+    _timestamp = option_receive_timestamp() && ReceiveTimestamp::Setup(_socket.native_handle());
+
     // Reset statistic
+    _bytes_pending = 0;
+    _datagrams_pending = 0;
     _bytes_sending = 0;
+    _datagrams_sending = 0;
     _bytes_sent = 0;
     _bytes_received = 0;
     _datagrams_sent = 0;
     _datagrams_received = 0;
+    _receive_timestamp = 0;
 
     // Update the connected flag
     _connected = true;
@@ -337,12 +363,19 @@ bool UDPClient::ConnectAsync(const std::shared_ptr<UDPResolver>& resolver)
                 // Prepare receive buffer
                 _receive_buffer.resize(option_receive_buffer_size());
 
+                // Setup receive timestamps
+                _timestamp = option_receive_timestamp() && ReceiveTimestamp::Setup(_socket.native_handle());
+
                 // Reset statistic
+                _bytes_pending = 0;
+                _datagrams_pending = 0;
                 _bytes_sending = 0;
+                _datagrams_sending = 0;
                 _bytes_sent = 0;
                 _bytes_received = 0;
                 _datagrams_sent = 0;
                 _datagrams_received = 0;
+                _receive_timestamp = 0;
 
                 // Update the connected flag
                 _connected = true;
@@ -591,9 +624,6 @@ bool UDPClient::SendAsync(const void* buffer, size_t size)
 
 bool UDPClient::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
 {
-    if (_sending)
-        return false;
-
     if (!IsConnected())
         return false;
 
@@ -604,59 +634,43 @@ bool UDPClient::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* b
     if (buffer == nullptr)
         return false;
 
-    // Check the send buffer limit
-    if ((size > _send_buffer_limit) && (_send_buffer_limit > 0))
-    {
-        SendError(asio::error::no_buffer_space);
-        return false;
-    }
-
-    // Fill the main send buffer
-    const uint8_t* bytes = (const uint8_t*)buffer;
-    _send_buffer.assign(bytes, bytes + size);
-
-    // Update statistic
-    _bytes_sending = _send_buffer.size();
-
-    // Update send endpoint
-    _send_endpoint = endpoint;
-
-    // Async send-to with the send-to handler
-    _sending = true;
-    auto self(this->shared_from_this());
-    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
     {
-        _sending = false;
-
-        if (!IsConnected())
-            return;
+        std::scoped_lock locker(_send_lock);
 
-        // Disconnect on error
-        if (ec)
+        // Check the send buffer and send queue limits
+        if ((((_bytes_pending + _bytes_sending + size) > _send_buffer_limit) && (_send_buffer_limit > 0)) ||
+            (((_datagrams_pending + _datagrams_sending) >= _send_queue_limit) && (_send_queue_limit > 0)))
         {
-            SendError(ec);
-            DisconnectInternalAsync(true);
-            return;
+            SendError(asio::error::no_buffer_space);
+            return false;
         }
 
-        // Send some data to the server
-        if (sent > 0)
-        {
-            // Update statistic
-            _bytes_sending = 0;
-            _bytes_sent += sent;
+        // Only the first datagram of the empty main send queue requires the send handler
+        bool send_required = _send_queue_main.empty();
 
-            // Clear the send buffer
-            _send_buffer.clear();
+        // Push the datagram into the main send queue
+        _send_queue_main.Push(endpoint, buffer, size);
 
-            // Call the buffer sent handler
-            onSent(_send_endpoint, sent);
-        }
-    });
+        // Update statistic
+        _bytes_pending = _send_queue_main.bytes();
+        _datagrams_pending = _send_queue_main.size();
+
+        // Avoid multiple send handlers
+        if (!send_required)
+            return true;
+    }
+
+    // Dispatch the send handler
+    auto self(this->shared_from_this());
+    auto send_handler = [this, self]()
+    {
+        // Try to send queued datagrams
+        TrySend();
+    };
     if (_strand_required)
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, bind_executor(_strand, async_send_to_handler));
+        asio::dispatch(_strand, send_handler);
     else
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, async_send_to_handler);
+        asio::dispatch(*_io_service, send_handler);
 
     return true;
 }
@@ -783,10 +797,35 @@ void UDPClient::TryReceive()
     if (!IsConnected())
         return;
 
+#if defined(__linux__)
+    // Receive datagrams with receive timestamps
+    if (_timestamp)
+    {
+        TryReceiveTimestamp();
+        return;
+    }
+#endif
+
     // Async receive with the receive handler
     _receiving = true;
     auto self(this->shared_from_this());
     auto async_receive_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec, size_t size)
+    {
+        ReceiveComplete(ec, size);
+    });
+    if (_strand_required)
+        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
+    else
+        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
+}
+
+#if defined(__linux__)
+void UDPClient::TryReceiveTimestamp()
+{
+    // Async wait for the readable socket with the wait handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec)
     {
         _receiving = false;
 
@@ -801,40 +840,251 @@ void UDPClient::TryReceive()
             return;
         }
 
-        // Update statistic
-        ++_datagrams_received;
-        _bytes_received += size;
-
-        // Call the datagram received handler
-        onReceived(_receive_endpoint, _receive_buffer.data(), size);
-
-        // If the receive buffer is full increase its size
-        if (_receive_buffer.size() == size)
+        // Receive the datagram with its receive timestamp without blocking
+        socklen_t address_size = (socklen_t)_receive_endpoint.capacity();
+        ssize_t result = ReceiveTimestamp::Receive(_socket.native_handle(), _receive_buffer.data(), _receive_buffer.size(), _receive_endpoint.data(), address_size, _receive_timestamp);
+        if (result < 0)
         {
-            // Check the receive buffer limit
-            if (((2 * size) > _receive_buffer_limit) && (_receive_buffer_limit > 0))
+            int error = errno;
+
+            // Wait for the next wakeup if the socket readiness was spurious
+            if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
             {
-                SendError(asio::error::no_buffer_space);
-                DisconnectInternalAsync(true);
+                TryReceiveTimestamp();
                 return;
             }
 
-            _receive_buffer.resize(2 * size);
+            ReceiveComplete(std::error_code(error, asio::error::get_system_category()), 0);
+            return;
         }
+        _receive_endpoint.resize(address_size);
+
+        // Truncated datagram fills the receive buffer, so it will be increased
+        ReceiveComplete(ec, (size_t)result);
     });
     if (_strand_required)
-        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
+        _socket.async_wait(asio::ip::udp::socket::wait_read, bind_executor(_strand, async_wait_handler));
     else
-        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
+        _socket.async_wait(asio::ip::udp::socket::wait_read, async_wait_handler);
+}
+#endif
+
+void UDPClient::ReceiveComplete(std::error_code ec, size_t size)
+{
+    _receiving = false;
+
+    if (!IsConnected())
+        return;
+
+    // Disconnect on error
+    if (ec)
+    {
+        SendError(ec);
+        DisconnectInternalAsync(true);
+        return;
+    }
+
+    // Update statistic
+    ++_datagrams_received;
+    _bytes_received += size;
+
+    // Call the datagram received handler
+    onReceived(_receive_endpoint, _receive_buffer.data(), size);
+
+    // If the receive buffer is full increase its size
+    if (_receive_buffer.size() == size)
+    {
+        // Check the receive buffer limit
+        if (((2 * size) > _receive_buffer_limit) && (_receive_buffer_limit > 0))
+        {
+            SendError(asio::error::no_buffer_space);
+            DisconnectInternalAsync(true);
+            return;
+        }
+
+        _receive_buffer.resize(2 * size);
+    }
+}
+
+bool UDPClient::SwapSendQueues()
+{
+    if (_send_queue.empty())
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Swap flush and main send queues
+        _send_queue.swap(_send_queue_main);
+
+        // Update statistic
+        _bytes_pending = 0;
+        _datagrams_pending = 0;
+        _bytes_sending = _send_queue.bytes();
+        _datagrams_sending = _send_queue.size();
+    }
+
+    return !_send_queue.empty();
+}
+
+void UDPClient::TrySend()
+{
+    if (_sending)
+        return;
+
+    if (!IsConnected())
+        return;
+
+    if (!SwapSendQueues())
+        return;
+
+    _sending = true;
+
+#if defined(__linux__)
+    // Send batches of queued datagrams with sendmmsg() while the socket accepts them without blocking
+    size_t batch = _send_queue.size();
+    while ((batch > 0) && !_send_queue.empty() && IsConnected())
+    {
+        size_t count = std::min(std::min(batch, _send_queue.size()), BATCH_MAX);
+        _send_batch_messages.resize(std::max(_send_batch_messages.size(), count));
+        _send_batch_iovecs.resize(std::max(_send_batch_iovecs.size(), count));
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& datagram = _send_queue[i];
+            _send_batch_iovecs[i].iov_base = datagram.buffer.data();
+            _send_batch_iovecs[i].iov_len = datagram.buffer.size();
+            std::memset(&_send_batch_messages[i], 0, sizeof(mmsghdr));
+            _send_batch_messages[i].msg_hdr.msg_name = datagram.endpoint.data();
+            _send_batch_messages[i].msg_hdr.msg_namelen = (socklen_t)datagram.endpoint.size();
+            _send_batch_messages[i].msg_hdr.msg_iov = &_send_batch_iovecs[i];
+            _send_batch_messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int result = ::sendmmsg(_socket.native_handle(), _send_batch_messages.data(), (unsigned)count, MSG_DONTWAIT);
+        if (result <= 0)
+        {
+            int error = errno;
+            if ((result == 0) || (error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+                break;
+
+            _sending = false;
+            SendComplete(std::error_code(error, asio::error::get_system_category()), 0);
+            return;
+        }
+
+        // Complete sent datagrams
+        batch -= result;
+        for (int i = 0; i < result; ++i)
+            if (!SendComplete(std::error_code(), _send_batch_messages[i].msg_len))
+                break;
+    }
+#elif (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    // Send a batch of queued datagrams while the socket accepts them without blocking
+    size_t batch = _send_queue.size();
+    while ((batch-- > 0) && !_send_queue.empty() && IsConnected())
+    {
+        auto& datagram = _send_queue.front();
+        ssize_t result = ::sendto(_socket.native_handle(), datagram.buffer.data(), datagram.buffer.size(), MSG_DONTWAIT, datagram.endpoint.data(), (socklen_t)datagram.endpoint.size());
+        if (result < 0)
+        {
+            int error = errno;
+            if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+                break;
+
+            _sending = false;
+            SendComplete(std::error_code(error, asio::error::get_system_category()), 0);
+            return;
+        }
+
+        SendComplete(std::error_code(), (size_t)result);
+    }
+#endif
+#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    // Wait for the socket to become writable only if some datagrams are left
+    if (_send_queue.empty() || !IsConnected())
+    {
+        _sending = false;
+
+        // Send datagrams queued by other threads while sending
+        if (IsConnected() && SwapSendQueues())
+        {
+            auto self(this->shared_from_this());
+            auto send_handler = [this, self]() { TrySend(); };
+            if (_strand_required)
+                asio::post(_strand, send_handler);
+            else
+                asio::post(*_io_service, send_handler);
+        }
+        return;
+    }
+#endif
+
+    // Async send-to the front queued datagram with the send-to handler
+    auto self(this->shared_from_this());
+    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
+    {
+        _sending = false;
+
+        if (!IsConnected())
+            return;
+
+        // Complete the sent datagram and try to send the rest of queued datagrams
+        if (SendComplete(ec, sent))
+            TrySend();
+    });
+    auto& datagram = _send_queue.front();
+    if (_strand_required)
+        _socket.async_send_to(asio::buffer(datagram.buffer.data(), datagram.buffer.size()), datagram.endpoint, bind_executor(_strand, async_send_to_handler));
+    else
+        _socket.async_send_to(asio::buffer(datagram.buffer.data(), datagram.buffer.size()), datagram.endpoint, async_send_to_handler);
+}
+
+bool UDPClient::SendComplete(std::error_code ec, size_t sent)
+{
+    // Disconnect on error
+    if (ec)
+    {
+        SendError(ec);
+        DisconnectInternalAsync(true);
+        return false;
+    }
+
+    if (_send_queue.empty())
+        return false;
+
+    // Pop the completed datagram from the send queue
+    asio::ip::udp::endpoint endpoint = _send_queue.front().endpoint;
+    _send_queue.Pop();
+
+    // Update statistic
+    ++_datagrams_sent;
+    _bytes_sending = _send_queue.bytes();
+    _datagrams_sending = _send_queue.size();
+    _bytes_sent += sent;
+
+    // Call the buffer sent handler
+    onSent(endpoint, sent);
+
+    return true;
 }
 
 void UDPClient::ClearBuffers()
 {
-    // Clear send buffers
-    _send_buffer.clear();
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Clear the main send queue
+        _send_queue_main.Clear();
+
+        // Update statistic
+        _bytes_pending = 0;
+        _datagrams_pending = 0;
+    }
+
+    // Clear the flush send queue
+    _send_queue.Clear();
 
     // Update statistic
     _bytes_sending = 0;
+    _datagrams_sending = 0;
 }
 
 void UDPClient::SendError(std::error_code ec)
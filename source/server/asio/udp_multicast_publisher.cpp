@@ -0,0 +1,356 @@
+/*!
+    \file udp_multicast_publisher.cpp
+    \brief UDP multicast publisher implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/udp_multicast_publisher.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Packet flags
+constexpr uint8_t FLAG_RETRANSMIT = 0x01;
+
+// Retransmit rate limit period and packets copied from the history at once
+constexpr uint64_t RETRANSMIT_PERIOD = 1000000000;
+constexpr size_t RETRANSMIT_CHUNK = 64;
+
+void WriteUInt32(uint8_t* buffer, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        buffer[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint32_t ReadUInt32(const uint8_t* buffer)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i)
+        value |= (uint32_t)buffer[i] << (8 * i);
+    return value;
+}
+
+void WriteUInt64(uint8_t* buffer, uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        buffer[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint64_t ReadUInt64(const uint8_t* buffer)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i)
+        value |= (uint64_t)buffer[i] << (8 * i);
+    return value;
+}
+
+void WriteHeader(uint8_t* buffer, UDPMulticastPublisher::PacketType type, uint8_t flags, uint32_t session, uint64_t sequence)
+{
+    buffer[0] = (uint8_t)type;
+    buffer[1] = flags;
+    buffer[2] = 0;
+    buffer[3] = 0;
+    WriteUInt32(buffer + 4, session);
+    WriteUInt64(buffer + 8, sequence);
+}
+
+} // namespace
+
+UDPMulticastPublisher::UDPMulticastPublisher(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol)
+    : UDPServer(service, port, protocol),
+      _session(0),
+      _sequence(1),
+      _published(false),
+      _timer(*io_service()),
+      _messages_published(0),
+      _retransmit_requests(0),
+      _packets_retransmitted(0),
+      _packets_unavailable(0),
+      _packets_limited(0),
+      _option_history_size(65536),
+      _option_heartbeat_interval(CppCommon::Timespan::milliseconds(100)),
+      _option_multicast_retransmit(false),
+      _option_retransmit_rate_limit(16384)
+{
+}
+
+UDPMulticastPublisher::UDPMulticastPublisher(const std::shared_ptr<Service>& service, const std::string& address, int port)
+    : UDPServer(service, address, port),
+      _session(0),
+      _sequence(1),
+      _published(false),
+      _timer(*io_service()),
+      _messages_published(0),
+      _retransmit_requests(0),
+      _packets_retransmitted(0),
+      _packets_unavailable(0),
+      _packets_limited(0),
+      _option_history_size(65536),
+      _option_heartbeat_interval(CppCommon::Timespan::milliseconds(100)),
+      _option_multicast_retransmit(false),
+      _option_retransmit_rate_limit(16384)
+{
+}
+
+UDPMulticastPublisher::UDPMulticastPublisher(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint)
+    : UDPServer(service, endpoint),
+      _session(0),
+      _sequence(1),
+      _published(false),
+      _timer(*io_service()),
+      _messages_published(0),
+      _retransmit_requests(0),
+      _packets_retransmitted(0),
+      _packets_unavailable(0),
+      _packets_limited(0),
+      _option_history_size(65536),
+      _option_heartbeat_interval(CppCommon::Timespan::milliseconds(100)),
+      _option_multicast_retransmit(false),
+      _option_retransmit_rate_limit(16384)
+{
+}
+
+bool UDPMulticastPublisher::Publish(const void* buffer, size_t size)
+{
+    if (!IsStarted())
+        return false;
+
+    if (size > MAX_MESSAGE_SIZE)
+        return false;
+
+    assert(((buffer != nullptr) || (size == 0)) && "Pointer to the buffer should not be null!");
+    if ((buffer == nullptr) && (size > 0))
+        return false;
+
+    std::scoped_lock locker(_publish_lock);
+
+    // The history is prepared when the publisher is started
+    if (_history.empty())
+        return false;
+
+    // Frame the message into the pooled history packet
+    uint64_t sequence = _sequence++;
+    auto& packet = _history[sequence % _history.size()];
+    packet.resize(HEADER_SIZE + size);
+    WriteHeader(packet.data(), PacketType::Data, 0, _session, sequence);
+    if (size > 0)
+        std::memcpy(packet.data() + HEADER_SIZE, buffer, size);
+
+    // Update statistic
+    ++_messages_published;
+    _published = true;
+
+    // Multicast the packet (lost packets are recovered from the history)
+    Multicast(packet.data(), packet.size());
+
+    return true;
+}
+
+void UDPMulticastPublisher::onStarted()
+{
+    {
+        std::scoped_lock locker(_publish_lock);
+
+        // Start the new publisher session
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        _session = (uint32_t)(timestamp ^ (timestamp >> 32));
+        _sequence = 1;
+        _published = false;
+
+        // Prepare the history keeping pooled packet buffers
+        _history.resize(std::max(_option_history_size, (size_t)1));
+
+        // Reset statistic
+        _messages_published = 0;
+        _retransmit_requests = 0;
+        _packets_retransmitted = 0;
+        _packets_unavailable = 0;
+        _packets_limited = 0;
+    }
+
+    // Release retransmit budgets of the previous session
+    _retransmit_budgets.clear();
+
+    // Start receive retransmit requests
+    ReceiveAsync();
+
+    // Start multicasting heartbeats
+    TryHeartbeat();
+}
+
+void UDPMulticastPublisher::onStopped()
+{
+    // Stop multicasting heartbeats
+    _timer.cancel();
+}
+
+void UDPMulticastPublisher::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    const uint8_t* request = (const uint8_t*)buffer;
+
+    // Serve the retransmit request of the current session
+    if ((size == REQUEST_SIZE) && (request[0] == (uint8_t)PacketType::Request) && (ReadUInt32(request + 4) == _session))
+        Retransmit(endpoint, ReadUInt64(request + 8), ReadUInt32(request + 16));
+
+    // Continue receive retransmit requests
+    ReceiveAsync();
+}
+
+void UDPMulticastPublisher::Retransmit(const asio::ip::udp::endpoint& endpoint, uint64_t first, uint32_t count)
+{
+    const asio::ip::udp::endpoint& target = _option_multicast_retransmit ? multicast_endpoint() : endpoint;
+
+    ++_retransmit_requests;
+
+    // Clamp the requested count with the subscriber reorder window
+    uint64_t requested = std::min((uint64_t)count, (uint64_t)MAX_RETRANSMIT_COUNT);
+
+    uint64_t last;
+    uint64_t unavailable = 0;
+    uint8_t unavailable_packet[REQUEST_SIZE];
+    {
+        std::scoped_lock locker(_publish_lock);
+
+        if (_history.empty())
+            return;
+
+        // Clamp the requested range with published packets
+        last = std::min(first + requested, _sequence.load());
+        uint64_t oldest = (_sequence > _history.size()) ? (_sequence - _history.size()) : 1;
+        if (first >= last)
+            return;
+
+        // Prepare the answer of packets which left the history
+        if (first < oldest)
+        {
+            unavailable = std::min(oldest, last) - first;
+            WriteHeader(unavailable_packet, PacketType::Unavailable, 0, _session, first);
+            WriteUInt32(unavailable_packet + HEADER_SIZE, (uint32_t)unavailable);
+            first = oldest;
+        }
+    }
+
+    // Answer packets which left the history
+    if (unavailable > 0)
+    {
+        Send(target, unavailable_packet, sizeof(unavailable_packet));
+        _packets_unavailable += unavailable;
+    }
+
+    // Clamp the retransmitted range with the retransmit budget of the endpoint
+    if ((first < last) && (_option_retransmit_rate_limit > 0))
+    {
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        auto& budget = _retransmit_budgets[endpoint];
+        if ((timestamp - budget.timestamp) >= RETRANSMIT_PERIOD)
+        {
+            budget.timestamp = timestamp;
+            budget.packets = 0;
+        }
+
+        uint64_t available = (budget.packets < _option_retransmit_rate_limit) ? (_option_retransmit_rate_limit - budget.packets) : 0;
+        if ((last - first) > available)
+        {
+            _packets_limited += (last - first) - available;
+            last = first + available;
+        }
+        budget.packets += last - first;
+    }
+
+    // Retransmit packets from the history copying them in chunks under the lock and sending outside of it
+    while (first < last)
+    {
+        size_t chunk = (size_t)std::min(last - first, (uint64_t)RETRANSMIT_CHUNK);
+        if (_retransmit_packets.size() < chunk)
+            _retransmit_packets.resize(chunk);
+
+        {
+            std::scoped_lock locker(_publish_lock);
+
+            // Stop if the rest of packets left the history while sending (subscribers will request them again)
+            uint64_t oldest = (_sequence > _history.size()) ? (_sequence - _history.size()) : 1;
+            if (first < oldest)
+                break;
+
+            for (size_t i = 0; i < chunk; ++i)
+            {
+                auto& packet = _retransmit_packets[i];
+                packet = _history[(first + i) % _history.size()];
+                packet[1] = FLAG_RETRANSMIT;
+            }
+        }
+
+        for (size_t i = 0; i < chunk; ++i)
+        {
+            auto& packet = _retransmit_packets[i];
+            Send(target, packet.data(), packet.size());
+        }
+
+        _packets_retransmitted += chunk;
+        first += chunk;
+    }
+}
+
+void UDPMulticastPublisher::TryHeartbeat()
+{
+    if (!IsStarted())
+        return;
+
+    // Wait for the next heartbeat
+    auto self(std::static_pointer_cast<UDPMulticastPublisher>(this->shared_from_this()));
+    auto heartbeat_handler = [this, self](std::error_code ec)
+    {
+        if (ec || !IsStarted())
+            return;
+
+        Heartbeat();
+    };
+    _timer.expires_after(std::chrono::nanoseconds(option_heartbeat_interval().total()));
+    if (service()->IsStrandRequired())
+        _timer.async_wait(asio::bind_executor(strand(), heartbeat_handler));
+    else
+        _timer.async_wait(heartbeat_handler);
+}
+
+void UDPMulticastPublisher::Heartbeat()
+{
+    {
+        std::scoped_lock locker(_publish_lock);
+
+        // Multicast the next sequence number of the idle publisher
+        if (!_published)
+        {
+            uint8_t packet[HEADER_SIZE];
+            WriteHeader(packet, PacketType::Heartbeat, 0, _session, _sequence);
+            Multicast(packet, sizeof(packet));
+        }
+
+        _published = false;
+    }
+
+    // Release expired retransmit budgets
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    for (auto it = _retransmit_budgets.begin(); it != _retransmit_budgets.end();)
+    {
+        if ((timestamp - it->second.timestamp) >= RETRANSMIT_PERIOD)
+            it = _retransmit_budgets.erase(it);
+        else
+            ++it;
+    }
+
+    // Continue multicasting heartbeats
+    TryHeartbeat();
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,442 @@
+/*!
+    \file udp_multicast_subscriber.cpp
+    \brief UDP multicast subscriber implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/udp_multicast_subscriber.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+void WriteUInt32(uint8_t* buffer, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        buffer[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint32_t ReadUInt32(const uint8_t* buffer)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i)
+        value |= (uint32_t)buffer[i] << (8 * i);
+    return value;
+}
+
+void WriteUInt64(uint8_t* buffer, uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+        buffer[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint64_t ReadUInt64(const uint8_t* buffer)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i)
+        value |= (uint64_t)buffer[i] << (8 * i);
+    return value;
+}
+
+} // namespace
+
+UDPMulticastSubscriber::UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, int port)
+    : UDPClient(service, address, port),
+      _session(0),
+      _synchronized(false),
+      _window(REORDER_WINDOW),
+      _expected(0),
+      _end(0),
+      _request_sequence(0),
+      _request_timestamp(0),
+      _request_retries(0),
+      _timer(*io_service()),
+      _ticking(false),
+      _messages_received(0),
+      _messages_recovered(0),
+      _messages_lost(0),
+      _gaps_detected(0),
+      _retransmit_requests(0),
+      _packets_duplicated(0),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_request_timeout(CppCommon::Timespan::milliseconds(50)),
+      _option_request_retries(5)
+{
+}
+
+UDPMulticastSubscriber::UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, const std::string& scheme)
+    : UDPClient(service, address, scheme),
+      _session(0),
+      _synchronized(false),
+      _window(REORDER_WINDOW),
+      _expected(0),
+      _end(0),
+      _request_sequence(0),
+      _request_timestamp(0),
+      _request_retries(0),
+      _timer(*io_service()),
+      _ticking(false),
+      _messages_received(0),
+      _messages_recovered(0),
+      _messages_lost(0),
+      _gaps_detected(0),
+      _retransmit_requests(0),
+      _packets_duplicated(0),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_request_timeout(CppCommon::Timespan::milliseconds(50)),
+      _option_request_retries(5)
+{
+}
+
+UDPMulticastSubscriber::UDPMulticastSubscriber(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint)
+    : UDPClient(service, endpoint),
+      _session(0),
+      _synchronized(false),
+      _window(REORDER_WINDOW),
+      _expected(0),
+      _end(0),
+      _request_sequence(0),
+      _request_timestamp(0),
+      _request_retries(0),
+      _timer(*io_service()),
+      _ticking(false),
+      _messages_received(0),
+      _messages_recovered(0),
+      _messages_lost(0),
+      _gaps_detected(0),
+      _retransmit_requests(0),
+      _packets_duplicated(0),
+      _option_tick_interval(CppCommon::Timespan::milliseconds(10)),
+      _option_request_timeout(CppCommon::Timespan::milliseconds(50)),
+      _option_request_retries(5)
+{
+}
+
+void UDPMulticastSubscriber::onConnected()
+{
+    // Reset the subscriber state keeping pooled buffers
+    _session = 0;
+    _synchronized = false;
+    for (auto& slot : _window)
+        slot.received = false;
+    _expected = 0;
+    _end = 0;
+    _request_sequence = 0;
+    _request_timestamp = 0;
+    _request_retries = 0;
+
+    // Reset statistic
+    _messages_received = 0;
+    _messages_recovered = 0;
+    _messages_lost = 0;
+    _gaps_detected = 0;
+    _retransmit_requests = 0;
+    _packets_duplicated = 0;
+
+    // Start receive datagrams
+    ReceiveAsync();
+}
+
+void UDPMulticastSubscriber::onDisconnected()
+{
+    // Stop ticking retransmit requests
+    _timer.cancel();
+}
+
+void UDPMulticastSubscriber::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    const uint8_t* packet = (const uint8_t*)buffer;
+
+    if (size >= UDPMulticastPublisher::HEADER_SIZE)
+    {
+        auto type = (UDPMulticastPublisher::PacketType)packet[0];
+        uint32_t session = ReadUInt32(packet + 4);
+        uint64_t sequence = ReadUInt64(packet + 8);
+
+        // Synchronize with the new publisher session
+        if ((!_synchronized || (session != _session)) && ((type == UDPMulticastPublisher::PacketType::Data) || (type == UDPMulticastPublisher::PacketType::Heartbeat)))
+        {
+            Synchronize(session, sequence);
+            _publisher = endpoint;
+        }
+
+        if (_synchronized && (session == _session))
+        {
+            switch (type)
+            {
+                case UDPMulticastPublisher::PacketType::Data:
+                    ReceiveData(sequence, packet, size);
+                    break;
+                case UDPMulticastPublisher::PacketType::Heartbeat:
+                    Detect(sequence);
+                    break;
+                case UDPMulticastPublisher::PacketType::Unavailable:
+                    if (size == UDPMulticastPublisher::REQUEST_SIZE)
+                        Skip(std::min(sequence + ReadUInt32(packet + UDPMulticastPublisher::HEADER_SIZE), _end));
+                    break;
+                default:
+                    break;
+            }
+
+            // Start ticking retransmit requests
+            TryTick();
+        }
+    }
+
+    // Continue receive datagrams
+    ReceiveAsync();
+}
+
+void UDPMulticastSubscriber::Synchronize(uint32_t session, uint64_t sequence)
+{
+    // Skip missing messages of the previous publisher session
+    if (_synchronized)
+        Skip(_end);
+
+    _session = session;
+    _synchronized = true;
+    _expected = sequence;
+    _end = sequence;
+    _request_sequence = 0;
+    _request_timestamp = 0;
+    _request_retries = 0;
+}
+
+void UDPMulticastSubscriber::ReceiveData(uint64_t sequence, const uint8_t* buffer, size_t size)
+{
+    // Skip the duplicate of the delivered packet
+    if (sequence < _expected)
+    {
+        ++_packets_duplicated;
+        return;
+    }
+
+    // Deliver the message in sequence without copying
+    if ((sequence == _expected) && (_expected == _end))
+    {
+        ++_expected;
+        ++_end;
+        ++_messages_received;
+        onReceivedMessage(sequence, buffer + UDPMulticastPublisher::HEADER_SIZE, size - UDPMulticastPublisher::HEADER_SIZE);
+        return;
+    }
+
+    // Skip missing messages which do not fit into the reorder window
+    if (sequence >= (_expected + REORDER_WINDOW))
+        Skip(sequence - REORDER_WINDOW + 1);
+
+    auto& slot = this->slot(sequence);
+    if (sequence < _end)
+    {
+        // Skip the duplicate of the reordered packet
+        if (slot.received)
+        {
+            ++_packets_duplicated;
+            return;
+        }
+
+        ++_messages_recovered;
+    }
+    else
+    {
+        Detect(sequence);
+        _end = sequence + 1;
+    }
+
+    // Keep the packet in the reorder window
+    slot.buffer.assign(buffer, buffer + size);
+    slot.received = true;
+
+    Deliver();
+}
+
+void UDPMulticastSubscriber::Detect(uint64_t end)
+{
+    if (end <= _end)
+        return;
+
+    // Skip missing messages which do not fit into the reorder window
+    if (end > (_expected + REORDER_WINDOW))
+        Skip(end - REORDER_WINDOW);
+
+    ++_gaps_detected;
+
+    // Request the new gap immediately
+    Request(_end, end - _end);
+    if (_request_timestamp == 0)
+    {
+        _request_sequence = _expected;
+        _request_timestamp = CppCommon::Timestamp::nano();
+    }
+
+    _end = end;
+}
+
+void UDPMulticastSubscriber::Deliver()
+{
+    while ((_expected < _end) && slot(_expected).received)
+    {
+        auto& slot = this->slot(_expected);
+        slot.received = false;
+        ++_messages_received;
+        uint64_t sequence = _expected++;
+        onReceivedMessage(sequence, slot.buffer.data() + UDPMulticastPublisher::HEADER_SIZE, slot.buffer.size() - UDPMulticastPublisher::HEADER_SIZE);
+    }
+
+    // Reset retransmit requests of the recovered gap
+    if (_expected == _end)
+    {
+        _request_timestamp = 0;
+        _request_retries = 0;
+    }
+}
+
+void UDPMulticastSubscriber::Skip(uint64_t end)
+{
+    uint64_t lost = _expected;
+
+    // Skip missing messages and deliver received ones of the reorder window
+    uint64_t known = std::min(end, _end);
+    while (_expected < known)
+    {
+        auto& slot = this->slot(_expected);
+        if (slot.received)
+        {
+            if (lost < _expected)
+            {
+                _messages_lost += _expected - lost;
+                onLost(lost, (size_t)(_expected - lost));
+            }
+            lost = _expected + 1;
+
+            slot.received = false;
+            ++_messages_received;
+            uint64_t sequence = _expected++;
+            onReceivedMessage(sequence, slot.buffer.data() + UDPMulticastPublisher::HEADER_SIZE, slot.buffer.size() - UDPMulticastPublisher::HEADER_SIZE);
+        }
+        else
+            ++_expected;
+    }
+
+    // Skip missing messages beyond the reorder window
+    _expected = std::max(_expected, end);
+    if (lost < _expected)
+    {
+        _messages_lost += _expected - lost;
+        onLost(lost, (size_t)(_expected - lost));
+    }
+
+    _end = std::max(_end, _expected);
+
+    Deliver();
+}
+
+void UDPMulticastSubscriber::Request(uint64_t timestamp)
+{
+    uint64_t first = _expected;
+
+    // Request all runs of missing packets
+    for (uint64_t sequence = _expected; sequence < _end; ++sequence)
+    {
+        if (slot(sequence).received)
+        {
+            if (first < sequence)
+                Request(first, sequence - first);
+            first = sequence + 1;
+        }
+    }
+    if (first < _end)
+        Request(first, _end - first);
+
+    _request_sequence = _expected;
+    _request_timestamp = timestamp;
+}
+
+void UDPMulticastSubscriber::Request(uint64_t first, uint64_t count)
+{
+    uint8_t packet[UDPMulticastPublisher::REQUEST_SIZE];
+    packet[0] = (uint8_t)UDPMulticastPublisher::PacketType::Request;
+    packet[1] = 0;
+    packet[2] = 0;
+    packet[3] = 0;
+    WriteUInt32(packet + 4, _session);
+    WriteUInt64(packet + 8, first);
+    WriteUInt32(packet + UDPMulticastPublisher::HEADER_SIZE, (uint32_t)std::min(count, (uint64_t)REORDER_WINDOW));
+
+    // Send the retransmit request to the publisher
+    if (SendAsync(_publisher, packet, sizeof(packet)))
+        ++_retransmit_requests;
+}
+
+void UDPMulticastSubscriber::TryTick()
+{
+    if (_ticking || (_expected == _end) || !IsConnected())
+        return;
+
+    _ticking = true;
+
+    // Wait for the next tick
+    auto self(std::static_pointer_cast<UDPMulticastSubscriber>(this->shared_from_this()));
+    auto tick_handler = [this, self](std::error_code ec)
+    {
+        _ticking = false;
+
+        if (ec || !IsConnected())
+            return;
+
+        Tick();
+    };
+    _timer.expires_after(std::chrono::nanoseconds(option_tick_interval().total()));
+    if (service()->IsStrandRequired())
+        _timer.async_wait(asio::bind_executor(strand(), tick_handler));
+    else
+        _timer.async_wait(tick_handler);
+}
+
+void UDPMulticastSubscriber::Tick()
+{
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+
+    if (_expected < _end)
+    {
+        // Restart retries when the head of the gap was recovered
+        if (_request_sequence != _expected)
+        {
+            _request_sequence = _expected;
+            _request_retries = 0;
+        }
+
+        if ((timestamp - _request_timestamp) >= (uint64_t)option_request_timeout().total())
+        {
+            // Skip the head of the gap after unanswered retransmit requests
+            if (_request_retries >= option_request_retries())
+            {
+                uint64_t sequence = _expected;
+                while ((sequence < _end) && !slot(sequence).received)
+                    ++sequence;
+                Skip(sequence);
+                _request_retries = 0;
+            }
+
+            // Repeat retransmit requests of missing packets
+            if (_expected < _end)
+            {
+                Request(timestamp);
+                ++_request_retries;
+            }
+        }
+    }
+
+    // Continue ticking retransmit requests
+    TryTick();
+}
+
+} // namespace Asio
+} // namespace CppServer
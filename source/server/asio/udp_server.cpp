@@ -8,6 +8,19 @@
 
 #include "server/asio/udp_server.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/udp.h>
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+#endif
+
 namespace CppServer {
 namespace Asio {
 
@@ -20,7 +33,10 @@ UDPServer::UDPServer(const std::shared_ptr<Service>& service, int port, Internet
       _port(port),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -56,7 +72,10 @@ UDPServer::UDPServer(const std::shared_ptr<Service>& service, const std::string&
       _port(port),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -87,7 +106,10 @@ UDPServer::UDPServer(const std::shared_ptr<Service>& service, const asio::ip::ud
       _endpoint(endpoint),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
+      _datagrams_pending(0),
       _bytes_sending(0),
+      _datagrams_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
@@ -152,15 +174,47 @@ bool UDPServer::Start()
 #endif
         _socket.bind(_endpoint);
 
-        // Prepare receive buffer
-        _receive_buffer.resize(option_receive_buffer_size());
+        // Prepare receive buffer (pooled buffers are acquired on receive)
+        _receive_pooled.reset();
+        if (!_option_receive_pool)
+            _receive_buffer.resize(option_receive_buffer_size());
+
+#if defined(__linux__)
+        // Detect and setup UDP segmentation offloads
+        int gso = 0;
+        int gro = 1;
+        _gso = option_gso() && (::setsockopt(_socket.native_handle(), IPPROTO_UDP, UDP_SEGMENT, &gso, sizeof(gso)) == 0);
+        _gro = option_gro() && (::setsockopt(_socket.native_handle(), IPPROTO_UDP, UDP_GRO, &gro, sizeof(gro)) == 0);
+
+        // Setup receive timestamps
+        _timestamp = option_receive_timestamp() && ReceiveTimestamp::Setup(_socket.native_handle());
+
+        // Prepare receive batch slab of datagram buffers and endpoints (coalesced and timestamped datagrams are received only in batches)
+        // Each slot fits the largest datagram allowed by the receive buffer limit (or coalesced datagrams) and the slab is capped
+        _receive_batch_slot = ((_receive_buffer_limit > 0) && !_gro) ? std::min(_receive_buffer_limit, BATCH_DATAGRAM_SIZE) : BATCH_DATAGRAM_SIZE;
+        size_t batch = (option_receive_batch() > 1) ? std::min(option_receive_batch(), BATCH_MAX) : ((_gro || _timestamp) ? 1 : 0);
+        if (!_option_receive_pool && (batch > 1))
+            batch = std::max(std::min(batch, BATCH_BUFFER_MAX / _receive_batch_slot), (size_t)1);
+        _receive_batch_buffer.resize(_option_receive_pool ? 0 : (batch * _receive_batch_slot));
+        _receive_batch_pooled.clear();
+        _receive_batch_pooled.resize(_option_receive_pool ? batch : 0);
+        _receive_batch_control.resize(batch * BATCH_CONTROL_SIZE);
+        _receive_batch_endpoints.resize(batch);
+        _receive_batch_messages.resize(batch);
+        _receive_batch_iovecs.resize(batch);
+        _receive_batch.reserve(batch);
+#endif
 
         // Reset statistic
+        _bytes_pending = 0;
+        _datagrams_pending = 0;
         _bytes_sending = 0;
+        _datagrams_sending = 0;
         _bytes_sent = 0;
         _bytes_received = 0;
         _datagrams_sent = 0;
         _datagrams_received = 0;
+        _receive_timestamp = 0;
 
          // Update the started flag
         _started = true;
@@ -350,9 +404,6 @@ size_t UDPServer::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
 
 bool UDPServer::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
 {
-    if (_sending)
-        return false;
-
     if (!IsStarted())
         return false;
 
@@ -363,70 +414,34 @@ bool UDPServer::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* b
     if (buffer == nullptr)
         return false;
 
-    // Check the send buffer limit
-    if ((size > _send_buffer_limit) && (_send_buffer_limit > 0))
-    {
-        SendError(asio::error::no_buffer_space);
-
-        // Call the buffer sent zero handler
-        onSent(_send_endpoint,  0);
-
-        return false;
-    }
-
-    // Fill the main send buffer
-    const uint8_t* bytes = (const uint8_t*)buffer;
-    _send_buffer.assign(bytes, bytes + size);
-
-    // Update statistic
-    _bytes_sending = _send_buffer.size();
-
-    // Update send endpoint
-    _send_endpoint = endpoint;
-
-    // Async send-to with the send-to handler
-    _sending = true;
-    auto self(this->shared_from_this());
-    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
     {
-        _sending = false;
+        std::scoped_lock locker(_send_lock);
 
-        if (!IsStarted())
-            return;
-
-        // Check for error
-        if (ec)
+        // Check the send buffer and send queue limits
+        if ((((_bytes_pending + _bytes_sending + size) > _send_buffer_limit) && (_send_buffer_limit > 0)) ||
+            (((_datagrams_pending + _datagrams_sending) >= _send_queue_limit) && (_send_queue_limit > 0)))
         {
-            SendError(ec);
+            SendError(asio::error::no_buffer_space);
+            return false;
+        }
 
-            // Call the buffer sent zero handler
-            onSent(_send_endpoint, 0);
+        // Only the first datagram of the empty main send queue requires the flush
+        bool flush_required = _send_queue_main.empty();
 
-            return;
-        }
+        // Push the datagram into the main send queue
+        _send_queue_main.Push(endpoint, buffer, size);
 
-        // Send some data to the client
-        if (sent > 0)
-        {
-            // Update statistic
-            _bytes_sending = 0;
-            _bytes_sent += sent;
+        // Update statistic
+        _bytes_pending = _send_queue_main.bytes();
+        _datagrams_pending = _send_queue_main.size();
 
-            // Clear the send buffer
-            _send_buffer.clear();
+        // Avoid multiple flush handlers
+        if (!flush_required)
+            return true;
+    }
 
-            // Call the buffer sent handler
-            onSent(_send_endpoint, sent);
-        }
-    });
-    if (_strand_required)
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), 
-                            _send_endpoint, 
-                            asio::bind_executor(_strand, async_send_to_handler));
-    else
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), 
-                            _send_endpoint, 
-                            async_send_to_handler);
+    // Try to flush the send queue (defer it to accumulate datagrams for GSO or the receive batch)
+    TryFlush(_gso || _receiving_batch);
 
     return true;
 }
@@ -547,6 +562,22 @@ void UDPServer::TryReceive()
     if (!IsStarted())
         return;
 
+#if defined(__linux__)
+    // Receive datagrams in batches
+    if (!_receive_batch_messages.empty())
+    {
+        TryReceiveBatch();
+        return;
+    }
+#endif
+
+    // Receive datagrams into pooled buffers
+    if (_option_receive_pool)
+    {
+        TryReceivePooled();
+        return;
+    }
+
     // Async receive with the receive handler
     _receiving = true;
     auto self(this->shared_from_this());
@@ -598,13 +629,487 @@ void UDPServer::TryReceive()
         _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
 }
 
+void UDPServer::TryReceivePooled()
+{
+    // Acquire a new pooled buffer if the previous one is kept by the handler
+    if (!_receive_pooled || (_receive_pooled.use_count() > 1))
+        _receive_pooled = _option_receive_pool->Acquire();
+    _receive_pooled.resize(_receive_pooled.capacity());
+
+    // Async receive with the receive handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_receive_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec, size_t size)
+    {
+        _receiving = false;
+
+        if (!IsStarted())
+            return;
+
+        // Check for error
+        if (ec)
+        {
+            SendError(ec);
+
+            // Call the datagram received zero handler
+            onReceived(_receive_endpoint, nullptr, 0);
+
+            return;
+        }
+
+        // Update statistic
+        ++_datagrams_received;
+        _bytes_received += size;
+
+        // Take the received pooled buffer, so the next receive started by the handler acquires another one
+        DatagramBuffer buffer = std::move(_receive_pooled);
+        buffer.resize(size);
+
+        // Call the pooled datagram received handler
+        onReceivedBuffer(_receive_endpoint, buffer);
+
+        // Reclaim the pooled buffer if it is not kept by the handler and not replaced by the next receive
+        if (!_receive_pooled && (buffer.use_count() == 1))
+            _receive_pooled = std::move(buffer);
+    });
+    if (_strand_required)
+        _socket.async_receive_from(asio::buffer(_receive_pooled.data(), _receive_pooled.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
+    else
+        _socket.async_receive_from(asio::buffer(_receive_pooled.data(), _receive_pooled.size()), _receive_endpoint, async_receive_handler);
+}
+
+#if defined(__linux__)
+void UDPServer::TryReceiveBatch()
+{
+    // Async wait for the readable socket with the wait handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec)
+    {
+        _receiving = false;
+
+        if (!IsStarted())
+            return;
+
+        // Check for error
+        if (ec)
+        {
+            SendError(ec);
+
+            // Call the datagram received zero handler
+            onReceived(_receive_endpoint, _receive_buffer.data(), 0);
+
+            return;
+        }
+
+        // Receive the batch of datagrams
+        ReceiveBatch();
+    });
+    if (_strand_required)
+        _socket.async_wait(asio::ip::udp::socket::wait_read, bind_executor(_strand, async_wait_handler));
+    else
+        _socket.async_wait(asio::ip::udp::socket::wait_read, async_wait_handler);
+}
+
+void UDPServer::ReceiveBatch()
+{
+    // Prepare the receive batch slab
+    size_t batch = _receive_batch_messages.size();
+    for (size_t i = 0; i < batch; ++i)
+    {
+        if (_option_receive_pool)
+        {
+            // Acquire a new pooled buffer if the previous one is kept by the handler
+            auto& pooled = _receive_batch_pooled[i];
+            if (!pooled || (pooled.use_count() > 1))
+                pooled = _option_receive_pool->Acquire();
+            pooled.resize(pooled.capacity());
+            _receive_batch_iovecs[i].iov_base = pooled.data();
+            _receive_batch_iovecs[i].iov_len = pooled.size();
+        }
+        else
+        {
+            _receive_batch_iovecs[i].iov_base = _receive_batch_buffer.data() + i * _receive_batch_slot;
+            _receive_batch_iovecs[i].iov_len = _receive_batch_slot;
+        }
+        std::memset(&_receive_batch_messages[i], 0, sizeof(mmsghdr));
+        _receive_batch_messages[i].msg_hdr.msg_name = _receive_batch_endpoints[i].data();
+        _receive_batch_messages[i].msg_hdr.msg_namelen = (socklen_t)_receive_batch_endpoints[i].capacity();
+        _receive_batch_messages[i].msg_hdr.msg_iov = &_receive_batch_iovecs[i];
+        _receive_batch_messages[i].msg_hdr.msg_iovlen = 1;
+        if (_gro || _timestamp)
+        {
+            _receive_batch_messages[i].msg_hdr.msg_control = _receive_batch_control.data() + i * BATCH_CONTROL_SIZE;
+            _receive_batch_messages[i].msg_hdr.msg_controllen = BATCH_CONTROL_SIZE;
+        }
+    }
+
+    // Receive the batch of datagrams without blocking
+    int result = ::recvmmsg(_socket.native_handle(), _receive_batch_messages.data(), (unsigned)batch, MSG_DONTWAIT, nullptr);
+    if (result < 0)
+    {
+        int error = errno;
+
+        // Wait for the next wakeup if the socket readiness was spurious
+        if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+        {
+            TryReceiveBatch();
+            return;
+        }
+
+        SendError(std::error_code(error, asio::error::get_system_category()));
+
+        // Call the datagram received zero handler
+        onReceived(_receive_endpoint, _receive_buffer.data(), 0);
+
+        return;
+    }
+
+    // Fill received datagrams skipping truncated ones
+    _receive_batch.clear();
+    for (size_t i = 0; i < (size_t)result; ++i)
+    {
+        auto& message = _receive_batch_messages[i];
+        if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+        {
+            SendError(asio::error::message_size);
+            continue;
+        }
+
+        auto& endpoint = _receive_batch_endpoints[i];
+        endpoint.resize(message.msg_hdr.msg_namelen);
+
+        // Find the segment size of the coalesced datagrams
+        size_t segment = message.msg_len;
+        if (_gro)
+        {
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message.msg_hdr, cmsg))
+            {
+                if ((cmsg->cmsg_level == IPPROTO_UDP) && (cmsg->cmsg_type == UDP_GRO))
+                {
+                    int value = 0;
+                    std::memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+                    if (value > 0)
+                        segment = (size_t)value;
+                }
+            }
+        }
+
+        // Find the receive timestamp
+        uint64_t timestamp = _timestamp ? ReceiveTimestamp::Parse(message.msg_hdr) : 0;
+
+        // Split the coalesced buffer back into datagrams (pooled datagrams share the same pooled buffer)
+        const uint8_t* buffer = (const uint8_t*)_receive_batch_iovecs[i].iov_base;
+        size_t offset = 0;
+        size_t size = message.msg_len;
+        do
+        {
+            size_t chunk = std::min(segment, size);
+            if (_option_receive_pool)
+                _receive_batch.push_back(ReceivedDatagram{ endpoint, buffer + offset, chunk, _receive_batch_pooled[i].slice(offset, chunk), timestamp });
+            else
+                _receive_batch.push_back(ReceivedDatagram{ endpoint, buffer + offset, chunk, DatagramBuffer(), timestamp });
+            offset += chunk;
+            size -= chunk;
+
+            // Update statistic
+            ++_datagrams_received;
+            _bytes_received += chunk;
+        } while (size > 0);
+    }
+
+    // Wait for the next wakeup if all received datagrams were truncated
+    if (_receive_batch.empty())
+    {
+        TryReceiveBatch();
+        return;
+    }
+
+    // Call the datagrams batch received handler
+    _receiving_batch = true;
+    onReceivedBatch(_receive_batch.data(), _receive_batch.size());
+    _receiving_batch = false;
+
+    // Release pooled datagrams which were not kept by the handler
+    _receive_batch.clear();
+
+    // Send all datagrams queued during the batch
+    TrySend();
+}
+#endif
+
+void UDPServer::onReceivedBatch(const ReceivedDatagram* datagrams, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        _receive_timestamp = datagrams[i].timestamp;
+        if (datagrams[i].handle)
+            onReceivedBuffer(datagrams[i].endpoint, datagrams[i].handle);
+        else
+            onReceived(datagrams[i].endpoint, datagrams[i].buffer, datagrams[i].size);
+    }
+}
+
+void UDPServer::TryFlush(bool defer)
+{
+    if (!IsStarted())
+        return;
+
+    // Post or dispatch the flush handler
+    auto self(this->shared_from_this());
+    auto flush_handler = [this, self]()
+    {
+        // Try to send queued datagrams
+        TrySend();
+    };
+    if (defer)
+    {
+        if (_strand_required)
+            asio::post(_strand, flush_handler);
+        else
+            asio::post(*_io_service, flush_handler);
+    }
+    else
+    {
+        if (_strand_required)
+            asio::dispatch(_strand, flush_handler);
+        else
+            asio::dispatch(*_io_service, flush_handler);
+    }
+}
+
+bool UDPServer::SwapSendQueues()
+{
+    if (_send_queue.empty())
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Swap flush and main send queues
+        _send_queue.swap(_send_queue_main);
+
+        // Update statistic
+        _bytes_pending = 0;
+        _datagrams_pending = 0;
+        _bytes_sending = _send_queue.bytes();
+        _datagrams_sending = _send_queue.size();
+    }
+
+    return !_send_queue.empty();
+}
+
+void UDPServer::TrySend()
+{
+    if (_sending)
+        return;
+
+    if (!IsStarted())
+        return;
+
+    if (!SwapSendQueues())
+        return;
+
+    _sending = true;
+
+#if defined(__linux__)
+    // Send batches of queued datagrams with sendmmsg() while the socket accepts them without blocking
+    size_t batch = _send_queue.size();
+    while ((batch > 0) && !_send_queue.empty() && IsStarted())
+    {
+        size_t available = std::min(batch, _send_queue.size());
+        _send_batch_messages.resize(std::max(_send_batch_messages.size(), std::min(available, BATCH_MAX)));
+        _send_batch_iovecs.resize(std::max(_send_batch_iovecs.size(), available));
+        _send_batch_control.resize(std::max(_send_batch_control.size(), std::min(available, BATCH_MAX) * CMSG_SPACE(sizeof(uint16_t))));
+        _send_batch_counts.resize(std::max(_send_batch_counts.size(), std::min(available, BATCH_MAX)));
+
+        // Prepare messages coalescing runs of equal-sized datagrams to the same endpoint with GSO
+        size_t messages = 0;
+        size_t index = 0;
+        while ((index < available) && (messages < BATCH_MAX))
+        {
+            auto& first = _send_queue[index];
+            size_t segment = first.buffer.size();
+            size_t count = 1;
+            if (_gso)
+            {
+                size_t total = segment;
+                while (((index + count) < available) && (count < GSO_SEGMENTS_MAX))
+                {
+                    auto& next = _send_queue[index + count];
+                    if ((next.endpoint != first.endpoint) || (next.buffer.size() > segment) || (next.buffer.size() == 0) || ((total + next.buffer.size()) > GSO_SIZE_MAX))
+                        break;
+                    total += next.buffer.size();
+                    ++count;
+
+                    // Only the last segment is allowed to be shorter
+                    if (next.buffer.size() < segment)
+                        break;
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& datagram = _send_queue[index + i];
+                _send_batch_iovecs[index + i].iov_base = datagram.buffer.data();
+                _send_batch_iovecs[index + i].iov_len = datagram.buffer.size();
+            }
+
+            auto& message = _send_batch_messages[messages];
+            std::memset(&message, 0, sizeof(mmsghdr));
+            message.msg_hdr.msg_name = first.endpoint.data();
+            message.msg_hdr.msg_namelen = (socklen_t)first.endpoint.size();
+            message.msg_hdr.msg_iov = &_send_batch_iovecs[index];
+            message.msg_hdr.msg_iovlen = count;
+            if (count > 1)
+            {
+                // Setup the segment size control message
+                message.msg_hdr.msg_control = _send_batch_control.data() + messages * CMSG_SPACE(sizeof(uint16_t));
+                message.msg_hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+                cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr);
+                cmsg->cmsg_level = IPPROTO_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t size = (uint16_t)segment;
+                std::memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+            }
+
+            _send_batch_counts[messages++] = count;
+            index += count;
+        }
+
+        int result = ::sendmmsg(_socket.native_handle(), _send_batch_messages.data(), (unsigned)messages, MSG_DONTWAIT);
+        if (result <= 0)
+        {
+            int error = errno;
+            if ((result == 0) || (error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+                break;
+
+            // Disable segmentation offload and retry if it is not supported for the route
+            if ((_send_batch_counts[0] > 1) && ((error == EIO) || (error == EINVAL)))
+            {
+                _gso = false;
+                continue;
+            }
+
+            // Complete the failed datagram
+            --batch;
+            SendComplete(std::error_code(error, asio::error::get_system_category()), 0);
+            continue;
+        }
+
+        // Complete sent datagrams
+        for (size_t i = 0; i < (size_t)result; ++i)
+        {
+            size_t count = _send_batch_counts[i];
+            batch -= count;
+            for (size_t j = 0; (j < count) && !_send_queue.empty(); ++j)
+                SendComplete(std::error_code(), _send_queue.front().buffer.size());
+        }
+    }
+#elif (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    // Send a batch of queued datagrams while the socket accepts them without blocking
+    size_t batch = _send_queue.size();
+    while ((batch-- > 0) && !_send_queue.empty() && IsStarted())
+    {
+        auto& datagram = _send_queue.front();
+        ssize_t result = ::sendto(_socket.native_handle(), datagram.buffer.data(), datagram.buffer.size(), MSG_DONTWAIT, datagram.endpoint.data(), (socklen_t)datagram.endpoint.size());
+        if (result < 0)
+        {
+            int error = errno;
+            if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+                break;
+
+            SendComplete(std::error_code(error, asio::error::get_system_category()), 0);
+        }
+        else
+            SendComplete(std::error_code(), (size_t)result);
+    }
+#endif
+#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    // Wait for the socket to become writable only if some datagrams are left
+    if (_send_queue.empty() || !IsStarted())
+    {
+        _sending = false;
+
+        // Flush datagrams queued by other threads while sending
+        if (IsStarted() && SwapSendQueues())
+            TryFlush(true);
+        return;
+    }
+#endif
+
+    // Async send-to the front queued datagram with the send-to handler
+    auto self(this->shared_from_this());
+    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
+    {
+        _sending = false;
+
+        if (!IsStarted())
+            return;
+
+        // Complete the sent datagram
+        SendComplete(ec, sent);
+
+        // Try to send the rest of queued datagrams
+        TrySend();
+    });
+    auto& datagram = _send_queue.front();
+    if (_strand_required)
+        _socket.async_send_to(asio::buffer(datagram.buffer.data(), datagram.buffer.size()), datagram.endpoint, bind_executor(_strand, async_send_to_handler));
+    else
+        _socket.async_send_to(asio::buffer(datagram.buffer.data(), datagram.buffer.size()), datagram.endpoint, async_send_to_handler);
+}
+
+void UDPServer::SendComplete(std::error_code ec, size_t sent)
+{
+    if (_send_queue.empty())
+        return;
+
+    // Pop the completed datagram from the send queue
+    asio::ip::udp::endpoint endpoint = _send_queue.front().endpoint;
+    _send_queue.Pop();
+
+    // Update statistic
+    _bytes_sending = _send_queue.bytes();
+    _datagrams_sending = _send_queue.size();
+
+    // Check for error
+    if (ec)
+    {
+        SendError(ec);
+
+        // Call the buffer sent zero handler
+        onSent(endpoint, 0);
+
+        return;
+    }
+
+    // Update statistic
+    ++_datagrams_sent;
+    _bytes_sent += sent;
+
+    // Call the buffer sent handler
+    onSent(endpoint, sent);
+}
+
 void UDPServer::ClearBuffers()
 {
-    // Clear send buffers
-    _send_buffer.clear();
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Clear the main send queue
+        _send_queue_main.Clear();
+
+        // Update statistic
+        _bytes_pending = 0;
+        _datagrams_pending = 0;
+    }
+
+    // Clear the flush send queue
+    _send_queue.Clear();
 
     // Update statistic
     _bytes_sending = 0;
+    _datagrams_sending = 0;
 }
 
 void UDPServer::SendError(std::error_code ec)
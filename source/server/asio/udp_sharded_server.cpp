@@ -0,0 +1,233 @@
+/*!
+    \file udp_sharded_server.cpp
+    \brief UDP sharded server implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/udp_sharded_server.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+size_t ShardsCount(const std::shared_ptr<Service>& service, size_t shards)
+{
+#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    // Create shard per each working thread of the Asio service by default
+    return (shards > 0) ? shards : std::max(service->threads(), (size_t)1);
+#else
+    // Sharding requires SO_REUSEPORT option
+    return 1;
+#endif
+}
+
+} // namespace
+
+UDPShardedServer::UDPShardedServer(const std::shared_ptr<Service>& service, int port, InternetProtocol protocol, size_t shards)
+    : _id(CppCommon::UUID::Sequential()),
+      _service(service),
+      _port(port),
+      _shards_count(0),
+      _started(false),
+      _option_reuse_address(false)
+{
+    assert((service != nullptr) && "Asio service is invalid!");
+    if (service == nullptr)
+        throw CppCommon::ArgumentException("Asio service is invalid!");
+
+    assert((port > 0) && "Sharded server port should be specified!");
+    if (port <= 0)
+        throw CppCommon::ArgumentException("Sharded server port should be specified!");
+
+    _shards_count = ShardsCount(_service, shards);
+
+    // Prepare endpoint
+    switch (protocol)
+    {
+        case InternetProtocol::IPv4:
+            _endpoint = asio::ip::udp::endpoint(asio::ip::udp::v4(), (unsigned short)port);
+            break;
+        case InternetProtocol::IPv6:
+            _endpoint = asio::ip::udp::endpoint(asio::ip::udp::v6(), (unsigned short)port);
+            break;
+    }
+}
+
+UDPShardedServer::UDPShardedServer(const std::shared_ptr<Service>& service, const std::string& address, int port, size_t shards)
+    : _id(CppCommon::UUID::Sequential()),
+      _service(service),
+      _address(address),
+      _port(port),
+      _shards_count(0),
+      _started(false),
+      _option_reuse_address(false)
+{
+    assert((service != nullptr) && "Asio service is invalid!");
+    if (service == nullptr)
+        throw CppCommon::ArgumentException("Asio service is invalid!");
+
+    assert((port > 0) && "Sharded server port should be specified!");
+    if (port <= 0)
+        throw CppCommon::ArgumentException("Sharded server port should be specified!");
+
+    _shards_count = ShardsCount(_service, shards);
+
+    // Prepare endpoint
+    asio::io_context io_service;
+    asio::ip::udp::resolver resolver(io_service);
+    asio::ip::udp::resolver::results_type endpoints = resolver.resolve(_address, std::to_string(_port));
+    _endpoint = *endpoints.begin();
+}
+
+UDPShardedServer::UDPShardedServer(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint, size_t shards)
+    : _id(CppCommon::UUID::Sequential()),
+      _service(service),
+      _address(endpoint.address().to_string()),
+      _port(endpoint.port()),
+      _endpoint(endpoint),
+      _shards_count(0),
+      _started(false),
+      _option_reuse_address(false)
+{
+    assert((service != nullptr) && "Asio service is invalid!");
+    if (service == nullptr)
+        throw CppCommon::ArgumentException("Asio service is invalid!");
+
+    assert((_port > 0) && "Sharded server port should be specified!");
+    if (_port <= 0)
+        throw CppCommon::ArgumentException("Sharded server port should be specified!");
+
+    _shards_count = ShardsCount(_service, shards);
+}
+
+uint64_t UDPShardedServer::bytes_pending() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->bytes_pending();
+    return total;
+}
+
+uint64_t UDPShardedServer::datagrams_pending() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->datagrams_pending();
+    return total;
+}
+
+uint64_t UDPShardedServer::bytes_sent() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->bytes_sent();
+    return total;
+}
+
+uint64_t UDPShardedServer::bytes_received() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->bytes_received();
+    return total;
+}
+
+uint64_t UDPShardedServer::datagrams_sent() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->datagrams_sent();
+    return total;
+}
+
+uint64_t UDPShardedServer::datagrams_received() const noexcept
+{
+    uint64_t total = 0;
+    for (const auto& shard : _shards)
+        total += shard->datagrams_received();
+    return total;
+}
+
+bool UDPShardedServer::Start()
+{
+    assert(!IsStarted() && "UDP sharded server is already started!");
+    if (IsStarted())
+        return false;
+
+    // Create shards bound to the next Asio IO services
+    if (_shards.empty())
+    {
+        for (size_t i = 0; i < _shards_count; ++i)
+        {
+            auto shard = CreateShard(_service, _endpoint);
+            assert((shard != nullptr) && "UDP server shard is invalid!");
+            if (shard == nullptr)
+                return false;
+            _shards.emplace_back(shard);
+        }
+    }
+
+    // Start all shards on the same endpoint
+    for (size_t i = 0; i < _shards.size(); ++i)
+    {
+        auto& shard = _shards[i];
+        shard->SetupReuseAddress(option_reuse_address());
+        shard->SetupReusePort(true);
+        if (!shard->Start())
+        {
+            // Stop already started shards after their posted start handlers
+            for (size_t j = 0; j < i; ++j)
+            {
+                auto started = _shards[j];
+                asio::post(started->strand(), [started]()
+                {
+                    if (started->IsStarted())
+                        started->Stop();
+                });
+            }
+            return false;
+        }
+    }
+
+    // Update the started flag
+    _started = true;
+
+    return true;
+}
+
+bool UDPShardedServer::Stop()
+{
+    assert(IsStarted() && "UDP sharded server is not started!");
+    if (!IsStarted())
+        return false;
+
+    // Stop all shards
+    for (auto& shard : _shards)
+        if (shard->IsStarted())
+            shard->Stop();
+
+    // Update the started flag
+    _started = false;
+
+    return true;
+}
+
+bool UDPShardedServer::Restart()
+{
+    if (!Stop())
+        return false;
+
+    for (auto& shard : _shards)
+        while (shard->IsStarted())
+            CppCommon::Thread::Yield();
+
+    return Start();
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,544 @@
+/*!
+    \file hpack.cpp
+    \brief HPACK header compression implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/hpack.h"
+
+#include <array>
+#include <tuple>
+
+namespace CppServer {
+namespace HTTP {
+
+namespace {
+
+// HPACK static table (RFC 7541, Appendix A)
+const std::pair<std::string_view, std::string_view> hpack_static_table[HPACK::STATIC_TABLE_SIZE] =
+{
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" }
+};
+
+// HPACK Huffman code
+struct HuffmanCode
+{
+    uint32_t code;
+    int bits;
+};
+
+// HPACK Huffman table (RFC 7541, Appendix B), the last entry is EOS
+const HuffmanCode hpack_huffman_table[257] =
+{
+    { 0x00001ff8, 13 }, { 0x007fffd8, 23 }, { 0x0fffffe2, 28 }, { 0x0fffffe3, 28 },
+    { 0x0fffffe4, 28 }, { 0x0fffffe5, 28 }, { 0x0fffffe6, 28 }, { 0x0fffffe7, 28 },
+    { 0x0fffffe8, 28 }, { 0x00ffffea, 24 }, { 0x3ffffffc, 30 }, { 0x0fffffe9, 28 },
+    { 0x0fffffea, 28 }, { 0x3ffffffd, 30 }, { 0x0fffffeb, 28 }, { 0x0fffffec, 28 },
+    { 0x0fffffed, 28 }, { 0x0fffffee, 28 }, { 0x0fffffef, 28 }, { 0x0ffffff0, 28 },
+    { 0x0ffffff1, 28 }, { 0x0ffffff2, 28 }, { 0x3ffffffe, 30 }, { 0x0ffffff3, 28 },
+    { 0x0ffffff4, 28 }, { 0x0ffffff5, 28 }, { 0x0ffffff6, 28 }, { 0x0ffffff7, 28 },
+    { 0x0ffffff8, 28 }, { 0x0ffffff9, 28 }, { 0x0ffffffa, 28 }, { 0x0ffffffb, 28 },
+    { 0x00000014,  6 }, { 0x000003f8, 10 }, { 0x000003f9, 10 }, { 0x00000ffa, 12 },
+    { 0x00001ff9, 13 }, { 0x00000015,  6 }, { 0x000000f8,  8 }, { 0x000007fa, 11 },
+    { 0x000003fa, 10 }, { 0x000003fb, 10 }, { 0x000000f9,  8 }, { 0x000007fb, 11 },
+    { 0x000000fa,  8 }, { 0x00000016,  6 }, { 0x00000017,  6 }, { 0x00000018,  6 },
+    { 0x00000000,  5 }, { 0x00000001,  5 }, { 0x00000002,  5 }, { 0x00000019,  6 },
+    { 0x0000001a,  6 }, { 0x0000001b,  6 }, { 0x0000001c,  6 }, { 0x0000001d,  6 },
+    { 0x0000001e,  6 }, { 0x0000001f,  6 }, { 0x0000005c,  7 }, { 0x000000fb,  8 },
+    { 0x00007ffc, 15 }, { 0x00000020,  6 }, { 0x00000ffb, 12 }, { 0x000003fc, 10 },
+    { 0x00001ffa, 13 }, { 0x00000021,  6 }, { 0x0000005d,  7 }, { 0x0000005e,  7 },
+    { 0x0000005f,  7 }, { 0x00000060,  7 }, { 0x00000061,  7 }, { 0x00000062,  7 },
+    { 0x00000063,  7 }, { 0x00000064,  7 }, { 0x00000065,  7 }, { 0x00000066,  7 },
+    { 0x00000067,  7 }, { 0x00000068,  7 }, { 0x00000069,  7 }, { 0x0000006a,  7 },
+    { 0x0000006b,  7 }, { 0x0000006c,  7 }, { 0x0000006d,  7 }, { 0x0000006e,  7 },
+    { 0x0000006f,  7 }, { 0x00000070,  7 }, { 0x00000071,  7 }, { 0x00000072,  7 },
+    { 0x000000fc,  8 }, { 0x00000073,  7 }, { 0x000000fd,  8 }, { 0x00001ffb, 13 },
+    { 0x0007fff0, 19 }, { 0x00001ffc, 13 }, { 0x00003ffc, 14 }, { 0x00000022,  6 },
+    { 0x00007ffd, 15 }, { 0x00000003,  5 }, { 0x00000023,  6 }, { 0x00000004,  5 },
+    { 0x00000024,  6 }, { 0x00000005,  5 }, { 0x00000025,  6 }, { 0x00000026,  6 },
+    { 0x00000027,  6 }, { 0x00000006,  5 }, { 0x00000074,  7 }, { 0x00000075,  7 },
+    { 0x00000028,  6 }, { 0x00000029,  6 }, { 0x0000002a,  6 }, { 0x00000007,  5 },
+    { 0x0000002b,  6 }, { 0x00000076,  7 }, { 0x0000002c,  6 }, { 0x00000008,  5 },
+    { 0x00000009,  5 }, { 0x0000002d,  6 }, { 0x00000077,  7 }, { 0x00000078,  7 },
+    { 0x00000079,  7 }, { 0x0000007a,  7 }, { 0x0000007b,  7 }, { 0x00007ffe, 15 },
+    { 0x000007fc, 11 }, { 0x00003ffd, 14 }, { 0x00001ffd, 13 }, { 0x0ffffffc, 28 },
+    { 0x000fffe6, 20 }, { 0x003fffd2, 22 }, { 0x000fffe7, 20 }, { 0x000fffe8, 20 },
+    { 0x003fffd3, 22 }, { 0x003fffd4, 22 }, { 0x003fffd5, 22 }, { 0x007fffd9, 23 },
+    { 0x003fffd6, 22 }, { 0x007fffda, 23 }, { 0x007fffdb, 23 }, { 0x007fffdc, 23 },
+    { 0x007fffdd, 23 }, { 0x007fffde, 23 }, { 0x00ffffeb, 24 }, { 0x007fffdf, 23 },
+    { 0x00ffffec, 24 }, { 0x00ffffed, 24 }, { 0x003fffd7, 22 }, { 0x007fffe0, 23 },
+    { 0x00ffffee, 24 }, { 0x007fffe1, 23 }, { 0x007fffe2, 23 }, { 0x007fffe3, 23 },
+    { 0x007fffe4, 23 }, { 0x001fffdc, 21 }, { 0x003fffd8, 22 }, { 0x007fffe5, 23 },
+    { 0x003fffd9, 22 }, { 0x007fffe6, 23 }, { 0x007fffe7, 23 }, { 0x00ffffef, 24 },
+    { 0x003fffda, 22 }, { 0x001fffdd, 21 }, { 0x000fffe9, 20 }, { 0x003fffdb, 22 },
+    { 0x003fffdc, 22 }, { 0x007fffe8, 23 }, { 0x007fffe9, 23 }, { 0x001fffde, 21 },
+    { 0x007fffea, 23 }, { 0x003fffdd, 22 }, { 0x003fffde, 22 }, { 0x00fffff0, 24 },
+    { 0x001fffdf, 21 }, { 0x003fffdf, 22 }, { 0x007fffeb, 23 }, { 0x007fffec, 23 },
+    { 0x001fffe0, 21 }, { 0x001fffe1, 21 }, { 0x003fffe0, 22 }, { 0x001fffe2, 21 },
+    { 0x007fffed, 23 }, { 0x003fffe1, 22 }, { 0x007fffee, 23 }, { 0x007fffef, 23 },
+    { 0x000fffea, 20 }, { 0x003fffe2, 22 }, { 0x003fffe3, 22 }, { 0x003fffe4, 22 },
+    { 0x007ffff0, 23 }, { 0x003fffe5, 22 }, { 0x003fffe6, 22 }, { 0x007ffff1, 23 },
+    { 0x03ffffe0, 26 }, { 0x03ffffe1, 26 }, { 0x000fffeb, 20 }, { 0x0007fff1, 19 },
+    { 0x003fffe7, 22 }, { 0x007ffff2, 23 }, { 0x003fffe8, 22 }, { 0x01ffffec, 25 },
+    { 0x03ffffe2, 26 }, { 0x03ffffe3, 26 }, { 0x03ffffe4, 26 }, { 0x07ffffde, 27 },
+    { 0x07ffffdf, 27 }, { 0x03ffffe5, 26 }, { 0x00fffff1, 24 }, { 0x01ffffed, 25 },
+    { 0x0007fff2, 19 }, { 0x001fffe3, 21 }, { 0x03ffffe6, 26 }, { 0x07ffffe0, 27 },
+    { 0x07ffffe1, 27 }, { 0x03ffffe7, 26 }, { 0x07ffffe2, 27 }, { 0x00fffff2, 24 },
+    { 0x001fffe4, 21 }, { 0x001fffe5, 21 }, { 0x03ffffe8, 26 }, { 0x03ffffe9, 26 },
+    { 0x0ffffffd, 28 }, { 0x07ffffe3, 27 }, { 0x07ffffe4, 27 }, { 0x07ffffe5, 27 },
+    { 0x000fffec, 20 }, { 0x00fffff3, 24 }, { 0x000fffed, 20 }, { 0x001fffe6, 21 },
+    { 0x003fffe9, 22 }, { 0x001fffe7, 21 }, { 0x001fffe8, 21 }, { 0x007ffff3, 23 },
+    { 0x003fffea, 22 }, { 0x003fffeb, 22 }, { 0x01ffffee, 25 }, { 0x01ffffef, 25 },
+    { 0x00fffff4, 24 }, { 0x00fffff5, 24 }, { 0x03ffffea, 26 }, { 0x007ffff4, 23 },
+    { 0x03ffffeb, 26 }, { 0x07ffffe6, 27 }, { 0x03ffffec, 26 }, { 0x03ffffed, 26 },
+    { 0x07ffffe7, 27 }, { 0x07ffffe8, 27 }, { 0x07ffffe9, 27 }, { 0x07ffffea, 27 },
+    { 0x07ffffeb, 27 }, { 0x0ffffffe, 28 }, { 0x07ffffec, 27 }, { 0x07ffffed, 27 },
+    { 0x07ffffee, 27 }, { 0x07ffffef, 27 }, { 0x07fffff0, 27 }, { 0x03ffffee, 26 },
+    { 0x3fffffff, 30 }
+
+};
+
+// HPACK Huffman decoding tree
+class HuffmanTree
+{
+public:
+    HuffmanTree() : _nodes(), _count(1)
+    {
+        for (int symbol = 0; symbol < 257; ++symbol)
+        {
+            const HuffmanCode& code = hpack_huffman_table[symbol];
+
+            int node = 0;
+            for (int bit = code.bits - 1; bit > 0; --bit)
+            {
+                int branch = (code.code >> bit) & 1;
+                if (_nodes[node][branch] == 0)
+                    _nodes[node][branch] = (int16_t)_count++;
+                node = _nodes[node][branch];
+            }
+            _nodes[node][code.code & 1] = (int16_t)(-symbol - 1);
+        }
+    }
+
+    // Get the next node (positive), symbol (negative as -symbol - 1) or zero for invalid code
+    int next(int node, int branch) const noexcept { return _nodes[node][branch]; }
+
+private:
+    std::array<std::array<int16_t, 2>, 512> _nodes;
+    size_t _count;
+};
+
+const HuffmanTree& GetHuffmanTree()
+{
+    static HuffmanTree tree;
+    return tree;
+}
+
+} // namespace
+
+std::pair<std::string_view, std::string_view> HPACK::StaticEntry(size_t index) noexcept
+{
+    if ((index == 0) || (index > STATIC_TABLE_SIZE))
+        return std::make_pair(std::string_view(), std::string_view());
+
+    return hpack_static_table[index - 1];
+}
+
+void HPACK::EncodeHeader(std::vector<uint8_t>& buffer, std::string_view name, std::string_view value, bool sensitive)
+{
+    // Find the best static table match
+    size_t name_index = 0;
+    for (size_t i = 0; i < STATIC_TABLE_SIZE; ++i)
+    {
+        if (hpack_static_table[i].first != name)
+            continue;
+
+        if (name_index == 0)
+            name_index = i + 1;
+
+        // Indexed header field representation
+        if (!sensitive && (hpack_static_table[i].second == value))
+        {
+            EncodeInteger(buffer, 0x80, 7, i + 1);
+            return;
+        }
+    }
+
+    // Literal header field without indexing or never indexed representation
+    EncodeInteger(buffer, sensitive ? 0x10 : 0x00, 4, name_index);
+    if (name_index == 0)
+        EncodeString(buffer, name);
+    EncodeString(buffer, value);
+}
+
+void HPACK::EncodeInteger(std::vector<uint8_t>& buffer, uint8_t prefix, int bits, uint64_t value)
+{
+    const uint64_t limit = (1 << bits) - 1;
+
+    if (value < limit)
+    {
+        buffer.push_back((uint8_t)(prefix | value));
+        return;
+    }
+
+    buffer.push_back((uint8_t)(prefix | limit));
+    value -= limit;
+    while (value >= 128)
+    {
+        buffer.push_back((uint8_t)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+bool HPACK::DecodeInteger(const uint8_t* buffer, size_t size, size_t& offset, int bits, uint64_t& value)
+{
+    if (offset >= size)
+        return false;
+
+    const uint64_t limit = (1 << bits) - 1;
+
+    value = buffer[offset++] & limit;
+    if (value < limit)
+        return true;
+
+    for (int shift = 0; shift < 56; shift += 7)
+    {
+        if (offset >= size)
+            return false;
+
+        uint8_t octet = buffer[offset++];
+        value += (uint64_t)(octet & 0x7F) << shift;
+        if ((octet & 0x80) == 0)
+            return true;
+    }
+
+    // Integer overflow
+    return false;
+}
+
+void HPACK::EncodeString(std::vector<uint8_t>& buffer, std::string_view value)
+{
+    size_t huffman = HuffmanSize(value);
+    if (huffman < value.size())
+    {
+        EncodeInteger(buffer, 0x80, 7, huffman);
+        EncodeHuffman(buffer, value);
+    }
+    else
+    {
+        EncodeInteger(buffer, 0x00, 7, value.size());
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+}
+
+bool HPACK::DecodeString(const uint8_t* buffer, size_t size, size_t& offset, std::string& value)
+{
+    if (offset >= size)
+        return false;
+
+    bool huffman = (buffer[offset] & 0x80) != 0;
+
+    uint64_t length;
+    if (!DecodeInteger(buffer, size, offset, 7, length))
+        return false;
+    if (length > (size - offset))
+        return false;
+
+    const uint8_t* data = buffer + offset;
+    offset += (size_t)length;
+
+    value.clear();
+    if (huffman)
+        return DecodeHuffman(data, (size_t)length, value);
+
+    value.assign((const char*)data, (size_t)length);
+    return true;
+}
+
+size_t HPACK::HuffmanSize(std::string_view value) noexcept
+{
+    size_t bits = 0;
+    for (char ch : value)
+        bits += hpack_huffman_table[(uint8_t)ch].bits;
+    return (bits + 7) / 8;
+}
+
+void HPACK::EncodeHuffman(std::vector<uint8_t>& buffer, std::string_view value)
+{
+    uint64_t accumulator = 0;
+    int bits = 0;
+
+    for (char ch : value)
+    {
+        const HuffmanCode& code = hpack_huffman_table[(uint8_t)ch];
+        accumulator = (accumulator << code.bits) | code.code;
+        bits += code.bits;
+        while (bits >= 8)
+        {
+            bits -= 8;
+            buffer.push_back((uint8_t)(accumulator >> bits));
+        }
+        accumulator &= (((uint64_t)1) << bits) - 1;
+    }
+
+    // Pad the last octet with the most significant bits of EOS
+    if (bits > 0)
+        buffer.push_back((uint8_t)((accumulator << (8 - bits)) | (0xFF >> bits)));
+}
+
+bool HPACK::DecodeHuffman(const uint8_t* buffer, size_t size, std::string& value)
+{
+    const HuffmanTree& tree = GetHuffmanTree();
+
+    int node = 0;
+    int padding = 0;
+    bool ones = true;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint8_t octet = buffer[i];
+        for (int bit = 7; bit >= 0; --bit)
+        {
+            int branch = (octet >> bit) & 1;
+            int next = tree.next(node, branch);
+
+            ++padding;
+            ones = ones && (branch == 1);
+
+            if (next < 0)
+            {
+                int symbol = -next - 1;
+
+                // EOS symbol must not be decoded
+                if (symbol == 256)
+                    return false;
+
+                value.push_back((char)symbol);
+                node = 0;
+                padding = 0;
+                ones = true;
+            }
+            else if (next == 0)
+                return false;
+            else
+                node = next;
+        }
+    }
+
+    // Padding must be shorter than 8 bits and correspond to the most significant bits of EOS
+    return (padding < 8) && ones;
+}
+
+HPACKDecoder::HPACKDecoder(size_t max_table_size, size_t max_headers_size)
+    : _table_size(0),
+      _table_max_size(max_table_size),
+      _table_limit(max_table_size),
+      _headers_limit(max_headers_size)
+{
+}
+
+bool HPACKDecoder::Decode(const void* buffer, size_t size, std::vector<HPACKHeader>& headers)
+{
+    const uint8_t* data = (const uint8_t*)buffer;
+    size_t offset = 0;
+    size_t fields = 0;
+    size_t headers_size = 0;
+
+    while (offset < size)
+    {
+        uint8_t octet = data[offset];
+
+        // Dynamic table size update
+        if ((octet & 0xE0) == 0x20)
+        {
+            uint64_t table_size;
+            if (!HPACK::DecodeInteger(data, size, offset, 5, table_size))
+                return false;
+
+            // Update must be at the beginning of the header block and must not exceed the limit
+            if ((fields > 0) || (table_size > _table_limit))
+                return false;
+
+            _table_max_size = (size_t)table_size;
+            EvictEntries(0);
+            continue;
+        }
+
+        std::string_view name;
+        std::string_view value;
+
+        // Indexed header field representation
+        if ((octet & 0x80) != 0)
+        {
+            uint64_t index;
+            if (!HPACK::DecodeInteger(data, size, offset, 7, index))
+                return false;
+            if (!FindEntry((size_t)index, name, value))
+                return false;
+
+            headers.emplace_back(name, value);
+        }
+        else
+        {
+            // Literal header field with incremental indexing, without indexing or never indexed
+            bool indexing = (octet & 0xC0) == 0x40;
+
+            uint64_t index;
+            if (!HPACK::DecodeInteger(data, size, offset, indexing ? 6 : 4, index))
+                return false;
+
+            headers.emplace_back();
+            HPACKHeader& header = headers.back();
+
+            if (index == 0)
+            {
+                if (!HPACK::DecodeString(data, size, offset, header.first))
+                    return false;
+            }
+            else
+            {
+                if (!FindEntry((size_t)index, name, value))
+                    return false;
+                header.first.assign(name);
+            }
+
+            if (!HPACK::DecodeString(data, size, offset, header.second))
+                return false;
+
+            if (indexing)
+                InsertEntry(header);
+        }
+
+        // Check the decoded header list size limit
+        const HPACKHeader& header = headers.back();
+        headers_size += header.first.size() + header.second.size() + 32;
+        if (headers_size > _headers_limit)
+            return false;
+
+        ++fields;
+    }
+
+    return true;
+}
+
+void HPACKDecoder::Clear()
+{
+    _table.clear();
+    _table_size = 0;
+    _table_max_size = _table_limit;
+}
+
+bool HPACKDecoder::FindEntry(size_t index, std::string_view& name, std::string_view& value) const
+{
+    if (index == 0)
+        return false;
+
+    // Static table entry
+    if (index <= HPACK::STATIC_TABLE_SIZE)
+    {
+        std::tie(name, value) = hpack_static_table[index - 1];
+        return true;
+    }
+
+    // Dynamic table entry
+    index -= HPACK::STATIC_TABLE_SIZE + 1;
+    if (index >= _table.size())
+        return false;
+
+    name = _table[index].first;
+    value = _table[index].second;
+    return true;
+}
+
+void HPACKDecoder::InsertEntry(const HPACKHeader& header)
+{
+    size_t size = header.first.size() + header.second.size() + 32;
+
+    // Entry larger than the table empties the table
+    if (size > _table_max_size)
+    {
+        _table.clear();
+        _table_size = 0;
+        return;
+    }
+
+    EvictEntries(size);
+    _table.push_front(header);
+    _table_size += size;
+}
+
+void HPACKDecoder::EvictEntries(size_t size)
+{
+    while (!_table.empty() && ((_table_size + size) > _table_max_size))
+    {
+        const HPACKHeader& entry = _table.back();
+        _table_size -= entry.first.size() + entry.second.size() + 32;
+        _table.pop_back();
+    }
+}
+
+} // namespace HTTP
+} // namespace CppServer
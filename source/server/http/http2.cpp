@@ -0,0 +1,1270 @@
+/*!
+    \file http2.cpp
+    \brief HTTP/2 protocol implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http2.h"
+
+#include "string/string_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace CppServer {
+namespace HTTP {
+
+namespace {
+
+// Maximal frame size accepted from the peer (SETTINGS_MAX_FRAME_SIZE is not changed)
+const size_t max_frame_size = 16384;
+// Maximal header block size accepted from the peer
+const size_t max_header_block_size = 262144;
+// Maximal count of recycled streams kept by the connection
+const size_t max_free_streams = 16;
+// Maximal flow control window size
+const int64_t max_window_size = 0x7FFFFFFF;
+
+uint32_t ReadUInt24(const uint8_t* buffer) { return ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | (uint32_t)buffer[2]; }
+uint32_t ReadUInt32(const uint8_t* buffer) { return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3]; }
+uint32_t ReadUInt31(const uint8_t* buffer) { return ReadUInt32(buffer) & 0x7FFFFFFF; }
+
+void WriteUInt16(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 8);
+    buffer[1] = (uint8_t)value;
+}
+
+void WriteUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+// Connection-specific headers are prohibited in HTTP/2 (RFC 9113, Section 8.2.2)
+bool IsConnectionHeader(std::string_view name)
+{
+    return (name == "connection") || (name == "keep-alive") || (name == "proxy-connection") || (name == "transfer-encoding") || (name == "upgrade") || (name == "te");
+}
+
+// Decode base64url encoded HTTP2-Settings header value
+bool DecodeBase64Url(std::string_view value, std::vector<uint8_t>& buffer)
+{
+    uint32_t accumulator = 0;
+    int bits = 0;
+
+    for (char ch : value)
+    {
+        int digit;
+        if ((ch >= 'A') && (ch <= 'Z'))
+            digit = ch - 'A';
+        else if ((ch >= 'a') && (ch <= 'z'))
+            digit = ch - 'a' + 26;
+        else if ((ch >= '0') && (ch <= '9'))
+            digit = ch - '0' + 52;
+        else if ((ch == '-') || (ch == '+'))
+            digit = 62;
+        else if ((ch == '_') || (ch == '/'))
+            digit = 63;
+        else if (ch == '=')
+            break;
+        else
+            return false;
+
+        accumulator = (accumulator << 6) | (uint32_t)digit;
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            buffer.push_back((uint8_t)(accumulator >> bits));
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool HTTP2::PerformHTTP2Upgrade(const HTTPRequest& request, HTTPResponse& response)
+{
+    bool upgrade = false;
+    bool settings = false;
+    std::vector<uint8_t> payload;
+
+    // Validate h2c upgrade request headers
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto header = request.header(i);
+        auto key = std::get<0>(header);
+        auto value = std::get<1>(header);
+
+        if (CppCommon::StringUtils::CompareNoCase(key, "Upgrade"))
+        {
+            if (CppCommon::StringUtils::CompareNoCase(value, "h2c"))
+                upgrade = true;
+        }
+        else if (CppCommon::StringUtils::CompareNoCase(key, "HTTP2-Settings"))
+        {
+            if (DecodeBase64Url(value, payload) && ((payload.size() % 6) == 0))
+                settings = true;
+        }
+    }
+
+    if (!upgrade || !settings)
+        return false;
+
+    std::scoped_lock locker(_http2_lock);
+
+    if (_http2 || (ApplySettings(payload.data(), payload.size()) != HTTP2_NO_ERROR))
+        return false;
+
+    // Upgrade request becomes the half-closed stream 1
+    auto stream = CreateStream(1);
+    stream->request = request;
+    stream->head = (request.method() == "HEAD");
+    stream->headers_received = true;
+    stream->remote_closed = true;
+    _http2_last_stream = 1;
+
+    // Prepare 101 Switching Protocols response
+    response.Clear();
+    response.SetBegin(101, "HTTP/1.1");
+    response.SetHeader("Connection", "Upgrade");
+    response.SetHeader("Upgrade", "h2c");
+    response.SetBody();
+
+    return true;
+}
+
+void HTTP2::StartHTTP2Server()
+{
+    std::scoped_lock locker(_http2_lock);
+
+    _http2 = true;
+    _http2_server = true;
+    _http2_preface = true;
+
+    PrepareSettings();
+    Flush();
+}
+
+void HTTP2::StartHTTP2Client()
+{
+    std::scoped_lock locker(_http2_lock);
+
+    _http2 = true;
+    _http2_server = false;
+    _http2_preface = false;
+
+    _http2_send_buffer.insert(_http2_send_buffer.end(), HTTP2_PREFACE.begin(), HTTP2_PREFACE.end());
+    PrepareSettings();
+    Flush();
+}
+
+uint32_t HTTP2::SendHTTP2Request(const HTTPRequest& request, std::string_view scheme)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || _http2_server || _http2_failed || _http2_goaway)
+        return 0;
+
+    // Respect the peer concurrent streams limit
+    if ((_http2_streams.size() >= _http2_peer_max_streams) || (_http2_next_stream > max_window_size))
+        return 0;
+
+    uint32_t id = _http2_next_stream;
+    _http2_next_stream += 2;
+
+    auto stream = CreateStream(id);
+
+    // Find the request authority
+    std::string_view authority;
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto header = request.header(i);
+        if (CppCommon::StringUtils::CompareNoCase(std::get<0>(header), "Host"))
+        {
+            authority = std::get<1>(header);
+            break;
+        }
+    }
+
+    // Encode the request header block
+    _http2_encode_buffer.clear();
+    EncodeHeader(":method", request.method());
+    EncodeHeader(":scheme", scheme);
+    if (!authority.empty())
+        EncodeHeader(":authority", authority);
+    EncodeHeader(":path", request.url());
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto header = request.header(i);
+        if (!CppCommon::StringUtils::CompareNoCase(std::get<0>(header), "Host"))
+            EncodeHeader(std::get<0>(header), std::get<1>(header));
+    }
+
+    std::string_view body = request.body();
+
+    PrepareHeaderBlock(id, body.empty());
+    if (body.empty())
+        stream->local_closed = true;
+    else
+        PrepareData(stream, body.data(), body.size(), true);
+
+    Flush();
+    return id;
+}
+
+bool HTTP2::SendHTTP2Response(uint32_t stream, std::string_view content)
+{
+    // Parse the HTTP/1.x status line
+    size_t index = content.find("\r\n");
+    if ((content.substr(0, 5) != "HTTP/") || (index == std::string_view::npos))
+        return false;
+    size_t status_index = content.find(' ');
+    if ((status_index == std::string_view::npos) || ((status_index + 4) > index))
+        return false;
+    std::string_view status = content.substr(status_index + 1, 3);
+
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || _http2_failed)
+        return false;
+
+    auto current = FindStream(stream);
+    if (!current || current->local_closed || !current->headers_received)
+        return false;
+
+    // Encode the response header block
+    _http2_encode_buffer.clear();
+    EncodeHeader(":status", status);
+
+    size_t content_length = std::string_view::npos;
+    size_t offset = index + 2;
+    for (;;)
+    {
+        index = content.find("\r\n", offset);
+        if (index == std::string_view::npos)
+            return false;
+
+        // Empty line before the body
+        if (index == offset)
+        {
+            offset += 2;
+            break;
+        }
+
+        std::string_view line = content.substr(offset, index - offset);
+        offset = index + 2;
+
+        size_t separator = line.find(':');
+        if (separator == std::string_view::npos)
+            return false;
+
+        std::string_view key = line.substr(0, separator);
+        std::string_view value = line.substr(separator + 1);
+        while (!value.empty() && (value.front() == ' '))
+            value.remove_prefix(1);
+
+        if (CppCommon::StringUtils::CompareNoCase(key, "Content-Length"))
+        {
+            content_length = 0;
+            for (char ch : value)
+                if ((ch >= '0') && (ch <= '9'))
+                    content_length = content_length * 10 + (ch - '0');
+        }
+
+        EncodeHeader(key, value);
+    }
+
+    std::string_view body = content.substr(offset);
+    if ((content_length != std::string_view::npos) && (body.size() > content_length))
+        body = body.substr(0, content_length);
+    current->body_remaining = ((content_length != std::string_view::npos) ? content_length : body.size()) - body.size();
+
+    // Response to HEAD request never has a body
+    if (current->head)
+    {
+        body = std::string_view();
+        current->body_remaining = 0;
+    }
+
+    bool end_stream = body.empty() && (current->body_remaining == 0);
+
+    PrepareHeaderBlock(stream, end_stream);
+    if (end_stream)
+    {
+        current->local_closed = true;
+        if (current->remote_closed)
+            CloseStream(current);
+    }
+    else if (!body.empty())
+        PrepareData(current, body.data(), body.size(), current->body_remaining == 0);
+
+    Flush();
+    return true;
+}
+
+bool HTTP2::SendHTTP2ResponseBody(uint32_t stream, const void* buffer, size_t size)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || _http2_failed)
+        return false;
+
+    auto current = FindStream(stream);
+    if (!current || current->local_closed || (current->body_remaining == 0))
+        return false;
+
+    size = std::min(size, (size_t)current->body_remaining);
+    current->body_remaining -= size;
+
+    PrepareData(current, buffer, size, current->body_remaining == 0);
+
+    Flush();
+    return true;
+}
+
+void HTTP2::ResetHTTP2Stream(uint32_t stream, uint32_t error)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || _http2_failed)
+        return;
+
+    ResetStream(stream, error);
+    Flush();
+}
+
+void HTTP2::SendHTTP2GoAway(uint32_t error)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || _http2_failed)
+        return;
+
+    uint8_t payload[8];
+    WriteUInt32(payload, _http2_last_stream);
+    WriteUInt32(payload + 4, error);
+    PrepareFrame(HTTP2_GOAWAY, 0, 0, payload, sizeof(payload));
+    Flush();
+}
+
+void HTTP2::PrepareReceiveHTTP2(const void* buffer, size_t size)
+{
+    {
+        std::scoped_lock locker(_http2_lock);
+
+        if (!_http2 || _http2_failed)
+            return;
+
+        if (_http2_receive_buffer.empty())
+        {
+            // Process complete frames directly from the received buffer
+            size_t processed = ReceiveFrames((const uint8_t*)buffer, size);
+            if (!_http2_failed && (processed < size))
+                _http2_receive_buffer.insert(_http2_receive_buffer.end(), (const uint8_t*)buffer + processed, (const uint8_t*)buffer + size);
+        }
+        else
+        {
+            _http2_receive_buffer.insert(_http2_receive_buffer.end(), (const uint8_t*)buffer, (const uint8_t*)buffer + size);
+            size_t processed = ReceiveFrames(_http2_receive_buffer.data(), _http2_receive_buffer.size());
+            _http2_receive_buffer.erase(_http2_receive_buffer.begin(), _http2_receive_buffer.begin() + processed);
+        }
+
+        if (_http2_failed)
+            _http2_receive_buffer.clear();
+
+        Flush();
+
+        // Take notifications to dispatch them outside of the lock
+        _http2_dispatch.swap(_http2_events);
+    }
+
+    Dispatch();
+}
+
+void HTTP2::ClearHTTP2()
+{
+    std::scoped_lock locker(_http2_lock);
+
+    _http2 = false;
+    _http2_server = false;
+    _http2_preface = false;
+    _http2_failed = false;
+    _http2_goaway = false;
+
+    _http2_peer_max_frame_size = 16384;
+    _http2_peer_max_streams = 0xFFFFFFFF;
+    _http2_peer_window_size = 65535;
+
+    _http2_send_window = 65535;
+    _http2_receive_window = 65535;
+
+    _http2_last_stream = 0;
+    _http2_next_stream = 1;
+    _http2_streams.clear();
+    _http2_pending_streams.clear();
+
+    _http2_decoder.Clear();
+    _http2_headers.clear();
+    _http2_header_block.clear();
+    _http2_continuation_stream = 0;
+    _http2_continuation_flags = 0;
+
+    _http2_receive_buffer.clear();
+    _http2_send_buffer.clear();
+    _http2_events.clear();
+}
+
+size_t HTTP2::ReceiveFrames(const uint8_t* buffer, size_t size)
+{
+    size_t offset = 0;
+
+    // Validate the client connection preface
+    if (_http2_preface)
+    {
+        size_t length = std::min(size, HTTP2_PREFACE.size());
+        if (std::memcmp(buffer, HTTP2_PREFACE.data(), length) != 0)
+        {
+            Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 client connection preface!");
+            return size;
+        }
+        if (length < HTTP2_PREFACE.size())
+            return 0;
+
+        offset += HTTP2_PREFACE.size();
+        _http2_preface = false;
+    }
+
+    while (!_http2_failed && ((size - offset) >= 9))
+    {
+        const uint8_t* frame = buffer + offset;
+
+        size_t length = ReadUInt24(frame);
+        if (length > max_frame_size)
+        {
+            Fail(HTTP2_FRAME_SIZE_ERROR, "HTTP/2 frame size exceeds the limit!");
+            return size;
+        }
+
+        // Wait for the whole frame
+        if ((size - offset) < (9 + length))
+            break;
+
+        ReceiveFrame(frame[3], frame[4], ReadUInt31(frame + 5), frame + 9, length);
+
+        offset += 9 + length;
+    }
+
+    return offset;
+}
+
+void HTTP2::ReceiveFrame(uint8_t type, uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    // Header block must be continued without interleaving frames
+    if ((_http2_continuation_stream != 0) && ((type != HTTP2_CONTINUATION) || (id != _http2_continuation_stream)))
+    {
+        Fail(HTTP2_PROTOCOL_ERROR, "HTTP/2 CONTINUATION frame expected!");
+        return;
+    }
+
+    switch (type)
+    {
+        case HTTP2_DATA:
+            ReceiveData(flags, id, payload, size);
+            break;
+        case HTTP2_HEADERS:
+            ReceiveHeaders(flags, id, payload, size);
+            break;
+        case HTTP2_PRIORITY:
+            if (id == 0)
+                Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 PRIORITY frame!");
+            else if (size != 5)
+                ResetStream(id, HTTP2_FRAME_SIZE_ERROR);
+            break;
+        case HTTP2_RST_STREAM:
+        {
+            if (id == 0)
+            {
+                Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 RST_STREAM frame!");
+                break;
+            }
+            if (size != 4)
+            {
+                Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 RST_STREAM frame size!");
+                break;
+            }
+            auto stream = FindStream(id);
+            if (stream)
+            {
+                _http2_events.push_back(Event{ Event::RESET, stream, id, ReadUInt32(payload), std::string() });
+                CloseStream(stream);
+            }
+            break;
+        }
+        case HTTP2_SETTINGS:
+            ReceiveSettings(flags, id, payload, size);
+            break;
+        case HTTP2_PUSH_PROMISE:
+            Fail(HTTP2_PROTOCOL_ERROR, "HTTP/2 server push is not supported!");
+            break;
+        case HTTP2_PING:
+            if (id != 0)
+                Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 PING frame!");
+            else if (size != 8)
+                Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 PING frame size!");
+            else if ((flags & HTTP2_FLAG_ACK) == 0)
+                PrepareFrame(HTTP2_PING, HTTP2_FLAG_ACK, 0, payload, size);
+            break;
+        case HTTP2_GOAWAY:
+            if (id != 0)
+                Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 GOAWAY frame!");
+            else if (size < 8)
+                Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 GOAWAY frame size!");
+            else
+            {
+                _http2_goaway = true;
+                _http2_events.push_back(Event{ Event::GOAWAY, nullptr, ReadUInt31(payload), ReadUInt32(payload + 4), std::string() });
+            }
+            break;
+        case HTTP2_WINDOW_UPDATE:
+            ReceiveWindowUpdate(id, payload, size);
+            break;
+        case HTTP2_CONTINUATION:
+            if (_http2_continuation_stream == 0)
+            {
+                Fail(HTTP2_PROTOCOL_ERROR, "Unexpected HTTP/2 CONTINUATION frame!");
+                break;
+            }
+            if ((_http2_header_block.size() + size) > max_header_block_size)
+            {
+                Fail(HTTP2_PROTOCOL_ERROR, "HTTP/2 header block size exceeds the limit!");
+                break;
+            }
+            _http2_header_block.insert(_http2_header_block.end(), payload, payload + size);
+            if ((flags & HTTP2_FLAG_END_HEADERS) != 0)
+            {
+                _http2_continuation_stream = 0;
+                ReceiveHeaderBlock(_http2_continuation_flags, id, _http2_header_block.data(), _http2_header_block.size());
+            }
+            break;
+        default:
+            // Unknown frames must be ignored
+            break;
+    }
+}
+
+void HTTP2::ReceiveData(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id == 0)
+    {
+        Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 DATA frame!");
+        return;
+    }
+
+    const uint8_t* data = payload;
+    size_t length = size;
+    if ((flags & HTTP2_FLAG_PADDED) != 0)
+    {
+        if ((size < 1) || (payload[0] >= size))
+        {
+            Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 DATA frame padding!");
+            return;
+        }
+        data = payload + 1;
+        length = size - 1 - payload[0];
+    }
+
+    // Connection flow control accounts the whole frame payload
+    _http2_receive_window -= size;
+    if (_http2_receive_window < 0)
+    {
+        Fail(HTTP2_FLOW_CONTROL_ERROR, "HTTP/2 connection flow control window exceeded!");
+        return;
+    }
+    if (_http2_receive_window < (HTTP2_CONNECTION_WINDOW_SIZE / 2))
+    {
+        PrepareWindowUpdate(0, (uint32_t)(HTTP2_CONNECTION_WINDOW_SIZE - _http2_receive_window));
+        _http2_receive_window = HTTP2_CONNECTION_WINDOW_SIZE;
+    }
+
+    auto stream = FindStream(id);
+    if (!stream || !stream->headers_received || stream->remote_closed)
+    {
+        ResetStream(id, HTTP2_STREAM_CLOSED);
+        return;
+    }
+
+    stream->receive_window -= size;
+    if (stream->receive_window < 0)
+    {
+        ResetStream(id, HTTP2_FLOW_CONTROL_ERROR);
+        return;
+    }
+
+    // Refuse the stream with too large body
+    if ((stream->body.size() + length) > HTTP2_MAX_BODY_SIZE)
+    {
+        ResetStream(id, HTTP2_REFUSED_STREAM);
+        return;
+    }
+
+    stream->body.append((const char*)data, length);
+
+    if ((flags & HTTP2_FLAG_END_STREAM) != 0)
+        CompleteStream(stream);
+    else if (stream->receive_window < (HTTP2_STREAM_WINDOW_SIZE / 2))
+    {
+        PrepareWindowUpdate(id, (uint32_t)(HTTP2_STREAM_WINDOW_SIZE - stream->receive_window));
+        stream->receive_window = HTTP2_STREAM_WINDOW_SIZE;
+    }
+}
+
+void HTTP2::ReceiveHeaders(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id == 0)
+    {
+        Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 HEADERS frame!");
+        return;
+    }
+
+    size_t offset = 0;
+    size_t padding = 0;
+    if ((flags & HTTP2_FLAG_PADDED) != 0)
+    {
+        if (size < 1)
+        {
+            Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 HEADERS frame padding!");
+            return;
+        }
+        padding = payload[0];
+        offset += 1;
+    }
+    if ((flags & HTTP2_FLAG_PRIORITY) != 0)
+        offset += 5;
+    if ((offset + padding) > size)
+    {
+        Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 HEADERS frame padding!");
+        return;
+    }
+
+    const uint8_t* block = payload + offset;
+    size_t length = size - offset - padding;
+
+    if ((flags & HTTP2_FLAG_END_HEADERS) != 0)
+        ReceiveHeaderBlock(flags, id, block, length);
+    else
+    {
+        // Wait for CONTINUATION frames
+        _http2_header_block.assign(block, block + length);
+        _http2_continuation_stream = id;
+        _http2_continuation_flags = flags;
+    }
+}
+
+void HTTP2::ReceiveHeaderBlock(uint8_t flags, uint32_t id, const uint8_t* block, size_t size)
+{
+    // Header block is always decoded to keep the dynamic table synchronized
+    _http2_headers.clear();
+    if (!_http2_decoder.Decode(block, size, _http2_headers))
+    {
+        Fail(HTTP2_COMPRESSION_ERROR, "Invalid HTTP/2 header block!");
+        return;
+    }
+
+    bool end_stream = (flags & HTTP2_FLAG_END_STREAM) != 0;
+
+    auto stream = FindStream(id);
+
+    if (_http2_server)
+    {
+        if (stream)
+        {
+            // Trailers must close the stream
+            if (stream->remote_closed)
+                ResetStream(id, HTTP2_STREAM_CLOSED);
+            else if (!end_stream)
+                ResetStream(id, HTTP2_PROTOCOL_ERROR);
+            else
+                CompleteStream(stream);
+            return;
+        }
+
+        // Client streams must be odd and increasing
+        if (((id % 2) == 0) || (id <= _http2_last_stream))
+        {
+            Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 stream Id!");
+            return;
+        }
+        _http2_last_stream = id;
+
+        if (_http2_streams.size() >= HTTP2_MAX_CONCURRENT_STREAMS)
+        {
+            ResetStream(id, HTTP2_REFUSED_STREAM);
+            return;
+        }
+
+        ProcessRequest(CreateStream(id), end_stream);
+    }
+    else
+    {
+        if (!stream || stream->remote_closed)
+        {
+            ResetStream(id, HTTP2_STREAM_CLOSED);
+            return;
+        }
+
+        ProcessResponse(stream, end_stream);
+    }
+}
+
+void HTTP2::ReceiveSettings(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id != 0)
+    {
+        Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 SETTINGS frame!");
+        return;
+    }
+
+    if ((flags & HTTP2_FLAG_ACK) != 0)
+    {
+        if (size != 0)
+            Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 SETTINGS frame size!");
+        return;
+    }
+
+    if ((size % 6) != 0)
+    {
+        Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 SETTINGS frame size!");
+        return;
+    }
+
+    uint32_t error = ApplySettings(payload, size);
+    if (error != HTTP2_NO_ERROR)
+    {
+        Fail(error, "Invalid HTTP/2 SETTINGS value!");
+        return;
+    }
+
+    PrepareFrame(HTTP2_SETTINGS, HTTP2_FLAG_ACK, 0, nullptr, 0);
+
+    // Initial window size changes could unblock pending streams
+    FlushStreams();
+}
+
+void HTTP2::ReceiveWindowUpdate(uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (size != 4)
+    {
+        Fail(HTTP2_FRAME_SIZE_ERROR, "Invalid HTTP/2 WINDOW_UPDATE frame size!");
+        return;
+    }
+
+    uint32_t increment = ReadUInt31(payload);
+
+    if (id == 0)
+    {
+        if (increment == 0)
+        {
+            Fail(HTTP2_PROTOCOL_ERROR, "Invalid HTTP/2 WINDOW_UPDATE increment!");
+            return;
+        }
+
+        _http2_send_window += increment;
+        if (_http2_send_window > max_window_size)
+        {
+            Fail(HTTP2_FLOW_CONTROL_ERROR, "HTTP/2 connection flow control window overflow!");
+            return;
+        }
+    }
+    else
+    {
+        auto stream = FindStream(id);
+        if (!stream)
+            return;
+
+        if (increment == 0)
+        {
+            ResetStream(id, HTTP2_PROTOCOL_ERROR);
+            return;
+        }
+
+        stream->send_window += increment;
+        if (stream->send_window > max_window_size)
+        {
+            ResetStream(id, HTTP2_FLOW_CONTROL_ERROR);
+            return;
+        }
+    }
+
+    FlushStreams();
+}
+
+uint32_t HTTP2::ApplySettings(const uint8_t* payload, size_t size)
+{
+    for (size_t offset = 0; (offset + 6) <= size; offset += 6)
+    {
+        uint32_t key = ((uint32_t)payload[offset] << 8) | (uint32_t)payload[offset + 1];
+        uint32_t value = ReadUInt32(payload + offset + 2);
+
+        switch (key)
+        {
+            // SETTINGS_ENABLE_PUSH
+            case 0x02:
+                if (value > 1)
+                    return HTTP2_PROTOCOL_ERROR;
+                break;
+            // SETTINGS_MAX_CONCURRENT_STREAMS
+            case 0x03:
+                _http2_peer_max_streams = value;
+                break;
+            // SETTINGS_INITIAL_WINDOW_SIZE
+            case 0x04:
+            {
+                if (value > max_window_size)
+                    return HTTP2_FLOW_CONTROL_ERROR;
+
+                // Adjust all stream send windows by the difference
+                int64_t delta = (int64_t)value - _http2_peer_window_size;
+                for (auto& stream : _http2_streams)
+                    stream.second->send_window += delta;
+                _http2_peer_window_size = value;
+                break;
+            }
+            // SETTINGS_MAX_FRAME_SIZE
+            case 0x05:
+                if ((value < 16384) || (value > 16777215))
+                    return HTTP2_PROTOCOL_ERROR;
+                _http2_peer_max_frame_size = value;
+                break;
+            default:
+                // Header table size is not used by the stateless encoder, unknown settings must be ignored
+                break;
+        }
+    }
+
+    return HTTP2_NO_ERROR;
+}
+
+void HTTP2::ProcessRequest(const std::shared_ptr<Stream>& stream, bool end_stream)
+{
+    std::string_view method;
+    std::string_view path;
+    std::string_view authority;
+
+    for (const auto& header : _http2_headers)
+    {
+        if (header.first == ":method")
+            method = header.second;
+        else if (header.first == ":path")
+            path = header.second;
+        else if (header.first == ":authority")
+            authority = header.second;
+    }
+
+    if (method.empty() || path.empty())
+    {
+        ResetStream(stream->id, HTTP2_PROTOCOL_ERROR);
+        return;
+    }
+
+    // Convert the request header block into the stream HTTP request
+    HTTPRequest& request = stream->request;
+    request.SetBegin(method, path, "HTTP/2.0");
+    if (!authority.empty())
+        request.SetHeader("Host", authority);
+    for (const auto& header : _http2_headers)
+    {
+        if (header.first.empty() || (header.first[0] == ':') || (header.first == "content-length"))
+            continue;
+
+        if (header.first == "cookie")
+        {
+            // Split HTTP/2 cookie header into separate cookies
+            std::string_view cookies = header.second;
+            while (!cookies.empty())
+            {
+                size_t index = cookies.find(';');
+                std::string_view cookie = cookies.substr(0, index);
+                cookies = (index == std::string_view::npos) ? std::string_view() : cookies.substr(index + 1);
+                while (!cookie.empty() && (cookie.front() == ' '))
+                    cookie.remove_prefix(1);
+
+                size_t separator = cookie.find('=');
+                if (separator != std::string_view::npos)
+                    request.SetCookie(cookie.substr(0, separator), cookie.substr(separator + 1));
+            }
+            continue;
+        }
+
+        request.SetHeader(header.first, header.second);
+    }
+
+    // Keep the HEAD request flag to send its response without reading the request
+    stream->head = (request.method() == "HEAD");
+    stream->headers_received = true;
+
+    if (end_stream)
+        CompleteStream(stream);
+}
+
+void HTTP2::ProcessResponse(const std::shared_ptr<Stream>& stream, bool end_stream)
+{
+    if (!stream->headers_received)
+    {
+        int status = 0;
+        for (const auto& header : _http2_headers)
+        {
+            if (header.first == ":status")
+            {
+                for (char ch : header.second)
+                    status = status * 10 + (ch - '0');
+                break;
+            }
+        }
+
+        if ((status < 100) || (status > 999))
+        {
+            ResetStream(stream->id, HTTP2_PROTOCOL_ERROR);
+            return;
+        }
+
+        // Skip informational responses
+        if (status < 200)
+            return;
+
+        // Convert the response header block into the stream HTTP response
+        HTTPResponse& response = stream->response;
+        response.SetBegin(status, "HTTP/2.0");
+        for (const auto& header : _http2_headers)
+            if (!header.first.empty() && (header.first[0] != ':') && (header.first != "content-length"))
+                response.SetHeader(header.first, header.second);
+
+        stream->headers_received = true;
+    }
+
+    if (end_stream)
+        CompleteStream(stream);
+}
+
+void HTTP2::CompleteStream(const std::shared_ptr<Stream>& stream)
+{
+    stream->remote_closed = true;
+
+    if (_http2_server)
+    {
+        stream->request.SetBody(stream->body);
+        _http2_events.push_back(Event{ Event::REQUEST, stream, stream->id, HTTP2_NO_ERROR, std::string() });
+    }
+    else
+    {
+        stream->response.SetBody(stream->body);
+        _http2_events.push_back(Event{ Event::RESPONSE, stream, stream->id, HTTP2_NO_ERROR, std::string() });
+    }
+
+    stream->body.clear();
+
+    if (stream->local_closed)
+        CloseStream(stream);
+}
+
+std::shared_ptr<HTTP2::Stream> HTTP2::CreateStream(uint32_t id)
+{
+    std::shared_ptr<Stream> stream;
+
+    // Reuse the recycled stream with retained capacity if it is not referenced by notifications
+    if (!_http2_free_streams.empty() && (_http2_free_streams.back().use_count() == 1))
+    {
+        stream = std::move(_http2_free_streams.back());
+        _http2_free_streams.pop_back();
+    }
+    else
+        stream = std::make_shared<Stream>();
+
+    stream->id = id;
+    stream->headers_received = false;
+    stream->remote_closed = false;
+    stream->local_closed = false;
+    stream->send_window = _http2_peer_window_size;
+    stream->receive_window = HTTP2_STREAM_WINDOW_SIZE;
+    stream->body_remaining = 0;
+    stream->head = false;
+    stream->request.Clear();
+    stream->response.Clear();
+    stream->body.clear();
+    stream->pending.clear();
+    stream->pending_offset = 0;
+    stream->pending_end = false;
+
+    _http2_streams.emplace(id, stream);
+    return stream;
+}
+
+std::shared_ptr<HTTP2::Stream> HTTP2::FindStream(uint32_t id) const
+{
+    auto it = _http2_streams.find(id);
+    return (it != _http2_streams.end()) ? it->second : nullptr;
+}
+
+void HTTP2::CloseStream(const std::shared_ptr<Stream>& stream)
+{
+    auto it = _http2_streams.find(stream->id);
+    if ((it == _http2_streams.end()) || (it->second != stream))
+        return;
+
+    auto pending = std::find(_http2_pending_streams.begin(), _http2_pending_streams.end(), stream);
+    if (pending != _http2_pending_streams.end())
+        _http2_pending_streams.erase(pending);
+
+    if (_http2_free_streams.size() < max_free_streams)
+        _http2_free_streams.push_back(it->second);
+
+    _http2_streams.erase(it);
+}
+
+void HTTP2::ResetStream(uint32_t id, uint32_t error)
+{
+    uint8_t payload[4];
+    WriteUInt32(payload, error);
+    PrepareFrame(HTTP2_RST_STREAM, 0, id, payload, sizeof(payload));
+
+    auto stream = FindStream(id);
+    if (stream)
+        CloseStream(stream);
+}
+
+void HTTP2::PrepareFrame(uint8_t type, uint8_t flags, uint32_t id, const void* payload, size_t size)
+{
+    uint8_t header[9];
+    header[0] = (uint8_t)(size >> 16);
+    header[1] = (uint8_t)(size >> 8);
+    header[2] = (uint8_t)size;
+    header[3] = type;
+    header[4] = flags;
+    WriteUInt32(header + 5, id & 0x7FFFFFFF);
+
+    _http2_send_buffer.insert(_http2_send_buffer.end(), header, header + sizeof(header));
+    if (size > 0)
+        _http2_send_buffer.insert(_http2_send_buffer.end(), (const uint8_t*)payload, (const uint8_t*)payload + size);
+}
+
+void HTTP2::PrepareSettings()
+{
+    uint8_t payload[18];
+    size_t size = 0;
+
+    // Disable server push for the client
+    if (!_http2_server)
+    {
+        WriteUInt16(payload + size, 0x02);
+        WriteUInt32(payload + size + 2, 0);
+        size += 6;
+    }
+
+    WriteUInt16(payload + size, 0x03);
+    WriteUInt32(payload + size + 2, HTTP2_MAX_CONCURRENT_STREAMS);
+    size += 6;
+
+    WriteUInt16(payload + size, 0x04);
+    WriteUInt32(payload + size + 2, HTTP2_STREAM_WINDOW_SIZE);
+    size += 6;
+
+    PrepareFrame(HTTP2_SETTINGS, 0, 0, payload, size);
+
+    // Enlarge the connection receive window
+    PrepareWindowUpdate(0, (uint32_t)(HTTP2_CONNECTION_WINDOW_SIZE - _http2_receive_window));
+    _http2_receive_window = HTTP2_CONNECTION_WINDOW_SIZE;
+}
+
+void HTTP2::PrepareWindowUpdate(uint32_t id, uint32_t increment)
+{
+    if (increment == 0)
+        return;
+
+    uint8_t payload[4];
+    WriteUInt32(payload, increment & 0x7FFFFFFF);
+    PrepareFrame(HTTP2_WINDOW_UPDATE, 0, id, payload, sizeof(payload));
+}
+
+void HTTP2::PrepareHeaderBlock(uint32_t id, bool end_stream)
+{
+    const uint8_t* block = _http2_encode_buffer.data();
+    size_t size = _http2_encode_buffer.size();
+
+    // Split the header block into HEADERS and CONTINUATION frames
+    size_t chunk = std::min(size, (size_t)_http2_peer_max_frame_size);
+    uint8_t flags = (end_stream ? HTTP2_FLAG_END_STREAM : 0) | ((chunk == size) ? HTTP2_FLAG_END_HEADERS : 0);
+    PrepareFrame(HTTP2_HEADERS, flags, id, block, chunk);
+
+    for (size_t offset = chunk; offset < size; offset += chunk)
+    {
+        chunk = std::min(size - offset, (size_t)_http2_peer_max_frame_size);
+        PrepareFrame(HTTP2_CONTINUATION, ((offset + chunk) == size) ? HTTP2_FLAG_END_HEADERS : 0, id, block + offset, chunk);
+    }
+}
+
+void HTTP2::PrepareData(const std::shared_ptr<Stream>& stream, const void* buffer, size_t size, bool end_stream)
+{
+    // Keep the order of the already queued data
+    if (!stream->pending.empty())
+    {
+        stream->pending.append((const char*)buffer, size);
+        stream->pending_end = end_stream;
+        return;
+    }
+
+    stream->pending_end = end_stream;
+
+    const uint8_t* data = (const uint8_t*)buffer;
+    for (;;)
+    {
+        size_t chunk = (size_t)std::max((int64_t)0, std::min({ (int64_t)size, _http2_send_window, stream->send_window, (int64_t)_http2_peer_max_frame_size }));
+        if ((chunk == 0) && (size > 0))
+            break;
+
+        bool last = (chunk == size) && end_stream;
+        PrepareFrame(HTTP2_DATA, last ? HTTP2_FLAG_END_STREAM : 0, stream->id, data, chunk);
+        _http2_send_window -= chunk;
+        stream->send_window -= chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (size == 0)
+        {
+            if (end_stream)
+            {
+                stream->local_closed = true;
+                if (stream->remote_closed)
+                    CloseStream(stream);
+            }
+            return;
+        }
+    }
+
+    // Queue the rest of data until the peer extends the flow control window
+    stream->pending.assign((const char*)data, size);
+    stream->pending_offset = 0;
+    _http2_pending_streams.push_back(stream);
+}
+
+void HTTP2::FlushStream(const std::shared_ptr<Stream>& stream)
+{
+    while (stream->pending_offset < stream->pending.size())
+    {
+        size_t size = stream->pending.size() - stream->pending_offset;
+        size_t chunk = (size_t)std::max((int64_t)0, std::min({ (int64_t)size, _http2_send_window, stream->send_window, (int64_t)_http2_peer_max_frame_size }));
+        if (chunk == 0)
+            return;
+
+        bool last = (chunk == size) && stream->pending_end;
+        PrepareFrame(HTTP2_DATA, last ? HTTP2_FLAG_END_STREAM : 0, stream->id, stream->pending.data() + stream->pending_offset, chunk);
+        _http2_send_window -= chunk;
+        stream->send_window -= chunk;
+        stream->pending_offset += chunk;
+    }
+
+    stream->pending.clear();
+    stream->pending_offset = 0;
+
+    if (stream->pending_end)
+    {
+        stream->local_closed = true;
+        if (stream->remote_closed)
+            CloseStream(stream);
+    }
+}
+
+void HTTP2::FlushStreams()
+{
+    // Flush streams in the queue order while the connection window is available
+    size_t index = 0;
+    while ((index < _http2_pending_streams.size()) && (_http2_send_window > 0))
+    {
+        auto stream = _http2_pending_streams[index];
+        FlushStream(stream);
+
+        if (stream->pending.empty())
+        {
+            // Stream could be already removed from the queue on close
+            if ((index < _http2_pending_streams.size()) && (_http2_pending_streams[index] == stream))
+                _http2_pending_streams.erase(_http2_pending_streams.begin() + index);
+        }
+        else
+            ++index;
+    }
+}
+
+void HTTP2::EncodeHeader(std::string_view name, std::string_view value)
+{
+    // HTTP/2 header names must be in lowercase
+    _http2_header_name.assign(name);
+    for (auto& ch : _http2_header_name)
+        if ((ch >= 'A') && (ch <= 'Z'))
+            ch = (char)(ch - 'A' + 'a');
+
+    if (IsConnectionHeader(_http2_header_name))
+        return;
+
+    HPACK::EncodeHeader(_http2_encode_buffer, _http2_header_name, value);
+}
+
+void HTTP2::Fail(uint32_t error, const std::string& message)
+{
+    if (_http2_failed)
+        return;
+
+    _http2_failed = true;
+    _http2_continuation_stream = 0;
+
+    uint8_t payload[8];
+    WriteUInt32(payload, _http2_last_stream);
+    WriteUInt32(payload + 4, error);
+    PrepareFrame(HTTP2_GOAWAY, 0, 0, payload, sizeof(payload));
+
+    _http2_events.push_back(Event{ Event::FAILURE, nullptr, 0, error, message });
+}
+
+void HTTP2::Flush()
+{
+    if (_http2_send_buffer.empty())
+        return;
+
+    SendHTTP2(_http2_send_buffer.data(), _http2_send_buffer.size());
+    _http2_send_buffer.clear();
+}
+
+void HTTP2::Dispatch()
+{
+    for (auto& event : _http2_dispatch)
+    {
+        switch (event.type)
+        {
+            case Event::REQUEST:
+                onHTTP2Request(event.id, event.stream->request);
+                break;
+            case Event::RESPONSE:
+                onHTTP2Response(event.id, event.stream->response);
+                break;
+            case Event::RESET:
+                onHTTP2Reset(event.id, event.error);
+                break;
+            case Event::GOAWAY:
+                onHTTP2GoAway(event.id, event.error);
+                break;
+            case Event::FAILURE:
+                onHTTP2Error(event.message);
+                break;
+        }
+    }
+
+    // Release streams referenced by notifications, but keep the capacity
+    _http2_dispatch.clear();
+}
+
+} // namespace HTTP
+} // namespace CppServer
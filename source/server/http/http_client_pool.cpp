@@ -0,0 +1,810 @@
+/*!
+    \file http_client_pool.cpp
+    \brief HTTP client connection pool implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http_client_pool.h"
+
+#include "server/asio/ssl_client.h"
+
+#include "string/string_utils.h"
+#include "time/timestamp.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP pooled connection
+class HTTPClientPool::Connection
+{
+public:
+    Connection(const std::shared_ptr<HTTPClientPool>& pool, const std::shared_ptr<Host>& host)
+        : host(host),
+          timer(std::make_shared<Asio::Timer>(pool->service())),
+          offset(0),
+          body(0),
+          chunked(false),
+          chunk(0),
+          served(0),
+          connected(false),
+          reusable(true),
+          _pool(pool)
+    {
+        // Request timeouts are planned in the timer wheel
+        timer->SetupTimerWheel(true);
+    }
+    Connection(const Connection&) = delete;
+    Connection(Connection&&) = delete;
+    virtual ~Connection() = default;
+
+    Connection& operator=(const Connection&) = delete;
+    Connection& operator=(Connection&&) = delete;
+
+    // Following fields are protected by the host lock
+    std::weak_ptr<Host> host;
+    std::shared_ptr<Asio::Timer> timer;
+    std::deque<std::shared_ptr<Request>> requests;
+    std::string buffer;
+    size_t offset;
+    HTTPResponse response;
+    size_t body;
+    bool chunked;
+    size_t chunk;
+    size_t served;
+    bool connected;
+    bool reusable;
+
+    // Connection transport
+    virtual std::shared_ptr<Connection> self() = 0;
+    virtual bool ConnectAsync() = 0;
+    virtual bool DisconnectAsync() = 0;
+    virtual bool SendAsync(std::string_view text) = 0;
+
+protected:
+    // Transport handlers
+    void Connected()
+    {
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onConnected(self());
+    }
+
+    void Disconnected()
+    {
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onDisconnected(self());
+    }
+
+    void Received(const void* buffer, size_t size)
+    {
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onReceived(self(), buffer, size);
+    }
+
+private:
+    std::weak_ptr<HTTPClientPool> _pool;
+};
+
+//! HTTP pooled connection over TCP transport
+class HTTPClientPool::TCPConnection : public Connection, public Asio::TCPClient
+{
+public:
+    TCPConnection(const std::shared_ptr<HTTPClientPool>& pool, const std::shared_ptr<Host>& host, const asio::ip::tcp::endpoint& endpoint)
+        : Connection(pool, host),
+          Asio::TCPClient(pool->service(), endpoint)
+    {
+        SetupNoDelay(true);
+    }
+
+    std::shared_ptr<Connection> self() override { return std::static_pointer_cast<TCPConnection>(shared_from_this()); }
+    bool ConnectAsync() override { return Asio::TCPClient::ConnectAsync(); }
+    bool DisconnectAsync() override { return Asio::TCPClient::DisconnectAsync(); }
+    bool SendAsync(std::string_view text) override { return Asio::TCPClient::SendAsync(text); }
+
+protected:
+    void onConnected() override { Connected(); }
+    void onDisconnected() override { Disconnected(); }
+    void onReceived(const void* buffer, size_t size) override { Received(buffer, size); }
+};
+
+//! HTTPS pooled connection over SSL transport
+class HTTPClientPool::SSLConnection : public Connection, public Asio::SSLClient
+{
+public:
+    SSLConnection(const std::shared_ptr<HTTPClientPool>& pool, const std::shared_ptr<Host>& host, const asio::ip::tcp::endpoint& endpoint)
+        : Connection(pool, host),
+          Asio::SSLClient(pool->service(), pool->context(), endpoint)
+    {
+        SetupNoDelay(true);
+    }
+
+    std::shared_ptr<Connection> self() override { return std::static_pointer_cast<SSLConnection>(shared_from_this()); }
+    bool ConnectAsync() override { return Asio::SSLClient::ConnectAsync(); }
+    bool DisconnectAsync() override { return Asio::SSLClient::DisconnectAsync(); }
+    bool SendAsync(std::string_view text) override { return Asio::SSLClient::SendAsync(text); }
+
+protected:
+    // Requests are sent only over the handshaked connection
+    void onHandshaked() override { Connected(); }
+    void onDisconnected() override { Disconnected(); }
+    void onReceived(const void* buffer, size_t size) override { Received(buffer, size); }
+};
+
+HTTPClientPool::HTTPClientPool(const std::shared_ptr<Asio::Service>& service, size_t max_connections, size_t max_pipeline)
+    : HTTPClientPool(service, nullptr, max_connections, max_pipeline)
+{
+}
+
+HTTPClientPool::HTTPClientPool(const std::shared_ptr<Asio::Service>& service, const std::shared_ptr<Asio::SSLContext>& context, size_t max_connections, size_t max_pipeline)
+    : _service(service),
+      _context(context),
+      _resolver(std::make_shared<Asio::TCPResolver>(service)),
+      _max_connections(std::max(max_connections, (size_t)1)),
+      _max_pipeline(std::max(max_pipeline, (size_t)1))
+{
+}
+
+HTTPClientPool::~HTTPClientPool()
+{
+    Clear();
+}
+
+size_t HTTPClientPool::connections() const
+{
+    std::scoped_lock locker(_hosts_lock);
+
+    size_t result = 0;
+    for (const auto& host : _hosts)
+    {
+        std::scoped_lock host_locker(host.second->lock);
+        result += host.second->connections.size();
+    }
+    return result;
+}
+
+size_t HTTPClientPool::requests() const
+{
+    std::scoped_lock locker(_hosts_lock);
+
+    size_t result = 0;
+    for (const auto& host : _hosts)
+    {
+        std::scoped_lock host_locker(host.second->lock);
+        result += host.second->queue.size();
+        for (const auto& connection : host.second->connections)
+            result += connection->requests.size();
+    }
+    return result;
+}
+
+std::future<HTTPResponse> HTTPClientPool::SendRequest(const std::string& address, int port, const HTTPRequest& request, const CppCommon::Timespan& timeout)
+{
+    auto pending = std::make_shared<Request>();
+    auto future = pending->promise.get_future();
+
+    // Check if the HTTP request is valid
+    if (request.empty() || request.error())
+    {
+        SetPromiseError(*pending, "Invalid HTTP request!");
+        return future;
+    }
+
+    std::string_view method = request.method();
+    pending->data = request.cache();
+    pending->deadline = (timeout > CppCommon::Timespan::zero()) ? (CppCommon::Timestamp::nano() + timeout.total()) : 0;
+    pending->head = (method == "HEAD");
+    pending->idempotent = (method == "GET") || (method == "HEAD") || (method == "PUT") || (method == "DELETE") || (method == "OPTIONS") || (method == "TRACE");
+    pending->sent = false;
+    pending->retried = false;
+
+    auto host = GetHost(address, port);
+
+    std::scoped_lock locker(host->lock);
+    host->queue.push_back(pending);
+    Dispatch(host);
+
+    return future;
+}
+
+void HTTPClientPool::Clear()
+{
+    std::unordered_map<std::string, std::shared_ptr<Host>> hosts;
+    {
+        std::scoped_lock locker(_hosts_lock);
+        hosts.swap(_hosts);
+    }
+
+    for (auto& item : hosts)
+    {
+        auto& host = item.second;
+
+        std::scoped_lock locker(host->lock);
+
+        // Fail all waiting requests
+        for (auto& request : host->queue)
+            SetPromiseError(*request, "HTTP client pool was cleared!");
+        host->queue.clear();
+        host->timer->Cancel();
+        host->deadline = 0;
+
+        // Disconnect all pooled connections
+        for (auto& connection : host->connections)
+        {
+            for (auto& request : connection->requests)
+                SetPromiseError(*request, "HTTP client pool was cleared!");
+            connection->requests.clear();
+            connection->timer->Cancel();
+            connection->reusable = false;
+            connection->DisconnectAsync();
+        }
+        host->connections.clear();
+    }
+}
+
+std::shared_ptr<HTTPClientPool::Host> HTTPClientPool::GetHost(const std::string& address, int port)
+{
+    std::string key = address + ":" + std::to_string(port);
+
+    std::scoped_lock locker(_hosts_lock);
+
+    auto it = _hosts.find(key);
+    if (it != _hosts.end())
+        return it->second;
+
+    auto host = std::make_shared<Host>();
+    host->address = address;
+    host->port = port;
+    host->endpoint = 0;
+    host->resolving = false;
+    host->timer = std::make_shared<Asio::Timer>(_service);
+    host->deadline = 0;
+
+    // Queued request timeouts are planned in the timer wheel
+    host->timer->SetupTimerWheel(true);
+
+    // Numeric host address does not require DNS resolution
+    asio::error_code ec;
+    auto ip = asio::ip::make_address(address, ec);
+    if (!ec)
+        host->endpoints.emplace_back(ip, (unsigned short)port);
+
+    _hosts.emplace(key, host);
+    return host;
+}
+
+std::shared_ptr<HTTPClientPool::Connection> HTTPClientPool::CreateConnection(const std::shared_ptr<Host>& host, const asio::ip::tcp::endpoint& endpoint)
+{
+    if (_context)
+        return std::make_shared<SSLConnection>(shared_from_this(), host, endpoint);
+    else
+        return std::make_shared<TCPConnection>(shared_from_this(), host, endpoint);
+}
+
+void HTTPClientPool::Resolve(const std::shared_ptr<Host>& host)
+{
+    if (host->resolving)
+        return;
+
+    host->resolving = true;
+
+    std::weak_ptr<HTTPClientPool> weak(shared_from_this());
+    auto async_resolve_handler = [weak, host](std::error_code ec, asio::ip::tcp::resolver::results_type results)
+    {
+        auto pool = weak.lock();
+        if (!pool)
+            return;
+
+        std::scoped_lock locker(host->lock);
+
+        host->resolving = false;
+
+        // Cache resolved endpoints
+        if (!ec)
+            for (const auto& result : results)
+                host->endpoints.push_back(result.endpoint());
+
+        if (host->endpoints.empty())
+        {
+            // Fail all waiting requests
+            for (auto& request : host->queue)
+                SetPromiseError(*request, "Failed to resolve the host: " + host->address);
+            host->queue.clear();
+            pool->Timeout(host);
+            return;
+        }
+
+        pool->Dispatch(host);
+    };
+
+    _resolver->resolver().async_resolve(host->address, std::to_string(host->port), async_resolve_handler);
+}
+
+void HTTPClientPool::Dispatch(const std::shared_ptr<Host>& host)
+{
+    uint64_t now = CppCommon::Timestamp::nano();
+
+    while (!host->queue.empty())
+    {
+        auto request = host->queue.front();
+
+        // Fail the expired request
+        if ((request->deadline > 0) && (now >= request->deadline))
+        {
+            SetPromiseError(*request, "Timeout!");
+            host->queue.pop_front();
+            continue;
+        }
+
+        // Find the least loaded connection
+        std::shared_ptr<Connection> connection;
+        for (auto& candidate : host->connections)
+            if (candidate->reusable && (candidate->requests.size() < _max_pipeline))
+                if (!connection || (candidate->requests.size() < connection->requests.size()))
+                    connection = candidate;
+
+        // Open a new connection instead of pipelining
+        if ((!connection || !connection->requests.empty()) && (host->connections.size() < _max_connections))
+        {
+            if (host->endpoints.empty())
+            {
+                Resolve(host);
+                break;
+            }
+
+            const auto& endpoint = host->endpoints[host->endpoint++ % host->endpoints.size()];
+            connection = CreateConnection(host, endpoint);
+            host->connections.push_back(connection);
+            connection->ConnectAsync();
+        }
+
+        // All connections are busy
+        if (!connection)
+            break;
+
+        host->queue.pop_front();
+        connection->requests.push_back(request);
+
+        // Send the request over the established connection
+        if (connection->connected)
+            Send(*connection, request);
+
+        // Setup the timeout for the first connection request
+        if (connection->requests.size() == 1)
+            Timeout(connection);
+    }
+
+    // Setup the timeout for queued requests
+    Timeout(host);
+}
+
+void HTTPClientPool::Send(Connection& connection, const std::shared_ptr<Request>& request)
+{
+    request->sent = true;
+    connection.SendAsync(request->data);
+}
+
+void HTTPClientPool::Timeout(const std::shared_ptr<Connection>& connection)
+{
+    if (connection->requests.empty() || (connection->requests.front()->deadline == 0))
+    {
+        connection->timer->Cancel();
+        return;
+    }
+
+    uint64_t now = CppCommon::Timestamp::nano();
+    uint64_t deadline = connection->requests.front()->deadline;
+    auto timeout = CppCommon::Timespan::nanoseconds((deadline > now) ? (deadline - now) : 0);
+
+    std::weak_ptr<HTTPClientPool> weak_pool(shared_from_this());
+    std::weak_ptr<Connection> weak_connection(connection);
+    auto timeout_handler = [weak_pool, weak_connection](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto pool = weak_pool.lock();
+        auto connection = weak_connection.lock();
+        if (pool && connection)
+            pool->onTimeout(connection);
+    };
+
+    if (connection->timer->Setup(timeout_handler, timeout))
+        connection->timer->WaitAsync();
+}
+
+void HTTPClientPool::Timeout(const std::shared_ptr<Host>& host)
+{
+    // Find the earliest queued request deadline
+    uint64_t deadline = 0;
+    for (const auto& request : host->queue)
+        if ((request->deadline > 0) && ((deadline == 0) || (request->deadline < deadline)))
+            deadline = request->deadline;
+
+    // Keep the timer planned for the same deadline
+    if (deadline == host->deadline)
+        return;
+
+    host->deadline = deadline;
+    if (deadline == 0)
+    {
+        host->timer->Cancel();
+        return;
+    }
+
+    uint64_t now = CppCommon::Timestamp::nano();
+    auto timeout = CppCommon::Timespan::nanoseconds((deadline > now) ? (deadline - now) : 0);
+
+    std::weak_ptr<HTTPClientPool> weak_pool(shared_from_this());
+    std::weak_ptr<Host> weak_host(host);
+    auto timeout_handler = [weak_pool, weak_host](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto pool = weak_pool.lock();
+        auto host = weak_host.lock();
+        if (pool && host)
+            pool->onTimeout(host);
+    };
+
+    if (host->timer->Setup(timeout_handler, timeout))
+        host->timer->WaitAsync();
+}
+
+void HTTPClientPool::onConnected(const std::shared_ptr<Connection>& connection)
+{
+    auto host = connection->host.lock();
+    if (!host)
+        return;
+
+    std::scoped_lock locker(host->lock);
+
+    connection->connected = true;
+
+    // Send all requests assigned to the connection
+    for (auto& request : connection->requests)
+        Send(*connection, request);
+
+    Dispatch(host);
+}
+
+void HTTPClientPool::onDisconnected(const std::shared_ptr<Connection>& connection)
+{
+    auto host = connection->host.lock();
+    if (!host)
+        return;
+
+    std::scoped_lock locker(host->lock);
+
+    connection->timer->Cancel();
+    connection->reusable = false;
+
+    // Remove the connection from the host
+    auto it = std::find(host->connections.begin(), host->connections.end(), connection);
+    if (it == host->connections.end())
+        return;
+    host->connections.erase(it);
+
+    // Complete the response delimited by the connection close
+    if (!connection->requests.empty() && (connection->body == std::string::npos) && !connection->chunked && !connection->response.IsPendingHeader() && !connection->response.error())
+    {
+        SetPromiseValue(*connection->requests.front(), connection->response);
+        connection->requests.pop_front();
+    }
+
+    // Connection to the host failed
+    if (!connection->connected)
+    {
+        for (auto& request : connection->requests)
+            SetPromiseError(*request, "Connection failed!");
+        connection->requests.clear();
+
+        // Resolve the host again for next connections
+        asio::error_code ec;
+        asio::ip::make_address(host->address, ec);
+        if (ec)
+            host->endpoints.clear();
+    }
+
+    // Send again requests lost by the closed keep-alive connection
+    bool partial = (connection->offset < connection->buffer.size()) || !connection->response.IsPendingHeader();
+    for (auto it = connection->requests.rbegin(); it != connection->requests.rend(); ++it)
+    {
+        auto& request = *it;
+        bool received = partial && (request == connection->requests.front());
+        if (!request->sent || ((connection->served > 0) && request->idempotent && !request->retried && !received))
+        {
+            request->retried = request->retried || request->sent;
+            request->sent = false;
+            host->queue.push_front(request);
+        }
+        else
+            SetPromiseError(*request, "Connection closed!");
+    }
+    connection->requests.clear();
+
+    Dispatch(host);
+}
+
+void HTTPClientPool::onReceived(const std::shared_ptr<Connection>& connection, const void* buffer, size_t size)
+{
+    auto host = connection->host.lock();
+    if (!host)
+        return;
+
+    std::scoped_lock locker(host->lock);
+
+    connection->buffer.append((const char*)buffer, size);
+
+    bool completed = false;
+    while (connection->offset < connection->buffer.size())
+    {
+        // Unexpected HTTP response data
+        if (connection->requests.empty())
+        {
+            connection->reusable = false;
+            connection->DisconnectAsync();
+            break;
+        }
+
+        auto& request = *connection->requests.front();
+        auto& response = connection->response;
+
+        // Receive HTTP response header
+        if (response.IsPendingHeader())
+        {
+            size_t index = connection->buffer.find("\r\n\r\n", connection->offset);
+            if (index == std::string::npos)
+                break;
+
+            size_t header = index + 4 - connection->offset;
+            if (!response.ReceiveHeader(connection->buffer.data() + connection->offset, header) || response.error())
+            {
+                SetPromiseError(request, "Invalid HTTP response!");
+                connection->requests.pop_front();
+                connection->reusable = false;
+                connection->DisconnectAsync();
+                break;
+            }
+            connection->offset += header;
+
+            // Find the response body length and the connection persistence
+            bool provided = false;
+            bool keep_alive = (response.protocol() != "HTTP/1.0");
+            for (size_t i = 0; i < response.headers(); ++i)
+            {
+                auto [name, value] = response.header(i);
+                if (CppCommon::StringUtils::CompareNoCase(name, "Content-Length"))
+                    provided = true;
+                else if (CppCommon::StringUtils::CompareNoCase(name, "Connection"))
+                    keep_alive = CppCommon::StringUtils::CompareNoCase(value, "keep-alive");
+            }
+            if (request.head || (response.status() / 100 == 1) || (response.status() == 204) || (response.status() == 304))
+                connection->body = 0;
+            else if (provided)
+                connection->body = response.body_length();
+            else
+                connection->body = std::string::npos;
+
+            // Chunked response body is delimited by the last chunk instead of the connection close
+            connection->chunked = false;
+            connection->chunk = 0;
+            if (connection->body == std::string::npos)
+            {
+                for (size_t i = 0; i < response.headers(); ++i)
+                {
+                    auto [name, value] = response.header(i);
+                    if (CppCommon::StringUtils::CompareNoCase(name, "Transfer-Encoding") && (value.find("chunked") != std::string_view::npos))
+                        connection->chunked = true;
+                }
+            }
+            if (!keep_alive || ((connection->body == std::string::npos) && !connection->chunked))
+                connection->reusable = false;
+        }
+
+        // Receive chunked HTTP response body
+        if (connection->chunked)
+        {
+            bool error = false;
+            if (!ReceiveChunkedBody(*connection, error))
+            {
+                if (error)
+                {
+                    SetPromiseError(request, "Invalid HTTP response!");
+                    connection->requests.pop_front();
+                    connection->reusable = false;
+                    connection->DisconnectAsync();
+                }
+                break;
+            }
+
+            // Complete the request with the received HTTP response
+            connection->chunked = false;
+            SetPromiseValue(request, response);
+            connection->requests.pop_front();
+            ++connection->served;
+            completed = true;
+
+            if (!connection->reusable)
+            {
+                connection->DisconnectAsync();
+                break;
+            }
+            continue;
+        }
+
+        // Receive HTTP response body
+        size_t available = connection->buffer.size() - connection->offset;
+        size_t length = (connection->body == std::string::npos) ? available : std::min(available, connection->body - response.body().size());
+        if ((connection->body != 0) && !response.ReceiveBody(connection->buffer.data() + connection->offset, length))
+        {
+            connection->offset += length;
+            break;
+        }
+        connection->offset += length;
+
+        // Complete the request with the received HTTP response
+        SetPromiseValue(request, response);
+        connection->requests.pop_front();
+        ++connection->served;
+        completed = true;
+
+        if (!connection->reusable)
+        {
+            connection->DisconnectAsync();
+            break;
+        }
+    }
+
+    // Compact the receive buffer
+    if (connection->offset >= connection->buffer.size())
+        connection->buffer.clear();
+    else
+        connection->buffer.erase(0, connection->offset);
+    connection->offset = 0;
+
+    if (completed && connection->reusable)
+    {
+        Timeout(connection);
+        Dispatch(host);
+    }
+}
+
+bool HTTPClientPool::ReceiveChunkedBody(Connection& connection, bool& error)
+{
+    auto& buffer = connection.buffer;
+    auto& response = connection.response;
+
+    while (connection.offset < buffer.size())
+    {
+        // Receive the trailer section after the last chunk
+        if (connection.chunk == std::string::npos)
+        {
+            size_t index = buffer.find("\r\n", connection.offset);
+            if (index == std::string::npos)
+                return false;
+
+            bool last = (index == connection.offset);
+            connection.offset = index + 2;
+            if (last)
+            {
+                connection.chunk = 0;
+                return true;
+            }
+            continue;
+        }
+
+        // Receive the chunk size line
+        if (connection.chunk == 0)
+        {
+            size_t index = buffer.find("\r\n", connection.offset);
+            if (index == std::string::npos)
+                return false;
+
+            size_t size = 0;
+            size_t digits = 0;
+            for (size_t i = connection.offset; (i < index) && (buffer[i] != ';') && (buffer[i] != ' '); ++i, ++digits)
+            {
+                char ch = buffer[i];
+                int digit = ((ch >= '0') && (ch <= '9')) ? (ch - '0') : ((ch >= 'a') && (ch <= 'f')) ? (ch - 'a' + 10) : ((ch >= 'A') && (ch <= 'F')) ? (ch - 'A' + 10) : -1;
+                if ((digit < 0) || (digits >= 15))
+                {
+                    error = true;
+                    return false;
+                }
+                size = (size << 4) | (size_t)digit;
+            }
+            if (digits == 0)
+            {
+                error = true;
+                return false;
+            }
+
+            connection.offset = index + 2;
+
+            // Chunk data is followed by CRLF, the last chunk is followed by the trailer section
+            connection.chunk = (size > 0) ? (size + 2) : std::string::npos;
+            continue;
+        }
+
+        // Receive the chunk data and its CRLF
+        size_t length = std::min(buffer.size() - connection.offset, connection.chunk);
+        size_t data = (connection.chunk > 2) ? std::min(length, connection.chunk - 2) : 0;
+        if (data > 0)
+            response.ReceiveBody(buffer.data() + connection.offset, data);
+        connection.offset += length;
+        connection.chunk -= length;
+    }
+
+    return false;
+}
+
+void HTTPClientPool::onTimeout(const std::shared_ptr<Host>& host)
+{
+    std::scoped_lock locker(host->lock);
+
+    // Fail all expired queued requests
+    uint64_t now = CppCommon::Timestamp::nano();
+    for (auto it = host->queue.begin(); it != host->queue.end();)
+    {
+        auto& request = *it;
+        if ((request->deadline > 0) && (now >= request->deadline))
+        {
+            SetPromiseError(*request, "Timeout!");
+            it = host->queue.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    // Plan the next queued request deadline
+    host->deadline = 0;
+    Dispatch(host);
+}
+
+void HTTPClientPool::onTimeout(const std::shared_ptr<Connection>& connection)
+{
+    auto host = connection->host.lock();
+    if (!host)
+        return;
+
+    std::scoped_lock locker(host->lock);
+
+    if (connection->requests.empty())
+        return;
+
+    // Wait for the next request deadline
+    auto request = connection->requests.front();
+    if ((request->deadline == 0) || (CppCommon::Timestamp::nano() < request->deadline))
+    {
+        Timeout(connection);
+        return;
+    }
+
+    // Pipelined responses cannot be skipped, so the connection is dropped
+    SetPromiseError(*request, "Timeout!");
+    connection->requests.pop_front();
+    connection->reusable = false;
+    if (!connection->DisconnectAsync())
+        Timeout(connection);
+}
+
+void HTTPClientPool::SetPromiseValue(Request& request, HTTPResponse& response)
+{
+    request.promise.set_value(std::move(response));
+    response.Clear();
+}
+
+void HTTPClientPool::SetPromiseError(Request& request, const std::string& error)
+{
+    request.promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -59,6 +59,14 @@ HTTPRequest& HTTPRequest::Clear()
     return *this;
 }
 
+HTTPRequest& HTTPRequest::Reserve(size_t cache_capacity, size_t headers_capacity)
+{
+    _cache.reserve(cache_capacity);
+    _headers.reserve(headers_capacity);
+    _cookies.reserve(headers_capacity);
+    return *this;
+}
+
 HTTPRequest& HTTPRequest::SetBegin(std::string_view method, std::string_view url, std::string_view protocol)
 {
     // Clear the HTTP request cache
@@ -7,18 +7,31 @@
 */
 
 #include "server/http/http_response.h"
+#include "server/http/http_response_template.h"
 
 #include "errors/exceptions.h"
 #include "string/format.h"
 #include "string/string_utils.h"
+#include "time/timestamp.h"
 #include "utility/countof.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace CppServer {
 namespace HTTP {
 
-const std::unordered_map<std::string, std::string> HTTPResponse::_mime_table =
+namespace {
+
+// MIME table entry
+struct MimeEntry
+{
+    std::string_view extension;
+    std::string_view content_type;
+};
+
+// MIME table with lower case extensions
+constexpr MimeEntry mime_entries[] =
 {
     // Base content types
     { ".html",      "text/html" },
@@ -82,13 +95,100 @@ const std::unordered_map<std::string, std::string> HTTPResponse::_mime_table =
     { ".url",       "text/uri-list" },
 
     // Video content types
-    { ".H264",      "video/H264" },
-    { ".H265",      "video/H265" },
+    { ".h264",      "video/H264" },
+    { ".h265",      "video/H265" },
     { ".mp4",       "video/mp4" },
     { ".mpeg",      "video/mpeg" },
     { ".raw",       "video/raw" }
 };
 
+// MIME perfect hash table size (power of two) and empty slot marker
+constexpr size_t mime_slots = 512;
+constexpr uint16_t mime_empty = 0xFFFF;
+
+constexpr char MimeToLower(char ch) noexcept
+{
+    return ((ch >= 'A') && (ch <= 'Z')) ? (char)(ch - 'A' + 'a') : ch;
+}
+
+// Case-insensitive seeded FNV-1a hash of the extension
+constexpr uint32_t MimeHash(std::string_view extension, uint32_t seed) noexcept
+{
+    uint32_t hash = 2166136261u ^ (seed * 16777619u);
+    for (char ch : extension)
+    {
+        hash ^= (uint8_t)MimeToLower(ch);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+constexpr bool MimeEqualNoCase(std::string_view extension, std::string_view lower) noexcept
+{
+    if (extension.size() != lower.size())
+        return false;
+    for (size_t i = 0; i < extension.size(); ++i)
+        if (MimeToLower(extension[i]) != lower[i])
+            return false;
+    return true;
+}
+
+// Check that the given seed maps all extensions into different slots
+constexpr bool MimeSeedValid(uint32_t seed) noexcept
+{
+    bool used[mime_slots] = {};
+    for (const auto& entry : mime_entries)
+    {
+        size_t slot = MimeHash(entry.extension, seed) & (mime_slots - 1);
+        if (used[slot])
+            return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+// Find the first seed that produces the perfect hash
+constexpr uint32_t MimeFindSeed() noexcept
+{
+    for (uint32_t seed = 0; seed < 1024; ++seed)
+        if (MimeSeedValid(seed))
+            return seed;
+    return 0xFFFFFFFF;
+}
+
+constexpr uint32_t mime_seed = MimeFindSeed();
+static_assert(mime_seed != 0xFFFFFFFF, "MIME table perfect hash seed was not found! Check for duplicate extensions.");
+
+// MIME perfect hash table slots
+struct MimeSlots
+{
+    uint16_t index[mime_slots];
+};
+
+constexpr MimeSlots MimeBuildSlots() noexcept
+{
+    MimeSlots slots = {};
+    for (size_t i = 0; i < mime_slots; ++i)
+        slots.index[i] = mime_empty;
+    for (size_t i = 0; i < CppCommon::countof(mime_entries); ++i)
+        slots.index[MimeHash(mime_entries[i].extension, mime_seed) & (mime_slots - 1)] = (uint16_t)i;
+    return slots;
+}
+
+constexpr MimeSlots mime_slots_table = MimeBuildSlots();
+
+} // namespace
+
+std::string_view HTTPResponse::FindContentType(std::string_view extension) noexcept
+{
+    uint16_t index = mime_slots_table.index[MimeHash(extension, mime_seed) & (mime_slots - 1)];
+    if (index == mime_empty)
+        return std::string_view();
+
+    const auto& entry = mime_entries[index];
+    return MimeEqualNoCase(extension, entry.extension) ? entry.content_type : std::string_view();
+}
+
 std::tuple<std::string_view, std::string_view> HTTPResponse::header(size_t i) const noexcept
 {
     assert((i < _headers.size()) && "Index out of bounds!");
@@ -119,9 +219,16 @@ HTTPResponse& HTTPResponse::Clear()
     return *this;
 }
 
+HTTPResponse& HTTPResponse::Reserve(size_t cache_capacity, size_t headers_capacity)
+{
+    _cache.reserve(cache_capacity);
+    _headers.reserve(headers_capacity);
+    return *this;
+}
+
 HTTPResponse& HTTPResponse::SetBegin(int status, std::string_view protocol)
 {
-    std::string status_phrase;
+    std::string_view status_phrase;
 
     switch (status)
     {
@@ -236,12 +343,34 @@ HTTPResponse& HTTPResponse::SetBegin(int status, std::string_view status_phrase,
     return *this;
 }
 
+HTTPResponse& HTTPResponse::SetBegin(const HTTPResponseTemplate& response_template)
+{
+    const HTTPResponse& prefix = response_template.response();
+
+    // Copy the pre-rendered status line and fixed headers
+    _error = false;
+    _status = prefix._status;
+    _status_phrase_index = prefix._status_phrase_index;
+    _status_phrase_size = prefix._status_phrase_size;
+    _protocol_index = prefix._protocol_index;
+    _protocol_size = prefix._protocol_size;
+    _headers.assign(prefix._headers.begin(), prefix._headers.end());
+    _body_index = 0;
+    _body_size = 0;
+    _body_length = 0;
+    _body_length_provided = false;
+
+    _cache.assign(prefix._cache);
+    _cache_size = 0;
+    return *this;
+}
+
 HTTPResponse& HTTPResponse::SetContentType(std::string_view extension)
 {
     // Try to lookup the content type in mime table
-    const auto& mime = _mime_table.find(std::string(extension));
-    if (mime != _mime_table.end())
-        return SetHeader("Content-Type", mime->second);
+    std::string_view content_type = FindContentType(extension);
+    if (!content_type.empty())
+        return SetHeader("Content-Type", content_type);
 
     return *this;
 }
@@ -319,8 +448,16 @@ HTTPResponse& HTTPResponse::SetCookie(std::string_view name, std::string_view va
     return *this;
 }
 
+HTTPResponse& HTTPResponse::SetDate()
+{
+    return SetHeader("Date", FastDate());
+}
+
 HTTPResponse& HTTPResponse::SetBody(std::string_view body)
 {
+    // Reserve the cache for the content length header and body at once
+    _cache.reserve(_cache.size() + 40 + body.size());
+
     // Append non empty content length header
     char buffer[32];
     SetHeader("Content-Length", FastConvert(body.size(), buffer, CppCommon::countof(buffer)));
@@ -356,6 +493,15 @@ HTTPResponse& HTTPResponse::SetBodyLength(size_t length)
     return *this;
 }
 
+HTTPResponse& HTTPResponse::MakeResponse(const HTTPResponseTemplate& response_template, std::string_view content)
+{
+    SetBegin(response_template);
+    if (response_template.date())
+        SetDate();
+    SetBody(content);
+    return *this;
+}
+
 HTTPResponse& HTTPResponse::MakeOKResponse(int status)
 {
     Clear();
@@ -638,6 +784,55 @@ std::string_view HTTPResponse::FastConvert(size_t value, char* buffer, size_t si
     return std::string_view(buffer + index, size - index);
 }
 
+std::string_view HTTPResponse::FastDate()
+{
+    static const char* weekdays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char* months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+    // IMF-fixdate format: "Sun, 06 Nov 1994 08:49:37 GMT"
+    thread_local char cache[29];
+    thread_local uint64_t cache_seconds = 0;
+
+    uint64_t seconds = CppCommon::UtcTimestamp().seconds();
+    if (seconds == cache_seconds)
+        return std::string_view(cache, CppCommon::countof(cache));
+
+    uint64_t days = seconds / 86400;
+    uint64_t time = seconds % 86400;
+
+    // Convert days since epoch into the civil date
+    uint64_t z = days + 719468;
+    uint64_t era = z / 146097;
+    uint64_t doe = z - era * 146097;
+    uint64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint64_t mp = (5 * doy + 2) / 153;
+    uint64_t day = doy - (153 * mp + 2) / 5 + 1;
+    uint64_t month = (mp < 10) ? (mp + 3) : (mp - 9);
+    uint64_t year = yoe + era * 400 + ((month <= 2) ? 1 : 0);
+
+    auto append2 = [](char* buffer, uint64_t value) { buffer[0] = (char)('0' + (value / 10) % 10); buffer[1] = (char)('0' + value % 10); };
+
+    std::memcpy(cache, weekdays[(days + 4) % 7], 3);
+    std::memcpy(cache + 3, ", ", 2);
+    append2(cache + 5, day);
+    cache[7] = ' ';
+    std::memcpy(cache + 8, months[month - 1], 3);
+    cache[11] = ' ';
+    append2(cache + 12, year / 100);
+    append2(cache + 14, year);
+    cache[16] = ' ';
+    append2(cache + 17, time / 3600);
+    cache[19] = ':';
+    append2(cache + 20, (time / 60) % 60);
+    cache[22] = ':';
+    append2(cache + 23, time % 60);
+    std::memcpy(cache + 25, " GMT", 4);
+
+    cache_seconds = seconds;
+    return std::string_view(cache, CppCommon::countof(cache));
+}
+
 std::ostream& operator<<(std::ostream& os, const HTTPResponse& response)
 {
     os << "Status: " << response.status() << std::endl;
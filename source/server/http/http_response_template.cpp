@@ -0,0 +1,48 @@
+/*!
+    \file http_response_template.cpp
+    \brief HTTP response template implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http_response_template.h"
+
+namespace CppServer {
+namespace HTTP {
+
+HTTPResponseTemplate::HTTPResponseTemplate(int status, std::string_view protocol)
+    : _response(std::make_shared<HTTPResponse>(status, protocol)),
+      _date(false)
+{
+}
+
+HTTPResponseTemplate::HTTPResponseTemplate(int status, std::string_view status_phrase, std::string_view protocol)
+    : _response(std::make_shared<HTTPResponse>(status, status_phrase, protocol)),
+      _date(false)
+{
+}
+
+HTTPResponseTemplate& HTTPResponseTemplate::SetContentType(std::string_view extension)
+{
+    Detach().SetContentType(extension);
+    return *this;
+}
+
+HTTPResponseTemplate& HTTPResponseTemplate::SetHeader(std::string_view key, std::string_view value)
+{
+    Detach().SetHeader(key, value);
+    return *this;
+}
+
+HTTPResponse& HTTPResponseTemplate::Detach()
+{
+    // Copy the shared pre-rendered HTTP response on write
+    if (_response.use_count() > 1)
+        _response = std::make_shared<HTTPResponse>(*_response);
+
+    return *_response;
+}
+
+} // namespace HTTP
+} // namespace CppServer
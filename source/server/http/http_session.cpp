@@ -9,22 +9,170 @@
 #include "server/http/http_session.h"
 #include "server/http/http_server.h"
 
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <cstring>
+
 namespace CppServer {
 namespace HTTP {
 
+namespace {
+
+// HTTP/2 stream dispatched to request handlers by the current thread
+thread_local const HTTPSession* http2_dispatch_session = nullptr;
+thread_local uint32_t http2_dispatch_stream = 0;
+thread_local HTTPRequest* http2_dispatch_request = nullptr;
+
+// Bind the HTTP/2 stream to request handlers called in the scope
+class HTTP2DispatchScope
+{
+public:
+    HTTP2DispatchScope(const HTTPSession* session, uint32_t stream, HTTPRequest* request = nullptr) noexcept
+        : _session(http2_dispatch_session), _stream(http2_dispatch_stream), _request(http2_dispatch_request)
+    {
+        http2_dispatch_session = session;
+        http2_dispatch_stream = stream;
+        http2_dispatch_request = request;
+    }
+    ~HTTP2DispatchScope()
+    {
+        http2_dispatch_session = _session;
+        http2_dispatch_stream = _stream;
+        http2_dispatch_request = _request;
+    }
+
+private:
+    const HTTPSession* _session;
+    uint32_t _stream;
+    HTTPRequest* _request;
+};
+
+} // namespace
+
 HTTPSession::HTTPSession(const std::shared_ptr<HTTPServer>& server)
     : Asio::TCPSession(server),
-      _cache(server->cache())
+      _cache(server->cache()),
+      _http2_option(server->option_http2()),
+      _watchdog_handshake_timeout(server->option_handshake_timeout()),
+      _watchdog_idle_timeout(server->option_idle_timeout()),
+      _watchdog_connected(0),
+      _watchdog_activity(0),
+      _watchdog_received(0),
+      _watchdog_handshaked(false)
 {
 }
 
+HTTPRequestPool::Pointer HTTPSession::DetachRequest()
+{
+    // HTTP/2 stream request is dispatched from the stream storage
+    HTTPRequest& current = ((http2_dispatch_session == this) && (http2_dispatch_request != nullptr)) ? *http2_dispatch_request : _request;
+
+    auto request = HTTPRequestPool::GetThreadPool().Acquire();
+    request->swap(current);
+    return request;
+}
+
+uint32_t HTTPSession::http2_stream() const noexcept
+{
+    return (http2_dispatch_session == this) ? http2_dispatch_stream : 0;
+}
+
+size_t HTTPSession::SendResponse(const HTTPResponse& response)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2Response(stream, response)) ? response.cache().size() : 0;
+    }
+
+    return Send(response.cache());
+}
+
+size_t HTTPSession::SendResponseBody(const void* buffer, size_t size)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2ResponseBody(stream, buffer, size)) ? size : 0;
+    }
+
+    return Send(buffer, size);
+}
+
+size_t HTTPSession::SendResponse(const HTTPResponse& response, const CppCommon::Timespan& timeout)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2Response(stream, response)) ? response.cache().size() : 0;
+    }
+
+    return Send(response.cache(), timeout);
+}
+
+size_t HTTPSession::SendResponseBody(const void* buffer, size_t size, const CppCommon::Timespan& timeout)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2ResponseBody(stream, buffer, size)) ? size : 0;
+    }
+
+    return Send(buffer, size, timeout);
+}
+
+bool HTTPSession::SendResponseAsync(const HTTPResponse& response)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return (stream != 0) && SendHTTP2Response(stream, response);
+    }
+
+    return SendAsync(response.cache());
+}
+
+bool HTTPSession::SendResponseBodyAsync(const void* buffer, size_t size)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return (stream != 0) && SendHTTP2ResponseBody(stream, buffer, size);
+    }
+
+    return SendAsync(buffer, size);
+}
+
 void HTTPSession::onReceived(const void* buffer, size_t size)
 {
+    // Receive HTTP/2 frames
+    if (IsHTTP2())
+    {
+        PrepareReceiveHTTP2(buffer, size);
+        return;
+    }
+
+    // Check for HTTP/2 prior knowledge connection preface
+    if (_http2_option && _request.cache().empty())
+    {
+        size_t length = std::min(size, HTTP2_PREFACE.size());
+        if ((length >= 4) && (std::memcmp(buffer, HTTP2_PREFACE.data(), length) == 0))
+        {
+            _watchdog_handshaked = true;
+            StartHTTP2Server();
+            PrepareReceiveHTTP2(buffer, size);
+            return;
+        }
+    }
     // Receive HTTP request header
     if (_request.IsPendingHeader())
     {
         if (_request.ReceiveHeader(buffer, size))
+        {
+            _watchdog_handshaked = true;
             onReceivedRequestHeader(_request);
+        }
 
         size = 0;
     }
@@ -56,8 +204,45 @@ void HTTPSession::onReceived(const void* buffer, size_t size)
     }
 }
 
+void HTTPSession::onConnected()
+{
+    // Start the session watchdog in the timer wheel of the session Asio IO service
+    _watchdog_wheel = server()->service()->GetTimerWheel(io_service());
+    _watchdog_connected = CppCommon::Timestamp::nano();
+    _watchdog_activity = _watchdog_connected;
+    _watchdog_received = bytes_received();
+    _watchdog_handshaked = false;
+
+    std::weak_ptr<HTTPSession> weak(std::static_pointer_cast<HTTPSession>(shared_from_this()));
+    bool strand_required = server()->service()->IsStrandRequired();
+    _watchdog.Setup([weak, strand_required]()
+    {
+        auto self = weak.lock();
+        if (!self)
+            return;
+
+        // Serialize the watchdog check with other session handlers
+        if (strand_required)
+            asio::post(self->strand(), [self]() { self->UpdateWatchdog(); });
+        else
+            self->UpdateWatchdog();
+    });
+
+    UpdateWatchdog();
+}
+
 void HTTPSession::onDisconnected()
 {
+    // Stop the session watchdog
+    StopWatchdog();
+
+    // Clear HTTP/2 streams
+    if (IsHTTP2())
+    {
+        ClearHTTP2();
+        return;
+    }
+
     // Receive HTTP request body
     if (_request.IsPendingBody())
     {
@@ -67,14 +252,111 @@ void HTTPSession::onDisconnected()
     }
 }
 
+void HTTPSession::onReceivedCachedRequest(const HTTPRequest& request, std::string_view content)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        if (stream != 0)
+            SendHTTP2Response(stream, content);
+    }
+    else
+        SendAsync(content);
+}
+
+void HTTPSession::onHTTP2Request(uint32_t stream, HTTPRequest& request)
+{
+    // Dispatch the request kept in the stream storage
+    HTTP2DispatchScope scope(this, stream, &request);
+    onReceivedRequestHeader(request);
+    onReceivedRequestInternal(request);
+}
+
+void HTTPSession::onHTTP2Error(const std::string& message)
+{
+    onReceivedRequestError(_request, message);
+    Disconnect();
+}
+
+void HTTPSession::StopWatchdog()
+{
+    if (_watchdog_wheel)
+        _watchdog_wheel->Cancel(_watchdog);
+}
+
+void HTTPSession::UpdateWatchdog()
+{
+    if (!IsConnected() || !_watchdog_wheel)
+        return;
+
+    uint64_t now = CppCommon::Timestamp::nano();
+
+    // Any received data is the session activity
+    if (bytes_received() != _watchdog_received)
+    {
+        _watchdog_received = bytes_received();
+        _watchdog_activity = now;
+    }
+
+    int64_t next = 0;
+    auto plan = [&next](int64_t timeout) { if ((timeout > 0) && ((next == 0) || (timeout < next))) next = timeout; };
+
+    // Check the handshake timeout
+    int64_t handshake = _watchdog_handshake_timeout.total();
+    if (!_watchdog_handshaked && (handshake > 0))
+    {
+        int64_t elapsed = (int64_t)(now - _watchdog_connected);
+        if (elapsed >= handshake)
+        {
+            Disconnect();
+            return;
+        }
+        plan(handshake - elapsed);
+    }
+
+    // Check the idle timeout
+    int64_t idle = (int64_t)(now - _watchdog_activity);
+    int64_t timeout = _watchdog_idle_timeout.total();
+    if (timeout > 0)
+    {
+        if (idle >= timeout)
+        {
+            Disconnect();
+            return;
+        }
+        plan(timeout - idle);
+    }
+
+    // Call the session watchdog handler
+    plan(onWatchdog(CppCommon::Timespan(idle)).total());
+
+    // Reschedule the session watchdog
+    if (next > 0)
+        _watchdog_wheel->Schedule(_watchdog, CppCommon::Timespan(next));
+    else
+        _watchdog_wheel->Cancel(_watchdog);
+}
+
 void HTTPSession::onReceivedRequestInternal(const HTTPRequest& request)
 {
+    // Upgrade the connection to HTTP/2 (h2c), the upgrade request becomes the stream 1
+    if (_http2_option && !IsHTTP2() && PerformHTTP2Upgrade(request, _response))
+    {
+        SendAsync(_response.cache());
+        StartHTTP2Server();
+
+        HTTP2DispatchScope scope(this, 1);
+        onReceivedRequestInternal(request);
+        return;
+    }
+
     // Try to get the cached response
     if (request.method() == "GET")
     {
         std::string_view url = request.url();
         size_t index = url.find('?');
-        auto response = cache().find(std::string((index == std::string_view::npos) ? url : url.substr(0, index)));
+        _cache_key.assign((index == std::string_view::npos) ? url : url.substr(0, index));
+        auto response = cache().find(_cache_key);
         if (response.first)
         {
             // Process the request with the cached response
@@ -11,6 +11,13 @@
 namespace CppServer {
 namespace HTTP {
 
+HTTPResponsePool::Pointer HTTPSClient::DetachResponse()
+{
+    auto response = HTTPResponsePool::GetThreadPool().Acquire();
+    response->swap(_response);
+    return response;
+}
+
 void HTTPSClient::onReceived(const void* buffer, size_t size)
 {
     // Receive HTTP response header
@@ -67,10 +74,16 @@ std::future<HTTPResponse> HTTPSClientEx::SendRequest(const HTTPRequest& request,
         _resolver = std::make_shared<Asio::TCPResolver>(service());
     // Create timeout check timer if the current one is empty
     if (!_timeout)
+    {
         _timeout = std::make_shared<Asio::Timer>(service());
+        _timeout->SetupTimerWheel(true);
+    }
 
     _promise = std::promise<HTTPResponse>();
-    _request = request;
+
+    // Copy the HTTP request into the retained client request storage
+    if (&request != &_request)
+        _request = request;
 
     // Check if the HTTP request is valid
     if (_request.empty() || _request.error())
@@ -158,6 +171,7 @@ void HTTPSClientEx::onReceivedResponseError(const HTTPResponse& response, const
 
 void HTTPSClientEx::SetPromiseValue(const HTTPResponse& response)
 {
+    // Copy the received response into the promise, so the client response keeps its capacity for the next request
     _promise.set_value(response);
     _request.Clear();
 }
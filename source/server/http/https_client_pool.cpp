@@ -0,0 +1,23 @@
+/*!
+    \file https_client_pool.cpp
+    \brief HTTPS client connection pool implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/https_client_pool.h"
+
+namespace CppServer {
+namespace HTTP {
+
+HTTPSClientPool::HTTPSClientPool(const std::shared_ptr<Asio::Service>& service, const std::shared_ptr<Asio::SSLContext>& context, size_t max_connections, size_t max_pipeline)
+    : HTTPClientPool(service, context, max_connections, max_pipeline)
+{
+    assert((context != nullptr) && "SSL context is invalid!");
+    if (context == nullptr)
+        throw CppCommon::ArgumentException("SSL context is invalid!");
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -28,5 +28,16 @@ void HTTPSServer::AddStaticContent(const CppCommon::Path& path, const std::strin
     cache().insert_path(path, prefix, timeout, hanlder);
 }
 
+void HTTPSServer::SetupHTTP2(bool enable)
+{
+    _option_http2 = enable;
+
+    // Advertise HTTP/2 protocol with ALPN
+    if (enable)
+        context()->set_alpn_protocols({ "h2", "http/1.1" });
+    else
+        context()->set_alpn_protocols({ "http/1.1" });
+}
+
 } // namespace HTTP
 } // namespace CppServer
@@ -9,22 +9,234 @@
 #include "server/http/https_session.h"
 #include "server/http/https_server.h"
 
+#include "time/timestamp.h"
+
+#include <fstream>
+
 namespace CppServer {
 namespace HTTP {
 
+namespace {
+
+// HTTP/2 stream dispatched to request handlers by the current thread
+thread_local const HTTPSSession* http2_dispatch_session = nullptr;
+thread_local uint32_t http2_dispatch_stream = 0;
+thread_local HTTPRequest* http2_dispatch_request = nullptr;
+
+// Bind the HTTP/2 stream to request handlers called in the scope
+class HTTP2DispatchScope
+{
+public:
+    HTTP2DispatchScope(const HTTPSSession* session, uint32_t stream, HTTPRequest* request = nullptr) noexcept
+        : _session(http2_dispatch_session), _stream(http2_dispatch_stream), _request(http2_dispatch_request)
+    {
+        http2_dispatch_session = session;
+        http2_dispatch_stream = stream;
+        http2_dispatch_request = request;
+    }
+    ~HTTP2DispatchScope()
+    {
+        http2_dispatch_session = _session;
+        http2_dispatch_stream = _stream;
+        http2_dispatch_request = _request;
+    }
+
+private:
+    const HTTPSSession* _session;
+    uint32_t _stream;
+    HTTPRequest* _request;
+};
+
+} // namespace
+
 HTTPSSession::HTTPSSession(const std::shared_ptr<HTTPSServer>& server)
     : Asio::SSLSession(server),
-      _cache(server->cache())
+      _cache(server->cache()),
+      _http2_option(server->option_http2()),
+      _watchdog_handshake_timeout(server->option_handshake_timeout()),
+      _watchdog_idle_timeout(server->option_idle_timeout()),
+      _watchdog_connected(0),
+      _watchdog_activity(0),
+      _watchdog_received(0),
+      _watchdog_handshaked(false)
+{
+}
+
+HTTPRequestPool::Pointer HTTPSSession::DetachRequest()
+{
+    // HTTP/2 stream request is dispatched from the stream storage
+    HTTPRequest& current = ((http2_dispatch_session == this) && (http2_dispatch_request != nullptr)) ? *http2_dispatch_request : _request;
+
+    auto request = HTTPRequestPool::GetThreadPool().Acquire();
+    request->swap(current);
+    return request;
+}
+
+void HTTPSSession::onConnected()
+{
+    // Start the session watchdog in the timer wheel of the session Asio IO service
+    _watchdog_wheel = server()->service()->GetTimerWheel(io_service());
+    _watchdog_connected = CppCommon::Timestamp::nano();
+    _watchdog_activity = _watchdog_connected;
+    _watchdog_received = bytes_received();
+    _watchdog_handshaked = false;
+
+    std::weak_ptr<HTTPSSession> weak(std::static_pointer_cast<HTTPSSession>(shared_from_this()));
+    bool strand_required = server()->service()->IsStrandRequired();
+    _watchdog.Setup([weak, strand_required]()
+    {
+        auto self = weak.lock();
+        if (!self)
+            return;
+
+        // Serialize the watchdog check with other session handlers
+        if (strand_required)
+            asio::post(self->strand(), [self]() { self->UpdateWatchdog(); });
+        else
+            self->UpdateWatchdog();
+    });
+
+    UpdateWatchdog();
+}
+
+void HTTPSSession::onHandshaked()
+{
+    // Switch to HTTP/2 protocol if it was negotiated with ALPN
+    if (_http2_option)
+    {
+        const unsigned char* protocol = nullptr;
+        unsigned int length = 0;
+        SSL_get0_alpn_selected(stream().native_handle(), &protocol, &length);
+        if ((protocol != nullptr) && (std::string_view((const char*)protocol, length) == "h2"))
+        {
+            _watchdog_handshaked = true;
+            StartHTTP2Server();
+        }
+    }
+}
+
+uint32_t HTTPSSession::http2_stream() const noexcept
+{
+    return (http2_dispatch_session == this) ? http2_dispatch_stream : 0;
+}
+
+size_t HTTPSSession::SendResponse(const HTTPResponse& response)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2Response(stream, response)) ? response.cache().size() : 0;
+    }
+
+    return Send(response.cache());
+}
+
+size_t HTTPSSession::SendResponseBody(const void* buffer, size_t size)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2ResponseBody(stream, buffer, size)) ? size : 0;
+    }
+
+    return Send(buffer, size);
+}
+
+size_t HTTPSSession::SendResponseFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return 0;
+
+    size_t size = (size_t)file.tellg();
+
+    // Find the content type by the file extension
+    size_t index = path.find_last_of("./\\");
+    std::string_view extension = ((index != std::string::npos) && (path[index] == '.')) ? std::string_view(path).substr(index) : std::string_view();
+
+    _response.Clear();
+    _response.SetBegin(200);
+    _response.SetContentType(extension);
+
+    // HTTP/2 response body is sent in HTTP/2 frames
+    if (IsHTTP2())
+    {
+        std::string content(size, 0);
+        file.seekg(0);
+        file.read(content.data(), (std::streamsize)size);
+        _response.SetBody(content);
+        return SendResponse(_response);
+    }
+
+    // Send the HTTP response header followed by the file content
+    _response.SetBodyLength(size);
+    size_t sent = SendResponse(_response);
+    if (sent < _response.cache().size())
+        return sent;
+
+    return sent + SendFile(path, 0, size);
+}
+
+size_t HTTPSSession::SendResponse(const HTTPResponse& response, const CppCommon::Timespan& timeout)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2Response(stream, response)) ? response.cache().size() : 0;
+    }
+
+    return Send(response.cache(), timeout);
+}
+
+size_t HTTPSSession::SendResponseBody(const void* buffer, size_t size, const CppCommon::Timespan& timeout)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return ((stream != 0) && SendHTTP2ResponseBody(stream, buffer, size)) ? size : 0;
+    }
+
+    return Send(buffer, size, timeout);
+}
+
+bool HTTPSSession::SendResponseAsync(const HTTPResponse& response)
 {
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return (stream != 0) && SendHTTP2Response(stream, response);
+    }
+
+    return SendAsync(response.cache());
+}
+
+bool HTTPSSession::SendResponseBodyAsync(const void* buffer, size_t size)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        return (stream != 0) && SendHTTP2ResponseBody(stream, buffer, size);
+    }
+
+    return SendAsync(buffer, size);
 }
 
 void HTTPSSession::onReceived(const void* buffer, size_t size)
 {
+    // Receive HTTP/2 frames
+    if (IsHTTP2())
+    {
+        PrepareReceiveHTTP2(buffer, size);
+        return;
+    }
     // Receive HTTP request header
     if (_request.IsPendingHeader())
     {
         if (_request.ReceiveHeader(buffer, size))
+        {
+            _watchdog_handshaked = true;
             onReceivedRequestHeader(_request);
+        }
 
         size = 0;
     }
@@ -58,6 +270,16 @@ void HTTPSSession::onReceived(const void* buffer, size_t size)
 
 void HTTPSSession::onDisconnected()
 {
+    // Stop the session watchdog
+    StopWatchdog();
+
+    // Clear HTTP/2 streams
+    if (IsHTTP2())
+    {
+        ClearHTTP2();
+        return;
+    }
+
     // Receive HTTP request body
     if (_request.IsPendingBody())
     {
@@ -67,6 +289,91 @@ void HTTPSSession::onDisconnected()
     }
 }
 
+void HTTPSSession::onReceivedCachedRequest(const HTTPRequest& request, std::string_view content)
+{
+    if (IsHTTP2())
+    {
+        uint32_t stream = http2_stream();
+        if (stream != 0)
+            SendHTTP2Response(stream, content);
+    }
+    else
+        SendAsync(content);
+}
+
+void HTTPSSession::onHTTP2Request(uint32_t stream, HTTPRequest& request)
+{
+    // Dispatch the request kept in the stream storage
+    HTTP2DispatchScope scope(this, stream, &request);
+    onReceivedRequestHeader(request);
+    onReceivedRequestInternal(request);
+}
+
+void HTTPSSession::onHTTP2Error(const std::string& message)
+{
+    onReceivedRequestError(_request, message);
+    Disconnect();
+}
+
+void HTTPSSession::StopWatchdog()
+{
+    if (_watchdog_wheel)
+        _watchdog_wheel->Cancel(_watchdog);
+}
+
+void HTTPSSession::UpdateWatchdog()
+{
+    if (!IsConnected() || !_watchdog_wheel)
+        return;
+
+    uint64_t now = CppCommon::Timestamp::nano();
+
+    // Any received data is the session activity
+    if (bytes_received() != _watchdog_received)
+    {
+        _watchdog_received = bytes_received();
+        _watchdog_activity = now;
+    }
+
+    int64_t next = 0;
+    auto plan = [&next](int64_t timeout) { if ((timeout > 0) && ((next == 0) || (timeout < next))) next = timeout; };
+
+    // Check the handshake timeout
+    int64_t handshake = _watchdog_handshake_timeout.total();
+    if (!_watchdog_handshaked && (handshake > 0))
+    {
+        int64_t elapsed = (int64_t)(now - _watchdog_connected);
+        if (elapsed >= handshake)
+        {
+            Disconnect();
+            return;
+        }
+        plan(handshake - elapsed);
+    }
+
+    // Check the idle timeout
+    int64_t idle = (int64_t)(now - _watchdog_activity);
+    int64_t timeout = _watchdog_idle_timeout.total();
+    if (timeout > 0)
+    {
+        if (idle >= timeout)
+        {
+            Disconnect();
+            return;
+        }
+        plan(timeout - idle);
+    }
+
+    // Call the session watchdog handler
+    plan(onWatchdog(CppCommon::Timespan(idle)).total());
+
+    // Reschedule the session watchdog
+    if (next > 0)
+        _watchdog_wheel->Schedule(_watchdog, CppCommon::Timespan(next));
+    else
+        _watchdog_wheel->Cancel(_watchdog);
+}
+
 void HTTPSSession::onReceivedRequestInternal(const HTTPRequest& request)
 {
     // Try to get the cached response
@@ -74,7 +381,8 @@ void HTTPSSession::onReceivedRequestInternal(const HTTPRequest& request)
     {
         std::string_view url = request.url();
         size_t index = url.find('?');
-        auto response = cache().find(std::string((index == std::string_view::npos) ? url : url.substr(0, index)));
+        _cache_key.assign((index == std::string_view::npos) ? url : url.substr(0, index));
+        auto response = cache().find(_cache_key);
         if (response.first)
         {
             // Process the request with the cached response
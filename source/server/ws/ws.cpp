@@ -13,8 +13,20 @@
 #include "string/string_utils.h"
 
 #include <algorithm>
+#include <cstring>
 #include <openssl/sha.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CPPSERVER_WS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CPPSERVER_WS_NEON
+#endif
+
 namespace CppServer {
 namespace WS {
 
@@ -32,6 +44,9 @@ bool WebSocket::PerformClientUpgrade(const HTTP::HTTPResponse& response, const C
     bool accept = false;
     bool connection = false;
     bool upgrade = false;
+    bool deflate = false;
+
+    WSDeflateOptions deflate_agreed;
 
     // Validate WebSocket handshake headers
     for (size_t i = 0; i < response.headers(); ++i)
@@ -82,6 +97,17 @@ bool WebSocket::PerformClientUpgrade(const HTTP::HTTPResponse& response, const C
 
             accept = true;
         }
+        else if (CppCommon::StringUtils::CompareNoCase(key, "Sec-WebSocket-Extensions"))
+        {
+            if (!_ws_deflate_enabled || deflate || !_ws_deflate_options.NegotiateResponse(value, deflate_agreed))
+            {
+                error = true;
+                onWSError("Invalid WebSocket handshaked response: 'Sec-WebSocket-Extensions' header value must be the accepted 'permessage-deflate' offer");
+                break;
+            }
+
+            deflate = true;
+        }
     }
 
     // Failed to perform WebSocket handshake
@@ -92,6 +118,13 @@ bool WebSocket::PerformClientUpgrade(const HTTP::HTTPResponse& response, const C
         return false;
     }
 
+    // Initialize permessage-deflate extension
+    if (deflate && !_ws_deflate.Initialize(deflate_agreed, false))
+    {
+        onWSError("Failed to initialize WebSocket permessage-deflate extension");
+        return false;
+    }
+
     // WebSocket successfully handshaked!
     _ws_handshaked = true;
     *((uint32_t*)_ws_send_mask) = rand();
@@ -110,8 +143,11 @@ bool WebSocket::PerformServerUpgrade(const HTTP::HTTPRequest& request, HTTP::HTT
     bool upgrade = false;
     bool ws_key = false;
     bool ws_version = false;
+    bool deflate = false;
 
     std::string accept;
+    std::string deflate_response;
+    WSDeflateOptions deflate_agreed;
 
     // Validate WebSocket handshake headers
     for (size_t i = 0; i < request.headers(); ++i)
@@ -171,6 +207,12 @@ bool WebSocket::PerformServerUpgrade(const HTTP::HTTPRequest& request, HTTP::HTT
 
             ws_version = true;
         }
+        else if (CppCommon::StringUtils::CompareNoCase(key, "Sec-WebSocket-Extensions"))
+        {
+            // Negotiate permessage-deflate extension offers
+            if (_ws_deflate_enabled && !deflate)
+                deflate = _ws_deflate_options.NegotiateOffer(value, deflate_agreed, deflate_response);
+        }
     }
 
     // Filter out non WebSocket handshake requests
@@ -192,11 +234,16 @@ bool WebSocket::PerformServerUpgrade(const HTTP::HTTPRequest& request, HTTP::HTT
     response.SetHeader("Connection", "Upgrade");
     response.SetHeader("Upgrade", "websocket");
     response.SetHeader("Sec-WebSocket-Accept", accept);
+    if (deflate && _ws_deflate.Initialize(deflate_agreed, true))
+        response.SetHeader("Sec-WebSocket-Extensions", deflate_response);
     response.SetBody();
 
     // Validate WebSocket upgrade request and response
     if (!onWSConnecting(request, response))
+    {
+        _ws_deflate.Clear();
         return false;
+    }
 
     // Send WebSocket upgrade response
     SendResponse(response);
@@ -204,82 +251,136 @@ bool WebSocket::PerformServerUpgrade(const HTTP::HTTPRequest& request, HTTP::HTT
     // WebSocket successfully handshaked!
     _ws_handshaked = true;
     *((uint32_t*)_ws_send_mask) = 0;
+    onWSHandshaked();
     onWSConnected(request);
 
     return true;
 }
 
-void WebSocket::PrepareSendFrame(uint8_t opcode, bool mask, const void* buffer, size_t size, int status)
+size_t WebSocket::PrepareFrameHeader(uint8_t* header, uint8_t opcode, const uint8_t* mask, size_t size, int status) noexcept
 {
     // Check if we need to store additional 2 bytes of close status frame
-    bool store_status = ((opcode & WS_CLOSE) == WS_CLOSE) && ((size > 0) || (status != 0));
+    bool store_status = ((opcode & 0x0F) == WS_CLOSE) && ((size > 0) || (status != 0));
     if (store_status)
         size += 2;
 
-    // Clear the previous WebSocket send buffer
-    _ws_send_buffer.clear();
+    size_t index = 0;
 
     // Append WebSocket frame opcode
-    _ws_send_buffer.push_back(opcode);
+    header[index++] = opcode;
 
     // Append WebSocket frame size
     if (size <= 125)
-        _ws_send_buffer.push_back((size & 0xFF) | (mask ? 0x80 : 0));
+        header[index++] = (size & 0xFF) | (mask ? 0x80 : 0);
     else if (size <= 65535)
     {
-        _ws_send_buffer.push_back(126 | (mask ? 0x80 : 0));
-        _ws_send_buffer.push_back((size >> 8) & 0xFF);
-        _ws_send_buffer.push_back(size & 0xFF);
+        header[index++] = 126 | (mask ? 0x80 : 0);
+        header[index++] = (size >> 8) & 0xFF;
+        header[index++] = size & 0xFF;
     }
     else
     {
-        _ws_send_buffer.push_back(127 | (mask ? 0x80 : 0));
+        header[index++] = 127 | (mask ? 0x80 : 0);
         for (int i = 7; i >= 0; --i)
-            _ws_send_buffer.push_back((size >> (8 * i)) & 0xFF);
+            header[index++] = (size >> (8 * i)) & 0xFF;
     }
 
     if (mask)
     {
         // Append WebSocket frame mask
-        _ws_send_buffer.push_back(_ws_send_mask[0]);
-        _ws_send_buffer.push_back(_ws_send_mask[1]);
-        _ws_send_buffer.push_back(_ws_send_mask[2]);
-        _ws_send_buffer.push_back(_ws_send_mask[3]);
+        header[index++] = mask[0];
+        header[index++] = mask[1];
+        header[index++] = mask[2];
+        header[index++] = mask[3];
     }
 
-    // Resize WebSocket frame buffer
-    size_t offset = _ws_send_buffer.size();
-    _ws_send_buffer.resize(offset + size);
-
-    size_t index = 0;
-    const uint8_t* data = (const uint8_t*)buffer;
-
     // Append WebSocket close status
     // RFC 6455: If there is a body, the first two bytes of the body MUST
     // be a 2-byte unsigned integer (in network byte order) representing
     // a status code with value code.
     if (store_status)
     {
-        index += 2;
-        _ws_send_buffer[offset + 0] = ((status >> 8) & 0xFF) ^ _ws_send_mask[0];
-        _ws_send_buffer[offset + 1] = (status & 0xFF) ^ _ws_send_mask[1];
+        header[index++] = ((status >> 8) & 0xFF) ^ (mask ? mask[0] : 0);
+        header[index++] = (status & 0xFF) ^ (mask ? mask[1] : 0);
     }
 
-    // Mask WebSocket frame content
-    for (size_t i = index; i < size; ++i)
-        _ws_send_buffer[offset + i] = data[i - index] ^ _ws_send_mask[i % 4];
+    return index;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> WebSocket::PrepareSharedFrame(uint8_t opcode, const void* buffer, size_t size, int status)
+{
+    uint8_t header[WS_MAX_HEADER_SIZE];
+    size_t header_size = PrepareFrameHeader(header, opcode, nullptr, size, status);
+
+    auto frame = std::make_shared<std::vector<uint8_t>>();
+    frame->reserve(header_size + size);
+    frame->insert(frame->end(), header, header + header_size);
+    if (size > 0)
+        frame->insert(frame->end(), (const uint8_t*)buffer, (const uint8_t*)buffer + size);
+    return frame;
+}
+
+bool WebSocket::PrepareSendDeflate(uint8_t& opcode, const void*& buffer, size_t& size)
+{
+    if (!_ws_deflate.IsInitialized())
+        return false;
+
+    // Compress only text and binary messages above the threshold
+    uint8_t code = opcode & 0x0F;
+    if (((code != WS_TEXT) && (code != WS_BINARY)) || (size < _ws_deflate.options().threshold))
+        return false;
+
+    // Send the original message if the compression failed
+    if (!_ws_deflate.Compress(buffer, size, _ws_send_deflate_buffer))
+        return false;
+
+    opcode |= WS_RSV1;
+    buffer = _ws_send_deflate_buffer.data();
+    size = _ws_send_deflate_buffer.size();
+    return true;
+}
+
+void WebSocket::PrepareSendFrame(uint8_t opcode, bool mask, const void* buffer, size_t size, int status)
+{
+    const uint8_t* send_mask = mask ? _ws_send_mask : nullptr;
+
+    // Compress WebSocket message if required
+    PrepareSendDeflate(opcode, buffer, size);
+
+    // Prepare WebSocket frame header
+    uint8_t header[WS_MAX_HEADER_SIZE];
+    size_t header_size = PrepareFrameHeader(header, opcode, send_mask, size, status);
+
+    // Prepare WebSocket frame buffer
+    _ws_send_buffer.resize(header_size + size);
+    std::memcpy(_ws_send_buffer.data(), header, header_size);
+
+    // Mask WebSocket frame content (close status takes the first two mask bytes)
+    if (size > 0)
+    {
+        size_t offset = (((opcode & 0x0F) == WS_CLOSE) ? 2 : 0);
+        if (send_mask)
+            MaskPayload(_ws_send_buffer.data() + header_size, (const uint8_t*)buffer, size, send_mask, offset);
+        else
+            std::memcpy(_ws_send_buffer.data() + header_size, buffer, size);
+    }
 }
 
 void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
 {
     const uint8_t* data = (const uint8_t*)buffer;
 
+    // Skip received data after WebSocket message was rejected
+    if (_ws_receive_rejected)
+        return;
+
     // Clear received data after WebSocket frame was processed
     if (_ws_frame_received)
     {
         _ws_frame_received = false;
         _ws_header_size = 0;
         _ws_payload_size = 0;
+        _ws_receive_streamed = 0;
         _ws_receive_frame_buffer.clear();
         *((uint32_t*)_ws_receive_mask) = 0;
     }
@@ -297,6 +398,7 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
             _ws_frame_received = false;
             _ws_header_size = 0;
             _ws_payload_size = 0;
+            _ws_receive_streamed = 0;
             _ws_receive_frame_buffer.clear();
             *((uint32_t*)_ws_receive_mask) = 0;
         }
@@ -309,7 +411,7 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
         // Prepare WebSocket frame opcode and mask flag
         if (_ws_receive_frame_buffer.size() < 2)
         {
-            for (size_t i = 0; i < 2; ++i, ++data, --size)
+            for (size_t i = _ws_receive_frame_buffer.size(); i < 2; ++i, ++data, --size)
             {
                 if (size == 0)
                     return;
@@ -319,25 +421,42 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
 
         uint8_t opcode = _ws_receive_frame_buffer[0] & 0x0F;
         bool fin = ((_ws_receive_frame_buffer[0] >> 7) & 0x01) != 0;
+        bool compressed = (_ws_receive_frame_buffer[0] & WS_RSV1) != 0;
         bool mask = ((_ws_receive_frame_buffer[1] >> 7) & 0x01) != 0;
         size_t payload = _ws_receive_frame_buffer[1] & (~0x80);
 
+        // Fail the connection on reserved bits not negotiated by any extension (RFC 6455 5.2)
+        bool reserved = (_ws_receive_frame_buffer[0] & 0x30) != 0;
+        if (reserved || (compressed && (!ws_deflate() || (opcode == 0) || ((opcode & 0x08) != 0))))
+        {
+            _ws_receive_rejected = true;
+            onWSError("Invalid WebSocket frame reserved bits");
+            CloseConnection(1002, "Protocol error");
+            return;
+        }
+
         // Prepare WebSocket opcode
         _ws_opcode = (opcode != 0) ? opcode : _ws_opcode;
 
+        // Compressed flag is set in the first frame of the data message
+        if ((opcode == WS_TEXT) || (opcode == WS_BINARY))
+            _ws_receive_compressed = compressed;
+
+        // Control frames are always collected, data frames of not compressed messages are streamed
+        bool control = (opcode & 0x08) != 0;
+        bool streaming = _ws_streaming && !control && !_ws_receive_compressed;
+
         // Prepare WebSocket frame size
         if (payload <= 125)
         {
             _ws_header_size = 2 + (mask ? 4 : 0);
             _ws_payload_size = payload;
-            _ws_receive_frame_buffer.reserve(_ws_header_size + _ws_payload_size);
-            _ws_receive_final_buffer.reserve(_ws_header_size + _ws_payload_size);
         }
         else if (payload == 126)
         {
             if (_ws_receive_frame_buffer.size() < 4)
             {
-                for (size_t i = 0; i < 2; ++i, ++data, --size)
+                for (size_t i = _ws_receive_frame_buffer.size(); i < 4; ++i, ++data, --size)
                 {
                     if (size == 0)
                         return;
@@ -348,14 +467,12 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
             payload = (((size_t)_ws_receive_frame_buffer[2] << 8) | ((size_t)_ws_receive_frame_buffer[3] << 0));
             _ws_header_size = 4 + (mask ? 4 : 0);
             _ws_payload_size = payload;
-            _ws_receive_frame_buffer.reserve(_ws_header_size + _ws_payload_size);
-            _ws_receive_final_buffer.reserve(_ws_header_size + _ws_payload_size);
         }
         else if (payload == 127)
         {
             if (_ws_receive_frame_buffer.size() < 10)
             {
-                for (size_t i = 0; i < 8; ++i, ++data, --size)
+                for (size_t i = _ws_receive_frame_buffer.size(); i < 10; ++i, ++data, --size)
                 {
                     if (size == 0)
                         return;
@@ -366,6 +483,20 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
             payload = (((size_t)_ws_receive_frame_buffer[2] << 56) | ((size_t)_ws_receive_frame_buffer[3] << 48) | ((size_t)_ws_receive_frame_buffer[4] << 40) | ((size_t)_ws_receive_frame_buffer[5] << 32) | ((size_t)_ws_receive_frame_buffer[6] << 24) | ((size_t)_ws_receive_frame_buffer[7] << 16) | ((size_t)_ws_receive_frame_buffer[8] << 8) | ((size_t)_ws_receive_frame_buffer[9] << 0));
             _ws_header_size = 10 + (mask ? 4 : 0);
             _ws_payload_size = payload;
+        }
+
+        // Reject too large WebSocket message before buffering its payload
+        if (!control && (_ws_max_message_size > 0) && ((_ws_receive_message_size + _ws_payload_size) > _ws_max_message_size))
+        {
+            _ws_receive_rejected = true;
+            onWSError("WebSocket message is too large");
+            CloseConnection(1009, "Message too big");
+            return;
+        }
+
+        // Streamed payload is not collected in WebSocket frame buffers
+        if (!streaming)
+        {
             _ws_receive_frame_buffer.reserve(_ws_header_size + _ws_payload_size);
             _ws_receive_final_buffer.reserve(_ws_header_size + _ws_payload_size);
         }
@@ -375,7 +506,8 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
         {
             if (_ws_receive_frame_buffer.size() < _ws_header_size)
             {
-                for (size_t i = 0; i < 4; ++i, ++data, --size)
+                // Continue from the mask bytes already received with the previous chunk
+                for (size_t i = _ws_receive_frame_buffer.size() + 4 - _ws_header_size; i < 4; ++i, ++data, --size)
                 {
                     if (size == 0)
                         return;
@@ -385,6 +517,44 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
             }
         }
 
+        // Stream WebSocket frame payload
+        if (streaming)
+        {
+            size_t length = std::min(_ws_payload_size - _ws_receive_streamed, size);
+
+            // Unmask WebSocket payload slice into the session buffer, the received data is never modified
+            const uint8_t* slice = data;
+            if (mask)
+            {
+                _ws_receive_stream_buffer.resize(length);
+                MaskPayload(_ws_receive_stream_buffer.data(), data, length, _ws_receive_mask, _ws_receive_streamed);
+                slice = _ws_receive_stream_buffer.data();
+            }
+
+            _ws_receive_streamed += length;
+            data += length;
+            size -= length;
+
+            bool complete = (_ws_receive_streamed == _ws_payload_size);
+            bool last = fin && complete;
+
+            // Call the WebSocket received fragment handler
+            if ((length > 0) || last)
+            {
+                bool first = _ws_receive_first;
+                _ws_receive_first = last;
+                onWSReceivedFragment(slice, length, first, last);
+            }
+
+            if (complete)
+            {
+                _ws_frame_received = true;
+                _ws_receive_message_size = last ? 0 : (_ws_receive_message_size + _ws_payload_size);
+                _ws_final_received = last;
+            }
+            continue;
+        }
+
         size_t total = _ws_header_size + _ws_payload_size;
         size_t length = std::min(total - _ws_receive_frame_buffer.size(), size);
 
@@ -399,14 +569,19 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
             // Unmask WebSocket frame content
             if (mask)
             {
-                for (size_t i = 0; i < _ws_payload_size; ++i)
-                    _ws_receive_final_buffer.push_back(_ws_receive_frame_buffer[_ws_header_size + i] ^ _ws_receive_mask[i % 4]);
+                size_t offset = _ws_receive_final_buffer.size();
+                _ws_receive_final_buffer.resize(offset + _ws_payload_size);
+                MaskPayload(_ws_receive_final_buffer.data() + offset, _ws_receive_frame_buffer.data() + _ws_header_size, _ws_payload_size, _ws_receive_mask);
             }
             else
                 _ws_receive_final_buffer.insert(_ws_receive_final_buffer.end(), _ws_receive_frame_buffer.begin() + _ws_header_size, _ws_receive_frame_buffer.end());
 
             _ws_frame_received = true;
 
+            // Update WebSocket message size
+            if (!control)
+                _ws_receive_message_size = fin ? 0 : (_ws_receive_message_size + _ws_payload_size);
+
             // Finalize WebSocket frame
             if (fin)
             {
@@ -445,8 +620,31 @@ void WebSocket::PrepareReceiveFrame(const void* buffer, size_t size)
                     case WS_BINARY:
                     case WS_TEXT:
                     {
+                        // Decompress WebSocket message
+                        if (_ws_receive_compressed)
+                        {
+                            if (!_ws_deflate.Decompress(_ws_receive_final_buffer.data(), _ws_receive_final_buffer.size(), _ws_receive_deflate_buffer, _ws_max_message_size))
+                            {
+                                if ((_ws_max_message_size > 0) && (_ws_receive_deflate_buffer.size() > _ws_max_message_size))
+                                {
+                                    _ws_receive_rejected = true;
+                                    onWSError("WebSocket message is too large");
+                                    CloseConnection(1009, "Message too big");
+                                    return;
+                                }
+                                _ws_receive_rejected = true;
+                                onWSError("Invalid WebSocket compressed message");
+                                CloseConnection(1007, "Invalid compressed message");
+                                return;
+                            }
+                            _ws_receive_final_buffer.swap(_ws_receive_deflate_buffer);
+                        }
+
                         // Call the WebSocket received handler
-                        onWSReceived(_ws_receive_final_buffer.data(), _ws_receive_final_buffer.size());
+                        if (_ws_streaming)
+                            onWSReceivedFragment(_ws_receive_final_buffer.data(), _ws_receive_final_buffer.size(), true, true);
+                        else
+                            onWSReceived(_ws_receive_final_buffer.data(), _ws_receive_final_buffer.size());
                         break;
                     }
                 }
@@ -477,8 +675,8 @@ size_t WebSocket::RequiredReceiveFrameSize()
     if ((mask) && (_ws_receive_frame_buffer.size() < _ws_header_size))
         return _ws_header_size - _ws_receive_frame_buffer.size();
 
-    // Required WebSocket frame payload
-    return _ws_header_size + _ws_payload_size - _ws_receive_frame_buffer.size();
+    // Required WebSocket frame payload (streamed payload is not collected)
+    return _ws_header_size + _ws_payload_size - _ws_receive_frame_buffer.size() - _ws_receive_streamed;
 }
 
 void WebSocket::ClearWSBuffers()
@@ -489,13 +687,98 @@ void WebSocket::ClearWSBuffers()
     _ws_payload_size = 0;
     _ws_receive_frame_buffer.clear();
     _ws_receive_final_buffer.clear();
+    _ws_receive_deflate_buffer.clear();
+    _ws_receive_stream_buffer.clear();
+    _ws_receive_compressed = false;
+    _ws_receive_message_size = 0;
+    _ws_receive_streamed = 0;
+    _ws_receive_first = true;
+    _ws_receive_rejected = false;
     *((uint32_t*)_ws_receive_mask) = 0;
 
     std::scoped_lock locker(_ws_send_lock);
 
     _ws_send_buffer.clear();
+    _ws_send_deflate_buffer.clear();
+    _ws_deflate.Clear();
     *((uint32_t*)_ws_send_mask) = 0;
 }
 
+void WebSocket::MaskPayload(uint8_t* destination, const uint8_t* source, size_t size, const uint8_t* mask, size_t offset) noexcept
+{
+    // Rotate the mask to the payload offset
+    uint8_t key[4] = { mask[(offset + 0) % 4], mask[(offset + 1) % 4], mask[(offset + 2) % 4], mask[(offset + 3) % 4] };
+    uint32_t key32;
+    std::memcpy(&key32, key, sizeof(key32));
+
+    // Zero mask does not change the payload
+    if (key32 == 0)
+    {
+        if ((destination != source) && (size > 0))
+            std::memmove(destination, source, size);
+        return;
+    }
+
+    // All blocks are multiple of 4 bytes, so the mask phase is kept
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i key256 = _mm256_set1_epi32((int)key32);
+    for (; (i + 64) <= size; i += 64)
+    {
+        __m256i block1 = _mm256_loadu_si256((const __m256i*)(source + i));
+        __m256i block2 = _mm256_loadu_si256((const __m256i*)(source + i + 32));
+        _mm256_storeu_si256((__m256i*)(destination + i), _mm256_xor_si256(block1, key256));
+        _mm256_storeu_si256((__m256i*)(destination + i + 32), _mm256_xor_si256(block2, key256));
+    }
+    for (; (i + 32) <= size; i += 32)
+        _mm256_storeu_si256((__m256i*)(destination + i), _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(source + i)), key256));
+#endif
+
+#if defined(CPPSERVER_WS_SSE2)
+    const __m128i key128 = _mm_set1_epi32((int)key32);
+    for (; (i + 64) <= size; i += 64)
+    {
+        __m128i block1 = _mm_loadu_si128((const __m128i*)(source + i));
+        __m128i block2 = _mm_loadu_si128((const __m128i*)(source + i + 16));
+        __m128i block3 = _mm_loadu_si128((const __m128i*)(source + i + 32));
+        __m128i block4 = _mm_loadu_si128((const __m128i*)(source + i + 48));
+        _mm_storeu_si128((__m128i*)(destination + i), _mm_xor_si128(block1, key128));
+        _mm_storeu_si128((__m128i*)(destination + i + 16), _mm_xor_si128(block2, key128));
+        _mm_storeu_si128((__m128i*)(destination + i + 32), _mm_xor_si128(block3, key128));
+        _mm_storeu_si128((__m128i*)(destination + i + 48), _mm_xor_si128(block4, key128));
+    }
+    for (; (i + 16) <= size; i += 16)
+        _mm_storeu_si128((__m128i*)(destination + i), _mm_xor_si128(_mm_loadu_si128((const __m128i*)(source + i)), key128));
+#elif defined(CPPSERVER_WS_NEON)
+    const uint8x16_t key128 = vreinterpretq_u8_u32(vdupq_n_u32(key32));
+    for (; (i + 64) <= size; i += 64)
+    {
+        uint8x16_t block1 = vld1q_u8(source + i);
+        uint8x16_t block2 = vld1q_u8(source + i + 16);
+        uint8x16_t block3 = vld1q_u8(source + i + 32);
+        uint8x16_t block4 = vld1q_u8(source + i + 48);
+        vst1q_u8(destination + i, veorq_u8(block1, key128));
+        vst1q_u8(destination + i + 16, veorq_u8(block2, key128));
+        vst1q_u8(destination + i + 32, veorq_u8(block3, key128));
+        vst1q_u8(destination + i + 48, veorq_u8(block4, key128));
+    }
+    for (; (i + 16) <= size; i += 16)
+        vst1q_u8(destination + i, veorq_u8(vld1q_u8(source + i), key128));
+#endif
+
+    // Scalar fallback with 8-byte words
+    const uint64_t key64 = ((uint64_t)key32 << 32) | key32;
+    for (; (i + 8) <= size; i += 8)
+    {
+        uint64_t block;
+        std::memcpy(&block, source + i, sizeof(block));
+        block ^= key64;
+        std::memcpy(destination + i, &block, sizeof(block));
+    }
+    for (; i < size; ++i)
+        destination[i] = source[i] ^ key[i % 4];
+}
+
 } // namespace WS
 } // namespace CppServer
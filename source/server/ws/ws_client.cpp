@@ -43,6 +43,10 @@ void WSClient::onConnected()
     // Fill the WebSocket upgrade HTTP request
     onWSConnecting(_request);
 
+    // Offer permessage-deflate extension
+    if (ws_deflate_enabled())
+        _request.SetHeader("Sec-WebSocket-Extensions", ws_deflate_options().PrepareOffer());
+
     // Set empty body of the WebSocket upgrade HTTP request
     _request.SetBody();
 
@@ -0,0 +1,467 @@
+/*!
+    \file ws_deflate.cpp
+    \brief WebSocket permessage-deflate extension implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/ws/ws_deflate.h"
+
+#include "string/string_utils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#include <zlib.h>
+
+namespace CppServer {
+namespace WS {
+
+namespace {
+
+// Shared memory pool of zlib streams
+class DeflatePool
+{
+public:
+    // Pool is never destroyed, because zlib streams could outlive static objects
+    static DeflatePool& Instance()
+    {
+        static DeflatePool* instance = new DeflatePool();
+        return *instance;
+    }
+
+    void* Allocate(size_t size)
+    {
+        {
+            std::scoped_lock locker(_lock);
+
+            // Reuse the cached block of the same size
+            auto it = _blocks.find(size);
+            if ((it != _blocks.end()) && !it->second.empty())
+            {
+                uint8_t* block = it->second.back();
+                it->second.pop_back();
+                _cached -= size;
+                return block + HEADER_SIZE;
+            }
+        }
+
+        // Allocate a new block with the size header
+        uint8_t* block = (uint8_t*)std::malloc(HEADER_SIZE + size);
+        if (block == nullptr)
+            return nullptr;
+        *((size_t*)block) = size;
+        return block + HEADER_SIZE;
+    }
+
+    void Free(void* address)
+    {
+        if (address == nullptr)
+            return;
+
+        uint8_t* block = (uint8_t*)address - HEADER_SIZE;
+        size_t size = *((size_t*)block);
+
+        {
+            std::scoped_lock locker(_lock);
+
+            // Cache the block until the pool limit is reached
+            if ((_cached + size) <= POOL_LIMIT)
+            {
+                _blocks[size].push_back(block);
+                _cached += size;
+                return;
+            }
+        }
+
+        std::free(block);
+    }
+
+private:
+    // Size header keeps the maximal alignment of the allocated memory
+    static const size_t HEADER_SIZE = alignof(std::max_align_t);
+    // Maximal size of cached memory
+    static const size_t POOL_LIMIT = 64 * 1024 * 1024;
+
+    std::mutex _lock;
+    std::unordered_map<size_t, std::vector<uint8_t*>> _blocks;
+    size_t _cached{0};
+};
+
+voidpf DeflateAlloc(voidpf opaque, uInt items, uInt size)
+{
+    return DeflatePool::Instance().Allocate((size_t)items * size);
+}
+
+void DeflateFree(voidpf opaque, voidpf address)
+{
+    DeflatePool::Instance().Free(address);
+}
+
+// Empty deflate block appended by the sync flush (RFC 7692, section 7.2.1)
+const uint8_t deflate_tail[4] = { 0x00, 0x00, 0xFF, 0xFF };
+
+std::string_view Trim(std::string_view str)
+{
+    while (!str.empty() && ((str.front() == ' ') || (str.front() == '\t')))
+        str.remove_prefix(1);
+    while (!str.empty() && ((str.back() == ' ') || (str.back() == '\t')))
+        str.remove_suffix(1);
+    return str;
+}
+
+// Parse extension parameter into its name and value
+void ParseParameter(std::string_view parameter, std::string_view& name, std::string_view& value)
+{
+    size_t index = parameter.find('=');
+    name = Trim(parameter.substr(0, index));
+    value = (index != std::string_view::npos) ? Trim(parameter.substr(index + 1)) : std::string_view();
+
+    // Remove quotes from the parameter value
+    if ((value.size() >= 2) && (value.front() == '"') && (value.back() == '"'))
+        value = value.substr(1, value.size() - 2);
+}
+
+// Parse LZ77 sliding window size in bits (8..15)
+int ParseWindowBits(std::string_view value)
+{
+    if ((value.size() == 1) && (value[0] >= '8') && (value[0] <= '9'))
+        return value[0] - '0';
+    if ((value.size() == 2) && (value[0] == '1') && (value[1] >= '0') && (value[1] <= '5'))
+        return 10 + (value[1] - '0');
+    return 0;
+}
+
+// Parse extension into its name and parameters
+std::vector<std::string_view> ParseExtension(std::string_view extension)
+{
+    std::vector<std::string_view> result;
+
+    size_t index;
+    while ((index = extension.find(';')) != std::string_view::npos)
+    {
+        result.push_back(Trim(extension.substr(0, index)));
+        extension.remove_prefix(index + 1);
+    }
+    result.push_back(Trim(extension));
+
+    return result;
+}
+
+} // namespace
+
+std::string WSDeflateOptions::PrepareOffer() const
+{
+    std::string result = "permessage-deflate";
+
+    if (server_no_context_takeover)
+        result += "; server_no_context_takeover";
+    if (client_no_context_takeover)
+        result += "; client_no_context_takeover";
+    if (server_max_window_bits < 15)
+        result += "; server_max_window_bits=" + std::to_string(server_max_window_bits);
+    if (client_max_window_bits < 15)
+        result += "; client_max_window_bits=" + std::to_string(client_max_window_bits);
+    else
+        result += "; client_max_window_bits";
+
+    return result;
+}
+
+bool WSDeflateOptions::NegotiateOffer(std::string_view offers, WSDeflateOptions& agreed, std::string& response) const
+{
+    // Try all comma separated offers in the client preference order
+    while (!offers.empty())
+    {
+        size_t index = offers.find(',');
+        auto parameters = ParseExtension(offers.substr(0, index));
+        offers.remove_prefix((index != std::string_view::npos) ? (index + 1) : offers.size());
+
+        if (!CppCommon::StringUtils::CompareNoCase(parameters[0], "permessage-deflate"))
+            continue;
+
+        bool valid = true;
+        bool server_no_context_takeover_offered = false;
+        bool client_no_context_takeover_offered = false;
+        int server_max_window_bits_offered = 0;
+        int client_max_window_bits_offered = 0;
+        bool client_max_window_bits_supported = false;
+
+        // Validate offer parameters
+        for (size_t i = 1; valid && (i < parameters.size()); ++i)
+        {
+            std::string_view name, value;
+            ParseParameter(parameters[i], name, value);
+
+            if (CppCommon::StringUtils::CompareNoCase(name, "server_no_context_takeover"))
+            {
+                valid = !server_no_context_takeover_offered && value.empty();
+                server_no_context_takeover_offered = true;
+            }
+            else if (CppCommon::StringUtils::CompareNoCase(name, "client_no_context_takeover"))
+            {
+                valid = !client_no_context_takeover_offered && value.empty();
+                client_no_context_takeover_offered = true;
+            }
+            else if (CppCommon::StringUtils::CompareNoCase(name, "server_max_window_bits"))
+            {
+                valid = (server_max_window_bits_offered == 0);
+                server_max_window_bits_offered = ParseWindowBits(value);
+                valid = valid && (server_max_window_bits_offered > 0);
+            }
+            else if (CppCommon::StringUtils::CompareNoCase(name, "client_max_window_bits"))
+            {
+                valid = !client_max_window_bits_supported;
+                client_max_window_bits_supported = true;
+                client_max_window_bits_offered = value.empty() ? 15 : ParseWindowBits(value);
+                valid = valid && (client_max_window_bits_offered > 0);
+            }
+            else
+                valid = false;
+        }
+        if (!valid)
+            continue;
+
+        agreed = *this;
+        agreed.server_no_context_takeover = server_no_context_takeover || server_no_context_takeover_offered;
+        agreed.client_no_context_takeover = client_no_context_takeover || client_no_context_takeover_offered;
+        agreed.server_max_window_bits = std::min(server_max_window_bits, (server_max_window_bits_offered > 0) ? server_max_window_bits_offered : 15);
+        agreed.client_max_window_bits = client_max_window_bits_supported ? std::min(client_max_window_bits, client_max_window_bits_offered) : 15;
+
+        // zlib raw deflate streams do not support 8 bits sliding window
+        if (agreed.server_max_window_bits < 9)
+            continue;
+
+        // Prepare the extension response
+        response = "permessage-deflate";
+        if (agreed.server_no_context_takeover)
+            response += "; server_no_context_takeover";
+        if (agreed.client_no_context_takeover)
+            response += "; client_no_context_takeover";
+        if ((agreed.server_max_window_bits < 15) || (server_max_window_bits_offered > 0))
+            response += "; server_max_window_bits=" + std::to_string(agreed.server_max_window_bits);
+        if (client_max_window_bits_supported && (agreed.client_max_window_bits < 15))
+            response += "; client_max_window_bits=" + std::to_string(agreed.client_max_window_bits);
+
+        return true;
+    }
+
+    return false;
+}
+
+bool WSDeflateOptions::NegotiateResponse(std::string_view value, WSDeflateOptions& agreed) const
+{
+    // Only one permessage-deflate extension could be accepted
+    if (value.find(',') != std::string_view::npos)
+        return false;
+
+    auto parameters = ParseExtension(value);
+    if (!CppCommon::StringUtils::CompareNoCase(parameters[0], "permessage-deflate"))
+        return false;
+
+    agreed = *this;
+    agreed.server_max_window_bits = 15;
+    agreed.client_max_window_bits = 15;
+
+    // Validate response parameters
+    for (size_t i = 1; i < parameters.size(); ++i)
+    {
+        std::string_view name, parameter;
+        ParseParameter(parameters[i], name, parameter);
+
+        if (CppCommon::StringUtils::CompareNoCase(name, "server_no_context_takeover") && parameter.empty())
+            agreed.server_no_context_takeover = true;
+        else if (CppCommon::StringUtils::CompareNoCase(name, "client_no_context_takeover") && parameter.empty())
+            agreed.client_no_context_takeover = true;
+        else if (CppCommon::StringUtils::CompareNoCase(name, "server_max_window_bits") && (ParseWindowBits(parameter) > 0))
+            agreed.server_max_window_bits = ParseWindowBits(parameter);
+        else if (CppCommon::StringUtils::CompareNoCase(name, "client_max_window_bits") && (ParseWindowBits(parameter) > 0))
+            agreed.client_max_window_bits = ParseWindowBits(parameter);
+        else
+            return false;
+    }
+
+    // Client compression must follow its own setup
+    agreed.client_max_window_bits = std::min(agreed.client_max_window_bits, client_max_window_bits);
+
+    // zlib raw deflate streams do not support 8 bits sliding window
+    return (agreed.client_max_window_bits >= 9);
+}
+
+WSDeflate::WSDeflate()
+{
+}
+
+WSDeflate::~WSDeflate()
+{
+    Clear();
+}
+
+bool WSDeflate::Initialize(const WSDeflateOptions& options, bool server)
+{
+    Clear();
+
+    _options = options;
+    _server = server;
+
+    int deflate_bits = server ? options.server_max_window_bits : options.client_max_window_bits;
+    int inflate_bits = server ? options.client_max_window_bits : options.server_max_window_bits;
+
+    // Initialize the compression stream
+    _deflate = std::make_unique<z_stream>();
+    _deflate->zalloc = DeflateAlloc;
+    _deflate->zfree = DeflateFree;
+    _deflate->opaque = Z_NULL;
+    if (deflateInit2(_deflate.get(), options.level, Z_DEFLATED, -deflate_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        _deflate.reset();
+        return false;
+    }
+
+    // Initialize the decompression stream
+    _inflate = std::make_unique<z_stream>();
+    _inflate->zalloc = DeflateAlloc;
+    _inflate->zfree = DeflateFree;
+    _inflate->opaque = Z_NULL;
+    if (inflateInit2(_inflate.get(), -inflate_bits) != Z_OK)
+    {
+        _inflate.reset();
+        Clear();
+        return false;
+    }
+
+    _initialized = true;
+    return true;
+}
+
+void WSDeflate::Clear()
+{
+    if (_deflate)
+    {
+        deflateEnd(_deflate.get());
+        _deflate.reset();
+    }
+    if (_inflate)
+    {
+        inflateEnd(_inflate.get());
+        _inflate.reset();
+    }
+    _initialized = false;
+}
+
+bool WSDeflate::Deflate(z_stream_s& stream, const void* buffer, size_t size, std::vector<uint8_t>& output)
+{
+    output.clear();
+
+    stream.next_in = (Bytef*)buffer;
+    stream.avail_in = (uInt)size;
+
+    // Compress the whole payload and flush it to the byte boundary
+    do
+    {
+        size_t offset = output.size();
+        output.resize(offset + std::max((size_t)64, size / 2 + 16));
+        stream.next_out = output.data() + offset;
+        stream.avail_out = (uInt)(output.size() - offset);
+
+        int result = deflate(&stream, Z_SYNC_FLUSH);
+        output.resize(output.size() - stream.avail_out);
+        if ((result != Z_OK) && (result != Z_BUF_ERROR))
+            return false;
+    } while ((stream.avail_out == 0) || (stream.avail_in > 0));
+
+    // Remove the empty deflate block tail
+    if ((output.size() >= sizeof(deflate_tail)) && std::equal(output.end() - sizeof(deflate_tail), output.end(), deflate_tail))
+        output.resize(output.size() - sizeof(deflate_tail));
+
+    // Empty compressed payload is a single empty deflate block
+    if (output.empty())
+        output.push_back(0x00);
+
+    return true;
+}
+
+bool WSDeflate::Compress(const void* buffer, size_t size, std::vector<uint8_t>& output)
+{
+    if (!_initialized)
+        return false;
+
+    if (!Deflate(*_deflate, buffer, size, output))
+        return false;
+
+    // Reset the compression context if required
+    if (_server ? _options.server_no_context_takeover : _options.client_no_context_takeover)
+        deflateReset(_deflate.get());
+
+    return true;
+}
+
+bool WSDeflate::Decompress(const void* buffer, size_t size, std::vector<uint8_t>& output, size_t limit)
+{
+    if (!_initialized)
+        return false;
+
+    output.clear();
+
+    // Decompress the payload followed by the empty deflate block tail
+    for (int part = 0; part < 2; ++part)
+    {
+        _inflate->next_in = (Bytef*)((part == 0) ? buffer : deflate_tail);
+        _inflate->avail_in = (uInt)((part == 0) ? size : sizeof(deflate_tail));
+
+        do
+        {
+            size_t offset = output.size();
+            output.resize(offset + std::max((size_t)256, 2 * (size_t)_inflate->avail_in));
+            _inflate->next_out = output.data() + offset;
+            _inflate->avail_out = (uInt)(output.size() - offset);
+
+            int result = inflate(_inflate.get(), Z_SYNC_FLUSH);
+            output.resize(output.size() - _inflate->avail_out);
+            if ((limit > 0) && (output.size() > limit))
+            {
+                // Stop decompression of too large payload
+                inflateReset(_inflate.get());
+                return false;
+            }
+            if (result == Z_STREAM_END)
+            {
+                // Final deflate block ends the payload
+                inflateReset(_inflate.get());
+                return true;
+            }
+            if ((result != Z_OK) && (result != Z_BUF_ERROR))
+            {
+                inflateReset(_inflate.get());
+                return false;
+            }
+        } while ((_inflate->avail_in > 0) || (_inflate->avail_out == 0));
+    }
+
+    // Reset the decompression context if required
+    if (_server ? _options.client_no_context_takeover : _options.server_no_context_takeover)
+        inflateReset(_inflate.get());
+
+    return true;
+}
+
+bool WSDeflate::CompressOnce(const void* buffer, size_t size, int window_bits, int level, std::vector<uint8_t>& output)
+{
+    z_stream stream = {};
+    stream.zalloc = DeflateAlloc;
+    stream.zfree = DeflateFree;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(&stream, level, Z_DEFLATED, -window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+
+    bool result = Deflate(stream, buffer, size, output);
+    deflateEnd(&stream);
+    return result;
+}
+
+} // namespace WS
+} // namespace CppServer
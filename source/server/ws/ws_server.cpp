@@ -13,10 +13,7 @@ namespace WS {
 
 bool WSServer::CloseAll(int status, const void* buffer, size_t size)
 {
-    std::scoped_lock locker(_ws_send_lock);
-
-    PrepareSendFrame(WS_FIN | WS_CLOSE, false, buffer, size, status);
-    if (!Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()))
+    if (!MulticastFrame(WS_FIN | WS_CLOSE, buffer, size, status))
         return false;
 
     return HTTPServer::DisconnectAll();
@@ -24,10 +21,7 @@ bool WSServer::CloseAll(int status, const void* buffer, size_t size)
 
 bool WSServer::CloseAll(int status, std::string_view text)
 {
-    std::scoped_lock locker(_ws_send_lock);
-
-    PrepareSendFrame(WS_FIN | WS_CLOSE, false, text.data(), text.size(), status);
-    if (!Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()))
+    if (!MulticastFrame(WS_FIN | WS_CLOSE, text.data(), text.size(), status))
         return false;
 
     return HTTPServer::DisconnectAll();
@@ -45,23 +39,97 @@ bool WSServer::Multicast(const void* buffer, size_t size)
     if (buffer == nullptr)
         return false;
 
-    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+    // Share the copy of multicasted data between all WebSocket sessions
+    const uint8_t* bytes = (const uint8_t*)buffer;
+    return Multicast(std::make_shared<const std::vector<uint8_t>>(bytes, bytes + size));
+}
+
+bool WSServer::Multicast(const std::shared_ptr<const std::vector<uint8_t>>& buffer)
+{
+    if (!IsStarted())
+        return false;
+
+    assert((buffer != nullptr) && "Pointer to the shared buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    if (buffer->empty())
+        return true;
+
+    std::shared_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Multicast all WebSocket sessions
+    for (auto& session : _ws_sessions)
+        session.second->SendAsync(buffer);
+
+    return true;
+}
+
+bool WSServer::MulticastFrame(uint8_t opcode, const void* buffer, size_t size, int status)
+{
+    if (!IsStarted())
+        return false;
+
+    // Prepare WebSocket frame once for all sessions
+    auto frame = PrepareSharedFrame(opcode, buffer, size, status);
+
+    // Multicast uncompressed messages
+    uint8_t code = opcode & 0x0F;
+    if (!_ws_deflate_enabled || ((code != WS_TEXT) && (code != WS_BINARY)) || (size < _ws_deflate_options.threshold))
+        return Multicast(frame);
+
+    // Compressed frames prepared once for each sliding window size
+    std::array<std::shared_ptr<const std::vector<uint8_t>>, 16> compressed_frames;
+    std::vector<uint8_t> payload;
+
+    std::shared_lock<std::shared_mutex> locker(_ws_sessions_lock);
 
     // Multicast all WebSocket sessions
-    for (auto& session : _sessions)
+    for (auto& session : _ws_sessions)
     {
-        auto ws_session = std::dynamic_pointer_cast<WSSession>(session.second);
-        if (ws_session)
-        {
-            std::scoped_lock ws_locker(ws_session->_ws_send_lock);
+        auto& ws_session = *session.second;
 
-            if (ws_session->_ws_handshaked)
-                ws_session->SendAsync(buffer, size);
+        if (!ws_session._ws_deflate.IsInitialized())
+            ws_session.SendAsync(frame);
+        else if (ws_session._ws_deflate.options().server_no_context_takeover)
+        {
+            // Sessions without context takeover share the compressed frame
+            int window_bits = ws_session._ws_deflate.options().server_max_window_bits;
+            auto& compressed = compressed_frames[window_bits];
+            if (!compressed)
+            {
+                if (WSDeflate::CompressOnce(buffer, size, window_bits, _ws_deflate_options.level, payload))
+                    compressed = PrepareSharedFrame(opcode | WS_RSV1, payload.data(), payload.size());
+                else
+                    compressed = frame;
+            }
+            ws_session.SendAsync(compressed);
+        }
+        else
+        {
+            // Sessions with context takeover compress the message with their own context
+            ws_session.SendFrameAsync(opcode, buffer, size, status);
         }
     }
 
     return true;
 }
 
+void WSServer::RegisterWSSession(const std::shared_ptr<WSSession>& session)
+{
+    std::unique_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Register a new handshaked WebSocket session
+    _ws_sessions.emplace(session->id(), session);
+}
+
+void WSServer::UnregisterWSSession(const CppCommon::UUID& id)
+{
+    std::unique_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Unregister WebSocket session by Id
+    _ws_sessions.erase(id);
+}
+
 } // namespace WS
 } // namespace CppServer
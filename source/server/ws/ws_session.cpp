@@ -15,14 +15,30 @@ namespace WS {
 WSSession::WSSession(const std::shared_ptr<WSServer>& server)
     : HTTP::HTTPSession(server)
 {
+    // Inherit permessage-deflate extension setup of the server
+    SetupWSDeflate(server->ws_deflate_enabled(), server->ws_deflate_options());
+
+    // Inherit receive setup of the server
+    SetupWSStreaming(server->ws_streaming());
+    SetupWSMaxMessageSize(server->ws_max_message_size());
+
+    // Inherit keep-alive setup of the server
+    SetupWSPingInterval(server->ws_ping_interval());
 }
 
 void WSSession::onDisconnected()
 {
+    // Stop the session watchdog
+    StopWatchdog();
+
     // Disconnect WebSocket
     if (_ws_handshaked)
     {
         _ws_handshaked = false;
+
+        // Unregister the WebSocket session in the server
+        std::static_pointer_cast<WSServer>(server())->UnregisterWSSession(id());
+
         onWSDisconnected();
     }
 
@@ -37,6 +53,36 @@ void WSSession::onDisconnected()
     InitWSNonce();
 }
 
+void WSSession::onWSHandshaked()
+{
+    // Register the WebSocket session in the server
+    std::static_pointer_cast<WSServer>(server())->RegisterWSSession(std::static_pointer_cast<WSSession>(shared_from_this()));
+
+    // Reschedule the session watchdog to send keep-alive pings
+    _ws_ping_idle = CppCommon::Timespan::zero();
+    UpdateWatchdog();
+}
+
+CppCommon::Timespan WSSession::onWatchdog(const CppCommon::Timespan& idle)
+{
+    // Keep-alive pings are sent only to handshaked WebSocket clients
+    if (!_ws_handshaked || (ws_ping_interval() <= CppCommon::Timespan::zero()))
+        return CppCommon::Timespan::zero();
+
+    // Received data restarts keep-alive pings
+    if (idle < _ws_ping_idle)
+        _ws_ping_idle = CppCommon::Timespan::zero();
+
+    // Send keep-alive ping once per ping interval of the idle client
+    if (idle >= (_ws_ping_idle + ws_ping_interval()))
+    {
+        SendPingAsync("");
+        _ws_ping_idle = idle;
+    }
+
+    return _ws_ping_idle + ws_ping_interval() - idle;
+}
+
 void WSSession::onReceived(const void* buffer, size_t size)
 {
     // Check for WebSocket handshaked status
@@ -214,5 +260,44 @@ std::vector<uint8_t> WSSession::ReceiveBinary(const CppCommon::Timespan& timeout
     return result;
 }
 
+size_t WSSession::SendFrame(uint8_t opcode, const void* buffer, size_t size, int status)
+{
+    // Synchronous frames must not be interleaved with each other
+    std::scoped_lock locker(_ws_send_lock);
+
+    // Compress WebSocket message if required
+    PrepareSendDeflate(opcode, buffer, size);
+
+    uint8_t header[WS_MAX_HEADER_SIZE];
+    size_t header_size = PrepareFrameHeader(header, opcode, nullptr, size, status);
+
+    return HTTP::HTTPSession::Send({ asio::const_buffer(header, header_size), asio::const_buffer(buffer, size) });
+}
+
+size_t WSSession::SendFrame(uint8_t opcode, const void* buffer, size_t size, const CppCommon::Timespan& timeout, int status)
+{
+    std::scoped_lock locker(_ws_send_lock);
+
+    PrepareSendFrame(opcode, false, buffer, size, status);
+    return HTTP::HTTPSession::Send(_ws_send_buffer.data(), _ws_send_buffer.size(), timeout);
+}
+
+bool WSSession::SendFrameAsync(uint8_t opcode, const void* buffer, size_t size, int status)
+{
+    // Compressed messages must be sent in the order of compression
+    std::unique_lock<std::mutex> locker(_ws_send_lock, std::defer_lock);
+    if (ws_deflate())
+    {
+        locker.lock();
+        PrepareSendDeflate(opcode, buffer, size);
+    }
+
+    uint8_t header[WS_MAX_HEADER_SIZE];
+    size_t header_size = PrepareFrameHeader(header, opcode, nullptr, size, status);
+
+    // Frame header and payload are copied into the send buffer at once
+    return HTTP::HTTPSession::SendAsync({ asio::const_buffer(header, header_size), asio::const_buffer(buffer, size) });
+}
+
 } // namespace WS
 } // namespace CppServer
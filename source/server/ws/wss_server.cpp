@@ -13,10 +13,7 @@ namespace WS {
 
 bool WSSServer::CloseAll(int status, const void* buffer, size_t size)
 {
-    std::scoped_lock locker(_ws_send_lock);
-
-    PrepareSendFrame(WS_FIN | WS_CLOSE, false, buffer, size, status);
-    if (!Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()))
+    if (!MulticastFrame(WS_FIN | WS_CLOSE, buffer, size, status))
         return false;
 
     return HTTPSServer::DisconnectAll();
@@ -24,10 +21,7 @@ bool WSSServer::CloseAll(int status, const void* buffer, size_t size)
 
 bool WSSServer::CloseAll(int status, std::string_view text)
 {
-    std::scoped_lock locker(_ws_send_lock);
-
-    PrepareSendFrame(WS_FIN | WS_CLOSE, false, text.data(), text.size(), status);
-    if (!Multicast(_ws_send_buffer.data(), _ws_send_buffer.size()))
+    if (!MulticastFrame(WS_FIN | WS_CLOSE, text.data(), text.size(), status))
         return false;
 
     return HTTPSServer::DisconnectAll();
@@ -45,23 +39,93 @@ bool WSSServer::Multicast(const void* buffer, size_t size)
     if (buffer == nullptr)
         return false;
 
-    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+    std::shared_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Multicast all WebSocket sessions
+    for (auto& session : _ws_sessions)
+        session.second->SendAsync(buffer, size);
+
+    return true;
+}
+
+bool WSSServer::Multicast(const std::shared_ptr<const std::vector<uint8_t>>& buffer)
+{
+    if (!IsStarted())
+        return false;
+
+    assert((buffer != nullptr) && "Pointer to the shared buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    // Each WebSocket session encrypts its own copy of the shared buffer
+    return Multicast(buffer->data(), buffer->size());
+}
+
+bool WSSServer::MulticastFrame(uint8_t opcode, const void* buffer, size_t size, int status)
+{
+    if (!IsStarted())
+        return false;
+
+    // Prepare WebSocket frame once for all sessions
+    auto frame = PrepareSharedFrame(opcode, buffer, size, status);
+
+    // Multicast uncompressed messages
+    uint8_t code = opcode & 0x0F;
+    if (!_ws_deflate_enabled || ((code != WS_TEXT) && (code != WS_BINARY)) || (size < _ws_deflate_options.threshold))
+        return Multicast(frame);
+
+    // Compressed frames prepared once for each sliding window size
+    std::array<std::shared_ptr<const std::vector<uint8_t>>, 16> compressed_frames;
+    std::vector<uint8_t> payload;
+
+    std::shared_lock<std::shared_mutex> locker(_ws_sessions_lock);
 
     // Multicast all WebSocket sessions
-    for (auto& session : _sessions)
+    for (auto& session : _ws_sessions)
     {
-        auto wss_session = std::dynamic_pointer_cast<WSSSession>(session.second);
-        if (wss_session)
-        {
-            std::scoped_lock ws_locker(wss_session->_ws_send_lock);
+        auto& ws_session = *session.second;
 
-            if (wss_session->_ws_handshaked)
-                wss_session->SendAsync(buffer, size);
+        if (!ws_session._ws_deflate.IsInitialized())
+            ws_session.SendAsync(frame->data(), frame->size());
+        else if (ws_session._ws_deflate.options().server_no_context_takeover)
+        {
+            // Sessions without context takeover share the compressed frame
+            int window_bits = ws_session._ws_deflate.options().server_max_window_bits;
+            auto& compressed = compressed_frames[window_bits];
+            if (!compressed)
+            {
+                if (WSDeflate::CompressOnce(buffer, size, window_bits, _ws_deflate_options.level, payload))
+                    compressed = PrepareSharedFrame(opcode | WS_RSV1, payload.data(), payload.size());
+                else
+                    compressed = frame;
+            }
+            ws_session.SendAsync(compressed->data(), compressed->size());
+        }
+        else
+        {
+            // Sessions with context takeover compress the message with their own context
+            ws_session.SendFrameAsync(opcode, buffer, size, status);
         }
     }
 
     return true;
 }
 
+void WSSServer::RegisterWSSession(const std::shared_ptr<WSSSession>& session)
+{
+    std::unique_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Register a new handshaked WebSocket session
+    _ws_sessions.emplace(session->id(), session);
+}
+
+void WSSServer::UnregisterWSSession(const CppCommon::UUID& id)
+{
+    std::unique_lock<std::shared_mutex> locker(_ws_sessions_lock);
+
+    // Unregister WebSocket session by Id
+    _ws_sessions.erase(id);
+}
+
 } // namespace WS
 } // namespace CppServer
@@ -4,13 +4,20 @@
 
 #include "test.h"
 
+#include "server/http/hpack.h"
+#include "server/http/http2.h"
 #include "server/http/http_client.h"
+#include "server/http/http_client_pool.h"
+#include "server/http/http_message_pool.h"
+#include "server/http/http_response_template.h"
 #include "server/http/http_server.h"
 #include "string/string_utils.h"
 #include "threads/thread.h"
 
+#include <chrono>
 #include <map>
 #include <mutex>
+#include <vector>
 
 using namespace CppCommon;
 using namespace CppServer::Asio;
@@ -85,6 +92,21 @@ public:
 protected:
     void onReceivedRequest(const HTTPRequest& request) override
     {
+        // Process special test URLs
+        if (request.url() == "/chunked")
+        {
+            SendAsync("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6;ext=1\r\n world\r\n0\r\n\r\n");
+            return;
+        }
+        if (request.url() == "/hang")
+            return;
+        if (request.url() == "/head")
+        {
+            // Response with a body which must be dropped for HEAD requests over HTTP/2
+            SendResponseAsync(response().MakeGetResponse("head"));
+            return;
+        }
+
         // Process HTTP request methods
         if (request.method() == "HEAD")
             SendResponseAsync(response().MakeHeadResponse());
@@ -248,4 +270,464 @@ TEST_CASE("HTTP server & client test", "[CppServer][HTTP]")
     REQUIRE(service->Stop());
     while (service->IsStarted())
         Thread::Yield();
-}
\ No newline at end of file
+}
+
+TEST_CASE("HTTP client pool test", "[CppServer][HTTP]")
+{
+    // HTTP server address and port
+    std::string address = "127.0.0.1";
+    int port = 8082;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start HTTP server
+    auto server = std::make_shared<HTTPCacheServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create HTTP client pool with two connections per host
+    auto pool = std::make_shared<HTTPClientPool>(service, 2);
+
+    HTTPRequest request;
+    REQUIRE(pool->SendRequest(address, port, request.MakePostRequest("/pool", "value"), CppCommon::Timespan::seconds(10)).get().status() == 200);
+
+    // Send concurrent requests over the pooled connections
+    std::vector<std::future<HTTPResponse>> futures;
+    for (size_t i = 0; i < 10; ++i)
+        futures.push_back(pool->SendRequest(address, port, request.MakeGetRequest("/pool"), CppCommon::Timespan::seconds(10)));
+    for (auto& future : futures)
+    {
+        auto response = future.get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == "value");
+    }
+    REQUIRE(pool->connections() <= 2);
+    REQUIRE(pool->requests() == 0);
+
+    // Receive chunked responses over the kept alive connections
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto response = pool->SendRequest(address, port, request.MakeGetRequest("/chunked"), CppCommon::Timespan::seconds(10)).get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == "hello world");
+    }
+    REQUIRE(pool->connections() <= 2);
+
+    // Clear HTTP client pool
+    pool->Clear();
+    REQUIRE(pool->connections() == 0);
+
+    // Check the timeout of the request waiting for a free connection
+    auto single = std::make_shared<HTTPClientPool>(service, 1);
+    auto hang = single->SendRequest(address, port, request.MakeGetRequest("/hang"), CppCommon::Timespan::seconds(10));
+    auto queued = single->SendRequest(address, port, request.MakeGetRequest("/pool"), CppCommon::Timespan::milliseconds(100));
+    REQUIRE(queued.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE_THROWS(queued.get());
+    single->Clear();
+    REQUIRE_THROWS(hang.get());
+
+    // Stop the HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("HTTP response template test", "[CppServer][HTTP]")
+{
+    // Pre-render HTTP response template
+    auto response_template = HTTPResponseTemplate(200).SetContentType(".json").SetHeader("Cache-Control", "no-cache").SetDate();
+
+    // Make HTTP responses from the template
+    HTTPResponse response;
+    for (const std::string& content : { "{}", "{\"key\":\"value\"}" })
+    {
+        response.MakeResponse(response_template, content);
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.status_phrase() == "OK");
+        REQUIRE(response.protocol() == "HTTP/1.1");
+        REQUIRE(response.headers() == 4);
+        REQUIRE(std::get<0>(response.header(0)) == "Content-Type");
+        REQUIRE(std::get<1>(response.header(0)) == "application/json");
+        REQUIRE(std::get<0>(response.header(1)) == "Cache-Control");
+        REQUIRE(std::get<0>(response.header(2)) == "Date");
+        REQUIRE(std::get<1>(response.header(2)).size() == 29);
+        REQUIRE(std::get<1>(response.header(2)).substr(25) == " GMT");
+        REQUIRE(std::get<0>(response.header(3)) == "Content-Length");
+        REQUIRE(response.body() == content);
+    }
+
+    // Modify the shared template copy
+    auto response_template_copy = response_template;
+    response_template_copy.SetHeader("X-Custom", "value");
+    REQUIRE(response_template.response().headers() == 2);
+    REQUIRE(response_template_copy.response().headers() == 3);
+}
+
+TEST_CASE("HTTP response content type test", "[CppServer][HTTP]")
+{
+    REQUIRE(HTTPResponse::FindContentType(".html") == "text/html");
+    REQUIRE(HTTPResponse::FindContentType(".HTML") == "text/html");
+    REQUIRE(HTTPResponse::FindContentType(".Json") == "application/json");
+    REQUIRE(HTTPResponse::FindContentType(".h264") == "video/H264");
+    REQUIRE(HTTPResponse::FindContentType(".unknown").empty());
+    REQUIRE(HTTPResponse::FindContentType("").empty());
+
+    HTTPResponse response;
+    response.SetBegin(200).SetContentType(".PNG");
+    REQUIRE(response.headers() == 1);
+    REQUIRE(std::get<1>(response.header(0)) == "image/png");
+}
+
+TEST_CASE("HTTP message pool test", "[CppServer][HTTP]")
+{
+    HTTPRequestPool pool(1, 1024);
+
+    const char* data = nullptr;
+    {
+        auto request = pool.Acquire();
+        REQUIRE(request->empty());
+        request->MakeGetRequest("/test");
+        data = request->cache().data();
+    }
+    REQUIRE(pool.size() == 1);
+
+    // Released request should be reused with the retained capacity
+    auto request = pool.Acquire();
+    REQUIRE(pool.size() == 0);
+    REQUIRE(request->empty());
+    REQUIRE(request->cache().capacity() >= 1024);
+    request->MakeGetRequest("/test");
+    REQUIRE(request->cache().data() == data);
+}
+
+class HTTP2TestClient : public TCPClient, protected HTTP2
+{
+public:
+    using TCPClient::TCPClient;
+
+    uint32_t Request(const HTTPRequest& request) { return SendHTTP2Request(request); }
+
+    std::mutex lock;
+    std::map<uint32_t, HTTPResponse> responses;
+
+protected:
+    void onConnected() override { StartHTTP2Client(); }
+    void onDisconnected() override { ClearHTTP2(); }
+    void onReceived(const void* buffer, size_t size) override { PrepareReceiveHTTP2(buffer, size); }
+
+    void onHTTP2Response(uint32_t stream, HTTPResponse& response) override
+    {
+        std::scoped_lock locker(lock);
+        responses[stream] = response;
+    }
+
+    void onHTTP2Error(const std::string& message) override { FAIL(message); }
+
+    bool SendHTTP2(const void* buffer, size_t size) override { return SendAsync(buffer, size); }
+};
+
+TEST_CASE("HTTP/2 server HEAD test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8085;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start HTTP server with HTTP/2 support
+    auto server = std::make_shared<HTTPCacheServer>(service, port);
+    server->SetupHTTP2(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect HTTP/2 client with the prior knowledge
+    auto client = std::make_shared<HTTP2TestClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send GET and HEAD requests to the same resource
+    HTTPRequest request;
+    uint32_t get = client->Request(request.MakeGetRequest("/head"));
+    uint32_t head = client->Request(request.MakeHeadRequest("/head"));
+    REQUIRE(get != 0);
+    REQUIRE(head != 0);
+    while (true)
+    {
+        {
+            std::scoped_lock locker(client->lock);
+            if (client->responses.size() == 2)
+                break;
+        }
+        Thread::Yield();
+    }
+
+    // Check the HEAD response has no body
+    {
+        std::scoped_lock locker(client->lock);
+        REQUIRE(client->responses[get].status() == 200);
+        REQUIRE(client->responses[get].body() == "head");
+        REQUIRE(client->responses[head].status() == 200);
+        REQUIRE(client->responses[head].body().empty());
+    }
+
+    // Disconnect the HTTP/2 client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+class HTTPDetachSession : public HTTPSession
+{
+public:
+    using HTTPSession::HTTPSession;
+
+    static std::mutex lock;
+    static std::vector<HTTPRequestPool::Pointer> requests;
+
+protected:
+    void onReceivedRequest(const HTTPRequest& request) override
+    {
+        auto detached = DetachRequest();
+        REQUIRE(request.empty());
+        SendResponseAsync(response().MakeGetResponse(detached->body()));
+        std::scoped_lock locker(lock);
+        requests.emplace_back(std::move(detached));
+    }
+};
+
+std::mutex HTTPDetachSession::lock;
+std::vector<HTTPRequestPool::Pointer> HTTPDetachSession::requests;
+
+class HTTPDetachServer : public HTTPServer
+{
+public:
+    using HTTPServer::HTTPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override
+    {
+        return std::make_shared<HTTPDetachSession>(std::dynamic_pointer_cast<HTTPServer>(server));
+    }
+};
+
+class HTTPDetachClient : public HTTPClient
+{
+public:
+    using HTTPClient::HTTPClient;
+
+    std::mutex lock;
+    std::vector<HTTPResponsePool::Pointer> responses;
+
+protected:
+    void onReceivedResponse(const HTTPResponse& response) override
+    {
+        auto detached = DetachResponse();
+        REQUIRE(response.empty());
+        std::scoped_lock locker(lock);
+        responses.emplace_back(std::move(detached));
+    }
+};
+
+TEST_CASE("HTTP detach message test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8084;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start HTTP server
+    auto server = std::make_shared<HTTPDetachServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect HTTP client
+    auto client = std::make_shared<HTTPDetachClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send requests one by one, so every detached message is followed by the next receive
+    HTTPRequest request;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(client->SendRequestAsync(request.MakePostRequest("/detach", "value" + std::to_string(i))));
+        while (true)
+        {
+            {
+                std::scoped_lock locker(client->lock);
+                if (client->responses.size() == (i + 1))
+                    break;
+            }
+            Thread::Yield();
+        }
+    }
+
+    // Check detached messages survived the next session and client receive
+    {
+        std::scoped_lock locker(HTTPDetachSession::lock);
+        REQUIRE(HTTPDetachSession::requests.size() == 3);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            REQUIRE(HTTPDetachSession::requests[i]->url() == "/detach");
+            REQUIRE(HTTPDetachSession::requests[i]->body() == ("value" + std::to_string(i)));
+        }
+        HTTPDetachSession::requests.clear();
+    }
+    {
+        std::scoped_lock locker(client->lock);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            REQUIRE(client->responses[i]->status() == 200);
+            REQUIRE(client->responses[i]->body() == ("value" + std::to_string(i)));
+        }
+        client->responses.clear();
+    }
+
+    // Disconnect the HTTP client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("HPACK test", "[CppServer][HTTP]")
+{
+    // RFC 7541 C.4.1 Huffman encoding
+    std::vector<uint8_t> buffer;
+    HPACK::EncodeHuffman(buffer, "www.example.com");
+    REQUIRE(buffer == std::vector<uint8_t>({ 0xF1, 0xE3, 0xC2, 0xE5, 0xF2, 0x3A, 0x6B, 0xA0, 0xAB, 0x90, 0xF4, 0xFF }));
+    std::string value;
+    REQUIRE(HPACK::DecodeHuffman(buffer.data(), buffer.size(), value));
+    REQUIRE(value == "www.example.com");
+
+    // RFC 7541 C.3.1 request header block
+    const uint8_t block[] = { 0x82, 0x86, 0x84, 0x41, 0x0F, 0x77, 0x77, 0x77, 0x2E, 0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x2E, 0x63, 0x6F, 0x6D };
+    HPACKDecoder decoder;
+    std::vector<HPACKHeader> headers;
+    REQUIRE(decoder.Decode(block, sizeof(block), headers));
+    REQUIRE(headers.size() == 4);
+    REQUIRE(headers[0] == HPACKHeader(":method", "GET"));
+    REQUIRE(headers[1] == HPACKHeader(":scheme", "http"));
+    REQUIRE(headers[2] == HPACKHeader(":path", "/"));
+    REQUIRE(headers[3] == HPACKHeader(":authority", "www.example.com"));
+    REQUIRE(decoder.entries() == 1);
+    REQUIRE(decoder.table_size() == 57);
+
+    // Encode and decode header fields
+    buffer.clear();
+    HPACK::EncodeHeader(buffer, ":status", "200");
+    REQUIRE(buffer == std::vector<uint8_t>({ 0x88 }));
+    HPACK::EncodeHeader(buffer, "content-type", "text/plain; charset=UTF-8");
+    HPACK::EncodeHeader(buffer, "x-custom", "value", true);
+    headers.clear();
+    REQUIRE(decoder.Decode(buffer.data(), buffer.size(), headers));
+    REQUIRE(headers.size() == 3);
+    REQUIRE(headers[0] == HPACKHeader(":status", "200"));
+    REQUIRE(headers[1] == HPACKHeader("content-type", "text/plain; charset=UTF-8"));
+    REQUIRE(headers[2] == HPACKHeader("x-custom", "value"));
+    REQUIRE(decoder.entries() == 1);
+}
+
+class HTTP2Loopback : public HTTP2
+{
+public:
+    std::vector<uint8_t> output;
+    std::map<uint32_t, HTTPResponse> responses;
+
+protected:
+    void onHTTP2Request(uint32_t stream, HTTPRequest& request) override
+    {
+        HTTPResponse response;
+        if (request.method() == "POST")
+            response.MakeGetResponse(request.body());
+        else if (request.url() == "/large")
+            response.MakeGetResponse(std::string(2000000, 'x'));
+        else
+            response.MakeGetResponse(request.url());
+        REQUIRE(SendHTTP2Response(stream, response));
+    }
+
+    void onHTTP2Response(uint32_t stream, HTTPResponse& response) override { responses[stream] = response; }
+    void onHTTP2Error(const std::string& message) override { FAIL(message); }
+
+    bool SendHTTP2(const void* buffer, size_t size) override
+    {
+        output.insert(output.end(), (const uint8_t*)buffer, (const uint8_t*)buffer + size);
+        return true;
+    }
+};
+
+TEST_CASE("HTTP/2 protocol test", "[CppServer][HTTP]")
+{
+    HTTP2Loopback server;
+    HTTP2Loopback client;
+    server.StartHTTP2Server();
+    client.StartHTTP2Client();
+
+    // Send multiplexed HTTP/2 requests
+    HTTPRequest request;
+    uint32_t stream1 = client.SendHTTP2Request(request.MakeGetRequest("/test"));
+    uint32_t stream2 = client.SendHTTP2Request(request.MakePostRequest("/echo", "payload"));
+    uint32_t stream3 = client.SendHTTP2Request(request.MakeGetRequest("/large"));
+    REQUIRE(stream1 == 1);
+    REQUIRE(stream2 == 3);
+    REQUIRE(stream3 == 5);
+
+    // Exchange HTTP/2 frames until both sides are idle
+    while (!client.output.empty() || !server.output.empty())
+    {
+        std::vector<uint8_t> buffer;
+        buffer.swap(client.output);
+        server.PrepareReceiveHTTP2(buffer.data(), buffer.size());
+        buffer.clear();
+        buffer.swap(server.output);
+        client.PrepareReceiveHTTP2(buffer.data(), buffer.size());
+    }
+
+    REQUIRE(client.responses.size() == 3);
+    REQUIRE(client.responses[stream1].status() == 200);
+    REQUIRE(client.responses[stream1].body() == "/test");
+    REQUIRE(client.responses[stream2].body() == "payload");
+    REQUIRE(client.responses[stream3].body().size() == 2000000);
+    REQUIRE(client.http2_streams() == 0);
+    REQUIRE(server.http2_streams() == 0);
+}
@@ -5,12 +5,17 @@
 #include "test.h"
 
 #include "server/http/https_client.h"
+#include "server/http/https_client_pool.h"
 #include "server/http/https_server.h"
 #include "string/string_utils.h"
 #include "threads/thread.h"
 
+#include <cstdio>
+#include <fstream>
+#include <future>
 #include <map>
 #include <mutex>
+#include <vector>
 
 using namespace CppCommon;
 using namespace CppServer::Asio;
@@ -77,6 +82,9 @@ private:
     std::map<std::string, std::string, std::less<>> _cache;
 };
 
+// Static file served by HTTPS sessions
+const std::string static_file = "test_https_static.txt";
+
 class HTTPSCacheSession : public HTTPSSession
 {
 public:
@@ -88,6 +96,12 @@ protected:
         // Process HTTP request methods
         if (request.method() == "HEAD")
             SendResponseAsync(response().MakeHeadResponse());
+        else if ((request.method() == "GET") && (request.url() == "/static"))
+        {
+            // Response with the static file
+            if (SendResponseFile(static_file) == 0)
+                SendResponseAsync(response().MakeErrorResponse(404, "Static file was not found"));
+        }
         else if (request.method() == "GET")
         {
             std::string key(request.url());
@@ -253,3 +267,121 @@ TEST_CASE("HTTPS server & client test", "[CppServer][HTTP]")
     while (service->IsStarted())
         Thread::Yield();
 }
+
+TEST_CASE("HTTPS static file test", "[CppServer][HTTP]")
+{
+    // HTTPS server address and port
+    std::string address = "127.0.0.1";
+    int port = 8448;
+
+    // Create the static file larger than a single TLS record
+    std::string content;
+    for (size_t i = 0; i < 100000; ++i)
+        content.push_back((char)('a' + (i % 26)));
+    {
+        std::ofstream file(static_file, std::ios::binary);
+        file.write(content.data(), (std::streamsize)content.size());
+    }
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context
+    auto server_context = HTTPSCacheServer::CreateContext();
+
+    // Create and start HTTPS server with kernel TLS offload (falls back to the SSL stream if not supported)
+    auto server = std::make_shared<HTTPSCacheServer>(service, server_context, port);
+    server->SetupKTLS(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context
+    auto client_context = HTTPSCacheServer::CreateContext();
+
+    // Create a new HTTPS client
+    auto client = std::make_shared<HTTPSClientEx>(service, client_context, address, port);
+
+    // Get the static file twice over the same connection
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto response = client->SendGetRequest("/static").get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == content);
+    }
+
+    // Stop the HTTPS server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    std::remove(static_file.c_str());
+}
+
+TEST_CASE("HTTPS client pool test", "[CppServer][HTTP]")
+{
+    // HTTPS server address and port
+    std::string address = "127.0.0.1";
+    int port = 8447;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context
+    auto server_context = HTTPSCacheServer::CreateContext();
+
+    // Create and start HTTPS server
+    auto server = std::make_shared<HTTPSCacheServer>(service, server_context, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create HTTPS client pool with two connections per host and the shared SSL context
+    auto client_context = HTTPSCacheServer::CreateContext();
+    auto pool = std::make_shared<HTTPSClientPool>(service, client_context, 2);
+
+    HTTPRequest request;
+    REQUIRE(pool->SendRequest(address, port, request.MakePostRequest("/pool", "value"), CppCommon::Timespan::seconds(10)).get().status() == 200);
+
+    // Send concurrent requests over the pooled connections
+    std::vector<std::future<HTTPResponse>> futures;
+    for (size_t i = 0; i < 10; ++i)
+        futures.push_back(pool->SendRequest(address, port, request.MakeGetRequest("/pool"), CppCommon::Timespan::seconds(10)));
+    for (auto& future : futures)
+    {
+        auto response = future.get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == "value");
+    }
+    REQUIRE(pool->connections() <= 2);
+    REQUIRE(pool->requests() == 0);
+
+    // Check the SSL handshake was performed once per pooled connection
+    REQUIRE(client_context->handshakes() >= 1);
+    REQUIRE(client_context->handshakes() <= 2);
+
+    // Clear HTTPS client pool
+    pool->Clear();
+    REQUIRE(pool->connections() == 0);
+
+    // Stop the HTTPS server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
@@ -8,10 +8,12 @@
 #include "server/asio/tcp_server.h"
 #include "threads/thread.h"
 
+#include "../proto/fbe_extensions.h"
 #include "../proto/simple_protocol.h"
 
 #include <atomic>
 #include <chrono>
+#include <string_view>
 #include <vector>
 
 using namespace CppCommon;
@@ -114,6 +116,122 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class ProtoViewSession : public TCPSession, public FBE::simple::Sender, public FBE::simple::Proxy
+{
+public:
+    using TCPSession::TCPSession;
+
+protected:
+    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); }
+    size_t onSend(const void* data, size_t size) override { return SendAsync(data, size) ? size : 0; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+protected:
+    // Protocol handlers
+    void onProxy(FBE::simple::SimpleRequestModel& model, size_t type, const void* data, size_t size) override
+    {
+        // Read the request view over the received bytes
+        std::string_view message = FBE::GetStringView(model.buffer(), model.model.Message);
+
+        // Send response
+        simple::SimpleResponse response;
+        model.model.id.get(response.id);
+        response.Hash = (message.find_first_not_of('x') == std::string_view::npos) ? 0 : 1;
+        response.Length = (uint32_t)message.size();
+        send(response);
+    }
+
+public:
+    std::atomic<bool> errors{false};
+};
+
+class ProtoViewServer : public ProtoServer
+{
+public:
+    using ProtoServer::ProtoServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override { return std::make_shared<ProtoViewSession>(server); }
+};
+
+class ProtoBatchClient : public TCPClient, public FBE::BatchSender<FBE::simple::Client>
+{
+public:
+    using TCPClient::TCPClient;
+
+    size_t Flush() { std::scoped_lock locker(this->_lock); return flush(); }
+
+protected:
+    void onConnected() override { reset(); connected = true; }
+    size_t onFlush(const void* data, size_t size) override { ++sends; return SendAsync(data, size) ? size : 0; }
+    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<size_t> sends{0};
+    std::atomic<bool> errors{false};
+};
+
+class ProtoBatchSession : public TCPSession, public FBE::BatchSender<FBE::simple::Sender>, public FBE::simple::Receiver
+{
+public:
+    ProtoBatchSession(const std::shared_ptr<TCPServer>& server, std::atomic<size_t>& sends) : TCPSession(server), _sends(sends) { batch(4096); }
+
+protected:
+    void onReceived(const void* buffer, size_t size) override { receive(buffer, size); }
+    size_t onFlush(const void* data, size_t size) override { ++_sends; return SendAsync(data, size) ? size : 0; }
+
+    void onBatch() override
+    {
+        // Flush the batch once the current receive handler is done
+        auto self(this->shared_from_this());
+        auto flush_handler = [this, self]() { flush(); };
+        if (server()->service()->IsStrandRequired())
+            asio::post(strand(), flush_handler);
+        else
+            asio::post(*io_service(), flush_handler);
+    }
+
+protected:
+    // Protocol handlers
+    void onReceive(const ::simple::SimpleRequest& request) override
+    {
+        // Send response
+        simple::SimpleResponse response;
+        response.id = request.id;
+        response.Hash = 0;
+        response.Length = (uint32_t)request.Message.size();
+        send(response);
+    }
+
+private:
+    std::atomic<size_t>& _sends;
+};
+
+class ProtoBatchSender : public FBE::BatchSender<FBE::simple::Sender>
+{
+protected:
+    size_t onFlush(const void* data, size_t size) override { return accept ? size : 0; }
+    void onBatch() override { ++batches; }
+
+public:
+    bool accept{false};
+    size_t batches{0};
+};
+
+class ProtoBatchServer : public ProtoServer
+{
+public:
+    using ProtoServer::ProtoServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override { return std::make_shared<ProtoBatchSession>(server, sends); }
+
+public:
+    std::atomic<size_t> sends{0};
+};
+
 } // namespace
 
 TEST_CASE("Protocol server test", "[CppServer][Proto]")
@@ -436,3 +554,159 @@ TEST_CASE("Protocol server random test", "[CppServer][Proto]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("Protocol server view test", "[CppServer][Proto]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 4445;
+
+    // Create and start Asio service
+    auto service = std::make_shared<ProtoService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start protocol server with view sessions
+    auto server = std::make_shared<ProtoViewServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect protocol client
+    auto client = std::make_shared<ProtoClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || !client->connected || (server->clients != 1))
+        Thread::Yield();
+
+    // Send contiguous and split requests to the protocol server
+    for (size_t size : { 4, 1000000 })
+    {
+        simple::SimpleRequest request;
+        request.Message = std::string(size, 'x');
+        auto response = client->request(request).get();
+        REQUIRE(response.id == request.id);
+        REQUIRE(response.Hash == 0);
+        REQUIRE(response.Length == size);
+    }
+
+    // Disconnect the protocol client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the protocol server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the protocol server state
+    REQUIRE(server->bytes_sent() > 0);
+    REQUIRE(server->bytes_received() > 1000000);
+    REQUIRE(!server->errors);
+
+    // Check the protocol client state
+    REQUIRE(client->bytes_received() > 0);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("Protocol server batch test", "[CppServer][Proto]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 4446;
+
+    // Create and start Asio service
+    auto service = std::make_shared<ProtoService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start protocol server with batch sessions
+    auto server = std::make_shared<ProtoBatchServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect protocol client
+    auto client = std::make_shared<ProtoBatchClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || !client->connected || (server->clients != 1))
+        Thread::Yield();
+
+    // Batch requests to the protocol server
+    client->batch(4096);
+    std::vector<simple::SimpleRequest> requests(1000);
+    std::vector<std::future<simple::SimpleResponse>> responses;
+    for (auto& request : requests)
+    {
+        request.Message = std::string(32, 'x');
+        responses.emplace_back(client->request(request));
+    }
+
+    // Flush the rest of batched requests, responses are flushed by the server automatically
+    client->Flush();
+
+    // Check responses
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        auto response = responses[i].get();
+        REQUIRE(response.id == requests[i].id);
+        REQUIRE(response.Length == 32);
+    }
+
+    // Disconnect the protocol client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the protocol server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the protocol server state
+    REQUIRE(server->bytes_sent() > 0);
+    REQUIRE(server->bytes_received() > 0);
+    REQUIRE(server->sends < requests.size());
+    REQUIRE(!server->errors);
+
+    // Check the protocol client state
+    REQUIRE(client->bytes_received() > 0);
+    REQUIRE(client->sends <= (client->bytes_sent() / 4096 + 1));
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("Protocol batch sender test", "[CppServer][Proto]")
+{
+    ProtoBatchSender sender;
+    sender.batch(4096);
+
+    simple::SimpleNotify notify;
+    notify.Notification = "test";
+
+    // The first kept message notifies about the new batch
+    REQUIRE(sender.send(notify) > 0);
+    REQUIRE(sender.send(notify) > 0);
+    REQUIRE(sender.batches == 1);
+
+    // Rejected messages are kept in the batch and the next message notifies again
+    REQUIRE(sender.flush() == 0);
+    REQUIRE(sender.send(notify) > 0);
+    REQUIRE(sender.batches == 2);
+
+    // Accepted flush sends all kept messages
+    sender.accept = true;
+    REQUIRE(sender.flush() > 0);
+    REQUIRE(sender.flush() == 0);
+    REQUIRE(sender.send(notify) > 0);
+    REQUIRE(sender.batches == 3);
+}
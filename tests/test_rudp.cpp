@@ -0,0 +1,307 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "server/asio/rudp_client.h"
+#include "server/asio/rudp_server.h"
+#include "threads/thread.h"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+namespace {
+
+class EchoRUDPClient : public RUDPClient
+{
+public:
+    EchoRUDPClient(const std::shared_ptr<Service>& service, const std::string& address, int port, uint32_t messages, size_t window, int loss)
+        : RUDPClient(service, address, port),
+          _messages(messages),
+          _window(window),
+          _loss(loss),
+          _sent(0),
+          _random(1)
+    {
+    }
+
+    bool SendAsync(const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        return ((int)(_random() % 100) < _loss) ? true : RUDPClient::SendAsync(buffer, size);
+    }
+
+protected:
+    void onConnected() override
+    {
+        RUDPClient::onConnected();
+        connected = true;
+        for (size_t i = 0; i < _window; ++i)
+            SendMessage();
+    }
+    void onDisconnected() override { RUDPClient::onDisconnected(); disconnected = true; }
+    void onReceivedMessage(const void* buffer, size_t size) override
+    {
+        uint32_t message;
+        std::memcpy(&message, buffer, sizeof(message));
+        if ((size != sizeof(message)) || (message != received))
+            errors = true;
+        ++received;
+        SendMessage();
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<uint32_t> received{0};
+    std::atomic<bool> errors{false};
+
+private:
+    uint32_t _messages;
+    size_t _window;
+    int _loss;
+    uint32_t _sent;
+    std::mt19937 _random;
+
+    void SendMessage()
+    {
+        if (_sent < _messages)
+        {
+            if (SendReliableAsync(&_sent, sizeof(_sent)))
+                ++_sent;
+        }
+    }
+};
+
+class EchoRUDPSession : public RUDPSession
+{
+public:
+    using RUDPSession::RUDPSession;
+
+protected:
+    void onReceivedMessage(const void* buffer, size_t size) override
+    {
+        // Keep the echoed messages which do not fit into the send window
+        _backlog.emplace_back((const uint8_t*)buffer, (const uint8_t*)buffer + size);
+        Flush();
+    }
+    void onDelivered(size_t messages) override { Flush(); }
+
+private:
+    std::deque<std::vector<uint8_t>> _backlog;
+
+    void Flush()
+    {
+        while (!_backlog.empty() && SendReliableAsync(_backlog.front().data(), _backlog.front().size()))
+            _backlog.pop_front();
+    }
+};
+
+class EchoRUDPServer : public RUDPServer
+{
+public:
+    EchoRUDPServer(const std::shared_ptr<Service>& service, int port, int loss)
+        : RUDPServer(service, port),
+          _loss(loss),
+          _random(2)
+    {
+    }
+
+    bool SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        return ((int)(_random() % 100) < _loss) ? true : RUDPServer::SendAsync(endpoint, buffer, size);
+    }
+
+protected:
+    std::shared_ptr<RUDPSession> CreateSession(const std::shared_ptr<RUDPServer>& server, const asio::ip::udp::endpoint& endpoint) override { return std::make_shared<EchoRUDPSession>(server, endpoint); }
+
+protected:
+    void onStarted() override { RUDPServer::onStarted(); started = true; }
+    void onStopped() override { RUDPServer::onStopped(); stopped = true; }
+    void onConnected(std::shared_ptr<RUDPSession>& session) override { ++connected; }
+    void onDisconnected(std::shared_ptr<RUDPSession>& session) override { ++disconnected; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<size_t> connected{0};
+    std::atomic<size_t> disconnected{0};
+    std::atomic<bool> errors{false};
+
+private:
+    int _loss;
+    std::mt19937 _random;
+};
+
+void TestRUDPEcho(int port, int loss)
+{
+    const std::string address = "127.0.0.1";
+    const uint32_t messages = 10000;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoRUDPServer>(service, port, loss);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoRUDPClient>(service, address, port, messages, 64, loss);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Wait for all echoed messages
+    while ((client->received != messages) && !client->errors && client->IsConnected())
+        Thread::Yield();
+    REQUIRE(client->received == messages);
+    if (loss > 0)
+        REQUIRE(client->channel().packets_retransmitted() > 0);
+
+    // Disconnect the client and wait for the reset session
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->disconnected != 1))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->connected == 1);
+    REQUIRE(server->disconnected == 1);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(!client->errors);
+}
+
+} // namespace
+
+TEST_CASE("Reliable UDP server test", "[CppServer][RUDP]")
+{
+    TestRUDPEcho(3347, 0);
+}
+
+TEST_CASE("Reliable UDP server loss test", "[CppServer][RUDP]")
+{
+    TestRUDPEcho(3348, 5);
+}
+
+TEST_CASE("Reliable UDP server max sessions test", "[CppServer][RUDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3349;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server limited to one session
+    auto server = std::make_shared<EchoRUDPServer>(service, port, 0);
+    server->SetupMaxSessions(1);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Connect the first Echo client and wait for all echoed messages
+    auto client1 = std::make_shared<EchoRUDPClient>(service, address, port, 10, 10, 0);
+    REQUIRE(client1->ConnectAsync());
+    while (client1->received != 10)
+        Thread::Yield();
+
+    // Connect the second Echo client and wait for the retransmission of the dropped message
+    auto client2 = std::make_shared<EchoRUDPClient>(service, address, port, 1, 1, 0);
+    REQUIRE(client2->ConnectAsync());
+    while (client2->channel().packets_retransmitted() == 0)
+        Thread::Yield();
+    REQUIRE(client2->received == 0);
+    REQUIRE(server->connected_sessions() == 1);
+
+    // Disconnect the Echo clients
+    REQUIRE(client1->DisconnectAsync());
+    REQUIRE(client2->DisconnectAsync());
+    while (client1->IsConnected() || client2->IsConnected() || (server->disconnected != 1))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->connected == 1);
+    REQUIRE(server->disconnected == 1);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("Reliable UDP channel epoch test", "[CppServer][RUDP]")
+{
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<std::string> received;
+    auto send = [&sent](const void* buffer, size_t size) { sent.emplace_back((const uint8_t*)buffer, (const uint8_t*)buffer + size); return true; };
+    auto receive = [&received](const void* buffer, size_t size) { received.emplace_back((const char*)buffer, size); };
+    auto deliver = [](size_t messages) {};
+
+    // Connecting and accepting channels
+    RUDPChannel client(send, [](const void* buffer, size_t size) {}, deliver);
+    RUDPChannel session([](const void* buffer, size_t size) { return true; }, receive, deliver);
+
+    // The accepting channel adopts the epoch of the first packet
+    client.Reset(1);
+    REQUIRE(client.Send("test", 4, true));
+    REQUIRE(sent.size() == 1);
+    REQUIRE(RUDPChannel::IsFirstPacket(sent[0].data(), sent[0].size()));
+    REQUIRE(RUDPChannel::PacketEpoch(sent[0].data()) == 1);
+    REQUIRE(session.Receive(sent[0].data(), sent[0].size()));
+    REQUIRE(session.epoch() == 1);
+    REQUIRE(received.size() == 1);
+    client.SendReset();
+    auto stale_reset = sent.back();
+    sent.clear();
+
+    // Packets and resets of another connection epoch are skipped
+    client.Reset(2);
+    REQUIRE(client.Send("next", 4, true));
+    REQUIRE(RUDPChannel::IsFirstPacket(sent[0].data(), sent[0].size()));
+    REQUIRE(RUDPChannel::PacketEpoch(sent[0].data()) == 2);
+    REQUIRE(session.Receive(sent[0].data(), sent[0].size()));
+    REQUIRE(received.size() == 1);
+    client.SendReset();
+    REQUIRE(session.Receive(sent.back().data(), sent.back().size()));
+
+    // Reset of the adopted connection epoch resets the channel
+    REQUIRE(!session.Receive(stale_reset.data(), stale_reset.size()));
+}
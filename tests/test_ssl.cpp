@@ -10,8 +10,20 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 using namespace CppCommon;
 using namespace CppServer::Asio;
 
@@ -39,6 +51,42 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class HandshakeSSLService : public Service
+{
+public:
+    using Service::Service;
+
+    bool IsServiceThread(std::thread::id id)
+    {
+        std::scoped_lock locker(_lock);
+        return _threads.find(id) != _threads.end();
+    }
+
+protected:
+    void onThreadInitialize() override
+    {
+        std::scoped_lock locker(_lock);
+        _threads.insert(std::this_thread::get_id());
+    }
+
+private:
+    std::mutex _lock;
+    std::set<std::thread::id> _threads;
+};
+
+// Threads which finished SSL handshakes
+std::mutex handshake_threads_lock;
+std::vector<std::thread::id> handshake_threads;
+
+void HandshakeInfoCallback(const SSL* ssl, int where, int ret)
+{
+    if ((where & SSL_CB_HANDSHAKE_DONE) != 0)
+    {
+        std::scoped_lock locker(handshake_threads_lock);
+        handshake_threads.push_back(std::this_thread::get_id());
+    }
+}
+
 class EchoSSLClient : public SSLClient
 {
 public:
@@ -108,7 +156,15 @@ protected:
     void onStarted() override { started = true; }
     void onStopped() override { stopped = true; }
     void onConnected(std::shared_ptr<SSLSession>& session) override { connected = true; }
-    void onHandshaked(std::shared_ptr<SSLSession>& session) override { handshaked = true; ++clients; }
+    void onHandshaked(std::shared_ptr<SSLSession>& session) override
+    {
+        handshaked = true;
+        ++clients;
+        if (session->IsKTLSSend())
+            ++ktls_send;
+        if (session->IsKTLSReceive())
+            ++ktls_receive;
+    }
     void onDisconnected(std::shared_ptr<SSLSession>& session) override { disconnected = true; --clients; }
     void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
 
@@ -119,9 +175,27 @@ public:
     std::atomic<bool> handshaked{false};
     std::atomic<bool> disconnected{false};
     std::atomic<size_t> clients{0};
+    std::atomic<size_t> ktls_send{0};
+    std::atomic<size_t> ktls_receive{0};
     std::atomic<bool> errors{false};
 };
 
+// Check if the kernel TLS upper layer protocol could be attached to a connected TCP socket
+bool IsKTLSSupported()
+{
+#if defined(__linux__) && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    asio::io_context io_service;
+    asio::ip::tcp::acceptor acceptor(io_service, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    asio::ip::tcp::socket client(io_service);
+    asio::ip::tcp::socket server(io_service);
+    client.connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+    return setsockopt(server.native_handle(), SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0;
+#else
+    return false;
+#endif
+}
+
 } // namespace
 
 TEST_CASE("SSL server test", "[CppServer][SSL]")
@@ -202,6 +276,241 @@ TEST_CASE("SSL server test", "[CppServer][SSL]")
     REQUIRE(!client->errors);
 }
 
+TEST_CASE("SSL server session resumption test", "[CppServer][SSL]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 2225;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoSSLService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context with session cache and tickets
+    auto server_context = EchoSSLServer::CreateContext();
+    server_context->set_session_cache();
+    server_context->set_session_tickets(true);
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoSSLServer>(service, server_context, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context with session reuse
+    auto client_context = EchoSSLClient::CreateContext();
+    client_context->set_session_reuse(true);
+
+    // Create Echo client
+    auto client = std::make_shared<EchoSSLClient>(service, client_context, address, port);
+
+    // Connect, exchange a message and disconnect several times
+    for (int i = 0; i < 3; ++i)
+    {
+        // Rotate ticket keys once, previous key tickets should be still accepted
+        if (i == 2)
+            server_context->rotate_session_ticket_keys();
+
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected() || !client->IsHandshaked() || (server->clients != 1))
+            Thread::Yield();
+
+        // Send a message to the Echo server and receive session tickets with the echo
+        client->SendAsync("test");
+        while (client->bytes_received() != 4)
+            Thread::Yield();
+
+        REQUIRE(client->DisconnectAsync());
+        while (client->IsConnected() || client->IsHandshaked() || (server->clients != 0))
+            Thread::Yield();
+    }
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the resumption statistic
+    REQUIRE(client_context->handshakes() == 3);
+    REQUIRE(client_context->handshakes_resumed() == 2);
+    REQUIRE(server_context->handshakes() == 3);
+    REQUIRE(server_context->handshakes_resumed() == 2);
+    REQUIRE(!server->errors);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("SSL server handshake service test", "[CppServer][SSL]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 2226;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoSSLService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Asio handshake service
+    auto handshake_service = std::make_shared<HandshakeSSLService>(2);
+    REQUIRE(handshake_service->Start());
+    while (!handshake_service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context which tracks handshake threads
+    auto server_context = EchoSSLServer::CreateContext();
+    SSL_CTX_set_info_callback(server_context->native_handle(), HandshakeInfoCallback);
+
+    // Create and start Echo server with the handshake service
+    auto server = std::make_shared<EchoSSLServer>(service, server_context, port);
+    server->SetupHandshakeService(handshake_service);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context
+    auto client_context = EchoSSLClient::CreateContext();
+
+    // Create and connect Echo clients
+    std::vector<std::shared_ptr<EchoSSLClient>> clients;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto client = std::make_shared<EchoSSLClient>(service, client_context, address, port);
+        REQUIRE(client->ConnectAsync());
+        clients.emplace_back(client);
+    }
+    for (const auto& client : clients)
+        while (!client->IsHandshaked())
+            Thread::Yield();
+    while (server->clients != 3)
+        Thread::Yield();
+
+    // Send messages to the Echo server
+    for (const auto& client : clients)
+        client->SendAsync("test");
+
+    // Wait for all data processed...
+    for (const auto& client : clients)
+        while (client->bytes_received() != 4)
+            Thread::Yield();
+
+    // Disconnect Echo clients
+    for (const auto& client : clients)
+        REQUIRE(client->DisconnectAsync());
+    while (server->clients != 0)
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio handshake service
+    REQUIRE(handshake_service->Stop());
+    while (handshake_service->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the handshake statistic
+    REQUIRE(server->handshakes_finished() == 3);
+    REQUIRE(server->handshakes_in_flight() == 0);
+    REQUIRE(server->handshakes_in_flight_max() >= 1);
+
+    // Check handshakes were performed by the handshake service threads
+    std::scoped_lock locker(handshake_threads_lock);
+    REQUIRE(handshake_threads.size() >= 3);
+    for (const auto& thread : handshake_threads)
+        REQUIRE(handshake_service->IsServiceThread(thread));
+    REQUIRE(server->handshake_latency() <= server->handshake_latency_max());
+    REQUIRE(server->bytes_received() == 12);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("SSL server kernel TLS test", "[CppServer][SSL]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 2227;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoSSLService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context
+    auto server_context = EchoSSLServer::CreateContext();
+
+    // Create and start Echo server with kernel TLS offload (falls back to the SSL stream if not supported)
+    auto server = std::make_shared<EchoSSLServer>(service, server_context, port);
+    server->SetupKTLS(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context
+    auto client_context = EchoSSLClient::CreateContext();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoSSLClient>(service, client_context, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || !client->IsHandshaked() || (server->clients != 1))
+        Thread::Yield();
+
+    // Send messages to the Echo server
+    client->SendAsync("test");
+    client->SendAsync("test");
+
+    // Wait for all data processed...
+    while (client->bytes_received() != 8)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || client->IsHandshaked() || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->bytes_sent() == 8);
+    REQUIRE(server->bytes_received() == 8);
+    REQUIRE(!server->errors);
+
+    // Check the session data path was offloaded if the kernel supports it
+    if (IsKTLSSupported())
+    {
+        REQUIRE(server->ktls_send == 1);
+        REQUIRE(server->ktls_receive == 1);
+    }
+    else
+    {
+        REQUIRE(server->ktls_send == 0);
+        REQUIRE(server->ktls_receive == 0);
+    }
+
+    // Check the Echo client state
+    REQUIRE(client->bytes_sent() == 8);
+    REQUIRE(client->bytes_received() == 8);
+    REQUIRE(!client->errors);
+}
+
 TEST_CASE("SSL server multicast test", "[CppServer][SSL]")
 {
     const std::string address = "127.0.0.1";
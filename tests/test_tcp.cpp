@@ -7,6 +7,7 @@
 #include "server/asio/tcp_client.h"
 #include "server/asio/tcp_server.h"
 #include "threads/thread.h"
+#include "time/timestamp.h"
 
 #include <atomic>
 #include <chrono>
@@ -96,6 +97,41 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class TimestampTCPServer : public EchoTCPServer
+{
+public:
+    using EchoTCPServer::EchoTCPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(const std::shared_ptr<TCPServer>& server) override;
+
+public:
+    std::atomic<size_t> timestamped{0};
+    std::atomic<bool> invalid{false};
+};
+
+class TimestampTCPSession : public EchoTCPSession
+{
+public:
+    using EchoTCPSession::EchoTCPSession;
+
+protected:
+    void onReceived(const void* buffer, size_t size) override
+    {
+        // Check the kernel receive timestamp
+        auto timestamp_server = std::static_pointer_cast<TimestampTCPServer>(server());
+        if (IsReceiveTimestamp())
+        {
+            ++timestamp_server->timestamped;
+            if ((receive_timestamp() == 0) || (receive_timestamp() > Timestamp::utc()))
+                timestamp_server->invalid = true;
+        }
+        EchoTCPSession::onReceived(buffer, size);
+    }
+};
+
+std::shared_ptr<TCPSession> TimestampTCPServer::CreateSession(const std::shared_ptr<TCPServer>& server) { return std::make_shared<TimestampTCPSession>(server); }
+
 } // namespace
 
 TEST_CASE("TCP server test", "[CppServer][TCP]")
@@ -421,3 +457,65 @@ TEST_CASE("TCP server random test", "[CppServer][TCP]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("TCP server receive timestamp test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1114;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server with receive timestamps
+    auto server = std::make_shared<TimestampTCPServer>(service, port);
+    server->SetupReceiveTimestamp(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client (data is sent after the session is connected, so all of it is timestamped)
+    auto client = std::make_shared<EchoTCPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || (server->clients != 1))
+        Thread::Yield();
+
+    // Send a bunch of messages to the Echo server
+    for (int i = 0; i < 100; ++i)
+    {
+        client->SendAsync("test");
+        while (client->bytes_received() != (size_t)(4 * (i + 1)))
+            Thread::Yield();
+    }
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+#if defined(__linux__)
+    REQUIRE(server->timestamped > 0);
+#endif
+    REQUIRE(!server->invalid);
+    REQUIRE(server->bytes_sent() == 400);
+    REQUIRE(server->bytes_received() == 400);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->bytes_sent() == 400);
+    REQUIRE(client->bytes_received() == 400);
+    REQUIRE(!client->errors);
+}
@@ -5,7 +5,14 @@
 #include "test.h"
 
 #include "server/asio/timer.h"
+#include "server/asio/timer_wheel.h"
 #include "threads/thread.h"
+#include "time/timestamp.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace CppCommon;
 using namespace CppServer::Asio;
@@ -81,3 +88,170 @@ TEST_CASE("Asio timer test", "[CppServer][Timer]")
     REQUIRE(timer->expired);
     REQUIRE(!timer->errors);
 }
+
+TEST_CASE("Asio timer in the timer wheel mode test", "[CppServer][Timer]")
+{
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create Asio timer planned in the timer wheel
+    auto timer = std::make_shared<AsioTimer>(service);
+    timer->SetupTimerWheel(true);
+    REQUIRE(timer->IsTimerWheel());
+
+    // Setup and asynchronously wait for the timer
+    timer->Setup(Timespan::milliseconds(500));
+    timer->WaitAsync();
+
+    // Wait for a while...
+    Thread::Sleep(1000);
+
+    // Setup and asynchronously wait for the timer
+    timer->Setup(Timespan::seconds(1));
+    timer->WaitAsync();
+
+    // Wait for a while...
+    Thread::Sleep(500);
+
+    // Cancel the timer
+    timer->Cancel();
+
+    // Wait for a while...
+    Thread::Sleep(500);
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the timer state
+    REQUIRE(timer->canceled);
+    REQUIRE(timer->expired);
+    REQUIRE(!timer->errors);
+}
+
+TEST_CASE("Asio timer wheel test", "[CppServer][Timer]")
+{
+    // Create the timer wheel driven manually
+    auto io_service = std::make_shared<asio::io_context>();
+    auto wheel = std::make_shared<TimerWheel>(io_service, Timespan::milliseconds(10));
+
+    int fired1 = 0;
+    int fired2 = 0;
+    int fired3 = 0;
+    int fired4 = 0;
+    TimerWheel::Handle handle1([&fired1]() { ++fired1; });
+    TimerWheel::Handle handle2([&fired2]() { ++fired2; });
+    TimerWheel::Handle handle3([&fired3]() { ++fired3; });
+    TimerWheel::Handle handle4;
+    handle4.Setup([&]() { ++fired4; wheel->Schedule(handle4, Timespan::milliseconds(50)); });
+
+    // Schedule handles into different levels of the timer wheel
+    uint64_t now = Timestamp::nano();
+    REQUIRE(wheel->Schedule(handle1, Timespan::milliseconds(100)));
+    REQUIRE(wheel->Schedule(handle2, Timespan::seconds(10)));
+    REQUIRE(wheel->Schedule(handle3, Timespan::hours(1)));
+    REQUIRE(wheel->Schedule(handle4, Timespan::milliseconds(50)));
+    REQUIRE(wheel->size() == 4);
+
+    // Nothing is expired before its timeout
+    REQUIRE(wheel->Expire(now + Timespan::milliseconds(40).total()) == 0);
+
+    // Cancel the handle
+    REQUIRE(wheel->Cancel(handle1));
+    REQUIRE(!handle1.IsScheduled());
+    REQUIRE(!wheel->Cancel(handle1));
+    REQUIRE(wheel->size() == 3);
+
+    // Rescheduled handle expires again
+    wheel->Expire(now + Timespan::seconds(1).total());
+    REQUIRE(fired4 == 1);
+    wheel->Expire(now + Timespan::seconds(2).total());
+    REQUIRE(fired4 == 2);
+
+    // Cascaded handles expire after their timeouts
+    wheel->Expire(now + Timespan::seconds(9).total());
+    REQUIRE(fired2 == 0);
+    wheel->Expire(now + Timespan::seconds(11).total());
+    REQUIRE(fired2 == 1);
+    wheel->Expire(now + Timespan::minutes(59).total());
+    REQUIRE(fired3 == 0);
+    wheel->Expire(now + Timespan::minutes(61).total());
+    REQUIRE(fired3 == 1);
+
+    REQUIRE(fired1 == 0);
+    REQUIRE(wheel->size() == 1);
+    REQUIRE(wheel->Cancel(handle4));
+    REQUIRE(wheel->size() == 0);
+}
+
+TEST_CASE("Asio timer wheel actions test", "[CppServer][Timer]")
+{
+    // Create the timer wheel driven manually
+    auto io_service = std::make_shared<asio::io_context>();
+    auto wheel = std::make_shared<TimerWheel>(io_service, Timespan::milliseconds(10));
+
+    // Action copies are counted by its captured counter
+    struct Counter
+    {
+        int* copies;
+        explicit Counter(int* c) : copies(c) {}
+        Counter(const Counter& other) : copies(other.copies) { ++*copies; }
+    };
+
+    int copies = 0;
+    int fired = 0;
+    Counter counter(&copies);
+    TimerWheel::Handle handle;
+    handle.Setup([&, counter]() { ++fired; wheel->Schedule(handle, Timespan::milliseconds(10)); });
+    copies = 0;
+
+    // Expired action is called in place and kept in its rearmed handle
+    uint64_t now = Timestamp::nano();
+    REQUIRE(wheel->Schedule(handle, Timespan::milliseconds(10)));
+    wheel->Expire(now + Timespan::milliseconds(100).total());
+    REQUIRE(fired == 1);
+    wheel->Expire(now + Timespan::milliseconds(200).total());
+    REQUIRE(fired == 2);
+    REQUIRE(copies == 0);
+    REQUIRE(handle.IsScheduled());
+    REQUIRE(wheel->Cancel(handle));
+
+    // Handle could be destroyed by its own action
+    auto owned = std::make_unique<TimerWheel::Handle>();
+    owned->Setup([&owned]() { owned.reset(); });
+    REQUIRE(wheel->Schedule(*owned, Timespan::milliseconds(10)));
+    REQUIRE(wheel->Expire(now + Timespan::seconds(1).total()) == 1);
+    REQUIRE(!owned);
+    REQUIRE(wheel->size() == 0);
+}
+
+TEST_CASE("Asio timer wheel handles destruction test", "[CppServer][Timer]")
+{
+    // Create the timer wheel driven by its Asio IO service thread
+    auto io_service = std::make_shared<asio::io_context>();
+    auto wheel = std::make_shared<TimerWheel>(io_service, Timespan::milliseconds(1));
+
+    std::atomic<int> fired{0};
+    std::vector<std::unique_ptr<TimerWheel::Handle>> handles;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        handles.emplace_back(std::make_unique<TimerWheel::Handle>([&fired]() { ++fired; }));
+        REQUIRE(wheel->Schedule(*handles.back(), Timespan::milliseconds(i % 20)));
+    }
+
+    // Destroy half of handles while the timer wheel expires them
+    std::thread thread([&io_service]() { io_service->run(); });
+    for (size_t i = 0; i < handles.size(); i += 2)
+        handles[i].reset();
+    thread.join();
+
+    // Check the timer wheel state
+    REQUIRE(wheel->size() == 0);
+    REQUIRE(fired >= 500);
+    for (size_t i = 1; i < handles.size(); i += 2)
+        REQUIRE(!handles[i]->IsScheduled());
+}
@@ -5,11 +5,16 @@
 #include "test.h"
 
 #include "server/asio/udp_client.h"
-#include "server/asio/udp_server.h"
+#include "server/asio/udp_sharded_server.h"
 #include "threads/thread.h"
+#include "time/timestamp.h"
 
 #include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 using namespace CppCommon;
@@ -74,6 +79,192 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class BatchUDPServer : public EchoUDPServer
+{
+public:
+    using EchoUDPServer::EchoUDPServer;
+
+protected:
+    void onReceivedBatch(const ReceivedDatagram* datagrams, size_t count) override
+    {
+        if (count > max_batch)
+            max_batch = count;
+        EchoUDPServer::onReceivedBatch(datagrams, count);
+    }
+
+public:
+    std::atomic<size_t> max_batch{0};
+};
+
+class OffloadUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+protected:
+    void onStarted() override { ReceiveAsync(); }
+    void onReceivedBatch(const ReceivedDatagram* datagrams, size_t count) override
+    {
+        // Split coalesced datagrams are adjacent in the same receive buffer
+        for (size_t i = 1; i < count; ++i)
+            if (datagrams[i].buffer == (datagrams[i - 1].buffer + datagrams[i - 1].size))
+                ++coalesced;
+        UDPServer::onReceivedBatch(datagrams, count);
+        ReceiveAsync();
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<size_t> coalesced{0};
+    std::atomic<bool> errors{false};
+};
+
+class QueueUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+protected:
+    void onStarted() override { ReceiveAsync(); }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Queue a bunch of replies without waiting for the sent notifications
+        for (int i = 0; i < 100; ++i)
+            if (!SendAsync(endpoint, buffer, size))
+                rejected = true;
+        ReceiveAsync();
+    }
+    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override { if (sent > 0) ++sent_notifications; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<size_t> sent_notifications{0};
+    std::atomic<bool> rejected{false};
+    std::atomic<bool> errors{false};
+};
+
+class LimitUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+protected:
+    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override { if (sent > 0) ++sent_notifications; }
+    void onError(int error, const std::string& category, const std::string& message) override { ++errors; }
+
+public:
+    std::atomic<size_t> sent_notifications{0};
+    std::atomic<size_t> errors{0};
+};
+
+class PooledUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+    std::vector<DatagramBuffer> TakeDatagrams()
+    {
+        std::vector<DatagramBuffer> datagrams;
+        std::scoped_lock locker(_lock);
+        datagrams.swap(_datagrams);
+        return datagrams;
+    }
+
+protected:
+    void onStarted() override { ReceiveAsync(); }
+    void onReceivedBuffer(const asio::ip::udp::endpoint& endpoint, const DatagramBuffer& buffer) override
+    {
+        // Continue receive before keeping the pooled datagram, so the next receive must not reuse it
+        ReceiveAsync();
+
+        // Keep the pooled datagram for the worker thread
+        std::scoped_lock locker(_lock);
+        _datagrams.push_back(buffer);
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> errors{false};
+
+private:
+    std::mutex _lock;
+    std::vector<DatagramBuffer> _datagrams;
+};
+
+class TimestampUDPClient : public UDPClient
+{
+public:
+    using UDPClient::UDPClient;
+
+protected:
+    void onConnected() override { ReceiveAsync(); }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Check the kernel receive timestamp
+        if (IsReceiveTimestamp() && ((receive_timestamp() == 0) || (receive_timestamp() > Timestamp::utc())))
+            invalid = true;
+        ReceiveAsync();
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> invalid{false};
+    std::atomic<bool> errors{false};
+};
+
+class TimestampUDPServer : public EchoUDPServer
+{
+public:
+    using EchoUDPServer::EchoUDPServer;
+
+protected:
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Check the kernel receive timestamp
+        if (IsReceiveTimestamp() && ((receive_timestamp() == 0) || (receive_timestamp() > Timestamp::utc())))
+            invalid = true;
+        EchoUDPServer::onReceived(endpoint, buffer, size);
+    }
+
+public:
+    std::atomic<bool> invalid{false};
+};
+
+class EchoUDPShardedServer : public UDPShardedServer
+{
+public:
+    using UDPShardedServer::UDPShardedServer;
+
+protected:
+    std::shared_ptr<UDPServer> CreateShard(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint) override { return std::make_shared<EchoUDPServer>(service, endpoint); }
+};
+
+class FailUDPServer : public EchoUDPServer
+{
+public:
+    using EchoUDPServer::EchoUDPServer;
+
+    bool Start() override { return false; }
+};
+
+class FailUDPShardedServer : public UDPShardedServer
+{
+public:
+    using UDPShardedServer::UDPShardedServer;
+
+protected:
+    std::shared_ptr<UDPServer> CreateShard(const std::shared_ptr<Service>& service, const asio::ip::udp::endpoint& endpoint) override
+    {
+        // The third shard always fails to start
+        if (_created++ == 2)
+            return std::make_shared<FailUDPServer>(service, endpoint);
+        return std::make_shared<EchoUDPServer>(service, endpoint);
+    }
+
+private:
+    size_t _created{0};
+};
+
 } // namespace
 
 TEST_CASE("UDP server test", "[CppServer][UDP]")
@@ -261,3 +452,533 @@ TEST_CASE("UDP server random test", "[CppServer][UDP]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("UDP server send queue test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3337;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Queue server
+    auto server = std::make_shared<QueueUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send a message to the Queue server
+    client->Send("test");
+
+    // Wait for all queued replies sent...
+    while (server->sent_notifications != 100)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Queue server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Queue server state
+    REQUIRE(server->datagrams_sent() == 100);
+    REQUIRE(server->bytes_sent() == 400);
+    REQUIRE(server->datagrams_pending() == 0);
+    REQUIRE(server->bytes_pending() == 0);
+    REQUIRE(!server->rejected);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("UDP server send queue limit test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3341;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Limit server with the limited send queue
+    auto server = std::make_shared<LimitUDPServer>(service, port);
+    server->SetupSendQueueLimit(10);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Block the Asio service thread, so queued datagrams cannot be flushed
+    std::atomic<bool> blocked{true};
+    std::atomic<bool> waiting{false};
+    service->Post([&blocked, &waiting]() { waiting = true; while (blocked) Thread::Yield(); });
+    while (!waiting)
+        Thread::Yield();
+
+    // Queue more datagrams than the send queue limit from another thread
+    size_t accepted = 0;
+    size_t rejected = 0;
+    asio::ip::udp::endpoint endpoint(asio::ip::make_address(address), port);
+    for (int i = 0; i < 15; ++i)
+    {
+        if (server->SendAsync(endpoint, "test"))
+            ++accepted;
+        else
+            ++rejected;
+    }
+    REQUIRE(accepted == 10);
+    REQUIRE(rejected == 5);
+    REQUIRE(server->datagrams_pending() == 10);
+    REQUIRE(server->bytes_pending() == 40);
+    REQUIRE(server->errors == 5);
+
+    // Unblock the Asio service thread and wait for all queued datagrams sent...
+    blocked = false;
+    while (server->sent_notifications != 10)
+        Thread::Yield();
+
+    // Queue is available again after the flush
+    REQUIRE(server->SendAsync(endpoint, "test"));
+    while (server->sent_notifications != 11)
+        Thread::Yield();
+
+    // Stop the Limit server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Limit server state
+    REQUIRE(server->datagrams_sent() == 11);
+    REQUIRE(server->bytes_sent() == 44);
+    REQUIRE(server->datagrams_pending() == 0);
+    REQUIRE(server->bytes_pending() == 0);
+    REQUIRE(server->errors == 5);
+}
+
+TEST_CASE("UDP server receive batch test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3338;
+
+    // Create and start Asio services for the server and the client
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+    auto client_service = std::make_shared<EchoUDPService>();
+    REQUIRE(client_service->Start());
+    while (!client_service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server with batched receive
+    auto server = std::make_shared<BatchUDPServer>(service, port);
+    server->SetupReceiveBatch(32);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoUDPClient>(client_service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Block the server Asio service thread, so sent datagrams are accumulated in the socket
+    std::atomic<bool> blocked{true};
+    std::atomic<bool> waiting{false};
+    service->Post([&blocked, &waiting]() { waiting = true; while (blocked) Thread::Yield(); });
+    while (!waiting)
+        Thread::Yield();
+
+    // Send a bunch of messages to the Echo server
+    for (int i = 0; i < 100; ++i)
+        client->SendAsync("test");
+    while (client->datagrams_sent() != 100)
+        Thread::Yield();
+
+    // Unblock the server Asio service thread and wait for all data processed...
+    blocked = false;
+    while (client->bytes_received() != 400)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio services
+    REQUIRE(client_service->Stop());
+    while (client_service->IsStarted())
+        Thread::Yield();
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->max_batch > 1);
+    REQUIRE(server->max_batch <= 32);
+    REQUIRE(server->datagrams_received() == 100);
+    REQUIRE(server->datagrams_sent() == 100);
+    REQUIRE(server->bytes_sent() == 400);
+    REQUIRE(server->bytes_received() == 400);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("UDP server segmentation offload test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3339;
+    const int sender_port = 3342;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start receiver server with the generic receive offload
+    auto receiver = std::make_shared<OffloadUDPServer>(service, port);
+    receiver->SetupReceiveBatch(32);
+    receiver->SetupGRO(true);
+    REQUIRE(receiver->Start());
+    while (!receiver->IsStarted())
+        Thread::Yield();
+
+    // Create and start sender server with the generic segmentation offload
+    auto sender = std::make_shared<OffloadUDPServer>(service, sender_port);
+    sender->SetupGSO(true);
+    REQUIRE(sender->Start());
+    while (!sender->IsStarted())
+        Thread::Yield();
+
+#if defined(__linux__)
+    REQUIRE(receiver->IsGRO());
+    REQUIRE(sender->IsGSO());
+#endif
+
+    // Block the Asio service thread, so all datagrams are flushed together
+    std::atomic<bool> blocked{true};
+    std::atomic<bool> waiting{false};
+    service->Post([&blocked, &waiting]() { waiting = true; while (blocked) Thread::Yield(); });
+    while (!waiting)
+        Thread::Yield();
+
+    // Queue a run of equal-sized datagrams to the same endpoint to be coalesced
+    asio::ip::udp::endpoint endpoint(asio::ip::make_address(address), port);
+    std::string datagram(100, 'x');
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(sender->SendAsync(endpoint, datagram));
+
+    // Unblock the Asio service thread and wait for all data processed...
+    blocked = false;
+    while (receiver->bytes_received() != 10000)
+        Thread::Yield();
+
+    // Stop the servers
+    REQUIRE(sender->Stop());
+    while (sender->IsStarted())
+        Thread::Yield();
+    REQUIRE(receiver->Stop());
+    while (receiver->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the servers state
+#if defined(__linux__)
+    REQUIRE(receiver->coalesced > 0);
+#endif
+    REQUIRE(sender->datagrams_sent() == 100);
+    REQUIRE(sender->bytes_sent() == 10000);
+    REQUIRE(receiver->datagrams_received() == 100);
+    REQUIRE(receiver->bytes_received() == 10000);
+    REQUIRE(!sender->errors);
+    REQUIRE(!receiver->errors);
+}
+
+TEST_CASE("UDP sharded server test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3340;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>(4);
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo sharded server
+    auto server = std::make_shared<EchoUDPShardedServer>(service, port);
+    REQUIRE(server->Start());
+    for (auto& shard : server->shards())
+        while (!shard->IsStarted())
+            Thread::Yield();
+
+    // Create and connect Echo clients
+    std::vector<std::shared_ptr<EchoUDPClient>> clients;
+    for (int i = 0; i < 10; ++i)
+    {
+        auto client = std::make_shared<EchoUDPClient>(service, address, port);
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected())
+            Thread::Yield();
+        clients.emplace_back(client);
+    }
+
+    // Send a message from each Echo client
+    for (auto& client : clients)
+        client->SendAsync("test");
+
+    // Wait for all data processed...
+    for (auto& client : clients)
+        while (client->bytes_received() != 4)
+            Thread::Yield();
+
+    // Disconnect Echo clients
+    for (auto& client : clients)
+    {
+        REQUIRE(client->DisconnectAsync());
+        while (client->IsConnected())
+            Thread::Yield();
+    }
+
+    // Stop the Echo sharded server
+    REQUIRE(server->Stop());
+    for (auto& shard : server->shards())
+        while (shard->IsStarted())
+            Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo sharded server state
+    REQUIRE(server->shards().size() == 4);
+    REQUIRE(server->datagrams_received() == 10);
+    REQUIRE(server->datagrams_sent() == 10);
+    REQUIRE(server->bytes_sent() == 40);
+    REQUIRE(server->bytes_received() == 40);
+}
+
+TEST_CASE("UDP sharded server failed start test", "[CppServer][UDP]")
+{
+    const int port = 3346;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>(4);
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Start the sharded server with the failing third shard
+    auto server = std::make_shared<FailUDPShardedServer>(service, port, InternetProtocol::IPv4, 4);
+    REQUIRE(!server->Start());
+    REQUIRE(!server->IsStarted());
+    REQUIRE(server->shards().size() == 4);
+
+    // Wait for the already started shards to be stopped
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto shard = std::static_pointer_cast<EchoUDPServer>(server->shards()[i]);
+        while (!shard->stopped)
+            Thread::Yield();
+        REQUIRE(shard->started);
+        REQUIRE(!shard->IsStarted());
+    }
+
+    // Check the rest of shards were not started
+    for (size_t i = 2; i < 4; ++i)
+        REQUIRE(!server->shards()[i]->IsStarted());
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("UDP server receive pool test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3344;
+
+    // Check single and batched receive modes
+    for (size_t batch : { 0, 8 })
+    {
+        // Create and start Asio service
+        auto service = std::make_shared<EchoUDPService>();
+        REQUIRE(service->Start());
+        while (!service->IsStarted())
+            Thread::Yield();
+
+        // Create and start the server receiving into pooled buffers
+        auto pool = std::make_shared<DatagramBufferPool>(256, 1024);
+        auto server = std::make_shared<PooledUDPServer>(service, port);
+        server->SetupReceivePool(pool);
+        server->SetupReceiveBatch(batch);
+        REQUIRE(server->Start());
+        while (!server->IsStarted())
+            Thread::Yield();
+
+        // Create and connect Echo client
+        auto client = std::make_shared<EchoUDPClient>(service, address, port);
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected())
+            Thread::Yield();
+
+        // Process pooled datagrams in the worker thread
+        std::atomic<size_t> processed(0);
+        std::atomic<bool> corrupted(false);
+        std::vector<bool> received(100, false);
+        std::thread worker([&server, &processed, &corrupted, &received]()
+        {
+            while (processed < 100)
+            {
+                for (auto& datagram : server->TakeDatagrams())
+                {
+                    // Each datagram should keep its own distinct payload
+                    std::string payload((const char*)datagram.data(), datagram.size());
+                    int index = ((payload.size() == 4) && (payload.find_first_not_of("0123456789") == std::string::npos)) ? std::stoi(payload) : -1;
+                    if ((index < 0) || (index >= 100) || received[index])
+                        corrupted = true;
+                    else
+                        received[index] = true;
+                    ++processed;
+                }
+                Thread::Yield();
+            }
+        });
+
+        // Send a bunch of distinct messages to the server
+        for (int i = 0; i < 100; ++i)
+        {
+            char message[5];
+            std::snprintf(message, sizeof(message), "%04d", i);
+            client->SendAsync(message, 4);
+        }
+
+        // Wait for all data processed...
+        worker.join();
+
+        // Disconnect the Echo client
+        REQUIRE(client->DisconnectAsync());
+        while (client->IsConnected())
+            Thread::Yield();
+
+        // Stop the server
+        REQUIRE(server->Stop());
+        while (server->IsStarted())
+            Thread::Yield();
+
+        // Stop the Asio service
+        REQUIRE(service->Stop());
+        while (service->IsStarted())
+            Thread::Yield();
+
+        // Check the server state
+        REQUIRE(processed == 100);
+        REQUIRE(!corrupted);
+        REQUIRE(server->datagrams_received() == 100);
+        REQUIRE(server->bytes_received() == 400);
+        REQUIRE(!server->errors);
+
+        // Check the pool state
+        REQUIRE(pool->allocations() == 0);
+    }
+}
+
+TEST_CASE("UDP server receive timestamp test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3345;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server with receive timestamps
+    auto server = std::make_shared<TimestampUDPServer>(service, port);
+    server->SetupReceiveTimestamp(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect the client with receive timestamps
+    auto client = std::make_shared<TimestampUDPClient>(service, address, port);
+    client->SetupReceiveTimestamp(true);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+#if defined(__linux__)
+    // Receive timestamps are supported on Linux
+    REQUIRE(server->IsReceiveTimestamp());
+    REQUIRE(client->IsReceiveTimestamp());
+#endif
+
+    // Send a bunch of messages to the Echo server
+    for (int i = 0; i < 100; ++i)
+        client->SendAsync("test");
+
+    // Wait for all data processed...
+    while (client->bytes_received() != 400)
+        Thread::Yield();
+
+    // Disconnect the client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->datagrams_received() == 100);
+    REQUIRE(server->bytes_received() == 400);
+    REQUIRE(!server->invalid);
+    REQUIRE(!server->errors);
+
+    // Check the client state
+    REQUIRE(client->datagrams_received() == 100);
+    REQUIRE(!client->invalid);
+    REQUIRE(!client->errors);
+}
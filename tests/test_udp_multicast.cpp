@@ -5,11 +5,15 @@
 #include "test.h"
 
 #include "server/asio/udp_client.h"
+#include "server/asio/udp_multicast_publisher.h"
+#include "server/asio/udp_multicast_subscriber.h"
 #include "server/asio/udp_server.h"
 #include "threads/thread.h"
 
 #include <atomic>
 #include <chrono>
+#include <cstring>
+#include <random>
 #include <vector>
 
 using namespace CppCommon;
@@ -72,6 +76,55 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class LossUDPMulticastSubscriber : public UDPMulticastSubscriber
+{
+public:
+    LossUDPMulticastSubscriber(const std::shared_ptr<Service>& service, const std::string& address, int port, int loss)
+        : UDPMulticastSubscriber(service, address, port),
+          _loss(loss),
+          _random(1)
+    {
+    }
+
+protected:
+    void onConnected() override { UDPMulticastSubscriber::onConnected(); connected = true; }
+    void onDisconnected() override { UDPMulticastSubscriber::onDisconnected(); disconnected = true; }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Inject the datagram loss
+        if ((int)(_random() % 100) < _loss)
+        {
+            ReceiveAsync();
+            return;
+        }
+
+        UDPMulticastSubscriber::onReceived(endpoint, buffer, size);
+        if (session() != 0)
+            synchronized = true;
+    }
+    void onReceivedMessage(uint64_t sequence, const void* buffer, size_t size) override
+    {
+        uint32_t message;
+        std::memcpy(&message, buffer, sizeof(message));
+        if ((size != sizeof(message)) || (message != received))
+            errors = true;
+        ++received;
+    }
+    void onLost(uint64_t sequence, size_t count) override { errors = true; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<bool> synchronized{false};
+    std::atomic<uint32_t> received{0};
+    std::atomic<bool> errors{false};
+
+private:
+    int _loss;
+    std::mt19937 _random;
+};
+
 } // namespace
 
 TEST_CASE("UDP server multicast test", "[CppServer][UDP]")
@@ -325,3 +378,157 @@ TEST_CASE("UDP server multicast random test", "[CppServer][UDP]")
     REQUIRE(server->bytes_received() == 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("UDP multicast publisher recovery test", "[CppServer][UDP]")
+{
+    const std::string listen_address = "0.0.0.0";
+    const std::string multicast_address = "239.255.0.1";
+    const int multicast_port = 3343;
+    const uint32_t messages = UDPMulticastSubscriber::REORDER_WINDOW / 2;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start multicast publisher
+    auto publisher = std::make_shared<UDPMulticastPublisher>(service, 0);
+    publisher->SetupHeartbeatInterval(Timespan::milliseconds(10));
+    REQUIRE(publisher->Start(multicast_address, multicast_port));
+    while (!publisher->IsStarted())
+        Thread::Yield();
+
+    // Create and connect multicast subscriber with 5% datagram loss
+    auto subscriber = std::make_shared<LossUDPMulticastSubscriber>(service, listen_address, multicast_port, 5);
+    subscriber->SetupMulticast(true);
+    REQUIRE(subscriber->ConnectAsync());
+    while (!subscriber->IsConnected())
+        Thread::Yield();
+
+    // Join multicast group and wait for the publisher heartbeat
+    subscriber->JoinMulticastGroup(multicast_address);
+    while (!subscriber->synchronized)
+        Thread::Yield();
+
+    // Publish messages
+    for (uint32_t i = 0; i < messages; ++i)
+        REQUIRE(publisher->Publish(&i, sizeof(i)));
+
+    // Wait for all messages recovered and received in sequence
+    while ((subscriber->received != messages) && !subscriber->errors)
+        Thread::Yield();
+
+    // Leave multicast group
+    subscriber->LeaveMulticastGroup(multicast_address);
+
+    // Disconnect the multicast subscriber
+    REQUIRE(subscriber->DisconnectAsync());
+    while (subscriber->IsConnected())
+        Thread::Yield();
+
+    // Stop the multicast publisher
+    REQUIRE(publisher->Stop());
+    while (publisher->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the multicast publisher state
+    REQUIRE(publisher->messages_published() == messages);
+    REQUIRE(publisher->retransmit_requests() > 0);
+    REQUIRE(publisher->packets_retransmitted() > 0);
+    REQUIRE(publisher->packets_unavailable() == 0);
+
+    // Check the multicast subscriber state
+    REQUIRE(subscriber->connected);
+    REQUIRE(subscriber->disconnected);
+    REQUIRE(subscriber->received == messages);
+    REQUIRE(subscriber->messages_received() == messages);
+    REQUIRE(subscriber->messages_recovered() > 0);
+    REQUIRE(subscriber->messages_lost() == 0);
+    REQUIRE(subscriber->gaps_detected() > 0);
+    REQUIRE(!subscriber->errors);
+}
+
+TEST_CASE("UDP multicast publisher retransmit limit test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const std::string multicast_address = "239.255.0.1";
+    const int port = 3350;
+    const int multicast_port = 3351;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start multicast publisher with the limited retransmit rate
+    auto publisher = std::make_shared<UDPMulticastPublisher>(service, port);
+    publisher->SetupRetransmitRateLimit(100);
+    REQUIRE(publisher->Start(multicast_address, multicast_port));
+    while (!publisher->IsStarted())
+        Thread::Yield();
+
+    // Publish messages
+    for (uint32_t i = 0; i < 200; ++i)
+        REQUIRE(publisher->Publish(&i, sizeof(i)));
+
+    // Request retransmit of more packets than the rate limit allows
+    asio::io_context io_context;
+    asio::ip::udp::socket socket(io_context, asio::ip::udp::endpoint(asio::ip::make_address(address), 0));
+    asio::ip::udp::endpoint endpoint(asio::ip::make_address(address), port);
+    auto request = [&socket, &endpoint, &publisher](uint64_t first, uint32_t count)
+    {
+        uint8_t packet[UDPMulticastPublisher::REQUEST_SIZE] = { (uint8_t)UDPMulticastPublisher::PacketType::Request };
+        for (size_t i = 0; i < 4; ++i)
+            packet[4 + i] = (uint8_t)(publisher->session() >> (8 * i));
+        for (size_t i = 0; i < 8; ++i)
+            packet[8 + i] = (uint8_t)(first >> (8 * i));
+        for (size_t i = 0; i < 4; ++i)
+            packet[16 + i] = (uint8_t)(count >> (8 * i));
+        socket.send_to(asio::buffer(packet, sizeof(packet)), endpoint);
+    };
+    request(1, 1000);
+    while (publisher->packets_retransmitted() != 100)
+        Thread::Yield();
+    REQUIRE(publisher->retransmit_requests() == 1);
+    REQUIRE(publisher->packets_limited() == 100);
+
+    // Check the retransmitted packet
+    std::vector<uint8_t> buffer(UDPMulticastPublisher::HEADER_SIZE + sizeof(uint32_t));
+    asio::ip::udp::endpoint sender;
+    REQUIRE(socket.receive_from(asio::buffer(buffer), sender) == buffer.size());
+    REQUIRE(buffer[0] == (uint8_t)UDPMulticastPublisher::PacketType::Data);
+    REQUIRE(buffer[1] != 0);
+
+    // Request retransmit over the exhausted rate limit
+    request(101, 50);
+    while (publisher->packets_limited() != 150)
+        Thread::Yield();
+    REQUIRE(publisher->retransmit_requests() == 2);
+    REQUIRE(publisher->packets_retransmitted() == 100);
+
+    // Request retransmit of not published packets does not charge the rate limit
+    request(1000, 50);
+    request(101, 1);
+    while (publisher->retransmit_requests() != 4)
+        Thread::Yield();
+    while (publisher->packets_limited() < 151)
+        Thread::Yield();
+    REQUIRE(publisher->packets_limited() == 151);
+
+    // Stop the multicast publisher
+    REQUIRE(publisher->Stop());
+    while (publisher->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
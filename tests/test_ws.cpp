@@ -8,8 +8,11 @@
 #include "server/ws/ws_server.h"
 #include "threads/thread.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstring>
+#include <future>
 #include <vector>
 
 using namespace CppCommon;
@@ -110,6 +113,18 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class WatchdogWSServer : public EchoWSServer
+{
+public:
+    using EchoWSServer::EchoWSServer;
+
+protected:
+    void onConnected(std::shared_ptr<TCPSession>& session) override { this->session = session; EchoWSServer::onConnected(session); }
+
+public:
+    std::shared_ptr<TCPSession> session;
+};
+
 } // namespace
 
 TEST_CASE("WebSocket server test", "[CppServer][WebSocket]")
@@ -182,6 +197,79 @@ TEST_CASE("WebSocket server test", "[CppServer][WebSocket]")
     REQUIRE(!client->errors);
 }
 
+TEST_CASE("WebSocket server watchdog test", "[CppServer][WebSocket]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8086;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoWSService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Get the timer wheel of the Asio service
+    auto io_service = service->GetAsioService();
+    auto wheel = service->GetTimerWheel(io_service);
+    REQUIRE(wheel);
+
+    // Timer wheel size is checked in its Asio IO service thread
+    auto scheduled = [&io_service, &wheel]()
+    {
+        std::promise<size_t> promise;
+        auto future = promise.get_future();
+        asio::post(*io_service, [&promise, &wheel]() { promise.set_value(wheel->size()); });
+        return future.get();
+    };
+
+    // Create and start Echo server with keep-alive pings
+    auto server = std::make_shared<WatchdogWSServer>(service, port);
+    server->SetupWSPingInterval(Timespan::seconds(10));
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoWSClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->connected || (server->clients != 1))
+        Thread::Yield();
+
+    // Wait for the session watchdog scheduled...
+    while (scheduled() == 0)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->CloseAsync(1000));
+    while (!client->disconnected || (server->clients != 0))
+        Thread::Yield();
+
+    // Check the session watchdog is released from the timer wheel while the session is still alive
+    REQUIRE(server->session);
+    REQUIRE(scheduled() == 0);
+    server->session.reset();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(!client->errors);
+}
+
 TEST_CASE("WebSocket server multicast test", "[CppServer][WebSocket]")
 {
     const std::string address = "127.0.0.1";
@@ -435,3 +523,198 @@ TEST_CASE("WebSocket server random test", "[CppServer][WebSocket]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("WebSocket mask test", "[CppServer][WebSocket]")
+{
+    const uint8_t mask[4] = { 0x37, 0xFA, 0x21, 0x3D };
+
+    for (size_t size : { 0, 1, 7, 16, 33, 64, 127, 1000 })
+    {
+        for (size_t offset = 0; offset < 4; ++offset)
+        {
+            std::vector<uint8_t> source(size);
+            for (size_t i = 0; i < size; ++i)
+                source[i] = (uint8_t)(i * 31 + 7);
+
+            // Mask the payload
+            std::vector<uint8_t> destination(size);
+            WebSocket::MaskPayload(destination.data(), source.data(), size, mask, offset);
+            for (size_t i = 0; i < size; ++i)
+                REQUIRE(destination[i] == (source[i] ^ mask[(i + offset) % 4]));
+
+            // Unmask the payload in place
+            WebSocket::MaskPayload(destination.data(), destination.data(), size, mask, offset);
+            REQUIRE(destination == source);
+        }
+    }
+}
+
+TEST_CASE("WebSocket shared frame test", "[CppServer][WebSocket]")
+{
+    // Small text frame
+    auto text = WebSocket::PrepareSharedFrame(WebSocket::WS_FIN | WebSocket::WS_TEXT, "test", 4);
+    REQUIRE(*text == std::vector<uint8_t>({ 0x81, 0x04, 't', 'e', 's', 't' }));
+
+    // Binary frame with 16-bit payload size
+    std::vector<uint8_t> payload(300, 0xAA);
+    auto binary = WebSocket::PrepareSharedFrame(WebSocket::WS_FIN | WebSocket::WS_BINARY, payload.data(), payload.size());
+    REQUIRE(binary->size() == (4 + payload.size()));
+    REQUIRE((*binary)[0] == 0x82);
+    REQUIRE((*binary)[1] == 126);
+    REQUIRE((*binary)[2] == 0x01);
+    REQUIRE((*binary)[3] == 0x2C);
+    REQUIRE(std::equal(payload.begin(), payload.end(), binary->begin() + 4));
+
+    // Close frame with status
+    auto close = WebSocket::PrepareSharedFrame(WebSocket::WS_FIN | WebSocket::WS_CLOSE, "bye", 3, 1000);
+    REQUIRE(*close == std::vector<uint8_t>({ 0x88, 0x05, 0x03, 0xE8, 'b', 'y', 'e' }));
+}
+
+TEST_CASE("WebSocket permessage-deflate test", "[CppServer][WebSocket]")
+{
+    WSDeflateOptions server_options;
+    WSDeflateOptions client_options;
+
+    // Negotiate permessage-deflate extension
+    std::string response;
+    WSDeflateOptions server_agreed;
+    REQUIRE(!server_options.NegotiateOffer("x-webkit-deflate-frame", server_agreed, response));
+    REQUIRE(!server_options.NegotiateOffer("permessage-deflate; server_max_window_bits=8", server_agreed, response));
+    REQUIRE(server_options.NegotiateOffer("permessage-deflate; unknown, permessage-deflate; server_no_context_takeover; client_max_window_bits", server_agreed, response));
+    REQUIRE(response == "permessage-deflate; server_no_context_takeover");
+    REQUIRE(server_agreed.server_no_context_takeover);
+    REQUIRE(!server_agreed.client_no_context_takeover);
+    REQUIRE(server_options.NegotiateOffer(client_options.PrepareOffer(), server_agreed, response));
+    REQUIRE(response == "permessage-deflate");
+    WSDeflateOptions client_agreed;
+    REQUIRE(!client_options.NegotiateResponse("permessage-deflate; unknown", client_agreed));
+    REQUIRE(client_options.NegotiateResponse(response, client_agreed));
+
+    // Decompress RFC 7692 sample message
+    WSDeflate client;
+    REQUIRE(client.Initialize(client_agreed, false));
+    const uint8_t hello[] = { 0xF2, 0x48, 0xCD, 0xC9, 0xC9, 0x07, 0x00 };
+    std::vector<uint8_t> output;
+    REQUIRE(client.Decompress(hello, sizeof(hello), output));
+    REQUIRE(std::string(output.begin(), output.end()) == "Hello");
+
+    // Compress messages with context takeover
+    WSDeflate server;
+    REQUIRE(server.Initialize(server_agreed, true));
+    REQUIRE(client.Initialize(client_agreed, false));
+    std::string message = "{\"symbol\":\"EURUSD\",\"bid\":1.1012,\"ask\":1.1014}";
+    std::vector<uint8_t> compressed;
+    size_t first = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(server.Compress(message.data(), message.size(), compressed));
+        REQUIRE(client.Decompress(compressed.data(), compressed.size(), output));
+        REQUIRE(std::string(output.begin(), output.end()) == message);
+        if (i == 0)
+            first = compressed.size();
+        else
+            REQUIRE(compressed.size() < first);
+    }
+
+    // Compress message once for sessions without context takeover
+    REQUIRE(WSDeflate::CompressOnce(message.data(), message.size(), 15, -1, compressed));
+    REQUIRE(client.Decompress(compressed.data(), compressed.size(), output));
+    REQUIRE(std::string(output.begin(), output.end()) == message);
+}
+
+namespace {
+
+class StreamingWebSocket : public WebSocket
+{
+public:
+    std::string message;
+    std::string ping;
+    size_t fragments{0};
+    size_t first_fragments{0};
+    size_t last_fragments{0};
+    std::string error;
+    int close_status{0};
+
+    std::vector<uint8_t> PrepareMaskedFrame(uint8_t opcode, std::string_view payload)
+    {
+        const uint8_t mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+        std::memcpy(_ws_send_mask, mask, sizeof(mask));
+        PrepareSendFrame(opcode, true, payload.data(), payload.size());
+        return _ws_send_buffer;
+    }
+
+protected:
+    void onWSReceivedFragment(const void* buffer, size_t size, bool first, bool last) override
+    {
+        message.append((const char*)buffer, size);
+        ++fragments;
+        first_fragments += first ? 1 : 0;
+        last_fragments += last ? 1 : 0;
+    }
+    void onWSPing(const void* buffer, size_t size) override { ping.assign((const char*)buffer, size); }
+    void onWSError(const std::string& message) override { error = message; }
+    void CloseConnection(int status, std::string_view reason) override { close_status = status; }
+};
+
+} // namespace
+
+TEST_CASE("WebSocket streaming receive test", "[CppServer][WebSocket]")
+{
+    StreamingWebSocket sender;
+    StreamingWebSocket receiver;
+    receiver.SetupWSStreaming(true);
+    receiver.SetupWSMaxMessageSize(64);
+
+    // Prepare fragmented message with the interleaved ping frame
+    std::vector<uint8_t> stream;
+    for (const auto& frame : { sender.PrepareMaskedFrame(WebSocket::WS_TEXT, "Hello, "), sender.PrepareMaskedFrame(0, "streaming "), sender.PrepareMaskedFrame(WebSocket::WS_FIN | WebSocket::WS_PING, "ping"), sender.PrepareMaskedFrame(WebSocket::WS_FIN, "world!") })
+        stream.insert(stream.end(), frame.begin(), frame.end());
+
+    // Receive the stream in small chunks
+    std::vector<uint8_t> received(stream);
+    for (size_t offset = 0; offset < stream.size(); offset += 3)
+        receiver.PrepareReceiveFrame(stream.data() + offset, std::min((size_t)3, stream.size() - offset));
+
+    // Received data must not be unmasked in place
+    REQUIRE(stream == received);
+    REQUIRE(receiver.message == "Hello, streaming world!");
+    REQUIRE(receiver.ping == "ping");
+    REQUIRE(receiver.fragments > 3);
+    REQUIRE(receiver.first_fragments == 1);
+    REQUIRE(receiver.last_fragments == 1);
+    REQUIRE(receiver.error.empty());
+
+    // Reject too large message by its frame header
+    std::string large(100, 'x');
+    auto frame = sender.PrepareMaskedFrame(WebSocket::WS_FIN | WebSocket::WS_BINARY, large);
+    receiver.PrepareReceiveFrame(frame.data(), 8);
+    REQUIRE(receiver.error == "WebSocket message is too large");
+    REQUIRE(receiver.close_status == 1009);
+    receiver.PrepareReceiveFrame(frame.data() + 8, frame.size() - 8);
+    REQUIRE(receiver.message == "Hello, streaming world!");
+}
+
+TEST_CASE("WebSocket reserved bits test", "[CppServer][WebSocket]")
+{
+    StreamingWebSocket sender;
+
+    // Fail the connection on the compressed frame without negotiated permessage-deflate extension
+    StreamingWebSocket receiver;
+    receiver.SetupWSStreaming(true);
+    auto frame = sender.PrepareMaskedFrame(WebSocket::WS_FIN | WebSocket::WS_RSV1 | WebSocket::WS_TEXT, "Hello");
+    receiver.PrepareReceiveFrame(frame.data(), frame.size());
+    REQUIRE(receiver.close_status == 1002);
+    REQUIRE(!receiver.error.empty());
+    REQUIRE(receiver.message.empty());
+
+    // Skip received data after the connection was failed
+    frame = sender.PrepareMaskedFrame(WebSocket::WS_FIN | WebSocket::WS_TEXT, "Hello");
+    receiver.PrepareReceiveFrame(frame.data(), frame.size());
+    REQUIRE(receiver.message.empty());
+
+    // Fail the connection on the not negotiated RSV2 bit
+    StreamingWebSocket other;
+    frame = sender.PrepareMaskedFrame(WebSocket::WS_FIN | 0x20 | WebSocket::WS_BINARY, "Hello");
+    other.PrepareReceiveFrame(frame.data(), frame.size());
+    REQUIRE(other.close_status == 1002);
+}